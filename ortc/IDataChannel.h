@@ -82,6 +82,28 @@ namespace ortc
                       const BYTE *buffer,
                       size_t bufferSizeInBytes
                       ) = 0;
+
+    // Sends binary data without copying; the data channel takes ownership of
+    // the buffer and the caller must not modify it after this call.
+    virtual void send(SecureByteBlockPtr data) = 0;
+
+    // Streams one large message as a sequence of chunks so it never has to be
+    // held in memory as a whole. Every chunk but the one flagged "lastChunk"
+    // is sent as a partial message and the remote party receives each chunk
+    // as it arrives (see MessageEventData::mPartial). Pace the stream by
+    // pausing while bufferedAmount() exceeds the chosen window and resuming
+    // on onDataChannelBufferedAmountLow. Only allowed on reliable ordered
+    // channels and no other message may be sent until the last chunk is.
+    // Each text chunk is delivered on its own so it must end on a UTF-8
+    // code point boundary (a chunk splitting a multi-byte sequence throws).
+    virtual void sendPartial(
+                             SecureByteBlockPtr chunk,
+                             bool lastChunk
+                             ) = 0;
+    virtual void sendPartial(
+                             const String &chunk,
+                             bool lastChunk
+                             ) = 0;
   };
 
   //---------------------------------------------------------------------------
@@ -102,6 +124,7 @@ namespace ortc
     {
       SecureByteBlockPtr mBinary;
       String mText;
+      bool mPartial {};   // more chunks of the same streamed message follow
     };
 
     virtual void onDataChannelStateChange(
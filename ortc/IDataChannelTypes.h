@@ -79,6 +79,7 @@ namespace ortc
       String            mProtocol;
       bool              mNegotiated {false};
       Optional<USHORT>  mID;
+      WORD              mPriority {256};  // RFC 8832 scale: 128 below normal, 256 normal, 512 high, 1024 extra high
 
       Parameters() {}
       Parameters(const Parameters &op2) {(*this) = op2;}
@@ -132,6 +132,7 @@ namespace ortc
 
     struct Options {
       bool                mContinuousGathering {true};
+      bool                mICELite {false};     // only answer checks (RFC 8445 section 2.5); for endpoints with public addresses
       InterfacePolicyList mInterfacePolicies;
       ServerList          mICEServers;
 
@@ -73,6 +73,7 @@ namespace ortc
       WORD mMaxPort {};
       WORD mMaxUsablePorts {};
       WORD mMaxSessionsPerPort {};
+      bool mMessageInterleaving {};   // I-DATA chunks (RFC 8260)
 
       Capabilities() {}
       Capabilities(const Capabilities &op2) {(*this) = op2;}
@@ -329,6 +329,20 @@ namespace ortc
       unsigned long mDataChannelsOpened {};
       unsigned long mDataChannelsClosed {};
 
+      String mStreamScheduler;
+      unsigned short mStreamPriority {};    // per stream reports only
+      unsigned long long mMessagesSent {};
+      unsigned long long mBytesSent {};
+
+      // association wide, from SCTP_STATUS (total report only)
+      unsigned long mCongestionWindow {};       // bytes, primary path
+      Milliseconds mSmoothedRoundTripTime {};
+      Milliseconds mRetransmissionTimeout {};
+      unsigned long mPathMTU {};
+      unsigned long mReceiverWindow {};         // peer's advertised window
+      unsigned long mUnackedData {};            // chunks sent, not yet acknowledged
+      unsigned long mPendingData {};            // chunks queued, not yet sent
+
       SCTPTransportStats() { mStatsType = IStatsReportTypes::StatsType_SCTPTransport; }
       SCTPTransportStats(const SCTPTransportStats &op2);
       SCTPTransportStats(ElementPtr rootEl);
@@ -442,6 +456,8 @@ namespace ortc
       unsigned long long        mBytesSent {};
       unsigned long             mMessagesReceived {};
       unsigned long long        mBytesReceived {};
+      unsigned long long        mBufferedAmount {};
+      unsigned long long        mBufferedAmountHighWaterMark {};
 
       DataChannelStats() { mStatsType = IStatsReportTypes::StatsType_DataChannel; }
       DataChannelStats(const DataChannelStats &op2);
@@ -474,8 +490,19 @@ namespace ortc
     {
       unsigned long long  mBytesSent{};
       unsigned long long  mBytesReceived{};
+      unsigned long long  mPacketsSent{};
+      unsigned long long  mPacketsReceived{};
+      unsigned long long  mPacketsDiscarded{};
+      unsigned long long  mSendWouldBlock{};
       String              mRTCPGathererStatsID;
 
+      Milliseconds        mTimeToFirstHostCandidate{};
+      Milliseconds        mTimeToFirstServerReflexiveCandidate{};
+      Milliseconds        mTimeToFirstRelayCandidate{};
+      Milliseconds        mTimeToGatheringComplete{};
+      unsigned long long  mWarmPoolSocketsAdopted{};
+      unsigned long long  mWarmPoolReflexiveMappingsAdopted{};
+
       ICEGathererStats() { mStatsType = IStatsReportTypes::StatsType_ICEGatherer; }
       ICEGathererStats(const ICEGathererStats &op2);
       ICEGathererStats(ElementPtr rootEl);
@@ -652,6 +679,10 @@ namespace ortc
       double                        mRoundTripTime {};
       double                        mAvailableOutgoingBitrate {};
       double                        mAvailableIncomingBitrate {};
+      unsigned long long            mRequestsSent {};       // connectivity checks
+      unsigned long long            mRequestsReceived {};
+      unsigned long long            mResponsesSent {};
+      unsigned long long            mResponsesReceived {};
 
       ICECandidatePairStats() { mStatsType = IStatsReportTypes::StatsType_CandidatePair; }
       ICECandidatePairStats(const ICECandidatePairStats &op2);
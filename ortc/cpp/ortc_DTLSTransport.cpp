@@ -31,6 +31,7 @@
 
 #include <ortc/internal/ortc_DTLSTransport.h>
 #include <ortc/internal/ortc_ICETransport.h>
+#include <ortc/internal/ortc_ICEGatherer.h>
 #include <ortc/internal/ortc_Certificate.h>
 #include <ortc/internal/ortc_RTPListener.h>
 #include <ortc/internal/ortc_SRTPTransport.h>
@@ -1320,6 +1321,9 @@ namespace ortc
 
     send_packets:
       {
+        // every queued record leaves on this thread (batched when possible)
+        ICEGatherer::SendBurst sendBurst;
+
         BYTE fillBuffer[kMaxDtlsPacketLen] {};
         size_t filled = 0;
 
@@ -32,6 +32,7 @@
 #include <ortc/internal/ortc_DataChannel.h>
 #include <ortc/internal/ortc_SCTPTransport.h>
 #include <ortc/internal/ortc_Helper.h>
+#include <ortc/internal/ortc_StatsReport.h>
 #include <ortc/internal/ortc_ORTC.h>
 #include <ortc/internal/ortc.events.h>
 #include <ortc/internal/platform.h>
@@ -80,6 +81,7 @@ namespace ortc
   {
     ZS_DECLARE_STRUCT_PTR(DataChannelHelper)
     ZS_DECLARE_TYPEDEF_PTR(DataChannelHelper, UseDataHelper)
+    ZS_DECLARE_TYPEDEF_PTR(IStatsReportForInternal, UseStatsReport)
 
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -136,6 +138,29 @@ namespace ortc
       return "unknown";
     }
 
+    //-------------------------------------------------------------------------
+    static bool endsOnCodePointBoundary(const String &text)
+    {
+      const BYTE *bytes = reinterpret_cast<const BYTE *>(text.c_str());
+      size_t pos = text.length();
+
+      // step back over the trailing continuation bytes (10xxxxxx)
+      size_t continuations = 0;
+      while ((pos > 0) &&
+             (continuations < 4) &&
+             (0x80 == (bytes[pos-1] & 0xC0))) {
+        --pos;
+        ++continuations;
+      }
+      if (0 == pos) return true;
+
+      BYTE lead = bytes[pos-1];
+      if (0xC0 == (lead & 0xE0)) return continuations >= 1;
+      if (0xE0 == (lead & 0xF0)) return continuations >= 2;
+      if (0xF0 == (lead & 0xF8)) return continuations >= 3;
+      return true;
+    }
+
     namespace data_channel
     {
       struct OpenPacket
@@ -488,10 +513,10 @@ namespace ortc
 
       AutoRecursiveLock lock(*this);
       if (data.isEmpty()) {
-        send(SCTP_PPID_STRING_LAST, NULL, 0);
+        send(SCTP_PPID_STRING_LAST, SecureByteBlockPtr());
         return;
       }
-      send(SCTP_PPID_STRING_LAST, (const BYTE *)data.c_str(), data.length());
+      send(SCTP_PPID_STRING_LAST, UseServicesHelper::convertToBuffer((const BYTE *)data.c_str(), data.length()));
     }
 
     //-------------------------------------------------------------------------
@@ -505,7 +530,7 @@ namespace ortc
                     );
 
       AutoRecursiveLock lock(*this);
-      send(SCTP_PPID_BINARY_LAST, data.BytePtr(), data.SizeInBytes());
+      send(SCTP_PPID_BINARY_LAST, data.SizeInBytes() > 0 ? UseServicesHelper::convertToBuffer(data.BytePtr(), data.SizeInBytes()) : SecureByteBlockPtr());
     }
 
     //-------------------------------------------------------------------------
@@ -523,7 +548,53 @@ namespace ortc
       ORTC_THROW_INVALID_PARAMETERS_IF((NULL == buffer) && (0 != bufferSizeInBytes))
 
       AutoRecursiveLock lock(*this);
-      send(SCTP_PPID_BINARY_LAST, buffer, bufferSizeInBytes);
+      send(SCTP_PPID_BINARY_LAST, (NULL != buffer) && (0 != bufferSizeInBytes) ? UseServicesHelper::convertToBuffer(buffer, bufferSizeInBytes) : SecureByteBlockPtr());
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::send(SecureByteBlockPtr data)
+    {
+      ZS_EVENTING_3(
+                    x, i, Trace, DataChannelSendBinary, ol, DataChannel, Send,
+                    puid, id, mID,
+                    buffer, buffer, ((bool)data) ? data->BytePtr() : NULL,
+                    size, size, ((bool)data) ? data->SizeInBytes() : 0
+                    );
+
+      AutoRecursiveLock lock(*this);
+      send(SCTP_PPID_BINARY_LAST, data);
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::sendPartial(
+                                  SecureByteBlockPtr chunk,
+                                  bool lastChunk
+                                  )
+    {
+      ZS_EVENTING_3(
+                    x, i, Trace, DataChannelSendBinary, ol, DataChannel, Send,
+                    puid, id, mID,
+                    buffer, buffer, ((bool)chunk) ? chunk->BytePtr() : NULL,
+                    size, size, ((bool)chunk) ? chunk->SizeInBytes() : 0
+                    );
+
+      AutoRecursiveLock lock(*this);
+      send(lastChunk ? SCTP_PPID_BINARY_LAST : SCTP_PPID_BINARY_PARTIAL, chunk, true);
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::sendPartial(
+                                  const String &chunk,
+                                  bool lastChunk
+                                  )
+    {
+      ZS_EVENTING_2(x, i, Trace, DataChannelSendString, ol, DataChannel, Send, puid, id, mID, string, data, chunk);
+
+      // the remote party decodes every chunk on its own
+      ORTC_THROW_INVALID_PARAMETERS_IF(!endsOnCodePointBoundary(chunk))
+
+      AutoRecursiveLock lock(*this);
+      send(lastChunk ? SCTP_PPID_STRING_LAST : SCTP_PPID_STRING_PARTIAL, chunk.hasData() ? UseServicesHelper::convertToBuffer((const BYTE *)chunk.c_str(), chunk.length()) : SecureByteBlockPtr(), true);
     }
 
     //-------------------------------------------------------------------------
@@ -541,9 +612,15 @@ namespace ortc
         return PromiseWithStatsReport::createRejected(IORTCForInternal::queueDelegate());
       }
 
-#define TODO 1
-#define TODO 2
-      return PromiseWithStatsReport::createRejected(IORTCForInternal::queueDelegate());
+      AutoRecursiveLock lock(*this);
+      if (isShutdown()) {
+        ZS_LOG_WARNING(Debug, log("cannot collect stats while shutdown"))
+        return PromiseWithStatsReport::createRejected(IORTCForInternal::queueDelegate());
+      }
+
+      PromiseWithStatsReportPtr promise = PromiseWithStatsReport::create(IORTCForInternal::queueDelegate());
+      IDataChannelAsyncDelegateProxy::create(mThisWeak.lock())->onResolveStatsPromise(promise, stats);
+      return promise;
     }
 
     //-------------------------------------------------------------------------
@@ -716,6 +793,38 @@ namespace ortc
       cancel();
     }
 
+    //-------------------------------------------------------------------------
+    void DataChannel::onResolveStatsPromise(
+                                            IStatsProvider::PromiseWithStatsReportPtr promise,
+                                            IStatsReportTypes::StatsTypeSet stats
+                                            )
+    {
+      UseStatsReport::StatMap reportStats;
+
+      AutoRecursiveLock lock(*this);
+
+      auto report = make_shared<IStatsReportTypes::DataChannelStats>();
+      report->mID = string(mID);
+      if (mParameters) {
+        report->mLabel = mParameters->mLabel;
+        report->mProtocol = mParameters->mProtocol;
+      }
+      if (ORTC_SCTP_INVALID_DATA_CHANNEL_SESSION_ID != mSessionID) {
+        report->mDataChannelID = mSessionID;
+      }
+      report->mState = mCurrentState;
+      report->mMessagesSent = mMessagesSent;
+      report->mBytesSent = mBytesSent;
+      report->mMessagesReceived = mMessagesReceived;
+      report->mBytesReceived = mBytesReceived;
+      report->mBufferedAmount = mOutgoingBufferFillSize;
+      report->mBufferedAmountHighWaterMark = mOutgoingBufferFillSizeHighWaterMark;
+
+      reportStats[report->mID] = report;
+
+      promise->resolve(UseStatsReport::create(reportStats));
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -840,11 +949,17 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "parameters", mParameters ? mParameters->toDebug() : ElementPtr());
 
       UseServicesHelper::debugAppend(resultEl, "incoming data", mIncomingData.size());
-      UseServicesHelper::debugAppend(resultEl, "outgoing data", mOutgoingData.size());
+      UseServicesHelper::debugAppend(resultEl, "outgoing data", mOutgoingData.toDebug());
       UseServicesHelper::debugAppend(resultEl, "outgoing buffer fill size", mOutgoingBufferFillSize);
+      UseServicesHelper::debugAppend(resultEl, "outgoing buffer fill size high water mark", mOutgoingBufferFillSizeHighWaterMark);
       UseServicesHelper::debugAppend(resultEl, "buffered amount low threshold", mBufferedAmountLowThreshold);
       UseServicesHelper::debugAppend(resultEl, "buffered amount low threshold fired", mBufferedAmountLowThresholdFired);
 
+      UseServicesHelper::debugAppend(resultEl, "messages sent", mMessagesSent);
+      UseServicesHelper::debugAppend(resultEl, "bytes sent", mBytesSent);
+      UseServicesHelper::debugAppend(resultEl, "messages received", mMessagesReceived);
+      UseServicesHelper::debugAppend(resultEl, "bytes received", mBytesReceived);
+
       UseServicesHelper::debugAppend(resultEl, "send ready", (bool)mSendReady);
 
       return resultEl;
@@ -1014,12 +1129,9 @@ namespace ortc
         mSendReady.reset();
       }
 
-      for (auto iter_doNotUse = mOutgoingData.begin(); iter_doNotUse != mOutgoingData.end();)
+      while (!mOutgoingData.isEmpty())
       {
-        auto current = iter_doNotUse;
-        ++iter_doNotUse;
-
-        SCTPPacketOutgoingPtr packet = (*current);
+        SCTPPacketOutgoingPtr packet = mOutgoingData.front();
 
         if (onlyControlPackets) {
           if (SCTP_PPID_CONTROL != packet->mType) {
@@ -1034,8 +1146,8 @@ namespace ortc
         }
 
         // consume the buffer as "sent"
+        mOutgoingData.popFront();
         outgoingPacketRemoved(packet);
-        mOutgoingData.erase(current);
       }
 
       return true;
@@ -1177,8 +1289,8 @@ namespace ortc
     //-------------------------------------------------------------------------
     bool DataChannel::send(
                            SCTPPayloadProtocolIdentifier ppid,
-                           const BYTE *buffer,
-                           size_t bufferSizeInBytes
+                           SecureByteBlockPtr buffer,
+                           bool streamChunk
                            )
     {
       if ((isShuttingDown()) &&
@@ -1187,11 +1299,47 @@ namespace ortc
         return false;
       }
 
-      if ((NULL == buffer) ||
-          (0 == bufferSizeInBytes)) {
+      // scope: keep the chunks of a streamed message contiguous
+      {
+        bool isPartial = ((SCTP_PPID_BINARY_PARTIAL == ppid) || (SCTP_PPID_STRING_PARTIAL == ppid));
+        bool isBinary = ((SCTP_PPID_BINARY_PARTIAL == ppid) || (SCTP_PPID_BINARY_LAST == ppid));
 
-        buffer = NULL;
-        bufferSizeInBytes = 0;
+        if (mPartialSendType.hasValue()) {
+          if (!streamChunk) {
+            ZS_LOG_ERROR(Detail, log("cannot send a message while a partial message is being sent") + ZS_PARAM("ppid", toString(ppid)))
+            ORTC_THROW_INVALID_STATE("cannot send a message while a partial message is being sent")
+          }
+
+          bool streamIsBinary = (SCTP_PPID_BINARY_PARTIAL == mPartialSendType.value());
+          if (streamIsBinary != isBinary) {
+            ZS_LOG_ERROR(Detail, log("cannot mix binary and text while a partial message is being sent") + ZS_PARAM("ppid", toString(ppid)))
+            ORTC_THROW_INVALID_STATE("cannot mix binary and text while a partial message is being sent")
+          }
+        }
+
+        if (isPartial) {
+          ORTC_THROW_INVALID_STATE_IF(!mParameters)
+          if ((!mParameters->mOrdered) ||
+              (mParameters->mMaxRetransmits.hasValue()) ||
+              (Milliseconds() != mParameters->mMaxPacketLifetime)) {
+            ZS_LOG_ERROR(Detail, log("partial messages require a reliable ordered channel") + mParameters->toDebug())
+            ORTC_THROW_INVALID_STATE("partial messages require a reliable ordered channel")
+          }
+
+          // an empty middle chunk carries nothing and would be ambiguous on the wire
+          if ((!buffer) ||
+              (0 == buffer->SizeInBytes())) return true;
+
+          mPartialSendType = ppid;
+        } else {
+          mPartialSendType.reset();
+        }
+      }
+
+      if ((!buffer) ||
+          (0 == buffer->SizeInBytes())) {
+
+        buffer.reset();
 
         switch (ppid) {
           case SCTP_PPID_BINARY_LAST: ppid = SCTP_PPID_BINARY_EMPTY; break;
@@ -1202,13 +1350,18 @@ namespace ortc
         }
       }
 
+      // a streamed message only counts once its last chunk goes out
+      if ((SCTP_PPID_BINARY_PARTIAL != ppid) &&
+          (SCTP_PPID_STRING_PARTIAL != ppid)) ++mMessagesSent;
+      mBytesSent += (buffer ? buffer->SizeInBytes() : 0);
+
       SCTPPacketOutgoingPtr packet(make_shared<SCTPPacketOutgoing>());
       packet->mType = ppid;
-      if (NULL != buffer) packet->mBuffer = UseServicesHelper::convertToBuffer(buffer, bufferSizeInBytes);
+      packet->mBuffer = buffer;
 
       // scope: check if buffering
       {
-        if (mOutgoingData.size() > 0) {
+        if (!mOutgoingData.isEmpty()) {
           goto buffer_data;
         }
 
@@ -1228,8 +1381,8 @@ namespace ortc
 
     buffer_data:
       {
-        ZS_LOG_TRACE(log("buffering data") + ZS_PARAM("ppid", internal::toString(ppid)) + ZS_PARAM("length", bufferSizeInBytes))
-        mOutgoingData.push_back(packet);
+        ZS_LOG_TRACE(log("buffering data") + ZS_PARAM("ppid", internal::toString(ppid)) + ZS_PARAM("length", ((bool)buffer) ? buffer->SizeInBytes() : 0))
+        mOutgoingData.pushBack(packet);
         outgoingPacketAdded(packet);
       }
 
@@ -1264,7 +1417,7 @@ namespace ortc
           openPacket.mChannelType = DataChannelOpenMessageChannelType_RELIABLE_UNORDERED;
         }
       }
-      openPacket.mPriority = 0;
+      openPacket.mPriority = mParameters->mPriority;
       openPacket.mLabel = mParameters->mLabel;
       openPacket.mLabelLength = static_cast<decltype(openPacket.mLabelLength)>(mParameters->mLabel.length());
       openPacket.mProtocol = mParameters->mProtocol;
@@ -1309,7 +1462,7 @@ namespace ortc
       packet->mOrdered = true;
       packet->mBuffer = buffer;
       if (!deliverOutgoing(packet, false)) {
-        mOutgoingData.push_front(packet);
+        mOutgoingData.pushFront(packet);
         outgoingPacketAdded(packet);
       }
     }
@@ -1337,7 +1490,7 @@ namespace ortc
       packet->mOrdered = true;
       packet->mBuffer = buffer;
       if (!deliverOutgoing(packet, false)) {
-        mOutgoingData.push_front(packet);
+        mOutgoingData.pushFront(packet);
         outgoingPacketAdded(packet);
       }
     }
@@ -1351,6 +1504,7 @@ namespace ortc
       ZS_LOG_TRACE(log("delivering data") + packet->toDebug())
 
       packet->mSessionID = mSessionID;
+      if (mParameters) packet->mPriority = mParameters->mPriority;
       if (fixPacket) {
         ORTC_THROW_INVALID_STATE_IF(!mParameters)
         packet->mOrdered = mParameters->mOrdered;
@@ -1468,6 +1622,7 @@ namespace ortc
           }
           params->mLabel = openPacket.mLabel;
           params->mProtocol = openPacket.mProtocol;
+          params->mPriority = openPacket.mPriority;
 
           if (mParameters) {
             ZS_LOG_WARNING(Debug, log("already received channel open message") + ZS_PARAM("original", mParameters->toDebug()) + ZS_PARAM("new", params->toDebug()))
@@ -1543,6 +1698,7 @@ namespace ortc
           } else {
             data->mBinary = make_shared<SecureByteBlock>(); // empty buffer
           }
+          data->mPartial = (SCTP_PPID_BINARY_PARTIAL == packet.mType);
           ZS_LOG_TRACE(log("forwarding data binary packet") + ZS_PARAM("buffer size", data->mBinary->SizeInBytes()))
           if (ZS_IS_LOGGING(Insane)) {
             String base64 = UseServicesHelper::convertToBase64(*(data->mBinary));
@@ -1557,6 +1713,7 @@ namespace ortc
           if (packet.mBuffer) {
             data->mText = UseServicesHelper::convertToString(*(packet.mBuffer));
           }
+          data->mPartial = (SCTP_PPID_STRING_PARTIAL == packet.mType);
           ZS_LOG_TRACE(log("forwarding data text packet") + ZS_PARAM("text size", data->mText.length()))
           if (ZS_IS_LOGGING(Insane)) {
             ZS_LOG_BASIC(log("forwarding data text packet") + ZS_PARAM("text", data->mText))
@@ -1578,6 +1735,9 @@ namespace ortc
                     );
 
 
+      if (!data->mPartial) ++mMessagesReceived;
+      mBytesReceived += (packet.mBuffer ? packet.mBuffer->SizeInBytes() : 0);
+
       mSubscriptions.delegate()->onDataChannelMessage(mThisWeak.lock(), data);
     }
 
@@ -1602,6 +1762,7 @@ namespace ortc
 
       auto previousFillSize = mOutgoingBufferFillSize;
       mOutgoingBufferFillSize += packet->mBuffer->SizeInBytes();
+      if (mOutgoingBufferFillSize > mOutgoingBufferFillSizeHighWaterMark) mOutgoingBufferFillSizeHighWaterMark = mOutgoingBufferFillSize;
 
       if (previousFillSize <= mBufferedAmountLowThreshold) {
         if (mOutgoingBufferFillSize > mBufferedAmountLowThreshold) {
@@ -1653,6 +1814,87 @@ namespace ortc
       }
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark DataChannel::OutgoingRing
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    SCTPPacketOutgoingPtr DataChannel::OutgoingRing::front() const
+    {
+      if (0 == mSize) return SCTPPacketOutgoingPtr();
+      return mSlots[mHead];
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::OutgoingRing::pushBack(SCTPPacketOutgoingPtr packet)
+    {
+      if (mSize == mSlots.size()) grow();
+
+      mSlots[(mHead + mSize) & (mSlots.size() - 1)] = packet;
+      ++mSize;
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::OutgoingRing::pushFront(SCTPPacketOutgoingPtr packet)
+    {
+      if (mSize == mSlots.size()) grow();
+
+      mHead = (mHead + mSlots.size() - 1) & (mSlots.size() - 1);
+      mSlots[mHead] = packet;
+      ++mSize;
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::OutgoingRing::popFront()
+    {
+      if (0 == mSize) return;
+
+      mSlots[mHead].reset();
+      mHead = (mHead + 1) & (mSlots.size() - 1);
+      --mSize;
+      if (0 == mSize) mHead = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::OutgoingRing::clear()
+    {
+      for (size_t index = 0; index < mSize; ++index) {
+        mSlots[(mHead + index) & (mSlots.size() - 1)].reset();
+      }
+      mHead = 0;
+      mSize = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr DataChannel::OutgoingRing::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::DataChannel::OutgoingRing");
+
+      UseServicesHelper::debugAppend(resultEl, "size", mSize);
+      UseServicesHelper::debugAppend(resultEl, "capacity", mSlots.size());
+      UseServicesHelper::debugAppend(resultEl, "head", mHead);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void DataChannel::OutgoingRing::grow()
+    {
+      size_t capacity = mSlots.size() > 0 ? (mSlots.size() * 2) : 16;
+
+      PacketVector slots(capacity);
+      for (size_t index = 0; index < mSize; ++index) {
+        slots[index] = std::move(mSlots[(mHead + index) & (mSlots.size() - 1)]);
+      }
+
+      mSlots.swap(slots);
+      mHead = 0;
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -1753,6 +1995,7 @@ namespace ortc
     UseHelper::getElementValue(elem, "ortc::IDataChannelTypes::Parameters", "protocol", mProtocol);
     UseHelper::getElementValue(elem, "ortc::IDataChannelTypes::Parameters", "negotiated", mNegotiated);
     UseHelper::getElementValue(elem, "ortc::IDataChannelTypes::Parameters", "id", mID);
+    UseHelper::getElementValue(elem, "ortc::IDataChannelTypes::Parameters", "priority", mPriority);
   }
 
   //---------------------------------------------------------------------------
@@ -1767,6 +2010,7 @@ namespace ortc
     UseHelper::adoptElementValue(elem, "protocol", mProtocol, false);
     UseHelper::adoptElementValue(elem, "negotiated", mNegotiated);
     UseHelper::adoptElementValue(elem, "id", mID);
+    UseHelper::adoptElementValue(elem, "priority", mPriority);
 
     if (!elem->hasChildren()) return ElementPtr();
 
@@ -1798,6 +2042,8 @@ namespace ortc
     hasher.update(mNegotiated);
     hasher.update(":");
     hasher.update(mID);
+    hasher.update(":");
+    hasher.update(mPriority);
 
     return hasher.final();
   }
@@ -1113,6 +1113,280 @@ namespace ortc
       elem->adoptAsLastChild(UseServicesHelper::createElementWithNumber(subElementName, string(value.value())));
     }
 
+    //-------------------------------------------------------------------------
+    IStatsReportTypes::ICECandidateAttributesPtr Helper::createCandidateStats(
+                                                                              const String &statsID,
+                                                                              const IICETypes::Candidate &candidate
+                                                                              )
+    {
+      auto result = make_shared<IStatsReportTypes::ICECandidateAttributes>();
+
+      result->mID = statsID;
+      result->mIPAddress = candidate.mIP;
+      result->mPortNumber = candidate.mPort;
+      result->mTransport = IICETypes::toString(candidate.mProtocol);
+      result->mCandidateType = candidate.mCandidateType;
+      result->mPriority = candidate.mPriority;
+
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark (helpers)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    static ULONGLONG mixHash(ULONGLONG value)
+    {
+      // splitmix64 finaliser
+      value ^= (value >> 30);
+      value *= 0xBF58476D1CE4E5B9ULL;
+      value ^= (value >> 27);
+      value *= 0x94D049BB133111EBULL;
+      value ^= (value >> 31);
+      return value;
+    }
+
+    //-------------------------------------------------------------------------
+    static ULONGLONG mixHash(
+                             ULONGLONG result,
+                             const String &value
+                             )
+    {
+      // FNV-1a over the bytes (length included so adjacent fields cannot alias)
+      ULONGLONG fnv = 0xCBF29CE484222325ULL;
+      for (auto iter = value.begin(); iter != value.end(); ++iter) {
+        fnv ^= static_cast<ULONGLONG>(static_cast<UCHAR>(*iter));
+        fnv *= 0x100000001B3ULL;
+      }
+      return mixHash(result ^ fnv ^ (static_cast<ULONGLONG>(value.length()) << 56));
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IPRouteKey
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    IPRouteKey::IPRouteKey(
+                           PUID localID,
+                           const IPAddress &remoteIP
+                           ) :
+      mLocalID(localID),
+      mPort(remoteIP.mPort)
+    {
+      mIP[0] = remoteIP.mIPAddress.ull[0];
+      mIP[1] = remoteIP.mIPAddress.ull[1];
+    }
+
+    //-------------------------------------------------------------------------
+    IPRouteKey::IPRouteKey(
+                           const void *localObject,
+                           const IPAddress &remoteIP
+                           ) :
+      IPRouteKey(static_cast<PUID>(reinterpret_cast<uintptr_t>(localObject)), remoteIP)
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    bool IPRouteKey::operator==(const IPRouteKey &op2) const
+    {
+      return ((mLocalID == op2.mLocalID) &&
+              (mPort == op2.mPort) &&
+              (mIP[0] == op2.mIP[0]) &&
+              (mIP[1] == op2.mIP[1]));
+    }
+
+    //-------------------------------------------------------------------------
+    size_t IPRouteKey::hash() const
+    {
+      ULONGLONG result = mixHash(static_cast<ULONGLONG>(mLocalID));
+      result = mixHash(result ^ mIP[0]);
+      result = mixHash(result ^ mIP[1]);
+      result = mixHash(result ^ static_cast<ULONGLONG>(mPort));
+      return static_cast<size_t>(result);
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr IPRouteKey::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::IPRouteKey");
+
+      UseServicesHelper::debugAppend(resultEl, "local id", mLocalID);
+      UseServicesHelper::debugAppend(resultEl, "hash", string(hash()));
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark CandidateKey
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    CandidateKey::CandidateKey(
+                               IICETypes::CandidatePtr candidate,
+                               bool includePriorities
+                               ) :
+      mCandidate(candidate.get()),
+      mHold(candidate),
+      mIncludePriorities(includePriorities)
+    {
+      if (mCandidate) mHash = hash(*mCandidate, includePriorities);
+    }
+
+    //-------------------------------------------------------------------------
+    CandidateKey::CandidateKey(
+                               const IICETypes::Candidate &candidate,
+                               bool includePriorities
+                               ) :
+      mHash(hash(candidate, includePriorities)),
+      mCandidate(&candidate),
+      mIncludePriorities(includePriorities)
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    bool CandidateKey::operator==(const CandidateKey &op2) const
+    {
+      if (mHash != op2.mHash) return false;
+      if (mIncludePriorities != op2.mIncludePriorities) return false;
+      if (mCandidate == op2.mCandidate) return true;
+      if ((!mCandidate) || (!op2.mCandidate)) return false;
+      return isEqual(*mCandidate, *op2.mCandidate, mIncludePriorities);
+    }
+
+    //-------------------------------------------------------------------------
+    String CandidateKey::string() const
+    {
+      return UseServicesHelper::convertToHex(reinterpret_cast<const BYTE *>(&mHash), sizeof(mHash));
+    }
+
+    //-------------------------------------------------------------------------
+    ULONGLONG CandidateKey::hash(
+                                 const IICETypes::Candidate &candidate,
+                                 bool includePriorities
+                                 )
+    {
+      ULONGLONG result = mixHash(static_cast<ULONGLONG>(candidate.mComponent));
+      result = mixHash(result, candidate.mInterfaceType);
+      result = mixHash(result, candidate.mFoundation);
+      if (includePriorities) {
+        result = mixHash(result ^ ((static_cast<ULONGLONG>(candidate.mPriority) << 32) | static_cast<ULONGLONG>(candidate.mUnfreezePriority)));
+      }
+      result = mixHash(result ^ static_cast<ULONGLONG>(candidate.mProtocol));
+      result = mixHash(result, candidate.mIP);
+      result = mixHash(result ^ static_cast<ULONGLONG>(candidate.mPort));
+      result = mixHash(result ^ static_cast<ULONGLONG>(candidate.mCandidateType));
+      if (IICETypes::Protocol_TCP == candidate.mProtocol) {
+        result = mixHash(result ^ static_cast<ULONGLONG>(candidate.mTCPType));
+      }
+      result = mixHash(result, candidate.mRelatedAddress);
+      result = mixHash(result ^ static_cast<ULONGLONG>(candidate.mRelatedPort));
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    bool CandidateKey::isEqual(
+                               const IICETypes::Candidate &op1,
+                               const IICETypes::Candidate &op2,
+                               bool includePriorities
+                               )
+    {
+      // same fields (and order) as IICETypes::Candidate::hash()
+      if (op1.mComponent != op2.mComponent) return false;
+      if (op1.mPort != op2.mPort) return false;
+      if (op1.mProtocol != op2.mProtocol) return false;
+      if (op1.mCandidateType != op2.mCandidateType) return false;
+      if (op1.mRelatedPort != op2.mRelatedPort) return false;
+      if (includePriorities) {
+        if (op1.mPriority != op2.mPriority) return false;
+        if (op1.mUnfreezePriority != op2.mUnfreezePriority) return false;
+      }
+      if ((IICETypes::Protocol_TCP == op1.mProtocol) &&
+          (op1.mTCPType != op2.mTCPType)) return false;
+      if (op1.mIP != op2.mIP) return false;
+      if (op1.mFoundation != op2.mFoundation) return false;
+      if (op1.mInterfaceType != op2.mInterfaceType) return false;
+      if (op1.mRelatedAddress != op2.mRelatedAddress) return false;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark CandidatePairKey
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    CandidatePairKey::CandidatePairKey(
+                                       IICETypes::CandidatePtr local,
+                                       IICETypes::CandidatePtr remote
+                                       ) :
+      mLocal(local),
+      mRemote(remote)
+    {
+      mHash = mixHash(mixHash(mLocal.mHash) ^ mRemote.mHash);
+    }
+
+    //-------------------------------------------------------------------------
+    bool CandidatePairKey::operator==(const CandidatePairKey &op2) const
+    {
+      if (mHash != op2.mHash) return false;
+      return ((mLocal == op2.mLocal) &&
+              (mRemote == op2.mRemote));
+    }
+
+    //-------------------------------------------------------------------------
+    String CandidatePairKey::string() const
+    {
+      return UseServicesHelper::convertToHex(reinterpret_cast<const BYTE *>(&mHash), sizeof(mHash));
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark Clock
+    #pragma mark
+
+    static thread_local Time gClockBatchTime;
+    static thread_local size_t gClockBatchDepth {};
+
+    //-------------------------------------------------------------------------
+    Clock::Batch::Batch()
+    {
+      if (0 == gClockBatchDepth) gClockBatchTime = zsLib::now();
+      ++gClockBatchDepth;
+    }
+
+    //-------------------------------------------------------------------------
+    Clock::Batch::~Batch()
+    {
+      --gClockBatchDepth;
+      if (0 == gClockBatchDepth) gClockBatchTime = Time();
+    }
+
+    //-------------------------------------------------------------------------
+    Time Clock::coarseNow()
+    {
+      if (0 != gClockBatchDepth) return gClockBatchTime;
+      return zsLib::now();
+    }
+
   }  //ortc::internal
 
   //---------------------------------------------------------------------------
@@ -0,0 +1,506 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#include <ortc/internal/ortc_ICECheckPacer.h>
+#include <ortc/internal/ortc_ORTC.h>
+#include <ortc/internal/platform.h>
+
+#include <ortc/services/IHelper.h>
+#include <ortc/services/ISettings.h>
+
+#include <zsLib/Singleton.h>
+#include <zsLib/XML.h>
+
+#include <map>
+
+namespace ortc { ZS_DECLARE_SUBSYSTEM(ortclib) }
+
+namespace ortc
+{
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::IHelper, UseServicesHelper)
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::ISettings, UseSettings)
+
+  using zsLib::Log;
+
+  namespace internal
+  {
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IICECheckPacerForSettings
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void IICECheckPacerForSettings::applyDefaults()
+    {
+      UseSettings::setUInt(ORTC_SETTING_ICE_CHECK_PACER_CHECKS_PER_SECOND, 200);
+      UseSettings::setUInt(ORTC_SETTING_ICE_CHECK_PACER_BURST, 10);
+      UseSettings::setUInt(ORTC_SETTING_ICE_CHECK_PACER_TICK_IN_MILLISECONDS, 10);
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    const char *ICECheckPacer::toString(Priorities priority)
+    {
+      switch (priority) {
+        case Priority_High:   return "high";
+        case Priority_Normal: return "normal";
+      }
+      return "UNDEFINED";
+    }
+
+    //-------------------------------------------------------------------------
+    ICECheckPacer::ICECheckPacer(
+                                 const make_private &,
+                                 IMessageQueuePtr queue
+                                 ) :
+      SharedRecursiveLock(SharedRecursiveLock::create()),
+      MessageQueueAssociator(queue),
+      mChecksPerSecond(UseSettings::getUInt(ORTC_SETTING_ICE_CHECK_PACER_CHECKS_PER_SECOND)),
+      mBurst(static_cast<double>(UseSettings::getUInt(ORTC_SETTING_ICE_CHECK_PACER_BURST))),
+      mTickDuration(UseSettings::getUInt(ORTC_SETTING_ICE_CHECK_PACER_TICK_IN_MILLISECONDS)),
+      mLastRefill(zsLib::now())
+    {
+      ZS_LOG_BASIC(log("created"))
+
+      if (mChecksPerSecond < 1) mChecksPerSecond = 1;
+      if (mBurst < 1.0) mBurst = 1.0;
+      if (mTickDuration < Milliseconds(1)) mTickDuration = Milliseconds(1);
+
+      mTokens = mBurst;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::init()
+    {
+      AutoRecursiveLock lock(*this);
+      ZS_LOG_DEBUG(debug("init"))
+    }
+
+    //-------------------------------------------------------------------------
+    ICECheckPacer::~ICECheckPacer()
+    {
+      mThisWeak.reset();
+      ZS_LOG_BASIC(log("destroyed"))
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer => (friends)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICECheckPacer::toDebug(ICECheckPacerPtr pacer)
+    {
+      if (!pacer) return ElementPtr();
+      return pacer->toDebug();
+    }
+
+    //-------------------------------------------------------------------------
+    ICECheckPacerPtr ICECheckPacer::singleton()
+    {
+      AutoRecursiveLock lock(*UseServicesHelper::getGlobalLock());
+      static SingletonLazySharedPtr<ICECheckPacer> singleton(create());
+      ICECheckPacerPtr result = singleton.singleton();
+
+      static zsLib::SingletonManager::Register registerSingleton("ortc::ICECheckPacer", result);
+
+      if (!result) {
+        ZS_LOG_WARNING(Detail, slog("singleton gone"))
+      }
+
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    ICECheckPacer::RequestID ICECheckPacer::request(
+                                                    OwnerID ownerID,
+                                                    IICECheckPacerDelegatePtr delegate,
+                                                    Priorities priority
+                                                    )
+    {
+      ZS_THROW_INVALID_ARGUMENT_IF(!delegate)
+
+      AutoRecursiveLock lock(*this);
+
+      OwnerPtr owner;
+
+      auto found = mOwners.find(ownerID);
+      if (found == mOwners.end()) {
+        owner = make_shared<Owner>();
+        owner->mID = ownerID;
+        owner->mDelegate = delegate;
+        mOwners[ownerID] = owner;
+      } else {
+        owner = (*found).second;
+      }
+
+      EntryPtr entry(make_shared<Entry>());
+      entry->mID = zsLib::createPUID();
+      entry->mOwner = owner;
+      entry->mPriority = priority;
+      entry->mQueued = zsLib::now();
+
+      auto &queue = owner->mQueue[priority];
+      entry->mPosition = queue.insert(queue.end(), entry);
+
+      if (!owner->mInRotation[priority]) {
+        auto &rotation = mRotation[priority];
+        owner->mRotationPosition[priority] = rotation.insert(rotation.end(), owner);
+        owner->mInRotation[priority] = true;
+      }
+
+      mEntries[entry->mID] = entry;
+
+      ++(mMetrics.mQueueDepth[priority]);
+      ++mMetrics.mTotalRequested;
+      if (mEntries.size() > mMetrics.mMaxQueueDepth) mMetrics.mMaxQueueDepth = mEntries.size();
+
+      ZS_LOG_INSANE(log("check slot requested") + ZS_PARAM("request id", entry->mID) + ZS_PARAM("owner id", ownerID) + ZS_PARAM("priority", toString(priority)) + ZS_PARAM("queued", mEntries.size()))
+
+      // hand out any slots already in the bucket without waiting for a tick
+      grant();
+
+      if ((!mTimer) &&
+          (mEntries.size() > 0)) {
+        mTimer = Timer::create(mThisWeak.lock(), mTickDuration);
+      }
+
+      return entry->mID;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::cancel(RequestID requestID)
+    {
+      if (0 == requestID) return;
+
+      AutoRecursiveLock lock(*this);
+
+      auto found = mEntries.find(requestID);
+      if (found == mEntries.end()) return;
+
+      EntryPtr entry = (*found).second;
+      mEntries.erase(found);
+
+      remove(*entry);
+      ++mMetrics.mTotalCancelled;
+
+      ZS_LOG_INSANE(log("check slot request cancelled") + ZS_PARAM("request id", requestID))
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::notifyCheckSent()
+    {
+      AutoRecursiveLock lock(*this);
+
+      refill();
+
+      // may go into debt so that queued checks yield to the unpaced check
+      mTokens -= 1.0;
+      if (mTokens < -mBurst) mTokens = -mBurst;
+
+      ++mMetrics.mTotalSentUnpaced;
+    }
+
+    //-------------------------------------------------------------------------
+    ICECheckPacer::MetricsPtr ICECheckPacer::getMetrics() const
+    {
+      AutoRecursiveLock lock(*this);
+
+      MetricsPtr result(make_shared<Metrics>(mMetrics));
+      result->mOwners = mOwners.size();
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer => ISingletonManagerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::notifySingletonCleanup()
+    {
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer => ITimerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::onTimer(TimerPtr timer)
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (timer != mTimer) {
+        ZS_LOG_WARNING(Debug, log("notified about obsolete timer") + ZS_PARAM("timer id", timer->getID()))
+        return;
+      }
+
+      grant();
+
+      if (mEntries.size() < 1) {
+        ZS_LOG_TRACE(log("no checks queued (pacer going idle)"))
+        mTimer->cancel();
+        mTimer.reset();
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer => (internal)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICECheckPacerPtr ICECheckPacer::create()
+    {
+      ICECheckPacerPtr pThis(make_shared<ICECheckPacer>(make_private {}, IORTCForInternal::queueORTC()));
+      pThis->mThisWeak = pThis;
+      pThis->init();
+      return pThis;
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICECheckPacer::log(const char *message) const
+    {
+      ElementPtr objectEl = Element::create("ortc::ICECheckPacer");
+      UseServicesHelper::debugAppend(objectEl, "id", mID);
+      return Log::Params(message, objectEl);
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICECheckPacer::slog(const char *message)
+    {
+      return Log::Params(message, "ortc::ICECheckPacer");
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICECheckPacer::debug(const char *message) const
+    {
+      return Log::Params(message, toDebug());
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICECheckPacer::toDebug() const
+    {
+      AutoRecursiveLock lock(*this);
+
+      ElementPtr resultEl = Element::create("ortc::ICECheckPacer");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "checks per second", mChecksPerSecond);
+      UseServicesHelper::debugAppend(resultEl, "burst", mBurst);
+      UseServicesHelper::debugAppend(resultEl, "tick duration", mTickDuration);
+
+      UseServicesHelper::debugAppend(resultEl, "tokens", mTokens);
+      UseServicesHelper::debugAppend(resultEl, "last refill", mLastRefill);
+
+      UseServicesHelper::debugAppend(resultEl, "queued", mEntries.size());
+      UseServicesHelper::debugAppend(resultEl, "owners", mOwners.size());
+      UseServicesHelper::debugAppend(resultEl, "timer", mTimer ? mTimer->getID() : 0);
+
+      UseServicesHelper::debugAppend(resultEl, "metrics", mMetrics.toDebug());
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::cancel()
+    {
+      AutoRecursiveLock lock(*this);
+
+      ZS_LOG_DEBUG(log("cancel called"))
+
+      if (mTimer) {
+        mTimer->cancel();
+        mTimer.reset();
+      }
+
+      for (size_t priority = 0; priority <= Priority_Last; ++priority) {
+        mRotation[priority].clear();
+        mMetrics.mQueueDepth[priority] = 0;
+      }
+      mOwners.clear();
+      mEntries.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::refill()
+    {
+      Time tickNow = zsLib::now();
+      if (tickNow <= mLastRefill) return;
+
+      auto elapsed = std::chrono::duration_cast<Microseconds>(tickNow - mLastRefill);
+      mLastRefill = tickNow;
+
+      mTokens += static_cast<double>(elapsed.count()) * static_cast<double>(mChecksPerSecond) / 1000000.0;
+      if (mTokens > mBurst) mTokens = mBurst;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::grant()
+    {
+      typedef std::pair<IICECheckPacerDelegatePtr, RequestIDListPtr> DelegateRequestsPair;
+      typedef std::map<OwnerID, DelegateRequestsPair> DelegateRequestsMap;
+
+      refill();
+
+      DelegateRequestsMap granted;
+
+      Time tickNow = zsLib::now();
+
+      for (size_t priority = 0; priority <= Priority_Last; ++priority) {
+        auto &rotation = mRotation[priority];
+
+        while ((mTokens >= 1.0) &&
+               (rotation.size() > 0)) {
+          OwnerPtr owner = rotation.front();
+          EntryPtr entry = owner->mQueue[priority].front();
+
+          mEntries.erase(entry->mID);
+          remove(*entry);
+
+          // owner moves to the back of the rotation if it still has more
+          // requests waiting at this priority
+          if (owner->mInRotation[priority]) {
+            rotation.erase(owner->mRotationPosition[priority]);
+            owner->mRotationPosition[priority] = rotation.insert(rotation.end(), owner);
+          }
+
+          mTokens -= 1.0;
+          ++mMetrics.mTotalGranted;
+
+          auto delay = zsLib::toMilliseconds(tickNow - entry->mQueued);
+          if (delay > mMetrics.mMaxQueueDelay) mMetrics.mMaxQueueDelay = delay;
+
+          auto &pair = granted[owner->mID];
+          if (!pair.second) {
+            pair.first = owner->mDelegate;
+            pair.second = make_shared<RequestIDList>();
+          }
+          pair.second->push_back(entry->mID);
+        }
+      }
+
+      if (granted.size() < 1) return;
+
+      ZS_LOG_INSANE(log("granted check slots") + ZS_PARAM("owners", granted.size()) + ZS_PARAM("tokens", mTokens) + ZS_PARAM("queued", mEntries.size()))
+
+      // delegates are proxies thus delivery is asynchronous
+      for (auto iter = granted.begin(); iter != granted.end(); ++iter) {
+        auto &pair = (*iter).second;
+        try {
+          pair.first->onICECheckPacerGranted(pair.second);
+        } catch (const IICECheckPacerDelegateProxy::Exceptions::DelegateGone &) {
+          ZS_LOG_WARNING(Trace, log("delegate gone"))
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void ICECheckPacer::remove(Entry &entry)
+    {
+      OwnerPtr owner = entry.mOwner;
+      auto priority = entry.mPriority;
+
+      auto &queue = owner->mQueue[priority];
+      queue.erase(entry.mPosition);
+
+      if (mMetrics.mQueueDepth[priority] > 0) --(mMetrics.mQueueDepth[priority]);
+
+      if (queue.size() < 1) {
+        if (owner->mInRotation[priority]) {
+          mRotation[priority].erase(owner->mRotationPosition[priority]);
+          owner->mInRotation[priority] = false;
+        }
+      }
+
+      for (size_t index = 0; index <= Priority_Last; ++index) {
+        if (owner->mQueue[index].size() > 0) return;
+      }
+
+      mOwners.erase(owner->mID);
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer::Metrics
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICECheckPacer::Metrics::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICECheckPacer::Metrics");
+
+      UseServicesHelper::debugAppend(resultEl, "high priority queue depth", mQueueDepth[Priority_High]);
+      UseServicesHelper::debugAppend(resultEl, "normal priority queue depth", mQueueDepth[Priority_Normal]);
+      UseServicesHelper::debugAppend(resultEl, "max queue depth", mMaxQueueDepth);
+      UseServicesHelper::debugAppend(resultEl, "owners", mOwners);
+
+      UseServicesHelper::debugAppend(resultEl, "total requested", mTotalRequested);
+      UseServicesHelper::debugAppend(resultEl, "total granted", mTotalGranted);
+      UseServicesHelper::debugAppend(resultEl, "total cancelled", mTotalCancelled);
+      UseServicesHelper::debugAppend(resultEl, "total sent unpaced", mTotalSentUnpaced);
+
+      UseServicesHelper::debugAppend(resultEl, "max queue delay", mMaxQueueDelay);
+
+      return resultEl;
+    }
+
+  }
+}
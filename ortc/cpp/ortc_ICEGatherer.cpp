@@ -30,9 +30,12 @@
  */
 
 #include <ortc/internal/ortc_ICEGatherer.h>
+#include <ortc/internal/ortc_ICEGathererUDPMux.h>
+#include <ortc/internal/ortc_ICEGathererWarmPool.h>
 #include <ortc/internal/ortc_ICETransport.h>
 #include <ortc/internal/ortc_Helper.h>
 #include <ortc/internal/ortc_ORTC.h>
+#include <ortc/internal/ortc_StatsReport.h>
 #include <ortc/internal/ortc.events.h>
 #include <ortc/internal/platform.h>
 
@@ -63,6 +66,30 @@
 #include <ifaddrs.h>
 #endif //HAVE_IFADDRS_H
 
+#if defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG) || defined(HAVE_SO_REUSEPORT)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <errno.h>
+#endif //defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG) || defined(HAVE_SO_REUSEPORT)
+
+#ifdef HAVE_WRITEV
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <errno.h>
+#endif //HAVE_WRITEV
+
+#ifdef HAVE_UDP_SEGMENT
+#include <netinet/udp.h>
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif //SOL_UDP
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif //UDP_SEGMENT
+#define ORTC_ICEGATHERER_MAX_UDP_SEGMENTS (64)
+#define ORTC_ICEGATHERER_MAX_UDP_SEGMENTED_PAYLOAD (0xFFFF - 8 - 40)
+#endif //HAVE_UDP_SEGMENT
+
 #ifdef HAVE_NET_IF_H
 #include <net/if.h>
 #endif //HAVE_NET_IF_H
@@ -112,6 +139,8 @@ namespace ortc
 
   namespace internal
   {
+    ZS_DECLARE_TYPEDEF_PTR(IStatsReportForInternal, UseStatsReport);
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -368,6 +397,21 @@ namespace ortc
       UseSettings::setBool(ORTC_SETTING_GATHERER_GATHER_PASSIVE_TCP_CANDIDATES, true);
 
       UseSettings::setUInt(ORTC_SETTING_GATHERER_RECHECK_IP_ADDRESSES_IN_SECONDS, 60);
+
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_MAX_UDP_RECEIVE_BATCH_SIZE, 32);
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_UDP_RECEIVE_BUFFER_SIZE_IN_BYTES, 2048);   // must exceed path MTU (larger datagrams are dropped)
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_MAX_UDP_SEND_BATCH_SIZE, 1);               // 1 = send each packet immediately (no batching)
+      UseSettings::setBool(ORTC_SETTING_GATHERER_UDP_SEND_SEGMENTATION_OFFLOAD, false);
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_UDP_REUSE_PORT_SOCKETS_PER_HOST_PORT, 1);   // >1 = bind N SO_REUSEPORT sockets per host port, each read on its own packet queue
+
+      UseSettings::setBool(ORTC_SETTING_GATHERER_UDP_MUX, false);
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_UDP_MUX_PORT, 0);                            // 0 = pick an ephemeral port once and share it across interfaces
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_UDP_MUX_ROUTE_EXPIRY_IN_SECONDS, 90);
+
+      UseSettings::setBool(ORTC_SETTING_GATHERER_WARM_POOL, false);
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_WARM_POOL_SOCKETS_PER_INTERFACE, 2);
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_WARM_POOL_INTERFACE_CACHE_IN_SECONDS, 10);     // older enumerations are ignored by new gatherers
+      UseSettings::setUInt(ORTC_SETTING_GATHERER_WARM_POOL_REFLEXIVE_EXPIRY_IN_SECONDS, 30);    // keep well below typical NAT binding lifetimes
     }
 
     //-------------------------------------------------------------------------
@@ -544,6 +588,42 @@ namespace ortc
       if (0 != recheckIPsInSeconds) {
         mRecheckIPsDuration = Seconds(recheckIPsInSeconds);
       }
+
+      mMaxUDPReceiveBatchSize = UseSettings::getUInt(ORTC_SETTING_GATHERER_MAX_UDP_RECEIVE_BATCH_SIZE);
+      if (mMaxUDPReceiveBatchSize < 1) mMaxUDPReceiveBatchSize = 1;
+      if (mMaxUDPReceiveBatchSize > ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE) mMaxUDPReceiveBatchSize = ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE;
+
+      mUDPReceiveBufferSize = UseSettings::getUInt(ORTC_SETTING_GATHERER_UDP_RECEIVE_BUFFER_SIZE_IN_BYTES);
+      if (mUDPReceiveBufferSize < 1500) mUDPReceiveBufferSize = 1500;
+      if (mUDPReceiveBufferSize > 0xFFFF) mUDPReceiveBufferSize = 0xFFFF;
+
+      mMaxUDPSendBatchSize = UseSettings::getUInt(ORTC_SETTING_GATHERER_MAX_UDP_SEND_BATCH_SIZE);
+      if (mMaxUDPSendBatchSize > ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE) mMaxUDPSendBatchSize = ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE;
+      mUDPSendSegmentationOffload = UseSettings::getBool(ORTC_SETTING_GATHERER_UDP_SEND_SEGMENTATION_OFFLOAD);
+
+      mUDPReusePortSockets = UseSettings::getUInt(ORTC_SETTING_GATHERER_UDP_REUSE_PORT_SOCKETS_PER_HOST_PORT);
+      if (mUDPReusePortSockets < 1) mUDPReusePortSockets = 1;
+#ifndef HAVE_SO_REUSEPORT
+      if (mUDPReusePortSockets > 1) {
+        ZS_LOG_WARNING(Detail, log("SO_REUSEPORT is not supported on this platform (thus only one socket per host port will be bound)"))
+        mUDPReusePortSockets = 1;
+      }
+#endif //ndef HAVE_SO_REUSEPORT
+
+      // an associated RTCP gatherer shares the RTP gatherer's username
+      // fragment (and needs its own port) so it never joins the mux
+      if ((UseSettings::getBool(ORTC_SETTING_GATHERER_UDP_MUX)) &&
+          (IICETypes::Component_RTCP != mComponent)) {
+        mUDPMux = ICEGathererUDPMux::singleton();
+        if (mUDPMux) {
+          // the shared socket is read by the mux (and is never SO_REUSEPORT)
+          mUDPReusePortSockets = 1;
+        }
+      }
+
+      if (UseSettings::getBool(ORTC_SETTING_GATHERER_WARM_POOL)) {
+        mWarmPool = ICEGathererWarmPool::singleton();
+      }
       
       ZS_EVENTING_16(
                      x, i, Detail, IceGathererCreate, ol, IceGatherer, Start,
@@ -674,7 +754,7 @@ namespace ortc
       }
 
       PromiseWithStatsReportPtr promise = PromiseWithStatsReport::create(IORTCForInternal::queueDelegate());
-      IGathererAsyncDelegateProxy::create(mThisWeak.lock())->onResolveStatsPromise(promise);
+      IGathererAsyncDelegateProxy::create(mThisWeak.lock())->onResolveStatsPromise(promise, stats);
       return promise;
     }
 
@@ -781,6 +861,7 @@ namespace ortc
       result->mUseUnfreezePriority = true;
       result->mUsernameFragment = mUsernameFrag;
       result->mPassword = mPassword;
+      result->mICELite = mOptions.mICELite;
       return result;
     }
 
@@ -851,6 +932,13 @@ namespace ortc
 
       mGetLocalIPsNow = true; // obtain local IPs again
       mLastBoundHostPortsHostHash.clear();
+
+      mGatherStarted = zsLib::now();
+      mFirstHostCandidate = Time();
+      mFirstServerReflexiveCandidate = Time();
+      mFirstRelayCandidate = Time();
+      mGatherCompleted = Time();
+
       mLastReflexiveHostsHash.clear();
       mLastRelayHostsHash.clear();
 
@@ -1078,6 +1166,13 @@ namespace ortc
       return mOptions.mContinuousGathering;
     }
 
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::isICELite() const
+    {
+      AutoRecursiveLock lock(*this);
+      return mOptions.mICELite;
+    }
+
     //-------------------------------------------------------------------------
     ICEGathererRouterPtr ICEGatherer::getGathererRouter() const
     {
@@ -1103,7 +1198,7 @@ namespace ortc
 
       mRoutes.erase(found);
 
-      auto foundQuick = mQuickSearchRoutes.find(LocalCandidateRemoteIPPair(route->mLocalCandidate, routerRoute->mRemoteIP));
+      auto foundQuick = mQuickSearchRoutes.find(LocalCandidateRemoteIPPair(route->mLocalCandidate.get(), routerRoute->mRemoteIP));
       ZS_EVENTING_4(
                     x, i, Trace, IceGathererSearchQuickRoute, ol, IceGatherer, Info,
                     puid, id, mID,
@@ -1119,12 +1214,13 @@ namespace ortc
       ZS_EVENTING_4(
                     x, i, Debug, IceGathererRemoveQuickRoute, ol, IceGatherer, Info,
                     puid, id, mID,
-                    pointer, candidate, (*foundQuick).first.first.get(),
-                    string, ipAddress, (*foundQuick).first.second.string(),
+                    pointer, candidate, route->mLocalCandidate.get(),
+                    string, ipAddress, routerRoute->mRemoteIP.string(),
                     puid, routeId, route->mID
                     );
 
       mQuickSearchRoutes.erase(foundQuick);
+      clearLastRoutes();
     }
 
     //-------------------------------------------------------------------------
@@ -1180,7 +1276,7 @@ namespace ortc
             route = installRoute(routerRoute, transport.getForGatherer());
           } else {
             route = (*found).second;
-            route->mLastUsed = zsLib::now();
+            route->mLastUsed = Clock::coarseNow();
           }
         }
 
@@ -1189,7 +1285,7 @@ namespace ortc
           goto send_failed;
         }
 
-        route->mLastUsed = zsLib::now();
+        route->mLastUsed = Clock::coarseNow();
 
         if (route->mHostPort) {
           if (!route->mHostPort->mBoundUDPSocket) {
@@ -1206,7 +1302,7 @@ namespace ortc
                         buffer, packet, buffer,
                         size, size, bufferSizeInBytes
                         );
-          return sendUDPPacket(route->mHostPort->mBoundUDPSocket, route->mHostPort->mBoundUDPIP, route->mRouterRoute->mRemoteIP, buffer, bufferSizeInBytes);
+          return queueUDPPacket(route->mHostPort, route->mRouterRoute->mRemoteIP, buffer, bufferSizeInBytes);
         }
         if (route->mRelayPort) {
           if (!route->mRelayPort->mTURNSocket) {
@@ -1223,11 +1319,16 @@ namespace ortc
             goto send_failed;
           }
 
-          auto currentSize = route->mTCPPort->mOutgoingBuffer.CurrentSize();
+          auto currentSize = route->mTCPPort->mOutgoingBuffer.size();
           auto maxSize = (route->mTCPPort->mConnected ? mMaxTCPBufferingSizeConnected : mMaxTCPBufferingSizePendingConnection);
 
           ZS_LOG_INSANE(log("putting packet into TCP buffer for sending") + route->toDebug() + route->mTCPPort->toDebug() + ZS_PARAM("buffer size", bufferSizeInBytes) + ZS_PARAM("current buffer size", currentSize) + ZS_PARAM("max size", maxSize))
 
+          if (bufferSizeInBytes > 0xFFFF) {
+            ZS_LOG_WARNING(Debug, log("packet is too large for RFC 4571 framing") + route->toDebug() + ZS_PARAM("buffer size", bufferSizeInBytes))
+            return false;
+          }
+
           if (currentSize > maxSize) {
             ZS_LOG_WARNING(Trace, log("cannot send packet due to TCP buffer overflow") + route->toDebug() + route->mTCPPort->toDebug() + ZS_PARAM("buffer size", bufferSizeInBytes) + ZS_PARAM("current buffer size", currentSize) + ZS_PARAM("max size", maxSize))
             return false;
@@ -1243,10 +1344,7 @@ namespace ortc
                         size, size, bufferSizeInBytes
                         );
 
-          CryptoPP::word16 packeSize {static_cast<CryptoPP::word16>(htons(static_cast<unsigned short>(bufferSizeInBytes)))};
-
-          route->mTCPPort->mOutgoingBuffer.Put((const BYTE *)(&packeSize), sizeof(packeSize));
-          route->mTCPPort->mOutgoingBuffer.Put(buffer, bufferSizeInBytes);
+          route->mTCPPort->mOutgoingBuffer.queue(buffer, bufferSizeInBytes);
           if ((route->mTCPPort->mConnected) &&
               (0 == currentSize) &&
               (route->mTCPPort->mWriteReady)) {
@@ -1343,6 +1441,73 @@ namespace ortc
       }
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer => IICEGathererForUDPMux
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::notifyUDPMuxPacket(
+                                         SocketPtr socket,
+                                         const IPAddress &fromIP,
+                                         const BYTE *buffer,
+                                         size_t bufferSizeInBytes,
+                                         STUNPacketPtr stunPacket
+                                         )
+    {
+      HostPortPtr hostPort;
+      CandidatePtr localCandidate;
+
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto found = mHostPortSockets.find(socket);
+        if (found == mHostPortSockets.end()) {
+          ZS_LOG_WARNING(Debug, log("mux socket is no longer bound to a host port (thus dropping packet)") + ZS_PARAM("from ip", fromIP.string()))
+          return;
+        }
+
+        hostPort = (*found).second;
+        localCandidate = hostPort->mCandidateUDP;
+
+        ++(hostPort->mUDPStats.mPacketsReceived);
+        hostPort->mUDPStats.mBytesReceived += bufferSizeInBytes;
+
+        ZS_LOG_INSANE(log("receiving incoming mux packet") + ZS_PARAM("from ip", fromIP.string()) + ZS_PARAM("read", bufferSizeInBytes) + hostPort->toDebug());
+
+        if (stunPacket) {
+          fixSTUNParserOptions(stunPacket);
+        }
+      }
+
+      // warning: do NOT dispatch from within a lock
+      handleUDPPacket(hostPort, socket, localCandidate, fromIP, buffer, bufferSizeInBytes, stunPacket, false, UseTURNSocketPtr());
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::notifyUDPMuxSocketClosed(SocketPtr socket)
+    {
+      HostPortPtr hostPort;
+
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto found = mHostPortSockets.find(socket);
+        if (found == mHostPortSockets.end()) {
+          ZS_LOG_WARNING(Debug, log("closed mux socket is no longer bound to a host port") + ZS_PARAM("socket", string(socket)))
+          return;
+        }
+
+        hostPort = (*found).second;
+      }
+
+      // removes the host candidate and wakes up to bind the host port again
+      close(hostPort, socket);
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -1427,8 +1592,13 @@ namespace ortc
     }
 
     //-------------------------------------------------------------------------
-    void ICEGatherer::onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise)
+    void ICEGatherer::onResolveStatsPromise(
+                                            IStatsProvider::PromiseWithStatsReportPtr promise,
+                                            IStatsReportTypes::StatsTypeSet stats
+                                            )
     {
+      UseStatsReport::StatMap reportStats;
+
       AutoRecursiveLock lock(*this);
 
       if (isShutdown()) {
@@ -1437,9 +1607,58 @@ namespace ortc
         return;
       }
 
-#define TODO_RESOLVE_STATS_PROMISE_WHEN_STATS_ARE_DEFINED 1
-#define TODO_RESOLVE_STATS_PROMISE_WHEN_STATS_ARE_DEFINED 2
-      promise->reject();
+      if (stats.hasStatType(IStatsReportTypes::StatsType_ICEGatherer)) {
+        auto total = make_shared<IStatsReportTypes::ICEGathererStats>();
+        total->mID = string(mID);
+
+        // one report per bound UDP socket plus the gatherer wide totals
+        for (auto iter = mHostPorts.begin(); iter != mHostPorts.end(); ++iter) {
+          auto hostPort = (*iter).second;
+          if (hostPort->mBoundUDPIP.isEmpty()) continue;
+
+          auto &socketStats = hostPort->mUDPStats;
+
+          auto report = make_shared<IStatsReportTypes::ICEGathererStats>();
+          report->mID = string(mID) + ":" + hostPort->mBoundUDPIP.string();
+          report->mBytesSent = socketStats.mBytesSent;
+          report->mBytesReceived = socketStats.mBytesReceived;
+          report->mPacketsSent = socketStats.mPacketsSent;
+          report->mPacketsReceived = socketStats.mPacketsReceived;
+          report->mPacketsDiscarded = socketStats.mPacketsDiscarded;
+          report->mSendWouldBlock = socketStats.mSendWouldBlock;
+
+          total->mBytesSent += report->mBytesSent;
+          total->mBytesReceived += report->mBytesReceived;
+          total->mPacketsSent += report->mPacketsSent;
+          total->mPacketsReceived += report->mPacketsReceived;
+          total->mPacketsDiscarded += report->mPacketsDiscarded;
+          total->mSendWouldBlock += report->mSendWouldBlock;
+
+          reportStats[report->mID] = report;
+        }
+
+        // gather phase timing is only meaningful for the gatherer as a whole
+        if (Time() != mGatherStarted) {
+          if (Time() != mFirstHostCandidate) total->mTimeToFirstHostCandidate = zsLib::toMilliseconds(mFirstHostCandidate - mGatherStarted);
+          if (Time() != mFirstServerReflexiveCandidate) total->mTimeToFirstServerReflexiveCandidate = zsLib::toMilliseconds(mFirstServerReflexiveCandidate - mGatherStarted);
+          if (Time() != mFirstRelayCandidate) total->mTimeToFirstRelayCandidate = zsLib::toMilliseconds(mFirstRelayCandidate - mGatherStarted);
+          if (Time() != mGatherCompleted) total->mTimeToGatheringComplete = zsLib::toMilliseconds(mGatherCompleted - mGatherStarted);
+        }
+        total->mWarmPoolSocketsAdopted = mWarmPoolSocketsAdopted;
+        total->mWarmPoolReflexiveMappingsAdopted = mWarmPoolReflexiveMappingsAdopted;
+
+        reportStats[total->mID] = total;
+      }
+
+      if (stats.hasStatType(IStatsReportTypes::StatsType_Candidate)) {
+        for (auto iter = mLocalCandidates.begin(); iter != mLocalCandidates.end(); ++iter) {
+          auto candidate = (*iter).second.first;
+          auto report = UseHelper::createCandidateStats(string(mID) + ":" + (*iter).first.string(), *candidate);
+          reportStats[report->mID] = report;
+        }
+      }
+
+      promise->resolve(UseStatsReport::create(reportStats));
     }
 
     //-------------------------------------------------------------------------
@@ -1727,6 +1946,7 @@ namespace ortc
 
       HostPortPtr hostPort;
       TCPPortPtr tcpPort;
+      UDPReceiveBatchPtr batch;
 
       // scope: figure out which host port fired the event
       {
@@ -1743,6 +1963,7 @@ namespace ortc
                           puid, hostPortId, hostPort->mID
                           );
             ZS_LOG_INSANE(log("read found host port") + hostPort->toDebug());
+            batch = findUDPReceiveBatch(*hostPort, socket);
             goto found_host_port;
           }
         }
@@ -1769,6 +1990,10 @@ namespace ortc
     found_host_port:
       {
         // warning: do NOT call from within a lock
+        if (batch) {
+          while (read(hostPort, socket, *batch)) {}
+          return;
+        }
         while (read(hostPort, socket)) {}
         return;
       }
@@ -1965,7 +2190,7 @@ namespace ortc
         return;
       }
 
-      auto result = sendUDPPacket(hostPort->mBoundUDPSocket, hostPort->mBoundUDPIP, destination, packet->BytePtr(), packet->SizeInBytes());
+      auto result = sendUDPPacket(*hostPort, hostPort->mBoundUDPSocket, destination, packet->BytePtr(), packet->SizeInBytes());
       if (!result) {
         ZS_LOG_WARNING(Debug, log("failed to send stun packet on bound socket") + hostPort->toDebug())
         return;
@@ -2207,7 +2432,7 @@ namespace ortc
         return false;
       }
 
-      auto result = sendUDPPacket(hostPort->mBoundUDPSocket, hostPort->mBoundUDPIP, destination, packet, packetLengthInBytes);
+      auto result = sendUDPPacket(*hostPort, hostPort->mBoundUDPSocket, destination, packet, packetLengthInBytes);
       if (!result) {
         ZS_LOG_WARNING(Debug, log("failed to send stun packet on bound socket") + hostPort->toDebug())
         return false;
@@ -2338,6 +2563,24 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "max tcp buffering size pending connection", mMaxTCPBufferingSizePendingConnection);
       UseServicesHelper::debugAppend(resultEl, "max tcp buffering size connected", mMaxTCPBufferingSizeConnected);
 
+      UseServicesHelper::debugAppend(resultEl, "max udp receive batch size", mMaxUDPReceiveBatchSize);
+      UseServicesHelper::debugAppend(resultEl, "udp receive buffer size", mUDPReceiveBufferSize);
+      UseServicesHelper::debugAppend(resultEl, "max udp send batch size", mMaxUDPSendBatchSize);
+      UseServicesHelper::debugAppend(resultEl, "udp send segmentation offload", mUDPSendSegmentationOffload);
+      UseServicesHelper::debugAppend(resultEl, "udp reuse port sockets", mUDPReusePortSockets);
+      UseServicesHelper::debugAppend(resultEl, "udp mux", mUDPMux ? mUDPMux->getID() : 0);
+
+      UseServicesHelper::debugAppend(resultEl, "warm pool", mWarmPool ? mWarmPool->getID() : 0);
+      UseServicesHelper::debugAppend(resultEl, "warm pool interfaces used", mWarmPoolInterfacesUsed);
+      UseServicesHelper::debugAppend(resultEl, "warm pool sockets adopted", mWarmPoolSocketsAdopted);
+      UseServicesHelper::debugAppend(resultEl, "warm pool reflexive mappings adopted", mWarmPoolReflexiveMappingsAdopted);
+
+      UseServicesHelper::debugAppend(resultEl, "gather started", mGatherStarted);
+      UseServicesHelper::debugAppend(resultEl, "first host candidate", mFirstHostCandidate);
+      UseServicesHelper::debugAppend(resultEl, "first server reflexive candidate", mFirstServerReflexiveCandidate);
+      UseServicesHelper::debugAppend(resultEl, "first relay candidate", mFirstRelayCandidate);
+      UseServicesHelper::debugAppend(resultEl, "gather completed", mGatherCompleted);
+
       UseServicesHelper::debugAppend(resultEl, "clean up buffering timer", mCleanUpBufferingTimer ? mCleanUpBufferingTimer->getID() : 0);
       UseServicesHelper::debugAppend(resultEl, "max buffering time", mMaxBufferingTime);
       UseServicesHelper::debugAppend(resultEl, "max total buffers", mMaxTotalBuffers);
@@ -2407,6 +2650,11 @@ namespace ortc
 
       if (!stepCheckIfReady()) goto not_complete;
 
+      if ((Time() != mGatherStarted) &&
+          (Time() == mGatherCompleted)) {
+        mGatherCompleted = zsLib::now();
+      }
+
       setState(InternalState_Ready);
       goto done;
 
@@ -2977,8 +3225,27 @@ namespace ortc
     void ICEGatherer::stepGetHostIPs_ifaddr()
     {
 #ifdef HAVE_GETIFADDRS
+      typedef ICEGathererWarmPool::HostInterface HostInterface;
+      typedef ICEGathererWarmPool::HostInterfaceList HostInterfaceList;
+
       ZS_EVENTING_1(x, i, Debug, IceGathererStep, ol, IceGatherer, Step, puid, id, mID);
 
+      HostInterfaceList interfaces;
+
+      // scope: the first enumeration may use the process wide cache
+      if ((mWarmPool) &&
+          (!mWarmPoolInterfacesUsed)) {
+        mWarmPoolInterfacesUsed = true;
+        if (mWarmPool->getInterfaces(interfaces)) {
+          ZS_LOG_DEBUG(log("using cached host interfaces") + ZS_PARAM("total", interfaces.size()))
+
+          // enumerate for real once the candidates from the cache are out
+          mGetLocalIPsNow = true;
+          IWakeDelegateProxy::create(mThisWeak.lock())->onWake();
+          goto prepare_interfaces;
+        }
+      }
+
       // scope: use getifaddrs
       {
         ifaddrs *ifAddrStruct = NULL;
@@ -3011,21 +3278,43 @@ namespace ortc
                         ulong, adapterSpecific, ifa->ifa_flags
                         );
 
-          auto data = HostIPSorter::prepare(ifa->ifa_name, ip, mInterfaceMappings, mOptions);
+          HostInterface hostInterface;
+          hostInterface.mName = String(ifa->ifa_name);
+          hostInterface.mIP = ip;
 
 #ifdef HAVE_NETINIT6_IN6_VAR_H
           if (0 != (IN6_IFF_TEMPORARY & ifa->ifa_flags)) {
-            data->mIsTemporaryIP = true;
+            hostInterface.mIsTemporaryIP = true;
           }
 #endif //HAVE_NETINIT6_IN6_VAR_H
 
-          mResolvedHostIPs.push_back(data);
+          interfaces.push_back(hostInterface);
         }
 
         if (ifAddrStruct) {
           freeifaddrs(ifAddrStruct);
           ifAddrStruct = NULL;
         }
+
+        if (mWarmPool) {
+          mWarmPool->notifyInterfaces(interfaces);
+        }
+      }
+
+      goto prepare_interfaces;
+
+    prepare_interfaces:
+      {
+        for (auto iter = interfaces.begin(); iter != interfaces.end(); ++iter) {
+          auto &hostInterface = (*iter);
+
+          auto data = HostIPSorter::prepare(hostInterface.mName, hostInterface.mIP, mInterfaceMappings, mOptions);
+          if (hostInterface.mIsTemporaryIP) {
+            data->mIsTemporaryIP = true;
+          }
+
+          mResolvedHostIPs.push_back(data);
+        }
       }
 #endif //HAVE_GETIFADDRS
     }
@@ -3173,7 +3462,24 @@ namespace ortc
             hostPort->mBindUDPBackOffTimer->notifyAttempting();
 
             IPAddress bindIP(hostPort->mHostData->mIP);
-            hostPort->mBoundUDPSocket = bind(firstAttempt, bindIP, IICETypes::Protocol_UDP);
+            bool fromWarmPool = false;
+            if (mUDPMux) {
+              hostPort->mBoundUDPSocket = mUDPMux->bind(mThisWeak.lock(), mUsernameFrag, bindIP);
+            } else {
+              if ((mWarmPool) &&
+                  (1 == mUDPReusePortSockets)) {
+                hostPort->mBoundUDPSocket = mWarmPool->takeUDPSocket(bindIP, hostPort->mWarmPoolMappings);
+                if (hostPort->mBoundUDPSocket) {
+                  hostPort->mBoundUDPSocket->setDelegate(mThisWeak.lock());
+                  fromWarmPool = true;
+                  ++mWarmPoolSocketsAdopted;
+                  ZS_LOG_DEBUG(log("adopted pre-bound socket from warm pool") + ZS_PARAM("ip", bindIP.string()) + ZS_PARAM("reflexive mappings", hostPort->mWarmPoolMappings.size()))
+                }
+              }
+              if (!hostPort->mBoundUDPSocket) {
+                hostPort->mBoundUDPSocket = bind(firstAttempt, bindIP, IICETypes::Protocol_UDP);
+              }
+            }
             if (hostPort->mBoundUDPSocket) {
               ZS_EVENTING_4(
                             x, i, Debug, IceGathererHostPortBind, ol, IceGatherer, HostSocketBind,
@@ -3190,6 +3496,19 @@ namespace ortc
 
               hostPort->mBoundUDPIP = bindIP;
               mHostPortSockets[hostPort->mBoundUDPSocket] = hostPort;
+              if (fromWarmPool) {
+                // a read signalled while the pool still owned the socket would otherwise be lost
+                ISocketDelegateProxy::create(mThisWeak.lock())->onReadReady(hostPort->mBoundUDPSocket);
+              }
+              if ((!mUDPMux) &&
+                  (!hostPort->mUDPReceiveBatch)) {
+                hostPort->mUDPReceiveBatch = make_shared<UDPReceiveBatch>(mMaxUDPReceiveBatchSize, mUDPReceiveBufferSize);
+              }
+              if ((!hostPort->mUDPSendBatch) &&
+                  (mMaxUDPSendBatchSize > 1)) {
+                hostPort->mUDPSendBatch = make_shared<UDPSendBatch>(mMaxUDPSendBatchSize, mUDPReceiveBufferSize, mUDPSendSegmentationOffload);
+              }
+              bindReusePortSockets(hostPort);
               hostPort->mCandidateUDP = createCandidate(hostPort->mHostData, IICETypes::CandidateType_Host, bindIP);
             } else {
               ZS_EVENTING_4(
@@ -3472,6 +3791,11 @@ namespace ortc
           }
         }
 
+        if (mOptions.mICELite) {
+          ZS_LOG_TRACE(log("ice lite only gathers host candidates (thus do not setup reflexive)"))
+          filterOut = true;
+        }
+
         if (filterOut) {
           for (auto iterReflex_doNotUse = hostPort->mReflexivePorts.begin(); iterReflex_doNotUse != hostPort->mReflexivePorts.end(); ) {
             auto currentReflex = iterReflex_doNotUse;
@@ -3577,6 +3901,19 @@ namespace ortc
             }
 
             if (!reflexivePort->mSTUNDiscovery->isComplete()) {
+              if (!reflexivePort->mCandidate) {
+                auto foundMapping = hostPort->mWarmPoolMappings.find(serverHash);
+                if (foundMapping != hostPort->mWarmPoolMappings.end()) {
+                  IPAddress mappedIP = (*foundMapping).second;
+                  hostPort->mWarmPoolMappings.erase(foundMapping);
+
+                  reflexivePort->mCandidate = createCandidate(hostPort->mHostData, IICETypes::CandidateType_Srflex, hostPort->mBoundUDPIP, hostPort->mBoundUDPIP, mappedIP, server);
+                  reflexivePort->mCandidateFromWarmPool = true;
+                  ++mWarmPoolReflexiveMappingsAdopted;
+
+                  ZS_LOG_DEBUG(log("offering cached reflexive candidate until stun discovery completes") + reflexivePort->mCandidate->toDebug())
+                }
+              }
               ZS_LOG_TRACE(log("still waiting for stun discovery to complete"))
               hostPortSetup = allSetup = false;
               continue;
@@ -3591,9 +3928,17 @@ namespace ortc
 
             if (ip.isAddressEmpty()) {
               ZS_LOG_WARNING(Debug, log("failed to obtain server reflexive address") + hostPort->toDebug() + server.toDebug())
+              if (reflexivePort->mCandidateFromWarmPool) {
+                // the cached mapping was never confirmed
+                removeCandidate(reflexivePort->mCandidate);
+                reflexivePort->mCandidate.reset();
+                reflexivePort->mCandidateFromWarmPool = false;
+              }
               continue;
             }
 
+            reflexivePort->mCandidateFromWarmPool = false;
+
             if (reflexivePort->mCandidate) {
 
               if (reflexivePort->mCandidate->ip() == ip) {
@@ -3773,6 +4118,11 @@ namespace ortc
           }
         }
 
+        if (mOptions.mICELite) {
+          ZS_LOG_TRACE(log("ice lite only gathers host candidates (thus do not setup relay)"))
+          filterOut = true;
+        }
+
         if (filterOut) {
           for (auto iterRelay_doNotUse = hostPort->mRelayPorts.begin(); iterRelay_doNotUse != hostPort->mRelayPorts.end(); ) {
             auto currentRelay = iterRelay_doNotUse;
@@ -4236,6 +4586,10 @@ namespace ortc
           auto hostPort = (*current).second;
           shutdown(hostPort);
         }
+
+        if (mUDPMux) {
+          mUDPMux->unregisterGatherer(mID, mUsernameFrag);
+        }
       }
 
       // scope: remote all routes
@@ -4385,6 +4739,9 @@ namespace ortc
     //-------------------------------------------------------------------------
     bool ICEGatherer::hasSTUNServers()
     {
+      // RFC 8445 section 2.5 - an ice lite agent only gathers host candidates
+      if (mOptions.mICELite) return false;
+
       if (mOptionsHash == mHasSTUNServersOptionsHash) {
         return mHasSTUNServers;
       }
@@ -4406,6 +4763,10 @@ namespace ortc
     //-------------------------------------------------------------------------
     bool ICEGatherer::hasTURNServers()
     {
+      // TURN allocations are per gatherer so they cannot share the mux socket
+      if (mUDPMux) return false;
+      if (mOptions.mICELite) return false;
+
       if (mOptionsHash == mHasTURNServersOptionsHash) {
         return mHasTURNServers;
       }
@@ -4559,6 +4920,19 @@ namespace ortc
 
       ZS_LOG_TRACE(log("shutting down host port") + hostPort->toDebug())
 
+      ReflexiveMappingMap warmPoolMappings;
+
+      // scope: remember confirmed mappings in case the socket goes back to the warm pool
+      if ((mWarmPool) &&
+          (!mUDPMux)) {
+        for (auto iter = hostPort->mReflexivePorts.begin(); iter != hostPort->mReflexivePorts.end(); ++iter) {
+          auto reflexivePort = (*iter);
+          if (!reflexivePort->mCandidate) continue;
+          if (reflexivePort->mCandidateFromWarmPool) continue;
+          warmPoolMappings[reflexivePort->mServer.hash()] = reflexivePort->mCandidate->ip();
+        }
+      }
+
       // scope: shutdown reflexive ports
       {
         for (auto iter_doNotUse = hostPort->mReflexivePorts.begin(); iter_doNotUse != hostPort->mReflexivePorts.end(); )
@@ -4608,15 +4982,28 @@ namespace ortc
       hostPort->mCandidateTCPPassive.reset();
       hostPort->mCandidateTCPActive.reset();
 
+      closeReusePortSockets(*hostPort);
+
       if (hostPort->mBoundUDPSocket) {
+        flushUDPSendBatch(*hostPort);
+
         auto found = mHostPortSockets.find(hostPort->mBoundUDPSocket);
         if (found != mHostPortSockets.end()) {
           mHostPortSockets.erase(found);
         }
-        try {
-          hostPort->mBoundUDPSocket->close();
-        } catch(Socket::Exceptions::Unspecified &error) {
-          ZS_LOG_ERROR(Detail, log("failed to close udp socket") + ZS_PARAM("error", error.errorCode()))
+        if (mUDPMux) {
+          // shared socket is owned (and closed) by the mux
+          mUDPMux->unbind(mID, hostPort->mBoundUDPSocket);
+        } else if ((mWarmPool) &&
+                   (1 == mUDPReusePortSockets) &&
+                   (mWarmPool->returnUDPSocket(hostPort->mHostData->mIP, hostPort->mBoundUDPIP, hostPort->mBoundUDPSocket, warmPoolMappings))) {
+          ZS_LOG_TRACE(log("udp socket returned to warm pool") + ZS_PARAM("reflexive mappings", warmPoolMappings.size()))
+        } else {
+          try {
+            hostPort->mBoundUDPSocket->close();
+          } catch(Socket::Exceptions::Unspecified &error) {
+            ZS_LOG_ERROR(Detail, log("failed to close udp socket") + ZS_PARAM("error", error.errorCode()))
+          }
         }
         hostPort->mBoundUDPSocket.reset();
       }
@@ -4853,8 +5240,8 @@ namespace ortc
         tcpPort->mSocket.reset();
       }
 
-      tcpPort->mIncomingBuffer.Clear();
-      tcpPort->mOutgoingBuffer.Clear();
+      tcpPort->mIncomingBuffer->clear();
+      tcpPort->mOutgoingBuffer.clear();
 
       for (auto iter_doNotUse = mRoutes.begin(); iter_doNotUse != mRoutes.end(); ) {
         auto current = iter_doNotUse;
@@ -4897,6 +5284,11 @@ namespace ortc
           }
         }
 
+        if ((IICETypes::Protocol_UDP == protocol) &&
+            (mUDPReusePortSockets > 1)) {
+          enableReusePort(socket);
+        }
+
         socket->bind(ioBindIP);
         socket->setBlocking(false);
 
@@ -5109,12 +5501,12 @@ namespace ortc
         return;
       }
 
-      String localHash = candidate->hash();
+      CandidateHash localHash(candidate);
 
       // NOTE: The uniqueness of a candidate is based on all properites minus
       // the priorities. Thus a candidate is not truly unique if the candidate
       // has all the same values but with different priority values.
-      String notifyHash = candidate->hash(false);
+      CandidateHash notifyHash(candidate, false);
 
       if (mLocalCandidates.find(localHash) != mLocalCandidates.end()) {
         ZS_LOG_TRACE(log("canadidate already added") + candidate->toDebug())
@@ -5130,8 +5522,8 @@ namespace ortc
                      x, i, Debug, IceGathererAddCandidateEvent, ol, IceGatherer, Event,
                      puid, id, mID,
                      pointer, candidate, candidate.get(),
-                     string, localHash, localHash,
-                     string, notifyHash, notifyHash,
+                     string, localHash, localHash.string(),
+                     string, notifyHash, notifyHash.string(),
                      string, interfaceType, candidate->mInterfaceType,
                      string, foundation, candidate->mFoundation,
                      enum, component, candidate->mComponent,
@@ -5154,6 +5546,21 @@ namespace ortc
 
       mNotifiedCandidates[notifyHash] = CandidatePair(candidate, localHash);
 
+      // scope: remember when each candidate type first became available
+      {
+        Time *first = NULL;
+        switch (candidate->mCandidateType) {
+          case IICETypes::CandidateType_Host:   first = &mFirstHostCandidate; break;
+          case IICETypes::CandidateType_Srflex: first = &mFirstServerReflexiveCandidate; break;
+          case IICETypes::CandidateType_Prflx:  break;
+          case IICETypes::CandidateType_Relay:  first = &mFirstRelayCandidate; break;
+        }
+        if ((first) &&
+            (Time() == (*first))) {
+          (*first) = zsLib::now();
+        }
+      }
+
       if (InternalState_Ready == mCurrentState) {
         setState(InternalState_Gathering);
       }
@@ -5169,8 +5576,8 @@ namespace ortc
     {
       if (!candidate) return;
 
-      String localHash = candidate->hash();
-      String notifyHash = candidate->hash(false);
+      CandidateHash localHash(candidate);
+      CandidateHash notifyHash(candidate, false);
 
       auto foundLocal = mLocalCandidates.find(localHash);
       if (foundLocal == mLocalCandidates.end()) {
@@ -5182,8 +5589,8 @@ namespace ortc
                      x, i, Debug, IceGathererRemoveCandidateEvent, ol, IceGatherer, Event,
                      puid, id, mID,
                      pointer, candidate, candidate.get(),
-                     string, localHash, localHash,
-                     string, notifyHash, notifyHash,
+                     string, localHash, localHash.string(),
+                     string, notifyHash, notifyHash.string(),
                      string, interfaceType, candidate->mInterfaceType,
                      string, foundation, candidate->mFoundation,
                      enum, component, candidate->mComponent,
@@ -5206,7 +5613,7 @@ namespace ortc
         return;
       }
 
-      const String &previousLocalHash = (*foundUnique).second.second;
+      const CandidateHash &previousLocalHash = (*foundUnique).second.second;
 
       if (previousLocalHash != localHash) {
         ZS_LOG_TRACE(log("candidate being removed was not notified candidate") + candidate->toDebug())
@@ -5226,12 +5633,12 @@ namespace ortc
       mNotifiedCandidates.erase(foundUnique);
 
       for (auto iter = mLocalCandidates.begin(); iter != mLocalCandidates.end(); ++iter) {
-        const String &otherNotifyHash = (*iter).second.second;
+        const CandidateHash &otherNotifyHash = (*iter).second.second;
         if (otherNotifyHash == notifyHash) {
-          const String &otherLocalHash = (*iter).first;
+          const CandidateHash &otherLocalHash = (*iter).first;
           auto otherCandidate = (*iter).second.first;
 
-          mNotifiedCandidates[notifyHash] = CandidatePair(otherCandidate, otherLocalHash);
+          mNotifiedCandidates[otherNotifyHash] = CandidatePair(otherCandidate, otherLocalHash);
 
           if (InternalState_Ready == mCurrentState) {
             setState(InternalState_Gathering);
@@ -5309,129 +5716,202 @@ namespace ortc
                            SocketPtr socket
                            )
     {
-      UseTURNSocketPtr turnSocket;
-      STUNPacketPtr stunPacket;
+      AutoRecursiveLock lock(*this);
 
-      size_t totalRead = 0;
-      IPAddress fromIP;
-      BYTE readBuffer[0xFFFF] {};
+      if (hostPort->mBoundTCPSocket == socket) {
+        if (mGatherPassiveTCP) {
+          ZS_THROW_INVALID_ASSUMPTION_IF(!hostPort->mCandidateTCPPassive)
+          ZS_LOG_DEBUG(log("notified of incoming TCP connection") + hostPort->toDebug())
 
-      CandidatePtr localCandidate;
+          TCPPortPtr tcpPort(make_shared<TCPPort>());
+          tcpPort->mConnected = true;
 
-      {
-        AutoRecursiveLock lock(*this);
+          IPAddress localAddress;
 
-        if (hostPort->mBoundUDPSocket == socket) {
-          bool wouldBlock = false;
           try {
-            totalRead = socket->receiveFrom(fromIP, readBuffer, sizeof(readBuffer), &wouldBlock);
-          } catch(Socket::Exceptions::Unspecified &error) {
-            ZS_LOG_WARNING(Debug, log("socket read error") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("error", error.errorCode()))
-            return false;
-          }
-
-          if (0 == totalRead) {
+            bool wouldBlock = false;
+            tcpPort->mSocket = socket->accept(tcpPort->mRemoteIP, &wouldBlock);
             if (wouldBlock) {
-              ZS_LOG_INSANE(log("socket read would block") + ZS_PARAM("socket", string(socket)))
-            } else {
-              ZS_LOG_WARNING(Debug, log("failed to read any data from socket") + ZS_PARAM("socket", string(socket)))
+              ZS_LOG_INSANE(log("no more sockets to accept") + tcpPort->toDebug())
+              return false;
             }
+            localAddress = socket->getLocalAddress();
+          } catch(Socket::Exceptions::Unspecified &error) {
+            ZS_LOG_WARNING(Detail, log("failed to accept incoming TCP connection") + ZS_PARAM("error", error.errorCode()))
             return false;
           }
 
-          ZS_EVENTING_4(
-                        x, i, Trace, IceGathererUdpSocketPacketReceivedFrom, ol, IceGatherer, Receive,
+          ZS_EVENTING_3(
+                        x, i, Trace, IceGathererTcpPortCreate, ol, IceGatherer, Start,
                         puid, id, mID,
-                        string, fromIp, fromIP.string(),
-                        buffer, packet, &(readBuffer[0]),
-                        size, size, totalRead
+                        puid, tcpPortId, tcpPort->mID,
+                        string, remoteIp, tcpPort->mRemoteIP.string()
                         );
 
-          ZS_LOG_INSANE(log("receiving incoming packet") + ZS_PARAM("from ip", fromIP.string()) + ZS_PARAM("read", totalRead) + hostPort->toDebug());
+          // create mappings for this socket
+          mTCPPorts[tcpPort->mSocket] = HostAndTCPPortPair(hostPort, tcpPort);
+          hostPort->mTCPPorts[tcpPort->mSocket] = HostAndTCPPortPair(hostPort, tcpPort);
 
-          stunPacket = STUNPacket::parseIfSTUN(&(readBuffer[0]), totalRead, mSTUNPacketParseOptions);
-          fixSTUNParserOptions(stunPacket);
+          tcpPort->mSocket->setDelegate(mThisWeak.lock());
 
-          // scope: check if for relay socket
-          {
-            auto found = hostPort->mIPToRelayPortMapping.find(fromIP);
-            if (found != hostPort->mIPToRelayPortMapping.end()) {
-              auto relayPort = (*found).second;
-              turnSocket = relayPort->mTURNSocket;
-              if (!turnSocket) {
-                ZS_LOG_WARNING(Detail, log("TURN socket was not found despite mapping being found") + relayPort->toDebug());
-                goto unknown_handler;
-              }
-              goto found_relay_port;
-            }
-          }
+          tcpPort->mCandidate = hostPort->mCandidateTCPPassive;
 
-          // this is not a relay socket, see if there is a route
-          localCandidate = hostPort->mCandidateUDP;
-          if (!localCandidate) {
-            ZS_LOG_WARNING(Trace, log("did not find local candidate"))
-            goto unknown_handler;
-          }
-          goto handle_incoming;
+          mTCPCandidateToTCPPorts[tcpPort->mCandidate] = tcpPort;
+
+          ZS_LOG_DEBUG(log("incoming connection ready") + hostPort->toDebug() + tcpPort->toDebug())
+          return true;
         }
+      }
 
-        if (hostPort->mBoundTCPSocket == socket) {
-          if (mGatherPassiveTCP) {
-            ZS_THROW_INVALID_ASSUMPTION_IF(!hostPort->mCandidateTCPPassive)
-            ZS_LOG_DEBUG(log("notified of incoming TCP connection") + hostPort->toDebug())
+      return false;
+    }
 
-            TCPPortPtr tcpPort(make_shared<TCPPort>());
-            tcpPort->mConnected = true;
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::read(
+                           HostPortPtr hostPort,
+                           SocketPtr socket,
+                           UDPReceiveBatch &batch
+                           )
+    {
+      bool wouldBlock = false;
+      size_t totalPackets = 0;
 
-            IPAddress localAddress;
+      CandidatePtr localCandidate;
+      STUNPacket::ParseOptions parseOptions;
 
-            try {
-              bool wouldBlock = false;
-              tcpPort->mSocket = socket->accept(tcpPort->mRemoteIP, &wouldBlock);
-              if (wouldBlock) {
-                ZS_LOG_INSANE(log("no more sockets to accept") + tcpPort->toDebug())
-                return false;
-              }
-              localAddress = socket->getLocalAddress();
-            } catch(Socket::Exceptions::Unspecified &error) {
-              ZS_LOG_WARNING(Detail, log("failed to accept incoming TCP connection") + ZS_PARAM("error", error.errorCode()))
-              return false;
-            }
+      // warning: the socket is drained outside the lock (the batch is only
+      // ever used from the gatherer's queue)
+      try {
+        totalPackets = batch.receive(*socket, wouldBlock);
+      } catch(Socket::Exceptions::Unspecified &error) {
+        ZS_LOG_WARNING(Debug, log("socket read error") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("error", error.errorCode()))
+        batch.reset();
+        return false;
+      }
 
-            ZS_EVENTING_3(
-                          x, i, Trace, IceGathererTcpPortCreate, ol, IceGatherer, Start,
-                          puid, id, mID,
-                          puid, tcpPortId, tcpPort->mID,
-                          string, remoteIp, tcpPort->mRemoteIP.string()
-                          );
+      if (0 == totalPackets) {
+        if (batch.mLastTruncated > 0) {
+          // datagrams were consumed (and dropped) so keep draining the socket
+          ZS_LOG_WARNING(Debug, log("dropped truncated datagrams") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("truncated", batch.mLastTruncated))
+          hostPort->mUDPStats.mPacketsDiscarded += batch.mLastTruncated;
+          return true;
+        }
+        if (wouldBlock) {
+          ZS_LOG_INSANE(log("socket read would block") + ZS_PARAM("socket", string(socket)))
+        } else {
+          ZS_LOG_WARNING(Debug, log("failed to read any data from socket") + ZS_PARAM("socket", string(socket)))
+        }
+        return false;
+      }
+
+      {
+        auto &socketStats = hostPort->mUDPStats;
+        size_t totalBytes = 0;
+        for (size_t index = 0; index < totalPackets; ++index) {
+          totalBytes += batch.mPackets[index].mSize;
+        }
+        socketStats.mPacketsReceived += totalPackets;
+        socketStats.mBytesReceived += totalBytes;
+        socketStats.mPacketsDiscarded += batch.mLastTruncated;
+      }
 
-            // create mappings for this socket
-            mTCPPorts[tcpPort->mSocket] = HostAndTCPPortPair(hostPort, tcpPort);
-            hostPort->mTCPPorts[tcpPort->mSocket] = HostAndTCPPortPair(hostPort, tcpPort);
+      // one clock read covers the bookkeeping for every packet in the batch
+      Clock::Batch clockBatch;
 
-            tcpPort->mSocket->setDelegate(mThisWeak.lock());
+      // replies produced while dispatching the batch go out together
+      SendBurst sendBurst;
+
+      // scope: resolve the entire batch against the host port with a single lock
+      {
+        AutoRecursiveLock lock(*this);
 
-            tcpPort->mCandidate = hostPort->mCandidateTCPPassive;
+        if ((hostPort->mBoundUDPSocket != socket) &&
+            (!findReusePortSocket(*hostPort, socket))) {
+          ZS_LOG_WARNING(Debug, log("udp socket is no longer bound to host port (thus dropping received packets)") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("packets", totalPackets))
+          hostPort->mUDPStats.mPacketsDiscarded += totalPackets;
+          batch.reset();
+          return false;
+        }
 
-            mTCPCandidateToTCPPorts[tcpPort->mCandidate] = tcpPort;
+        localCandidate = hostPort->mCandidateUDP;
+        parseOptions = mSTUNPacketParseOptions;
 
-            ZS_LOG_DEBUG(log("incoming connection ready") + hostPort->toDebug() + tcpPort->toDebug())
-            return true;
+        for (size_t index = 0; index < totalPackets; ++index) {
+          auto &packet = batch.mPackets[index];
+
+          ZS_EVENTING_4(
+                        x, i, Trace, IceGathererUdpSocketPacketReceivedFrom, ol, IceGatherer, Receive,
+                        puid, id, mID,
+                        string, fromIp, packet.mFromIP.string(),
+                        buffer, packet, packet.mBuffer,
+                        size, size, packet.mSize
+                        );
+
+          ZS_LOG_INSANE(log("receiving incoming packet") + ZS_PARAM("from ip", packet.mFromIP.string()) + ZS_PARAM("read", packet.mSize) + hostPort->toDebug());
+
+          if (hostPort->mIPToRelayPortMapping.size() < 1) continue;
+
+          auto found = hostPort->mIPToRelayPortMapping.find(packet.mFromIP);
+          if (found == hostPort->mIPToRelayPortMapping.end()) continue;
+
+          auto relayPort = (*found).second;
+          packet.mRelayMapped = true;
+          packet.mTURNSocket = relayPort->mTURNSocket;
+          if (!packet.mTURNSocket) {
+            ZS_LOG_WARNING(Detail, log("TURN socket was not found despite mapping being found") + relayPort->toDebug());
           }
         }
       }
 
-      return false;
+      // warning: do NOT dispatch from within a lock
+      for (size_t index = 0; index < totalPackets; ++index) {
+        auto &packet = batch.mPackets[index];
+
+        STUNPacketPtr stunPacket = STUNPacket::parseIfSTUN(packet.mBuffer, packet.mSize, parseOptions);
+        if (stunPacket) {
+          AutoRecursiveLock lock(*this);
+          fixSTUNParserOptions(stunPacket);
+        }
+
+        handleUDPPacket(hostPort, socket, localCandidate, packet.mFromIP, packet.mBuffer, packet.mSize, stunPacket, packet.mRelayMapped, packet.mTURNSocket);
+      }
+
+      batch.reset();
+      return !wouldBlock;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::handleUDPPacket(
+                                      HostPortPtr hostPort,
+                                      SocketPtr socket,
+                                      CandidatePtr localCandidate,
+                                      const IPAddress &fromIP,
+                                      const BYTE *buffer,
+                                      size_t bufferSizeInBytes,
+                                      STUNPacketPtr stunPacket,
+                                      bool relayMapped,
+                                      UseTURNSocketPtr turnSocket
+                                      )
+    {
+      if (relayMapped) {
+        if (!turnSocket) goto unknown_handler;
+        goto found_relay_port;
+      }
+
+      if (!localCandidate) {
+        ZS_LOG_WARNING(Trace, log("did not find local candidate"))
+        goto unknown_handler;
+      }
+      goto handle_incoming;
 
     unknown_handler:
       {
         if (stunPacket) {
           if (ISTUNRequester::handleSTUNPacket(fromIP, stunPacket)) {
             ZS_LOG_TRACE(log("handled by stun requester") + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
-            return true;
           }
         }
-        return true;
+        return;
       }
 
     found_relay_port:
@@ -5441,24 +5921,24 @@ namespace ortc
                       puid, id, mID,
                       string, fromIp, fromIP.string(),
                       bool, isStunPacket, ((bool)stunPacket),
-                      buffer, packet, &(readBuffer[0]),
-                      size, size, totalRead
+                      buffer, packet, buffer,
+                      size, size, bufferSizeInBytes
                       );
 
         if (stunPacket) {
           if (ISTUNRequester::handleSTUNPacket(fromIP, stunPacket)) {
             ZS_LOG_TRACE(log("handled by stun requester") + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
-            return true;
+            return;
           }
 
           ZS_LOG_INSANE(log("forwarding stun packet to turn socket") + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
           turnSocket->handleSTUNPacket(fromIP, stunPacket);
-          return true;
+          return;
         }
 
-        ZS_LOG_INSANE(log("forwarding turn channel data to turn socket") + ZS_PARAM("from ip", fromIP.string()) + ZS_PARAM("total", totalRead))
-        turnSocket->handleChannelData(fromIP, &(readBuffer[0]), totalRead);
-        return true;
+        ZS_LOG_INSANE(log("forwarding turn channel data to turn socket") + ZS_PARAM("from ip", fromIP.string()) + ZS_PARAM("total", bufferSizeInBytes))
+        turnSocket->handleChannelData(fromIP, buffer, bufferSizeInBytes);
+        return;
       }
 
     handle_incoming:
@@ -5466,7 +5946,7 @@ namespace ortc
         if (stunPacket) {
           if (ISTUNRequester::handleSTUNPacket(fromIP, stunPacket)) {
             ZS_LOG_TRACE(log("handled by stun requester") + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
-            return true;
+            return;
           }
 
           ZS_LOG_INSANE(log("handling incoming stun packet") + localCandidate->toDebug() + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
@@ -5475,7 +5955,7 @@ namespace ortc
             AutoRecursiveLock lock(*this);
 
             if (hostPort->mBoundUDPSocket) {
-              auto result = sendUDPPacket(socket, hostPort->mBoundUDPIP, fromIP, *response, response->SizeInBytes());
+              auto result = sendUDPPacket(*hostPort, socket, fromIP, *response, response->SizeInBytes());
               if (!result) {
                 ZS_LOG_WARNING(Debug, log("failed to send response packet to stun request") + localCandidate->toDebug() + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
               }
@@ -5483,11 +5963,11 @@ namespace ortc
               ZS_LOG_WARNING(Debug, log("cannot send response as socket is gone") + localCandidate->toDebug() + ZS_PARAM("from ip", fromIP.string()) + stunPacket->toDebug())
             }
           }
-          return true;
+          return;
         }
-        ZS_LOG_INSANE(log("handling incoming packet") + localCandidate->toDebug() + ZS_PARAM("from ip", fromIP.string()) + ZS_PARAM("total", totalRead))
-        handleIncomingPacket(localCandidate, fromIP, &(readBuffer[0]), totalRead);
-        return true;
+        ZS_LOG_INSANE(log("handling incoming packet") + localCandidate->toDebug() + ZS_PARAM("from ip", fromIP.string()) + ZS_PARAM("total", bufferSizeInBytes))
+        handleIncomingPacket(localCandidate, fromIP, buffer, bufferSizeInBytes, hostPort);
+        return;
       }
     }
 
@@ -5497,119 +5977,104 @@ namespace ortc
                            TCPPort &tcpPort
                            )
     {
-      BufferedPacketList packets;
+      struct Frame
+      {
+        const BYTE *mBuffer {};
+        size_t mSize {};
+        STUNPacketPtr mSTUNPacket;
+      };
+      typedef std::vector<Frame> FrameVector;
 
-      CandidatePtr localCandidate;
-      IPAddress fromIP;
+      FrameVector frames;
 
+      while (true)
       {
-        AutoRecursiveLock lock(*this);
+        Clock::Batch clockBatch;
+        SendBurst sendBurst;
+
+        TCPReceiveBufferPtr incoming;
+
+        CandidatePtr localCandidate;
+        IPAddress fromIP;
+
+        frames.clear();
 
-        while (true)
         {
+          AutoRecursiveLock lock(*this);
+
           if (!tcpPort.mSocket) {
             ZS_LOG_WARNING(Detail, log("cannot read closed socket") + tcpPort.toDebug());
             return;
           }
 
-          BYTE buffer[4096] {};
+          // hold a reference so the frames remain valid even if the port is
+          // closed while they are being delivered
+          incoming = tcpPort.mIncomingBuffer;
+          localCandidate = tcpPort.mCandidate;
+          fromIP = tcpPort.mRemoteIP;
 
           try {
             bool wouldBlock = false;
-            size_t read = tcpPort.mSocket->receive(&(buffer[0]), sizeof(buffer), &wouldBlock);
-            if (0 == read) goto process_packets;
-
-            tcpPort.mIncomingBuffer.Put(&(buffer[0]), read);
+            size_t read = incoming->receive(*(tcpPort.mSocket), wouldBlock);
+            if (0 == read) return;
           } catch(Socket::Exceptions::Unspecified &error) {
             ZS_LOG_ERROR(Detail, log("unable to receive from socket") + ZS_PARAM("error", error.errorCode()) + tcpPort.toDebug());
-            goto process_packets;
+            return;
           }
 
-          while (true) {
-            auto currentSize = tcpPort.mIncomingBuffer.CurrentSize();
-
-            CryptoPP::word16 packetSize {};
-
-            if (currentSize < sizeof(packetSize)) goto nothing_more_to_parse;
-
-            // peak ahead to see if the entire packet has arrived
-            tcpPort.mIncomingBuffer.PeekWord16(packetSize);
-
-            if (currentSize < sizeof(packetSize) + packetSize) goto nothing_more_to_parse;
-
-            tcpPort.mIncomingBuffer.Skip(sizeof(packetSize));
-
-            // now have enough to extract out of buffer
-
-            BufferedPacketPtr packet(make_shared<BufferedPacket>());
-            packet->mBuffer = make_shared<SecureByteBlock>(packetSize);
-            if (!localCandidate) {
-              localCandidate = tcpPort.mCandidate;
-              fromIP = tcpPort.mRemoteIP;
-            }
-
-            // fill packet with incoming data
-            tcpPort.mIncomingBuffer.Get(*(packet->mBuffer), packetSize);
+          Frame frame;
+          while (incoming->nextFrame(frame.mBuffer, frame.mSize)) {
+            if (0 == frame.mSize) continue;
 
             ZS_EVENTING_4(
                           x, i, Trace, IceGathererTcpSocketPacketReceivedFrom, ol, IceGatherer, Receive,
                           puid, id, mID,
                           string, remoteIp, tcpPort.mRemoteIP.string(),
-                          buffer, packet, packet->mBuffer->BytePtr(),
-                          size, size, packetSize
+                          buffer, packet, frame.mBuffer,
+                          size, size, frame.mSize
                           );
 
-            packet->mSTUNPacket = STUNPacket::parseIfSTUN(*(packet->mBuffer), packet->mBuffer->SizeInBytes(), mSTUNPacketParseOptions);
-            fixSTUNParserOptions(packet->mSTUNPacket);
+            frame.mSTUNPacket = STUNPacket::parseIfSTUN(frame.mBuffer, frame.mSize, mSTUNPacketParseOptions);
+            fixSTUNParserOptions(frame.mSTUNPacket);
 
-            packets.push_back(packet);
+            frames.push_back(frame);
           }
 
-        nothing_more_to_parse:
-          {
-            ZS_LOG_INSANE(log("nothing more to parse at this time") + ZS_PARAM("packets found", packets.size()) + tcpPort.toDebug())
-          }
+          ZS_LOG_INSANE(log("nothing more to parse at this time") + ZS_PARAM("frames found", frames.size()) + tcpPort.toDebug())
         }
-      }
 
-    process_packets:
-      {
-        for (auto iter = packets.begin(); iter != packets.end(); ++iter) {
-          auto packet = (*iter);
+        for (auto iter = frames.begin(); iter != frames.end(); ++iter) {
+          auto &frame = (*iter);
 
-          if (packet->mSTUNPacket) {
-            if (ISTUNRequester::handleSTUNPacket(fromIP, packet->mSTUNPacket)) {
-              ZS_LOG_TRACE(log("handled by stun requester") + ZS_PARAM("from ip", fromIP.string()) + packet->mSTUNPacket->toDebug())
+          if (frame.mSTUNPacket) {
+            if (ISTUNRequester::handleSTUNPacket(fromIP, frame.mSTUNPacket)) {
+              ZS_LOG_TRACE(log("handled by stun requester") + ZS_PARAM("from ip", fromIP.string()) + frame.mSTUNPacket->toDebug())
               continue;
             }
 
-            ZS_LOG_TRACE(log("handling incoming TCP stun packet") + packet->toDebug() + packet->mSTUNPacket->toDebug())
+            ZS_LOG_TRACE(log("handling incoming TCP stun packet") + ZS_PARAM("size", frame.mSize) + frame.mSTUNPacket->toDebug())
 
-            auto response = handleIncomingPacket(localCandidate, fromIP, packet->mSTUNPacket);
+            auto response = handleIncomingPacket(localCandidate, fromIP, frame.mSTUNPacket);
             if (response) {
               AutoRecursiveLock lock(*this);
               if (tcpPort.mSocket) {
                 ZS_LOG_TRACE(log("sending packet response by putting into TCP send queue") + tcpPort.toDebug())
-                // put the buffer at the end of the queue
-
-                CryptoPP::word16 packeSize = ((CryptoPP::word16)(response->SizeInBytes()));
 
-                tcpPort.mOutgoingBuffer.PutWord16(packeSize);
-                tcpPort.mOutgoingBuffer.Put(*response, response->SizeInBytes());
+                tcpPort.mOutgoingBuffer.queue(*response, response->SizeInBytes());
                 if ((tcpPort.mConnected) &&
                     (tcpPort.mWriteReady)) {
                   ZS_LOG_INSANE(log("simulate TCP write ready to force the packet to send immediately"))
                   ISocketDelegateProxy::create(mThisWeak.lock())->onWriteReady(tcpPort.mSocket);
                 }
               } else {
-                ZS_LOG_WARNING(Debug, log("socket is now gone thus response cannot be sent") + tcpPort.toDebug() + ZS_PARAM("from ip", fromIP.string()) + packet->mSTUNPacket->toDebug())
+                ZS_LOG_WARNING(Debug, log("socket is now gone thus response cannot be sent") + tcpPort.toDebug() + ZS_PARAM("from ip", fromIP.string()) + frame.mSTUNPacket->toDebug())
               }
             }
             continue;
           }
 
-          ZS_LOG_INSANE(log("handling incoming TCP packet") + packet->toDebug())
-          handleIncomingPacket(localCandidate, fromIP, *(packet->mBuffer), packet->mBuffer->SizeInBytes());
+          ZS_LOG_INSANE(log("handling incoming TCP packet") + ZS_PARAM("size", frame.mSize))
+          handleIncomingPacket(localCandidate, fromIP, frame.mBuffer, frame.mSize);
         }
       }
     }
@@ -5638,6 +6103,121 @@ namespace ortc
       }
     }
 
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::enableReusePort(SocketPtr socket)
+    {
+#ifdef HAVE_SO_REUSEPORT
+      int enable = 1;
+      if (0 != setsockopt(socket->getSocket(), SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable))) {
+        ZS_LOG_WARNING(Detail, log("unable to enable SO_REUSEPORT on socket") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("error", errno))
+        return false;
+      }
+      return true;
+#else
+      return false;
+#endif //HAVE_SO_REUSEPORT
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::bindReusePortSockets(HostPortPtr hostPort)
+    {
+      if (mUDPReusePortSockets < 2) return;
+      if (!hostPort->mBoundUDPSocket) return;
+      if (hostPort->mReusePortSockets.size() > 0) return;
+
+      auto createFamily = (hostPort->mBoundUDPIP.isIPv6() ? Socket::Create::IPv6 : Socket::Create::IPv4);
+
+      // the primary bound UDP socket counts as the first socket
+      for (size_t index = 1; index < mUDPReusePortSockets; ++index) {
+        ReusePortSocketPtr reusePortSocket(make_shared<ReusePortSocket>());
+
+        try {
+          reusePortSocket->mSocket = Socket::createUDP(createFamily);
+          if (!enableReusePort(reusePortSocket->mSocket)) goto bind_failure;
+
+          reusePortSocket->mSocket->bind(hostPort->mBoundUDPIP);
+          reusePortSocket->mSocket->setBlocking(false);
+
+          try {
+#ifndef __QNX__
+            reusePortSocket->mSocket->setOptionFlag(Socket::SetOptionFlag::IgnoreSigPipe, true);
+#endif //ndef __QNX__
+          } catch(Socket::Exceptions::UnsupportedSocketOption &) {
+          }
+        } catch(Socket::Exceptions::Unspecified &error) {
+          ZS_LOG_ERROR(Detail, log("reuse port bind error") + ZS_PARAM("error", error.errorCode()) + ZS_PARAM("bind ip", hostPort->mBoundUDPIP.string()))
+          goto bind_failure;
+        }
+
+        // each socket is read on its own packet queue (the kernel keeps each 5-tuple on the same socket)
+        reusePortSocket->mUDPReceiveBatch = make_shared<UDPReceiveBatch>(mMaxUDPReceiveBatchSize, mUDPReceiveBufferSize);
+        reusePortSocket->mReader = make_shared<ReusePortReader>(IORTCForInternal::queuePacket(), mThisWeak.lock());
+
+        mHostPortSockets[reusePortSocket->mSocket] = hostPort;
+        hostPort->mReusePortSockets.push_back(reusePortSocket);
+
+        reusePortSocket->mSocket->setDelegate(reusePortSocket->mReader);
+
+        ZS_LOG_DEBUG(log("bound reuse port socket") + hostPort->toDebug() + reusePortSocket->toDebug())
+        continue;
+
+      bind_failure:
+        {
+          ZS_LOG_WARNING(Debug, log("unable to bind additional reuse port socket (host port will continue with fewer sockets)") + ZS_PARAM("bind ip", hostPort->mBoundUDPIP.string()))
+          if (reusePortSocket->mSocket) {
+            try {
+              reusePortSocket->mSocket->close();
+            } catch(Socket::Exceptions::Unspecified &) {
+            }
+          }
+          break;
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::closeReusePortSockets(HostPort &hostPort)
+    {
+      for (auto iter = hostPort.mReusePortSockets.begin(); iter != hostPort.mReusePortSockets.end(); ++iter) {
+        auto reusePortSocket = (*iter);
+
+        auto found = mHostPortSockets.find(reusePortSocket->mSocket);
+        if (found != mHostPortSockets.end()) {
+          mHostPortSockets.erase(found);
+        }
+
+        // the reader may be mid-read on its packet queue (without this lock)
+        ReusePortReader::close(reusePortSocket->mReader, reusePortSocket->mSocket);
+      }
+      hostPort.mReusePortSockets.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGatherer::ReusePortSocketPtr ICEGatherer::findReusePortSocket(
+                                                                    HostPort &hostPort,
+                                                                    SocketPtr socket
+                                                                    ) const
+    {
+      for (auto iter = hostPort.mReusePortSockets.begin(); iter != hostPort.mReusePortSockets.end(); ++iter) {
+        auto reusePortSocket = (*iter);
+        if (reusePortSocket->mSocket == socket) return reusePortSocket;
+      }
+      return ReusePortSocketPtr();
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGatherer::UDPReceiveBatchPtr ICEGatherer::findUDPReceiveBatch(
+                                                                    HostPort &hostPort,
+                                                                    SocketPtr socket
+                                                                    ) const
+    {
+      if (hostPort.mBoundUDPSocket == socket) return hostPort.mUDPReceiveBatch;
+
+      auto reusePortSocket = findReusePortSocket(hostPort, socket);
+      if (reusePortSocket) return reusePortSocket->mUDPReceiveBatch;
+      return UDPReceiveBatchPtr();
+    }
+
     //-------------------------------------------------------------------------
     bool ICEGatherer::writeIfTCPPort(SocketPtr socket)
     {
@@ -5665,20 +6245,17 @@ namespace ortc
       }
 
       while (true) {
-        size_t currentSize = static_cast<size_t>(tcpPort.mOutgoingBuffer.CurrentSize());
-        if (0 == currentSize) {
+        if (tcpPort.mOutgoingBuffer.isEmpty()) {
           ZS_LOG_INSANE(log("nothing more to send") + tcpPort.toDebug());
           goto finished_write;
         }
 
         try {
-          if (currentSize > 0xFFFF + sizeof(CryptoPP::word16)) currentSize = 0xFFFF + sizeof(CryptoPP::word16);
-
-          SecureByteBlock buffer(currentSize);
-          tcpPort.mOutgoingBuffer.Peek(buffer, currentSize);
+          size_t contiguous = 0;
+          const BYTE *pending = tcpPort.mOutgoingBuffer.peek(contiguous);
 
           bool wouldBlock = false;
-          auto sent = tcpPort.mSocket->send(buffer, currentSize, &wouldBlock);
+          auto sent = tcpPort.mOutgoingBuffer.send(*(tcpPort.mSocket), wouldBlock);
 
           if (0 == sent) {
             ZS_LOG_INSANE(log("no more room to send data") + tcpPort.toDebug());
@@ -5690,14 +6267,11 @@ namespace ortc
                         x, i, Trace, IceGathererTcpSocketSentOutgoing, ol, IceGatherer, Send,
                         puid, id, mID,
                         string, remoteIp, tcpPort.mRemoteIP.string(),
-                        buffer, packet, buffer.BytePtr(),
-                        size, size, sent
+                        buffer, packet, pending,
+                        size, size, (sent < contiguous ? sent : contiguous)
                         );
 
           ZS_LOG_INSANE(log("sent TCP data to remote party") + tcpPort.toDebug() + ZS_PARAM("sent", sent))
-
-          // consume the amount sent from the pending queue (and try sending more)
-          tcpPort.mOutgoingBuffer.Skip(sent);
         } catch(Socket::Exceptions::Unspecified &error) {
           ZS_LOG_ERROR(Detail, log("unable to send to socket") + ZS_PARAM("error", error.errorCode()) + tcpPort.toDebug())
           goto finished_write;
@@ -5717,6 +6291,22 @@ namespace ortc
       ZS_THROW_INVALID_ARGUMENT_IF(!hostPort)
       AutoRecursiveLock lock(*this);
 
+      // scope: an additional reuse port socket only closes itself
+      {
+        auto reusePortSocket = findReusePortSocket(*hostPort, socket);
+        if (reusePortSocket) {
+          ZS_LOG_WARNING(Detail, log("reuse port socket unexpectedly closed") + hostPort->toDebug() + reusePortSocket->toDebug())
+
+          auto found = mHostPortSockets.find(socket);
+          if (found != mHostPortSockets.end()) {
+            mHostPortSockets.erase(found);
+          }
+          ReusePortReader::close(reusePortSocket->mReader, socket);
+          hostPort->mReusePortSockets.remove(reusePortSocket);
+          return;
+        }
+      }
+
       if ((hostPort->mBoundUDPSocket != socket) &&
           (hostPort->mBoundTCPSocket != socket)) {
         ZS_LOG_WARNING(Detail, log("socket was not found on host port") + hostPort->toDebug() + ZS_PARAM("socket", string(socket)))
@@ -5739,15 +6329,26 @@ namespace ortc
 
       ZS_LOG_WARNING(Detail, log("bound UDP or TCP socket unexpectedly closed") + hostPort->toDebug() + ZS_PARAM("socket", string(socket)))
 
+      if (hostPort->mBoundUDPSocket == socket) {
+        // the port will be rebound so the sockets sharing it must go too
+        closeReusePortSockets(*hostPort);
+      }
+
       auto found = mHostPortSockets.find(socket);
       if (found != mHostPortSockets.end()) {
         mHostPortSockets.erase(found);
       }
 
-      try {
-        socket->close();
-      } catch(Socket::Exceptions::Unspecified &error) {
-        ZS_LOG_ERROR(Detail, log("unable to close socket") + ZS_PARAM("error", error.errorCode()) + hostPort->toDebug())
+      if ((mUDPMux) &&
+          (hostPort->mBoundUDPSocket == socket)) {
+        // shared socket is owned (and closed) by the mux
+        mUDPMux->unbind(mID, socket);
+      } else {
+        try {
+          socket->close();
+        } catch(Socket::Exceptions::Unspecified &error) {
+          ZS_LOG_ERROR(Detail, log("unable to close socket") + ZS_PARAM("error", error.errorCode()) + hostPort->toDebug())
+        }
       }
 
       socket.reset();
@@ -5848,6 +6449,11 @@ namespace ortc
             }
           }
 
+          if (mUDPMux) {
+            // only an authenticated request may claim the remote address on the shared socket
+            learnUDPMuxRoute(localCandidate, remoteIP);
+          }
+
           auto found = mInstalledTransports.find(rFrag);
           if (found == mInstalledTransports.end()) goto buffer_data_now;
 
@@ -5924,7 +6530,7 @@ namespace ortc
         AutoRecursiveLock lock(*this);
 
         BufferedPacketPtr packet(make_shared<BufferedPacket>());
-        packet->mTimestamp = zsLib::now();
+        packet->mTimestamp = Clock::coarseNow();
         packet->mRouterRoute = routerRoute;
         packet->mSTUNPacket = stunPacket;
         packet->mRFrag = rFrag;
@@ -5951,7 +6557,8 @@ namespace ortc
                                            CandidatePtr localCandidate,
                                            const IPAddress &remoteIP,
                                            const BYTE *buffer,
-                                           size_t bufferSizeInBytes
+                                           size_t bufferSizeInBytes,
+                                           HostPortPtr hostPort
                                            )
     {
       RoutePtr route;
@@ -5961,6 +6568,23 @@ namespace ortc
       {
         AutoRecursiveLock lock(*this);
 
+        // scope: check the last route used by this host port
+        if (hostPort) {
+          route = hostPort->mLastRoute.lock();
+          if ((route) &&
+              (route->mLocalCandidate == localCandidate) &&
+              (route->mRouterRoute) &&
+              (route->mRouterRoute->mRemoteIP == remoteIP)) {
+            transport = route->mTransport.lock();
+            if (transport) {
+              route->mLastUsed = Clock::coarseNow();
+              routerRoute = route->mRouterRoute;
+              goto found_transport;
+            }
+          }
+          route.reset();
+        }
+
         // scope: search for existing route
         {
           route = installRoute(localCandidate, remoteIP, UseICETransportPtr());
@@ -5968,7 +6592,10 @@ namespace ortc
             routerRoute = route->mRouterRoute;
             transport = route->mTransport.lock();
 
-            if (transport) goto found_transport;
+            if (transport) {
+              if (hostPort) hostPort->mLastRoute = route;
+              goto found_transport;
+            }
           }
         }
       }
@@ -5989,6 +6616,7 @@ namespace ortc
                       size, size, bufferSizeInBytes
                       );
         transport->notifyPacket(routerRoute, buffer, bufferSizeInBytes);
+        return;
       }
 
     buffer_data_now:
@@ -6004,14 +6632,14 @@ namespace ortc
         AutoRecursiveLock lock(*this);
 
         BufferedPacketPtr packet(make_shared<BufferedPacket>());
-        packet->mTimestamp = zsLib::now();
+        packet->mTimestamp = Clock::coarseNow();
         packet->mRouterRoute = routerRoute;
         packet->mBuffer = UseServicesHelper::convertToBuffer(buffer, bufferSizeInBytes);
 
         ZS_EVENTING_6(
                       x, i, Trace, IceGathererBufferIceTransportIncomingPacket, ol, IceGatherer, Buffer,
                       puid, id, mID,
-                      puid, iceTransportId, transport->getID(),
+                      puid, iceTransportId, transport ? transport->getID() : 0,
                       puid, routerRouteId, routerRoute->mID,
                       bool, wasBuffered, false,
                       buffer, packet, buffer,
@@ -6033,7 +6661,7 @@ namespace ortc
       CandidatePtr result;
 
       auto routerCandidate = routerRoute->mLocalCandidate;
-      String routerCandidateHash = routerRoute->mLocalCandidate->hash();
+      CandidateHash routerCandidateHash(*routerCandidate);
 
       AutoRecursiveLock lock(*this);
 
@@ -6046,7 +6674,7 @@ namespace ortc
           auto hostPort = (*iter).second;
           if (IICETypes::Protocol_UDP == routerCandidate->mProtocol) {
             if (hostPort->mCandidateUDP) {
-              if (hostPort->mCandidateUDP->hash() == routerCandidateHash) {
+              if (CandidateHash(*(hostPort->mCandidateUDP)) == routerCandidateHash) {
                 result = hostPort->mCandidateUDP;
                 goto done;
               }
@@ -6055,13 +6683,13 @@ namespace ortc
             for (auto iterRelay = hostPort->mRelayPorts.begin(); iterRelay != hostPort->mRelayPorts.end(); ++iterRelay) {
               auto relayPort = (*iterRelay);
               if (relayPort->mReflexiveCandidate) {
-                if (relayPort->mReflexiveCandidate->hash() == routerCandidateHash) {
+                if (CandidateHash(*(relayPort->mReflexiveCandidate)) == routerCandidateHash) {
                   result = hostPort->mCandidateUDP;
                   goto done;
                 }
               }
               if (relayPort->mRelayCandidate) {
-                if (relayPort->mRelayCandidate->hash() == routerCandidateHash) {
+                if (CandidateHash(*(relayPort->mRelayCandidate)) == routerCandidateHash) {
                   result = relayPort->mRelayCandidate;
                   goto done;
                 }
@@ -6071,7 +6699,7 @@ namespace ortc
             for (auto iterRelay = hostPort->mReflexivePorts.begin(); iterRelay != hostPort->mReflexivePorts.end(); ++iterRelay) {
               auto reflexivePort = (*iterRelay);
               if (reflexivePort->mCandidate) {
-                if (reflexivePort->mCandidate->hash() == routerCandidateHash) {
+                if (CandidateHash(*(reflexivePort->mCandidate)) == routerCandidateHash) {
                   result = hostPort->mCandidateUDP;
                   goto done;
                 }
@@ -6081,13 +6709,13 @@ namespace ortc
 
           if (IICETypes::Protocol_TCP == routerCandidate->mProtocol) {
             if (hostPort->mCandidateTCPPassive) {
-              if (hostPort->mCandidateTCPPassive->hash() == routerCandidateHash) {
+              if (CandidateHash(*(hostPort->mCandidateTCPPassive)) == routerCandidateHash) {
                 result = hostPort->mCandidateTCPPassive;
                 goto done;
               }
             }
             if (hostPort->mCandidateTCPActive) {
-              if (hostPort->mCandidateTCPActive->hash() == routerCandidateHash) {
+              if (CandidateHash(*(hostPort->mCandidateTCPActive)) == routerCandidateHash) {
                 result = hostPort->mCandidateTCPActive;
                 goto done;
               }
@@ -6132,7 +6760,7 @@ namespace ortc
           if (foundTransport->getID() != transport->getID()) goto remove_existing_route;
         }
 
-        route->mLastUsed = zsLib::now();
+        route->mLastUsed = Clock::coarseNow();
         return route;
       }
 
@@ -6161,7 +6789,7 @@ namespace ortc
                                                     UseICETransportPtr transport
                                                     )
     {
-      LocalCandidateRemoteIPPair search(sentFromLocalCandidate, remoteIP);
+      LocalCandidateRemoteIPPair search(sentFromLocalCandidate.get(), remoteIP);
 
       RoutePtr route;
 
@@ -6186,7 +6814,7 @@ namespace ortc
           if (foundTransport->getID() != transport->getID()) goto remove_existing_route;
         }
 
-        route->mLastUsed = zsLib::now();
+        route->mLastUsed = Clock::coarseNow();
         return route;
       }
 
@@ -6207,7 +6835,7 @@ namespace ortc
         // install a route
         route = make_shared<Route>();
         route->mOuterObjectID = mID;
-        route->mLastUsed = zsLib::now();
+        route->mLastUsed = Clock::coarseNow();
         route->mLocalCandidate = sentFromLocalCandidate;
         route->mTransportID = transport->getID();
         route->mTransport = transport;
@@ -6366,14 +6994,21 @@ namespace ortc
           ZS_EVENTING_4(
                         x, i, Debug, IceGathererInstallQuickRoute, ol, IceGatherer, Receive,
                         puid, id, mID,
-                        pointer, candidate, search.first.get(),
-                        string, ip, search.second.string(),
+                        pointer, candidate, sentFromLocalCandidate.get(),
+                        string, ip, remoteIP.string(),
                         puid, routeId, route->mID
                         );
 
           mRoutes[route->mRouterRoute->mID] = route;
           mQuickSearchRoutes[search] = route;
 
+          if ((mUDPMux) &&
+              (route->mHostPort) &&
+              (route->mHostPort->mBoundUDPSocket)) {
+            // non-STUN packets on the shared socket are demultiplexed by remote address
+            mUDPMux->learnRoute(route->mHostPort->mBoundUDPSocket, remoteIP, mThisWeak.lock());
+          }
+
           IGathererAsyncDelegateProxy::create(mThisWeak.lock())->onNotifyDeliverRouteBufferedPackets(transport, route->mRouterRoute->mID);
           return route;
         }
@@ -6412,8 +7047,8 @@ namespace ortc
         ZS_EVENTING_4(
                       x, i, Debug, IceGathererRemoveQuickRoute, ol, IceGatherer, Info,
                       puid, id, mID,
-                      pointer, candidate, (*current).first.first.get(),
-                      string, ipAddress, (*current).first.second.string(),
+                      pointer, candidate, route->mLocalCandidate.get(),
+                      string, ipAddress, route->mRouterRoute ? route->mRouterRoute->mRemoteIP.string() : String(),
                       puid, routeId, route->mID
                       );
 
@@ -6436,12 +7071,129 @@ namespace ortc
 
         mRoutes.erase(current);
       }
+
+      clearLastRoutes();
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::clearLastRoutes()
+    {
+      for (auto iter = mHostPorts.begin(); iter != mHostPorts.end(); ++iter) {
+        auto hostPort = (*iter).second;
+        hostPort->mLastRoute.reset();
+      }
     }
     
+    //-------------------------------------------------------------------------
+    void ICEGatherer::learnUDPMuxRoute(
+                                       CandidatePtr localCandidate,
+                                       const IPAddress &remoteIP
+                                       )
+    {
+      if (!mUDPMux) return;
+      if (!localCandidate) return;
+      if (IICETypes::Protocol_UDP != localCandidate->mProtocol) return;
+
+      for (auto iter = mHostPorts.begin(); iter != mHostPorts.end(); ++iter) {
+        auto hostPort = (*iter).second;
+        if (hostPort->mCandidateUDP != localCandidate) continue;
+        if (!hostPort->mBoundUDPSocket) return;
+
+        mUDPMux->learnRoute(hostPort->mBoundUDPSocket, remoteIP, mThisWeak.lock());
+        return;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::queueUDPPacket(
+                                     HostPortPtr hostPort,
+                                     const IPAddress &remoteIP,
+                                     const BYTE *buffer,
+                                     size_t bufferSizeInBytes
+                                     )
+    {
+      auto batch = hostPort->mUDPSendBatch;
+      if (!batch) return sendUDPPacket(*hostPort, hostPort->mBoundUDPSocket, remoteIP, buffer, bufferSizeInBytes);
+
+      if ((!SendBurst::isOpen()) ||
+          (batch->mBlocked) ||
+          (bufferSizeInBytes > batch->mBufferSize)) {
+        // preserve ordering with anything already pending; sending directly
+        // lets the caller see a would-block or send error
+        if (!flushUDPSendBatch(*hostPort)) return false;
+        bool sent = sendUDPPacket(*hostPort, hostPort->mBoundUDPSocket, remoteIP, buffer, bufferSizeInBytes);
+        if (sent) batch->mBlocked = false;
+        return sent;
+      }
+
+      ZS_EVENTING_5(
+                    x, i, Trace, IceGathererUdpSocketPacketSentTo, ol, IceGatherer, Send,
+                    puid, id, mID,
+                    string, boundIp, hostPort->mBoundUDPIP.string(),
+                    string, remoteIp, remoteIP.string(),
+                    buffer, packet, buffer,
+                    size, size, bufferSizeInBytes
+                    );
+
+      if (batch->isEmpty()) registerSendBurst(mThisWeak.lock(), hostPort);
+
+      batch->queue(remoteIP, buffer, bufferSizeInBytes);
+
+      if (batch->isFull()) return flushUDPSendBatch(*hostPort);
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::flushUDPSendBatch(HostPort &hostPort)
+    {
+      auto batch = hostPort.mUDPSendBatch;
+      if (!batch) return true;
+      if (batch->isEmpty()) return true;
+
+      auto &socketStats = hostPort.mUDPStats;
+
+      if (!hostPort.mBoundUDPSocket) {
+        ZS_LOG_WARNING(Debug, log("no UDP socket to flush send batch (thus dropping packets)") + batch->toDebug())
+        socketStats.mPacketsDiscarded += batch->mTotalPackets;
+        batch->mTotalDropped += batch->mTotalPackets;
+        batch->mTotalPackets = 0;
+        return false;
+      }
+
+      auto total = batch->mTotalPackets;
+
+      try {
+        auto sent = batch->flush(*(hostPort.mBoundUDPSocket), hostPort.mBoundUDPIP);
+
+        // packets are always sent in queued order (the buffers remain valid after the flush)
+        size_t sentBytes = 0;
+        for (size_t index = 0; index < sent; ++index) {
+          sentBytes += batch->mPackets[index].mSize;
+        }
+        socketStats.mPacketsSent += sent;
+        socketStats.mBytesSent += sentBytes;
+
+        ZS_LOG_INSANE(log("udp send batch flushed") + ZS_PARAM("socket", string(hostPort.mBoundUDPSocket)) + ZS_PARAM("from", hostPort.mBoundUDPIP.string()) + ZS_PARAM("packets", total) + ZS_PARAM("sent", sent))
+        if (sent != total) {
+          ++(socketStats.mSendWouldBlock);
+          socketStats.mPacketsDiscarded += (total - sent);
+          batch->mBlocked = true;
+          ZS_LOG_WARNING(Trace, log("could not send all batched packets at this time") + ZS_PARAM("socket", string(hostPort.mBoundUDPSocket)) + ZS_PARAM("packets", total) + ZS_PARAM("sent", sent))
+          return false;
+        }
+      } catch(Socket::Exceptions::Unspecified &error) {
+        socketStats.mPacketsDiscarded += total;
+        batch->mBlocked = true;
+        ZS_LOG_ERROR(Debug, log("unable to send batched packets") + ZS_PARAM("error", error.errorCode()) + ZS_PARAM("from", hostPort.mBoundUDPIP.string()) + ZS_PARAM("packets", total))
+        return false;
+      }
+      return true;
+    }
+
     //-------------------------------------------------------------------------
     bool ICEGatherer::sendUDPPacket(
+                                    HostPort &hostPort,
                                     SocketPtr socket,
-                                    const IPAddress &boundIP,
                                     const IPAddress &remoteIP,
                                     const BYTE *buffer,
                                     size_t bufferSizeInBytes
@@ -6451,6 +7203,9 @@ namespace ortc
       if (!buffer) return true;
       if (0 == bufferSizeInBytes) return true;
 
+      const IPAddress &boundIP = hostPort.mBoundUDPIP;
+      auto &socketStats = hostPort.mUDPStats;
+
       try {
         bool wouldBlock = false;
 
@@ -6466,12 +7221,21 @@ namespace ortc
         auto sent = socket->sendTo(remoteIP, buffer, bufferSizeInBytes, &wouldBlock);
         ZS_LOG_INSANE(log("packet sent") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("to", remoteIP.string()) + ZS_PARAM("from", boundIP.string()) + ZS_PARAM("size", bufferSizeInBytes))
 
-        if (sent == bufferSizeInBytes) return true;
+        if (sent == bufferSizeInBytes) {
+          ++(socketStats.mPacketsSent);
+          socketStats.mBytesSent += bufferSizeInBytes;
+          return true;
+        }
+
+        if (wouldBlock) ++(socketStats.mSendWouldBlock);
       } catch(Socket::Exceptions::Unspecified &error) {
+        ++(socketStats.mPacketsDiscarded);
         ZS_LOG_ERROR(Debug, log("unable to send packet") + ZS_PARAM("error", error.errorCode()) + ZS_PARAM("to", remoteIP.string()) + ZS_PARAM("from", boundIP.string()))
         return false;
       }
 
+      ++(socketStats.mPacketsDiscarded);
+
       ZS_LOG_WARNING(Trace, log("could not send packet at this time") + ZS_PARAM("socket", string(socket)) + ZS_PARAM("to", remoteIP.string()) + ZS_PARAM("from", boundIP.string()) + ZS_PARAM("size", bufferSizeInBytes))
       return false;
     }
@@ -6863,6 +7627,7 @@ namespace ortc
 
       UseServicesHelper::debugAppend(resultEl, "options hash", mOptionsHash);
       UseServicesHelper::debugAppend(resultEl, mCandidate ? mCandidate->toDebug() : ElementPtr());
+      UseServicesHelper::debugAppend(resultEl, "candidate from warm pool", mCandidateFromWarmPool);
 
       UseServicesHelper::debugAppend(resultEl, "last activity", mLastActivity);
       UseServicesHelper::debugAppend(resultEl, "inactivity timer", mInactivityTimer ? mInactivityTimer->getID() : 0);
@@ -6898,6 +7663,29 @@ namespace ortc
       return resultEl;
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::SocketStats
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::SocketStats::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::SocketStats");
+
+      UseServicesHelper::debugAppend(resultEl, "packets sent", mPacketsSent.load());
+      UseServicesHelper::debugAppend(resultEl, "bytes sent", mBytesSent.load());
+      UseServicesHelper::debugAppend(resultEl, "packets received", mPacketsReceived.load());
+      UseServicesHelper::debugAppend(resultEl, "bytes received", mBytesReceived.load());
+      UseServicesHelper::debugAppend(resultEl, "packets discarded", mPacketsDiscarded.load());
+      UseServicesHelper::debugAppend(resultEl, "send would block", mSendWouldBlock.load());
+
+      return resultEl;
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -6920,6 +7708,10 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "candidate udp", mCandidateUDP ? mCandidateUDP->toDebug() : ElementPtr());
       UseServicesHelper::debugAppend(resultEl, "bound udp ip", mBoundUDPIP.string());
       UseServicesHelper::debugAppend(resultEl, "bound udp socket", string(mBoundUDPSocket));
+      UseServicesHelper::debugAppend(resultEl, "udp receive batch", mUDPReceiveBatch ? mUDPReceiveBatch->toDebug() : ElementPtr());
+      UseServicesHelper::debugAppend(resultEl, "udp send batch", mUDPSendBatch ? mUDPSendBatch->toDebug() : ElementPtr());
+      UseServicesHelper::debugAppend(resultEl, "udp stats", mUDPStats.toDebug());
+      UseServicesHelper::debugAppend(resultEl, "udp reuse port sockets", mReusePortSockets.size());
       UseServicesHelper::debugAppend(resultEl, "udp back off timer", UseBackOffTimer::toDebug(mBindUDPBackOffTimer));
 
       UseServicesHelper::debugAppend(resultEl, "passive candidate tcp", mCandidateTCPPassive ? mCandidateTCPPassive->toDebug() : ElementPtr());
@@ -6932,6 +7724,7 @@ namespace ortc
 
       UseServicesHelper::debugAppend(resultEl, "reflexive options hash", mReflexiveOptionsHash);
       UseServicesHelper::debugAppend(resultEl, "reflexive ports", mReflexivePorts.size());
+      UseServicesHelper::debugAppend(resultEl, "warm pool mappings", mWarmPoolMappings.size());
 
       UseServicesHelper::debugAppend(resultEl, "relay options hash", mRelayOptionsHash);
       UseServicesHelper::debugAppend(resultEl, "relay ports", mRelayPorts.size());
@@ -6947,30 +7740,74 @@ namespace ortc
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     #pragma mark
-    #pragma mark ICEGatherer::TCPPort
+    #pragma mark ICEGatherer::ReusePortReader
     #pragma mark
 
     //-------------------------------------------------------------------------
-    ElementPtr ICEGatherer::TCPPort::toDebug() const
+    ICEGatherer::ReusePortReader::ReusePortReader(
+                                                  IMessageQueuePtr queue,
+                                                  ICEGathererPtr gatherer
+                                                  ) :
+      MessageQueueAssociator(queue),
+      mGatherer(gatherer)
     {
-      ElementPtr resultEl = Element::create("ortc::ICEGatherer::TCPPort");
+    }
 
-      UseServicesHelper::debugAppend(resultEl, "id", mID);
+    //-------------------------------------------------------------------------
+    void ICEGatherer::ReusePortReader::close(
+                                             ReusePortReaderPtr reader,
+                                             SocketPtr socket
+                                             )
+    {
+      if (!socket) return;
 
-      UseServicesHelper::debugAppend(resultEl, "connected", mConnected);
+      if (!reader) {
+        try {
+          socket->close();
+        } catch(Socket::Exceptions::Unspecified &) {
+        }
+        return;
+      }
 
-      UseServicesHelper::debugAppend(resultEl, "candidate", mCandidate ? mCandidate->toDebug() : ElementPtr());
+      // stop forwarding events now; the close itself runs on the reader's queue
+      reader->mClosing = true;
+      IGathererReusePortReaderAsyncDelegateProxy::create(reader)->onReusePortReaderClose(socket);
+    }
 
-      UseServicesHelper::debugAppend(resultEl, "remote ip", mRemoteIP.string());
-      UseServicesHelper::debugAppend(resultEl, "socket", string(mSocket));
-      UseServicesHelper::debugAppend(resultEl, "incoming buffer", mIncomingBuffer.CurrentSize());
-      UseServicesHelper::debugAppend(resultEl, "outgoing buffer", mOutgoingBuffer.CurrentSize());
+    //-------------------------------------------------------------------------
+    void ICEGatherer::ReusePortReader::onReadReady(SocketPtr socket)
+    {
+      if (mClosing) return;
 
-      UseServicesHelper::debugAppend(resultEl, "transport id", mTransportID);
-      UseICETransportPtr transport = mTransport.lock();
-      UseServicesHelper::debugAppend(resultEl, "ice transport", transport ? transport->getID() : 0);
+      auto gatherer = mGatherer.lock();
+      if (!gatherer) return;
+      gatherer->onReadReady(socket);
+    }
 
-      return resultEl;
+    //-------------------------------------------------------------------------
+    void ICEGatherer::ReusePortReader::onWriteReady(SocketPtr socket)
+    {
+      // outgoing packets are always sent via the primary bound socket
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::ReusePortReader::onException(SocketPtr socket)
+    {
+      if (mClosing) return;
+
+      auto gatherer = mGatherer.lock();
+      if (!gatherer) return;
+      gatherer->onException(socket);
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::ReusePortReader::onReusePortReaderClose(SocketPtr socket)
+    {
+      try {
+        socket->close();
+      } catch(Socket::Exceptions::Unspecified &error) {
+        ZS_LOG_ERROR(Detail, slog("failed to close reuse port socket") + ZS_PARAM("error", error.errorCode()))
+      }
     }
 
     //-------------------------------------------------------------------------
@@ -6978,22 +7815,18 @@ namespace ortc
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     #pragma mark
-    #pragma mark ICEGatherer::BufferedPacket
+    #pragma mark ICEGatherer::ReusePortSocket
     #pragma mark
 
     //-------------------------------------------------------------------------
-    ElementPtr ICEGatherer::BufferedPacket::toDebug() const
+    ElementPtr ICEGatherer::ReusePortSocket::toDebug() const
     {
-      ElementPtr resultEl = Element::create("ortc::ICEGatherer::BufferedPacket");
-
-      UseServicesHelper::debugAppend(resultEl, "timestamp", mTimestamp);
-
-      UseServicesHelper::debugAppend(resultEl, mRouterRoute ? mRouterRoute->toDebug() : ElementPtr());
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::ReusePortSocket");
 
-      UseServicesHelper::debugAppend(resultEl, "stun packet", (bool)mSTUNPacket);
-      UseServicesHelper::debugAppend(resultEl, "rfrag", mRFrag);
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
 
-      UseServicesHelper::debugAppend(resultEl, "buffer", mBuffer ? mBuffer->SizeInBytes() : 0);
+      UseServicesHelper::debugAppend(resultEl, "socket", string(mSocket));
+      UseServicesHelper::debugAppend(resultEl, "udp receive batch", mUDPReceiveBatch ? mUDPReceiveBatch->toDebug() : ElementPtr());
 
       return resultEl;
     }
@@ -7003,28 +7836,765 @@ namespace ortc
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     #pragma mark
-    #pragma mark ICEGatherer::Route
+    #pragma mark ICEGatherer::TCPReceiveBuffer
     #pragma mark
 
     //-------------------------------------------------------------------------
-    void ICEGatherer::Route::trace(const char *function, const char *message) const
+    ICEGatherer::TCPReceiveBuffer::TCPReceiveBuffer() :
+      mBuffer(ORTC_ICEGATHERER_MAX_TCP_FRAME_SIZE * 2)
     {
-      if (mLocalCandidate) {
-        ZS_EVENTING_20(
-                       x, i, Trace, IceGathererRouteTrace, ol, IceGatherer, Info,
-                       puid, routeId, mID,
-                       string, callingMethod, function,
-                       string, message, message,
-                       puid, outerObjectId, mOuterObjectID,
-                       duration, lastUsed, zsLib::timeSinceEpoch<Milliseconds>(mLastUsed).count(),
-                       puid, transportId, mTransportID,
-                       word, hostPort, mHostPort ? mHostPort->mID : 0,
-                       word, relayPort, mRelayPort ? mRelayPort->mID : 0,
-                       puid, tcpPortId, mTCPPort ? mTCPPort->mID : 0,
-                       string, interfaceType, mLocalCandidate->mInterfaceType,
-                       string, foundation, mLocalCandidate->mFoundation,
-                       dword, priority, mLocalCandidate->mPriority,
-                       dword, unfreezePriority, mLocalCandidate->mUnfreezePriority,
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ICEGatherer::TCPReceiveBuffer::receive(
+                                                  Socket &socket,
+                                                  bool &outWouldBlock
+                                                  ) throw (Socket::Exceptions::Unspecified)
+    {
+      outWouldBlock = false;
+
+      if (mHead == mTail) clear();
+
+      if (mBuffer.SizeInBytes() - mTail < ORTC_ICEGATHERER_MIN_TCP_RECEIVE_SPACE) {
+        // only a partial frame can remain (complete frames are always
+        // consumed before the next receive) so this always makes room
+        auto remaining = size();
+        if (remaining > 0) {
+          memmove(mBuffer.BytePtr(), mBuffer.BytePtr() + mHead, remaining);
+        }
+        mHead = 0;
+        mTail = remaining;
+
+        ++mTotalCompactions;
+        mTotalCompactedBytes += remaining;
+      }
+
+      auto read = socket.receive(mBuffer.BytePtr() + mTail, mBuffer.SizeInBytes() - mTail, &outWouldBlock);
+      mTail += read;
+      return read;
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::TCPReceiveBuffer::nextFrame(
+                                                  const BYTE * &outFrame,
+                                                  size_t &outFrameSize
+                                                  )
+    {
+      outFrame = NULL;
+      outFrameSize = 0;
+
+      auto available = size();
+      if (available < sizeof(WORD)) return false;
+
+      const BYTE *header = mBuffer.BytePtr() + mHead;
+      size_t frameSize = (static_cast<size_t>(header[0]) << 8) | static_cast<size_t>(header[1]);
+
+      if (available < sizeof(WORD) + frameSize) return false;
+
+      outFrame = header + sizeof(WORD);
+      outFrameSize = frameSize;
+
+      mHead += sizeof(WORD) + frameSize;
+      ++mTotalFrames;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::TCPReceiveBuffer::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::TCPReceiveBuffer");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "capacity", mBuffer.SizeInBytes());
+      UseServicesHelper::debugAppend(resultEl, "head", mHead);
+      UseServicesHelper::debugAppend(resultEl, "tail", mTail);
+
+      UseServicesHelper::debugAppend(resultEl, "total frames", mTotalFrames);
+      UseServicesHelper::debugAppend(resultEl, "total compactions", mTotalCompactions);
+      UseServicesHelper::debugAppend(resultEl, "total compacted bytes", mTotalCompactedBytes);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::TCPSendRing
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    const BYTE *ICEGatherer::TCPSendRing::peek(size_t &outSize) const
+    {
+      outSize = 0;
+      if (isEmpty()) return NULL;
+
+      auto capacity = mBuffer.SizeInBytes();
+      outSize = (mHead + mSize > capacity ? capacity - mHead : mSize);
+      return mBuffer.BytePtr() + mHead;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::TCPSendRing::queue(
+                                         const BYTE *buffer,
+                                         size_t bufferSizeInBytes
+                                         )
+    {
+      ZS_THROW_INVALID_ARGUMENT_IF(bufferSizeInBytes > 0xFFFF)
+
+      size_t required = mSize + sizeof(WORD) + bufferSizeInBytes;
+      if (required > mBuffer.SizeInBytes()) grow(required);
+
+      BYTE header[sizeof(WORD)] {};
+      header[0] = static_cast<BYTE>((bufferSizeInBytes >> 8) & 0xFF);
+      header[1] = static_cast<BYTE>(bufferSizeInBytes & 0xFF);
+
+      put(&(header[0]), sizeof(header));
+      put(buffer, bufferSizeInBytes);
+
+      ++mTotalFrames;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ICEGatherer::TCPSendRing::send(
+                                          Socket &socket,
+                                          bool &outWouldBlock
+                                          ) throw (Socket::Exceptions::Unspecified)
+    {
+      outWouldBlock = false;
+
+      if (isEmpty()) return 0;
+
+      size_t firstSize = 0;
+      const BYTE *first = peek(firstSize);
+      size_t secondSize = mSize - firstSize;
+
+      size_t sent = 0;
+
+#ifdef HAVE_WRITEV
+      struct iovec vectors[2];
+      vectors[0].iov_base = const_cast<BYTE *>(first);
+      vectors[0].iov_len = firstSize;
+      vectors[1].iov_base = mBuffer.BytePtr();
+      vectors[1].iov_len = secondSize;
+
+#ifdef MSG_NOSIGNAL
+      // writev cannot suppress SIGPIPE on a peer reset (there is no
+      // per-socket SO_NOSIGPIPE as on Apple) so gather through sendmsg
+      struct msghdr message {};
+      message.msg_iov = &(vectors[0]);
+      message.msg_iovlen = (0 != secondSize ? 2 : 1);
+#endif //MSG_NOSIGNAL
+
+      ssize_t result = 0;
+      do {
+        ++mTotalSystemCalls;
+#ifdef MSG_NOSIGNAL
+        result = sendmsg(socket.getSocket(), &message, MSG_NOSIGNAL);
+#else
+        result = writev(socket.getSocket(), &(vectors[0]), (0 != secondSize ? 2 : 1));
+#endif //MSG_NOSIGNAL
+      } while ((result < 0) && (EINTR == errno));
+
+      if (result < 0) {
+        if ((EAGAIN == errno) ||
+            (EWOULDBLOCK == errno)) {
+          outWouldBlock = true;
+          return 0;
+        }
+        auto error = errno;
+        ZS_THROW_CUSTOM_PROPERTIES_1(Socket::Exceptions::Unspecified, error, "gathered send failed on socket")
+      }
+
+      sent = static_cast<size_t>(result);
+#else
+      ++mTotalSystemCalls;
+      sent = socket.send(first, firstSize, &outWouldBlock);
+      if ((sent == firstSize) &&
+          (0 != secondSize)) {
+        ++mTotalSystemCalls;
+        sent += socket.send(mBuffer.BytePtr(), secondSize, &outWouldBlock);
+      }
+#endif //HAVE_WRITEV
+
+      if (sent > mSize) sent = mSize;
+
+      mHead = (mHead + sent) % mBuffer.SizeInBytes();
+      mSize -= sent;
+      if (isEmpty()) mHead = 0;
+
+      return sent;
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::TCPSendRing::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::TCPSendRing");
+
+      UseServicesHelper::debugAppend(resultEl, "capacity", mBuffer.SizeInBytes());
+      UseServicesHelper::debugAppend(resultEl, "head", mHead);
+      UseServicesHelper::debugAppend(resultEl, "size", mSize);
+
+      UseServicesHelper::debugAppend(resultEl, "total frames", mTotalFrames);
+      UseServicesHelper::debugAppend(resultEl, "total system calls", mTotalSystemCalls);
+      UseServicesHelper::debugAppend(resultEl, "total growths", mTotalGrowths);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::TCPSendRing::grow(size_t required)
+    {
+      size_t capacity = mBuffer.SizeInBytes();
+      if (capacity < ORTC_ICEGATHERER_INITIAL_TCP_SEND_RING_SIZE) capacity = ORTC_ICEGATHERER_INITIAL_TCP_SEND_RING_SIZE;
+      while (capacity < required) capacity *= 2;
+
+      SecureByteBlock buffer(capacity);
+
+      // unwrap the pending data to the start of the new buffer
+      size_t firstSize = 0;
+      const BYTE *first = peek(firstSize);
+      if (firstSize > 0) {
+        memcpy(buffer.BytePtr(), first, firstSize);
+      }
+      if (mSize > firstSize) {
+        memcpy(buffer.BytePtr() + firstSize, mBuffer.BytePtr(), mSize - firstSize);
+      }
+
+      mBuffer.swap(buffer);
+      mHead = 0;
+
+      ++mTotalGrowths;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::TCPSendRing::put(
+                                       const BYTE *buffer,
+                                       size_t bufferSizeInBytes
+                                       )
+    {
+      if (0 == bufferSizeInBytes) return;
+
+      auto capacity = mBuffer.SizeInBytes();
+      size_t tail = (mHead + mSize) % capacity;
+
+      size_t firstSize = capacity - tail;
+      if (firstSize > bufferSizeInBytes) firstSize = bufferSizeInBytes;
+
+      memcpy(mBuffer.BytePtr() + tail, buffer, firstSize);
+      if (bufferSizeInBytes > firstSize) {
+        memcpy(mBuffer.BytePtr(), buffer + firstSize, bufferSizeInBytes - firstSize);
+      }
+
+      mSize += bufferSizeInBytes;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::TCPPort
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::TCPPort::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::TCPPort");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "connected", mConnected);
+
+      UseServicesHelper::debugAppend(resultEl, "candidate", mCandidate ? mCandidate->toDebug() : ElementPtr());
+
+      UseServicesHelper::debugAppend(resultEl, "remote ip", mRemoteIP.string());
+      UseServicesHelper::debugAppend(resultEl, "socket", string(mSocket));
+      UseServicesHelper::debugAppend(resultEl, "incoming buffer", mIncomingBuffer ? mIncomingBuffer->toDebug() : ElementPtr());
+      UseServicesHelper::debugAppend(resultEl, "outgoing buffer", mOutgoingBuffer.toDebug());
+
+      UseServicesHelper::debugAppend(resultEl, "transport id", mTransportID);
+      UseICETransportPtr transport = mTransport.lock();
+      UseServicesHelper::debugAppend(resultEl, "ice transport", transport ? transport->getID() : 0);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::BufferedPacket
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::BufferedPacket::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::BufferedPacket");
+
+      UseServicesHelper::debugAppend(resultEl, "timestamp", mTimestamp);
+
+      UseServicesHelper::debugAppend(resultEl, mRouterRoute ? mRouterRoute->toDebug() : ElementPtr());
+
+      UseServicesHelper::debugAppend(resultEl, "stun packet", (bool)mSTUNPacket);
+      UseServicesHelper::debugAppend(resultEl, "rfrag", mRFrag);
+
+      UseServicesHelper::debugAppend(resultEl, "buffer", mBuffer ? mBuffer->SizeInBytes() : 0);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::SendBurst
+    #pragma mark
+
+    typedef std::pair<ICEGathererWeakPtr, ICEGatherer::HostPortWeakPtr> SendBurstPendingPair;
+    typedef std::vector<SendBurstPendingPair> SendBurstPendingList;
+
+    static thread_local size_t gSendBurstDepth {};
+    static thread_local SendBurstPendingList gSendBurstPending;
+
+    //-------------------------------------------------------------------------
+    ICEGatherer::SendBurst::SendBurst()
+    {
+      ++gSendBurstDepth;
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGatherer::SendBurst::~SendBurst()
+    {
+      --gSendBurstDepth;
+      if (0 != gSendBurstDepth) return;
+
+      while (gSendBurstPending.size() > 0) {
+        SendBurstPendingList pending;
+        pending.swap(gSendBurstPending);
+
+        for (auto iter = pending.begin(); iter != pending.end(); ++iter) {
+          auto gatherer = (*iter).first.lock();
+          auto hostPort = (*iter).second.lock();
+          if ((!gatherer) || (!hostPort)) continue;
+
+          AutoRecursiveLock lock(*gatherer);
+          gatherer->flushUDPSendBatch(*hostPort);
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::SendBurst::isOpen()
+    {
+      return 0 != gSendBurstDepth;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::registerSendBurst(
+                                        ICEGathererPtr gatherer,
+                                        HostPortPtr hostPort
+                                        )
+    {
+      gSendBurstPending.push_back(SendBurstPendingPair(gatherer, hostPort));
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::UDPReceiveBatch
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICEGatherer::UDPReceiveBatch::UDPReceiveBatch(
+                                                  size_t maxPackets,
+                                                  size_t bufferSize
+                                                  ) :
+      mMaxPackets(maxPackets),
+      mBufferSize(bufferSize),
+      mBuffers(maxPackets * bufferSize),
+      mPackets(maxPackets)
+    {
+      for (size_t index = 0; index < mMaxPackets; ++index) {
+        mPackets[index].mBuffer = mBuffers.BytePtr() + (index * mBufferSize);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ICEGatherer::UDPReceiveBatch::receive(
+                                                 Socket &socket,
+                                                 bool &outWouldBlock
+                                                 ) throw (Socket::Exceptions::Unspecified)
+    {
+      outWouldBlock = false;
+      mTotalPackets = 0;
+      mLastTruncated = 0;
+
+#ifdef HAVE_RECVMMSG
+      struct mmsghdr headers[ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE];
+      struct iovec vectors[ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE];
+      sockaddr_storage addresses[ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE];
+
+      memset(&(headers[0]), 0, sizeof(headers[0]) * mMaxPackets);
+
+      for (size_t index = 0; index < mMaxPackets; ++index) {
+        vectors[index].iov_base = mPackets[index].mBuffer;
+        vectors[index].iov_len = mBufferSize;
+        headers[index].msg_hdr.msg_name = &(addresses[index]);
+        headers[index].msg_hdr.msg_namelen = sizeof(addresses[index]);
+        headers[index].msg_hdr.msg_iov = &(vectors[index]);
+        headers[index].msg_hdr.msg_iovlen = 1;
+      }
+
+      int result = 0;
+      do {
+        result = recvmmsg(socket.getSocket(), &(headers[0]), static_cast<unsigned int>(mMaxPackets), MSG_DONTWAIT, NULL);
+      } while ((result < 0) && (EINTR == errno));
+
+      if (result < 0) {
+        if ((EAGAIN == errno) ||
+            (EWOULDBLOCK == errno)) {
+          outWouldBlock = true;
+          return 0;
+        }
+        ZS_THROW_CUSTOM_PROPERTIES_1(Socket::Exceptions::Unspecified, errno, "recvmmsg failed on socket")
+      }
+
+      ++mTotalBatches;
+
+      for (int index = 0; index < result; ++index) {
+        auto &header = headers[index];
+        if (0 != (header.msg_hdr.msg_flags & MSG_TRUNC)) {
+          // datagram exceeded the pooled buffer size (never a valid ICE / media packet)
+          ++mLastTruncated;
+          ++mTotalTruncated;
+          continue;
+        }
+
+        auto &packet = mPackets[mTotalPackets];
+
+        // buffers are laid out in order so compact by swapping buffer ownership
+        if (&packet != &(mPackets[index])) std::swap(packet.mBuffer, mPackets[index].mBuffer);
+
+        if (AF_INET6 == addresses[index].ss_family) {
+          packet.mFromIP = IPAddress(*reinterpret_cast<const sockaddr_in6 *>(&(addresses[index])));
+        } else {
+          packet.mFromIP = IPAddress(*reinterpret_cast<const sockaddr_in *>(&(addresses[index])));
+        }
+        packet.mSize = static_cast<size_t>(header.msg_len);
+        ++mTotalPackets;
+      }
+
+      outWouldBlock = (static_cast<size_t>(result) < mMaxPackets);
+      return mTotalPackets;
+#else
+      while ((mTotalPackets + mLastTruncated) < mMaxPackets) {
+        auto &packet = mPackets[mTotalPackets];
+
+        // buffers are pooled and are never cleared between reads
+        size_t totalRead = 0;
+        try {
+          totalRead = socket.receiveFrom(packet.mFromIP, packet.mBuffer, mBufferSize, &outWouldBlock);
+        } catch (Socket::Exceptions::Unspecified &error) {
+#ifdef _WIN32
+          // windows reports an oversized datagram as an error (after discarding it)
+          if (WSAEMSGSIZE == error.errorCode()) {
+            ++mLastTruncated;
+            ++mTotalTruncated;
+            continue;
+          }
+#endif //_WIN32
+          if (mTotalPackets > 0) break;
+          throw;
+        }
+        if (0 == totalRead) break;
+
+        if (totalRead >= mBufferSize) {
+          // BSD sockets truncate silently; a datagram filling the entire
+          // buffer can not be told apart from a truncated one so drop it
+          ++mLastTruncated;
+          ++mTotalTruncated;
+          continue;
+        }
+
+        packet.mSize = totalRead;
+        ++mTotalPackets;
+      }
+
+      if ((mTotalPackets + mLastTruncated) > 0) ++mTotalBatches;
+      return mTotalPackets;
+#endif //HAVE_RECVMMSG
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::UDPReceiveBatch::reset()
+    {
+      for (size_t index = 0; index < mTotalPackets; ++index) {
+        auto &packet = mPackets[index];
+        packet.mSize = 0;
+        packet.mRelayMapped = false;
+        packet.mTURNSocket.reset();
+      }
+      mTotalPackets = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::UDPReceiveBatch::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::UDPReceiveBatch");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "max packets", mMaxPackets);
+      UseServicesHelper::debugAppend(resultEl, "buffer size", mBufferSize);
+      UseServicesHelper::debugAppend(resultEl, "packets", mTotalPackets);
+
+      UseServicesHelper::debugAppend(resultEl, "total batches", mTotalBatches);
+      UseServicesHelper::debugAppend(resultEl, "total truncated", mTotalTruncated);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::UDPSendBatch
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICEGatherer::UDPSendBatch::UDPSendBatch(
+                                            size_t maxPackets,
+                                            size_t bufferSize,
+                                            bool segmentationOffload
+                                            ) :
+      mMaxPackets(maxPackets),
+      mBufferSize(bufferSize),
+      mSegmentationOffload(segmentationOffload),
+      mBuffers(maxPackets * bufferSize),
+      mPackets(maxPackets)
+    {
+      for (size_t index = 0; index < mMaxPackets; ++index) {
+        mPackets[index].mBuffer = mBuffers.BytePtr() + (index * mBufferSize);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGatherer::UDPSendBatch::queue(
+                                         const IPAddress &remoteIP,
+                                         const BYTE *buffer,
+                                         size_t bufferSizeInBytes
+                                         )
+    {
+      if (isFull()) return false;
+      if (bufferSizeInBytes > mBufferSize) return false;
+
+      auto &packet = mPackets[mTotalPackets];
+      packet.mRemoteIP = remoteIP;
+      packet.mSize = bufferSizeInBytes;
+      memcpy(packet.mBuffer, buffer, bufferSizeInBytes);
+
+      ++mTotalPackets;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ICEGatherer::UDPSendBatch::flush(
+                                            Socket &socket,
+                                            const IPAddress &boundIP
+                                            ) throw (Socket::Exceptions::Unspecified)
+    {
+      if (isEmpty()) return 0;
+
+      ++mTotalFlushes;
+
+      size_t totalSent = 0;
+
+#ifdef HAVE_SENDMMSG
+      struct mmsghdr headers[ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE];
+      struct iovec vectors[ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE];
+      sockaddr_storage addresses[ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE];
+      socklen_t addressLengths[ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE];
+
+      memset(&(headers[0]), 0, sizeof(headers[0]) * mTotalPackets);
+
+      for (size_t index = 0; index < mTotalPackets; ++index) {
+        auto &packet = mPackets[index];
+
+        memset(&(addresses[index]), 0, sizeof(addresses[index]));
+        if (boundIP.isIPv4()) {
+          packet.mRemoteIP.getIPv4(*((sockaddr_in *)&(addresses[index])));
+          addressLengths[index] = sizeof(sockaddr_in);
+        } else {
+          packet.mRemoteIP.getIPv6(*((sockaddr_in6 *)&(addresses[index])));
+          addressLengths[index] = sizeof(sockaddr_in6);
+        }
+
+        vectors[index].iov_base = packet.mBuffer;
+        vectors[index].iov_len = packet.mSize;
+        headers[index].msg_hdr.msg_name = &(addresses[index]);
+        headers[index].msg_hdr.msg_namelen = addressLengths[index];
+        headers[index].msg_hdr.msg_iov = &(vectors[index]);
+        headers[index].msg_hdr.msg_iovlen = 1;
+      }
+
+      size_t index = 0;
+
+#ifdef HAVE_UDP_SEGMENT
+      // a run of packets to the same destination where every packet (except
+      // possibly the last) is the same size can be handed to the kernel as a
+      // single segmented datagram
+      while ((mSegmentationOffload) &&
+             (index < mTotalPackets)) {
+        size_t segmentSize = mPackets[index].mSize;
+        size_t totalBytes = segmentSize;
+        size_t end = index + 1;
+
+        for (; end < mTotalPackets; ++end) {
+          auto &next = mPackets[end];
+          if (end - index >= ORTC_ICEGATHERER_MAX_UDP_SEGMENTS) break;
+          if (next.mRemoteIP != mPackets[index].mRemoteIP) break;
+          if (next.mSize > segmentSize) break;
+          if (totalBytes + next.mSize > ORTC_ICEGATHERER_MAX_UDP_SEGMENTED_PAYLOAD) break;
+          totalBytes += next.mSize;
+          if (next.mSize < segmentSize) {++end; break;}   // a short segment must be the final segment
+        }
+
+        if (end - index < 2) break;   // not worth segmenting (remainder sent via sendmmsg)
+
+        char control[CMSG_SPACE(sizeof(uint16_t))] {};
+
+        struct msghdr header {};
+        header.msg_name = &(addresses[index]);
+        header.msg_namelen = addressLengths[index];
+        header.msg_iov = &(vectors[index]);
+        header.msg_iovlen = end - index;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        *((uint16_t *)CMSG_DATA(cmsg)) = static_cast<uint16_t>(segmentSize);
+
+        ssize_t result = 0;
+        do {
+          ++mTotalSystemCalls;
+          result = sendmsg(socket.getSocket(), &header, MSG_DONTWAIT);
+        } while ((result < 0) && (EINTR == errno));
+
+        if (result < 0) {
+          if ((EAGAIN == errno) ||
+              (EWOULDBLOCK == errno)) goto done;
+
+          // kernel / device does not support segmentation offload, use sendmmsg from now on
+          mSegmentationOffload = false;
+          break;
+        }
+
+        totalSent += (end - index);
+        index = end;
+      }
+#endif //HAVE_UDP_SEGMENT
+
+      while (index < mTotalPackets) {
+        int result = 0;
+        do {
+          ++mTotalSystemCalls;
+          result = sendmmsg(socket.getSocket(), &(headers[index]), static_cast<unsigned int>(mTotalPackets - index), MSG_DONTWAIT);
+        } while ((result < 0) && (EINTR == errno));
+
+        if (result < 0) {
+          if ((EAGAIN == errno) ||
+              (EWOULDBLOCK == errno)) goto done;
+
+          auto error = errno;
+          mTotalDropped += (mTotalPackets - totalSent);
+          mTotalSent += totalSent;
+          mTotalPackets = 0;
+          ZS_THROW_CUSTOM_PROPERTIES_1(Socket::Exceptions::Unspecified, error, "sendmmsg failed on socket")
+        }
+        if (0 == result) goto done;
+
+        totalSent += static_cast<size_t>(result);
+        index += static_cast<size_t>(result);
+      }
+
+    done:
+#else
+      for (size_t index = 0; index < mTotalPackets; ++index) {
+        auto &packet = mPackets[index];
+
+        bool wouldBlock = false;
+        ++mTotalSystemCalls;
+        auto sent = socket.sendTo(packet.mRemoteIP, packet.mBuffer, packet.mSize, &wouldBlock);
+        if (sent != packet.mSize) break;
+        ++totalSent;
+      }
+#endif //HAVE_SENDMMSG
+
+      // UDP is lossy; anything that could not be sent now is dropped rather than re-queued
+      mTotalDropped += (mTotalPackets - totalSent);
+      mTotalSent += totalSent;
+      mTotalPackets = 0;
+      return totalSent;
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGatherer::UDPSendBatch::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGatherer::UDPSendBatch");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "max packets", mMaxPackets);
+      UseServicesHelper::debugAppend(resultEl, "buffer size", mBufferSize);
+      UseServicesHelper::debugAppend(resultEl, "segmentation offload", mSegmentationOffload);
+      UseServicesHelper::debugAppend(resultEl, "packets", mTotalPackets);
+
+      UseServicesHelper::debugAppend(resultEl, "total flushes", mTotalFlushes);
+      UseServicesHelper::debugAppend(resultEl, "total system calls", mTotalSystemCalls);
+      UseServicesHelper::debugAppend(resultEl, "total sent", mTotalSent);
+      UseServicesHelper::debugAppend(resultEl, "total dropped", mTotalDropped);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGatherer::Route
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGatherer::Route::trace(const char *function, const char *message) const
+    {
+      if (mLocalCandidate) {
+        ZS_EVENTING_20(
+                       x, i, Trace, IceGathererRouteTrace, ol, IceGatherer, Info,
+                       puid, routeId, mID,
+                       string, callingMethod, function,
+                       string, message, message,
+                       puid, outerObjectId, mOuterObjectID,
+                       duration, lastUsed, zsLib::timeSinceEpoch<Milliseconds>(mLastUsed).count(),
+                       puid, transportId, mTransportID,
+                       word, hostPort, mHostPort ? mHostPort->mID : 0,
+                       word, relayPort, mRelayPort ? mRelayPort->mID : 0,
+                       puid, tcpPortId, mTCPPort ? mTCPPort->mID : 0,
+                       string, interfaceType, mLocalCandidate->mInterfaceType,
+                       string, foundation, mLocalCandidate->mFoundation,
+                       dword, priority, mLocalCandidate->mPriority,
+                       dword, unfreezePriority, mLocalCandidate->mUnfreezePriority,
                        string, protocol, IICETypes::toString(mLocalCandidate->mProtocol),
                        string, ip, mLocalCandidate->mIP,
                        word, port, mLocalCandidate->mPort,
@@ -7589,6 +9159,17 @@ namespace ortc
       }
     }
 
+    {
+      String str = UseServicesHelper::getElementText(elem->findFirstChildElement("iceLite"));
+      if (str.hasData()) {
+        try {
+          mICELite = Numeric<decltype(mICELite)>(str);
+        } catch(const Numeric<decltype(mICELite)>::ValueOutOfRange &) {
+          ZS_LOG_WARNING(Debug, slog("ice lite value out of range") + ZS_PARAM("value", str))
+        }
+      }
+    }
+
     ElementPtr interfacePoliciesEl = elem->findFirstChildElement("interfacePolicies");
 
     if (interfacePoliciesEl) {
@@ -7633,6 +9214,9 @@ namespace ortc
     ElementPtr elem = Element::create(objectName);
 
     elem->adoptAsLastChild(UseServicesHelper::createElementWithNumber("continuousGathering",  string(mContinuousGathering)));
+    if (mICELite) {
+      elem->adoptAsLastChild(UseServicesHelper::createElementWithNumber("iceLite",  string(mICELite)));
+    }
 
     if (mInterfacePolicies.size() > 0) {
       ElementPtr interfacePoliciesEl = Element::create("interfacePolicies");
@@ -7673,7 +9257,8 @@ namespace ortc
   {
     SHA1Hasher hasher;
 
-    hasher.update(mContinuousGathering ? "Options:true:policy:" : "Options:false:policy:");
+    hasher.update(mContinuousGathering ? "Options:true:" : "Options:false:");
+    hasher.update(mICELite ? "lite:policy:" : "full:policy:");
     for (auto iter = mInterfacePolicies.begin(); iter != mInterfacePolicies.end(); ++iter) {
       auto policy = (*iter);
       hasher.update(policy.hash());
@@ -119,13 +119,13 @@ namespace ortc
     {
       AutoRecursiveLock lock(*this);
 
-      LocalCandidateHash hash = localCandidate ? localCandidate->hash() : String();
+      LocalCandidateHash hash = localCandidate ? LocalCandidateHash(*localCandidate) : LocalCandidateHash();
 
-      CandidateRemoteIPPair search(hash, remoteIP);
+      IPRouteKey search(findLocalCandidateID(hash, createRouteIfNeeded), remoteIP);
 
-      auto found = mRoutes.find(search);
+      auto found = (0 != search.mLocalID ? mRoutes.find(search) : mRoutes.end());
       if (found != mRoutes.end()) {
-        RoutePtr route = (*found).second.lock();
+        RoutePtr route = (*found).second.mRoute.lock();
 
         if (route) {
           //IceGathererRouterInternalEvent(__func__, mID, "found", hash, ((bool)localCandidate) ? localCandidate->mIP : String(), ((bool)localCandidate) ? localCandidate->mPort : 0, remoteIP.string());
@@ -133,7 +133,7 @@ namespace ortc
                         x, i, Trace, IceGathererRouterInternalEvent, ol, IceGathererRouter, InternalEvent,
                         puid, id, mID,
                         string, event, "found",
-                        string, candidateHash, hash,
+                        string, candidateHash, hash.string(),
                         string, localCandidateIp, ((bool)localCandidate) ? localCandidate->mIP : String(),
                         word, localCandidatePort, ((bool)localCandidate) ? localCandidate->mPort : 0,
                         string, remoteIp, remoteIP.string()
@@ -149,7 +149,7 @@ namespace ortc
                       x, i, Trace, IceGathererRouterInternalEvent, ol, IceGathererRouter, InternalEvent,
                       puid, id, mID,
                       string, event, "gone",
-                      string, candidateHash, hash,
+                      string, candidateHash, hash.string(),
                       string, localCandidateIp, ((bool)localCandidate) ? localCandidate->mIP : String(),
                       word, localCandidatePort, ((bool)localCandidate) ? localCandidate->mPort : 0,
                       string, remoteIp, remoteIP.string()
@@ -165,7 +165,7 @@ namespace ortc
                       x, i, Trace, IceGathererRouterInternalEvent, ol, IceGathererRouter, InternalEvent,
                       puid, id, mID,
                       string, event, "not found",
-                      string, candidateHash, hash,
+                      string, candidateHash, hash.string(),
                       string, localCandidateIp, ((bool)localCandidate) ? localCandidate->mIP : String(),
                       word, localCandidatePort, ((bool)localCandidate) ? localCandidate->mPort : 0,
                       string, remoteIp, remoteIP.string()
@@ -178,26 +178,55 @@ namespace ortc
       RoutePtr route(make_shared<Route>());
       route->mLocalCandidate = localCandidate ? make_shared<Candidate>(*localCandidate) : CandidatePtr();
       route->mRemoteIP = remoteIP;
+      route->mKey = search;
 
       //IceGathererRouterInternalEvent(__func__, mID, "created", hash, ((bool)localCandidate) ? localCandidate->mIP : String(), ((bool)localCandidate) ? localCandidate->mPort : 0, remoteIP.string());
       ZS_EVENTING_6(
                     x, i, Trace, IceGathererRouterInternalEvent, ol, IceGathererRouter, InternalEvent,
                     puid, id, mID,
                     string, event, "created",
-                    string, candidateHash, hash,
+                    string, candidateHash, hash.string(),
                     string, localCandidateIp, ((bool)localCandidate) ? localCandidate->mIP : String(),
                     word, localCandidatePort, ((bool)localCandidate) ? localCandidate->mPort : 0,
                     string, remoteIp, remoteIP.string()
                     );
       route->trace(__func__, "created");
 
-      mRoutes[search] = route;
+      {
+        auto &entry = mRoutes[search];
+        entry.mRoute = route;
+        entry.mLocalCandidateHash = LocalCandidateHash(route->mLocalCandidate);
+        entry.mRemoteIP = remoteIP;
+      }
 
       ZS_LOG_DEBUG(log("route created") + route->toDebug())
 
       return route;
     }
 
+    //-------------------------------------------------------------------------
+    ICEGathererRouter::RoutePtr ICEGathererRouter::findRoute(const IPRouteKey &routeKey)
+    {
+      if (0 == routeKey.mLocalID) return RoutePtr();
+
+      AutoRecursiveLock lock(*this);
+
+      auto found = mRoutes.find(routeKey);
+      if (found == mRoutes.end()) {
+        ZS_LOG_TRACE(log("route key not found") + routeKey.toDebug())
+        return RoutePtr();
+      }
+
+      RoutePtr route = (*found).second.mRoute.lock();
+      if (!route) {
+        ZS_LOG_TRACE(log("route key found but route is gone") + routeKey.toDebug())
+        mRoutes.erase(found);
+        return RoutePtr();
+      }
+
+      return route;
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -218,10 +247,10 @@ namespace ortc
         auto current = iter_doNotUse;
         ++iter_doNotUse;
 
-        auto route = (*current).second.lock();
+        auto route = (*current).second.mRoute.lock();
 
-        auto candidateHash = ((*current).first).first;
-        auto remoteIP = ((*current).first).second;
+        const auto &candidateHash = (*current).second.mLocalCandidateHash;
+        const auto &remoteIP = (*current).second.mRemoteIP;
 
         if (route) {
           //IceGathererRouterInternalEvent(__func__, mID, "keep", candidateHash, NULL, 0, remoteIP.string());
@@ -229,13 +258,13 @@ namespace ortc
                         x, i, Trace, IceGathererRouterInternalEvent, ol, IceGathererRouter, InternalEvent,
                         puid, id, mID,
                         string, event, "keep",
-                        string, candidateHash, candidateHash,
+                        string, candidateHash, candidateHash.string(),
                         string, localCandidateIp, NULL,
                         word, localCandidatePort, 0,
                         string, remoteIp, remoteIP.string()
                         );
           route->trace(__func__, "keep");
-          ZS_LOG_TRACE(log("route still in use") + ZS_PARAM("candidate hash", candidateHash) + ZS_PARAM("remote ip", remoteIP.string()))
+          ZS_LOG_TRACE(log("route still in use") + ZS_PARAM("candidate hash", candidateHash.string()) + ZS_PARAM("remote ip", remoteIP.string()))
           continue;
         }
 
@@ -244,15 +273,32 @@ namespace ortc
                       x, i, Trace, IceGathererRouterInternalEvent, ol, IceGathererRouter, InternalEvent,
                       puid, id, mID,
                       string, event, "prune",
-                      string, candidateHash, candidateHash,
+                      string, candidateHash, candidateHash.string(),
                       string, localCandidateIp, NULL,
                       word, localCandidatePort, 0,
                       string, remoteIp, remoteIP.string()
                       );
 
-        ZS_LOG_TRACE(log("pruning route") + ZS_PARAM("candidate hash", candidateHash) + ZS_PARAM("remote ip", remoteIP.string()));
+        ZS_LOG_TRACE(log("pruning route") + ZS_PARAM("candidate hash", candidateHash.string()) + ZS_PARAM("remote ip", remoteIP.string()));
         mRoutes.erase(current);
       }
+
+      // scope: forget local candidate ids no longer used by any route
+      {
+        std::set<LocalCandidateID> inUse;
+        for (auto iter = mRoutes.begin(); iter != mRoutes.end(); ++iter) {
+          inUse.insert((*iter).first.mLocalID);
+        }
+
+        for (auto iter_doNotUse = mLocalCandidateIDs.begin(); iter_doNotUse != mLocalCandidateIDs.end(); )
+        {
+          auto current = iter_doNotUse;
+          ++iter_doNotUse;
+
+          if (inUse.end() != inUse.find((*current).second)) continue;
+          mLocalCandidateIDs.erase(current);
+        }
+      }
     }
 
     //-------------------------------------------------------------------------
@@ -293,6 +339,7 @@ namespace ortc
 
       UseServicesHelper::debugAppend(resultEl, "id", mID);
 
+      UseServicesHelper::debugAppend(resultEl, "local candidate ids", mLocalCandidateIDs.size());
       UseServicesHelper::debugAppend(resultEl, "routes", mRoutes.size());
 
       UseServicesHelper::debugAppend(resultEl, "timer", mTimer ? mTimer->getID() : 0);
@@ -312,6 +359,26 @@ namespace ortc
       }
 
       mRoutes.clear();
+      mLocalCandidateIDs.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererRouter::LocalCandidateID ICEGathererRouter::findLocalCandidateID(
+                                                                                const LocalCandidateHash &hash,
+                                                                                bool createIfNeeded
+                                                                                )
+    {
+      auto found = mLocalCandidateIDs.find(hash);
+      if (found != mLocalCandidateIDs.end()) return (*found).second;
+
+      if (!createIfNeeded) return 0;
+
+      LocalCandidateID localID = zsLib::createPUID();
+
+      // the interned key holds its own copy of the candidate (the hash passed
+      // in may only reference the caller's candidate)
+      mLocalCandidateIDs[hash.hasData() ? LocalCandidateHash(make_shared<Candidate>(*(hash.mCandidate))) : hash] = localID;
+      return localID;
     }
 
     //-------------------------------------------------------------------------
@@ -416,6 +483,7 @@ namespace ortc
       UseServicesHelper::debugAppend(objectEl, "id", mID);
       UseServicesHelper::debugAppend(objectEl, "local candidate", mLocalCandidate ? mLocalCandidate->toDebug() : ElementPtr());
       UseServicesHelper::debugAppend(objectEl, "remote ip", mRemoteIP.string());
+      UseServicesHelper::debugAppend(objectEl, "key", mKey.toDebug());
       return objectEl;
     }
 
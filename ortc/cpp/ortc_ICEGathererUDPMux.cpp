@@ -0,0 +1,703 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#include <ortc/internal/ortc_ICEGathererUDPMux.h>
+#include <ortc/internal/ortc_ORTC.h>
+#include <ortc/internal/platform.h>
+
+#include <ortc/services/IHelper.h>
+#include <ortc/services/ISettings.h>
+#include <ortc/services/ISTUNRequester.h>
+
+#include <zsLib/Singleton.h>
+#include <zsLib/XML.h>
+
+namespace ortc { ZS_DECLARE_SUBSYSTEM(ortclib_icegatherer) }
+
+namespace ortc
+{
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::IHelper, UseServicesHelper)
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::ISettings, UseSettings)
+
+  using zsLib::Log;
+
+  namespace internal
+  {
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICEGathererUDPMux::ICEGathererUDPMux(
+                                         const make_private &,
+                                         IMessageQueuePtr queue
+                                         ) :
+      SharedRecursiveLock(SharedRecursiveLock::create()),
+      MessageQueueAssociator(queue)
+    {
+      ZS_LOG_BASIC(log("created"))
+
+      mMuxPort = static_cast<WORD>(UseSettings::getUInt(ORTC_SETTING_GATHERER_UDP_MUX_PORT));
+      mRouteExpiry = Seconds(UseSettings::getUInt(ORTC_SETTING_GATHERER_UDP_MUX_ROUTE_EXPIRY_IN_SECONDS));
+      if (mRouteExpiry < Seconds(1)) mRouteExpiry = Seconds(1);
+
+      mMaxUDPReceiveBatchSize = UseSettings::getUInt(ORTC_SETTING_GATHERER_MAX_UDP_RECEIVE_BATCH_SIZE);
+      if (mMaxUDPReceiveBatchSize < 1) mMaxUDPReceiveBatchSize = 1;
+      if (mMaxUDPReceiveBatchSize > ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE) mMaxUDPReceiveBatchSize = ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE;
+
+      mUDPReceiveBufferSize = UseSettings::getUInt(ORTC_SETTING_GATHERER_UDP_RECEIVE_BUFFER_SIZE_IN_BYTES);
+      if (mUDPReceiveBufferSize < 1500) mUDPReceiveBufferSize = 1500;
+      if (mUDPReceiveBufferSize > 0xFFFF) mUDPReceiveBufferSize = 0xFFFF;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::init()
+    {
+      AutoRecursiveLock lock(*this);
+
+      mSTUNPacketParseOptions = STUNPacket::ParseOptions(STUNPacket::RFC_AllowAll, false, "ortc::ICEGathererUDPMux", mID);
+
+      Seconds sweep(mRouteExpiry / 3);
+      if (sweep < Seconds(1)) sweep = Seconds(1);
+      mTimer = Timer::create(mThisWeak.lock(), sweep);
+
+      ZS_LOG_DEBUG(debug("init"))
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererUDPMux::~ICEGathererUDPMux()
+    {
+      mThisWeak.reset();
+      ZS_LOG_BASIC(log("destroyed"))
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux => (friends)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGathererUDPMux::toDebug(ICEGathererUDPMuxPtr mux)
+    {
+      if (!mux) return ElementPtr();
+      return mux->toDebug();
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererUDPMuxPtr ICEGathererUDPMux::singleton()
+    {
+      AutoRecursiveLock lock(*UseServicesHelper::getGlobalLock());
+      static SingletonLazySharedPtr<ICEGathererUDPMux> singleton(create());
+      ICEGathererUDPMuxPtr result = singleton.singleton();
+
+      static zsLib::SingletonManager::Register registerSingleton("ortc::ICEGathererUDPMux", result);
+
+      if (!result) {
+        ZS_LOG_WARNING(Detail, slog("singleton gone"))
+      }
+
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererUDPMux::SocketPtr ICEGathererUDPMux::bind(
+                                                         UseGathererPtr gatherer,
+                                                         const String &usernameFrag,
+                                                         IPAddress &ioBindIP
+                                                         )
+    {
+      ZS_THROW_INVALID_ARGUMENT_IF(!gatherer)
+
+      AutoRecursiveLock lock(*this);
+
+      IPAddress hostIP(ioBindIP);
+      hostIP.setPort(0);
+
+      MuxSocketPtr muxSocket;
+
+      auto found = mBoundIPs.find(hostIP);
+      if (found != mBoundIPs.end()) {
+        muxSocket = (*found).second;
+        goto register_gatherer;
+      }
+
+      // scope: create the shared socket for this interface
+      {
+        SocketPtr socket;
+        IPAddress bindIP(hostIP);
+        bindIP.setPort(mMuxPort);
+
+        try {
+          socket = Socket::createUDP(bindIP.isIPv6() ? Socket::Create::IPv6 : Socket::Create::IPv4);
+          socket->bind(bindIP);
+          socket->setBlocking(false);
+
+          try {
+#ifndef __QNX__
+            socket->setOptionFlag(Socket::SetOptionFlag::IgnoreSigPipe, true);
+#endif //ndef __QNX__
+          } catch(Socket::Exceptions::UnsupportedSocketOption &) {
+          }
+
+          IPAddress local = socket->getLocalAddress();
+          WORD bindPort = local.getPort();
+          ZS_THROW_CUSTOM_PROPERTIES_1_IF(Socket::Exceptions::Unspecified, 0 == bindPort, 0)
+
+          bindIP.setPort(bindPort);
+          if (0 == mMuxPort) {
+            // every interface shares the port picked for the first one
+            mMuxPort = bindPort;
+            ZS_LOG_DEBUG(log("selected mux port") + ZS_PARAMIZE(mMuxPort))
+          }
+
+          socket->setDelegate(mThisWeak.lock());
+        } catch(Socket::Exceptions::Unspecified &error) {
+          ZS_LOG_ERROR(Detail, log("mux bind error") + ZS_PARAM("ip", bindIP.string()) + ZS_PARAM("error", error.errorCode()))
+          if (socket) {
+            try {
+              socket->close();
+            } catch(Socket::Exceptions::Unspecified &) {
+            }
+          }
+          return SocketPtr();
+        }
+
+        muxSocket = make_shared<MuxSocket>();
+        muxSocket->mBoundIP = bindIP;
+        muxSocket->mSocket = socket;
+        muxSocket->mUDPReceiveBatch = make_shared<UDPReceiveBatch>(mMaxUDPReceiveBatchSize, mUDPReceiveBufferSize);
+
+        mBoundIPs[hostIP] = muxSocket;
+        mSockets[socket] = muxSocket;
+
+        ZS_LOG_DEBUG(log("bound mux socket") + muxSocket->toDebug())
+      }
+
+    register_gatherer:
+      {
+        auto gathererID = gatherer->getID();
+        muxSocket->mGatherers[gathererID] = gatherer;
+
+        if (usernameFrag.hasData()) {
+          auto &user = mUsernameFrags[usernameFrag];
+          user.mGathererID = gathererID;
+          user.mGatherer = gatherer;
+          user.mLastUsed = zsLib::now();
+        }
+
+        ioBindIP = muxSocket->mBoundIP;
+
+        ZS_LOG_TRACE(log("gatherer attached to mux socket") + ZS_PARAM("gatherer", gathererID) + ZS_PARAM("username frag", usernameFrag) + muxSocket->toDebug())
+        return muxSocket->mSocket;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::unbind(
+                                   GathererID gathererID,
+                                   SocketPtr socket
+                                   )
+    {
+      AutoRecursiveLock lock(*this);
+
+      auto found = mSockets.find(socket);
+      if (found == mSockets.end()) {
+        ZS_LOG_WARNING(Debug, log("mux socket already gone") + ZS_PARAM("gatherer", gathererID))
+        return;
+      }
+
+      auto muxSocket = (*found).second;
+      muxSocket->mGatherers.erase(gathererID);
+
+      ZS_LOG_TRACE(log("gatherer detached from mux socket") + ZS_PARAM("gatherer", gathererID) + muxSocket->toDebug())
+
+      if (muxSocket->mGatherers.size() > 0) return;
+
+      close(muxSocket);
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::unregisterGatherer(
+                                               GathererID gathererID,
+                                               const String &usernameFrag
+                                               )
+    {
+      AutoRecursiveLock lock(*this);
+
+      {
+        auto found = mUsernameFrags.find(usernameFrag);
+        if (found != mUsernameFrags.end()) {
+          if ((*found).second.mGathererID == gathererID) {
+            mUsernameFrags.erase(found);
+          }
+        }
+      }
+
+      for (auto iter_doNotUse = mRoutes.begin(); iter_doNotUse != mRoutes.end(); ) {
+        auto current = iter_doNotUse;
+        ++iter_doNotUse;
+
+        if ((*current).second.mGathererID != gathererID) continue;
+        mRoutes.erase(current);
+      }
+
+      ZS_LOG_TRACE(log("gatherer unregistered") + ZS_PARAM("gatherer", gathererID) + ZS_PARAM("username frag", usernameFrag))
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::learnRoute(
+                                       SocketPtr socket,
+                                       const IPAddress &remoteIP,
+                                       UseGathererPtr gatherer
+                                       )
+    {
+      if (!gatherer) return;
+
+      AutoRecursiveLock lock(*this);
+
+      auto found = mSockets.find(socket);
+      if (found == mSockets.end()) return;
+
+      auto muxSocket = (*found).second;
+
+      auto &route = mRoutes[IPRouteKey(muxSocket->mID, remoteIP)];
+      route.mGathererID = gatherer->getID();
+      route.mGatherer = gatherer;
+      route.mLastUsed = zsLib::now();
+
+      ZS_LOG_INSANE(log("learned route") + ZS_PARAM("remote ip", remoteIP.string()) + ZS_PARAM("gatherer", route.mGathererID))
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux => ISingletonManagerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::notifySingletonCleanup()
+    {
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux => ISocketDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::onReadReady(SocketPtr socket)
+    {
+      MuxSocketPtr muxSocket;
+
+      {
+        AutoRecursiveLock lock(*this);
+        auto found = mSockets.find(socket);
+        if (found == mSockets.end()) {
+          ZS_LOG_WARNING(Trace, log("read ready on unknown socket"))
+          return;
+        }
+        muxSocket = (*found).second;
+      }
+
+      while (read(muxSocket)) {}
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::onWriteReady(SocketPtr socket)
+    {
+      ZS_LOG_INSANE(log("write ready (ignored)"))
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::onException(SocketPtr socket)
+    {
+      ZS_LOG_WARNING(Debug, log("mux socket exception"))
+
+      GathererList gatherers;
+
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto found = mSockets.find(socket);
+        if (found == mSockets.end()) return;
+
+        auto muxSocket = (*found).second;
+
+        for (auto iter = muxSocket->mGatherers.begin(); iter != muxSocket->mGatherers.end(); ++iter) {
+          auto gatherer = (*iter).second.lock();
+          if (!gatherer) continue;
+          gatherers.push_back(gatherer);
+        }
+
+        close(muxSocket);
+      }
+
+      // warning: do NOT notify from within the lock (gatherers call into the mux)
+      for (auto iter = gatherers.begin(); iter != gatherers.end(); ++iter) {
+        auto gatherer = (*iter);
+        ZS_LOG_DEBUG(log("notifying gatherer mux socket closed") + ZS_PARAM("gatherer", gatherer->getID()))
+        gatherer->notifyUDPMuxSocketClosed(socket);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux => ITimerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::onTimer(TimerPtr timer)
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (timer != mTimer) return;
+
+      auto expireBefore = zsLib::now() - mRouteExpiry;
+
+      size_t expired = 0;
+      for (auto iter_doNotUse = mRoutes.begin(); iter_doNotUse != mRoutes.end(); ) {
+        auto current = iter_doNotUse;
+        ++iter_doNotUse;
+
+        auto &route = (*current).second;
+        if ((route.mLastUsed >= expireBefore) &&
+            (!route.mGatherer.expired())) continue;
+
+        mRoutes.erase(current);
+        ++expired;
+      }
+
+      for (auto iter_doNotUse = mUsernameFrags.begin(); iter_doNotUse != mUsernameFrags.end(); ) {
+        auto current = iter_doNotUse;
+        ++iter_doNotUse;
+
+        if (!(*current).second.mGatherer.expired()) continue;
+        mUsernameFrags.erase(current);
+      }
+
+      if (expired > 0) {
+        ZS_LOG_TRACE(log("expired mux routes") + ZS_PARAM("expired", expired) + ZS_PARAM("remaining", mRoutes.size()))
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux => IICEGathererUDPMuxAsyncDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::onUDPMuxSocketClose(SocketPtr socket)
+    {
+      ZS_LOG_TRACE(log("closing mux socket on packet queue"))
+
+      try {
+        socket->close();
+      } catch(Socket::Exceptions::Unspecified &error) {
+        ZS_LOG_ERROR(Detail, log("failed to close mux socket") + ZS_PARAM("error", error.errorCode()))
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux => (internal)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICEGathererUDPMuxPtr ICEGathererUDPMux::create()
+    {
+      ICEGathererUDPMuxPtr pThis(make_shared<ICEGathererUDPMux>(make_private {}, IORTCForInternal::queuePacket()));
+      pThis->mThisWeak = pThis;
+      pThis->init();
+      return pThis;
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICEGathererUDPMux::log(const char *message) const
+    {
+      ElementPtr objectEl = Element::create("ortc::ICEGathererUDPMux");
+      UseServicesHelper::debugAppend(objectEl, "id", mID);
+      return Log::Params(message, objectEl);
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICEGathererUDPMux::slog(const char *message)
+    {
+      return Log::Params(message, "ortc::ICEGathererUDPMux");
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICEGathererUDPMux::debug(const char *message) const
+    {
+      return Log::Params(message, toDebug());
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGathererUDPMux::toDebug() const
+    {
+      AutoRecursiveLock lock(*this);
+
+      ElementPtr resultEl = Element::create("ortc::ICEGathererUDPMux");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "mux port", mMuxPort);
+      UseServicesHelper::debugAppend(resultEl, "route expiry", mRouteExpiry);
+
+      UseServicesHelper::debugAppend(resultEl, "max udp receive batch size", mMaxUDPReceiveBatchSize);
+      UseServicesHelper::debugAppend(resultEl, "udp receive buffer size", mUDPReceiveBufferSize);
+
+      UseServicesHelper::debugAppend(resultEl, "bound ips", mBoundIPs.size());
+      UseServicesHelper::debugAppend(resultEl, "sockets", mSockets.size());
+      UseServicesHelper::debugAppend(resultEl, "username frags", mUsernameFrags.size());
+      UseServicesHelper::debugAppend(resultEl, "routes", mRoutes.size());
+
+      UseServicesHelper::debugAppend(resultEl, "timer", mTimer ? mTimer->getID() : 0);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::cancel()
+    {
+      AutoRecursiveLock lock(*this);
+
+      ZS_LOG_DEBUG(log("cancel called"))
+
+      if (mTimer) {
+        mTimer->cancel();
+        mTimer.reset();
+      }
+
+      while (mSockets.size() > 0) {
+        close((*(mSockets.begin())).second);
+      }
+
+      mUsernameFrags.clear();
+      mRoutes.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGathererUDPMux::read(MuxSocketPtr muxSocket)
+    {
+      if (muxSocket->mClosing) return false;
+
+      auto socket = muxSocket->mSocket;
+      if (!socket) return false;
+
+      auto &batch = *(muxSocket->mUDPReceiveBatch);
+
+      bool wouldBlock = false;
+      size_t total = 0;
+
+      try {
+        total = batch.receive(*socket, wouldBlock);
+      } catch(Socket::Exceptions::Unspecified &error) {
+        ZS_LOG_ERROR(Detail, log("mux socket receive error") + ZS_PARAM("error", error.errorCode()) + muxSocket->toDebug())
+        batch.reset();
+        return false;
+      }
+
+      if (0 == total) return false;
+
+      Clock::Batch clockBatch;
+      ICEGatherer::SendBurst sendBurst;
+
+      STUNPacketPtr stunPackets[ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE];
+      UseGathererPtr gatherers[ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE];
+
+      // parsing does not need the lock (options are fixed after init)
+      for (size_t index = 0; index < total; ++index) {
+        auto &packet = batch.mPackets[index];
+        stunPackets[index] = STUNPacket::parseIfSTUN(packet.mBuffer, packet.mSize, mSTUNPacketParseOptions);
+      }
+
+      // scope: resolve each packet's gatherer under a single lock
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto tick = Clock::coarseNow();
+
+        for (size_t index = 0; index < total; ++index) {
+          auto &packet = batch.mPackets[index];
+          auto &stunPacket = stunPackets[index];
+
+          IPRouteKey key(muxSocket->mID, packet.mFromIP);
+
+          if (stunPacket) {
+            String usernameFrag = extractLocalUsernameFrag(stunPacket);
+            if (usernameFrag.hasData()) {
+              auto found = mUsernameFrags.find(usernameFrag);
+              if (found != mUsernameFrags.end()) {
+                // the owning gatherer installs the address route once the
+                // request passes its message integrity check (learnRoute)
+                gatherers[index] = (*found).second.mGatherer.lock();
+                continue;
+              }
+            }
+          }
+
+          auto found = mRoutes.find(key);
+          if (found == mRoutes.end()) continue;
+
+          auto &route = (*found).second;
+          route.mLastUsed = tick;
+          gatherers[index] = route.mGatherer.lock();
+        }
+      }
+
+      for (size_t index = 0; index < total; ++index) {
+        auto &packet = batch.mPackets[index];
+        auto &stunPacket = stunPackets[index];
+        auto &gatherer = gatherers[index];
+
+        if (gatherer) {
+          gatherer->notifyUDPMuxPacket(socket, packet.mFromIP, packet.mBuffer, packet.mSize, stunPacket);
+        } else if (stunPacket) {
+          // responses to requests sent on the shared socket carry no USERNAME
+          if (!ISTUNRequester::handleSTUNPacket(packet.mFromIP, stunPacket)) {
+            ZS_LOG_TRACE(log("no gatherer found for stun packet") + ZS_PARAM("from ip", packet.mFromIP.string()))
+          }
+        } else {
+          ZS_LOG_INSANE(log("no route found for packet (dropped)") + ZS_PARAM("from ip", packet.mFromIP.string()) + ZS_PARAM("size", packet.mSize))
+        }
+
+        gatherer.reset();
+        stunPacket.reset();
+      }
+
+      batch.reset();
+      return !wouldBlock;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererUDPMux::close(MuxSocketPtr muxSocket)
+    {
+      if (muxSocket->mClosing) return;
+      muxSocket->mClosing = true;
+
+      ZS_LOG_DEBUG(log("closing mux socket") + muxSocket->toDebug())
+
+      for (auto iter_doNotUse = mBoundIPs.begin(); iter_doNotUse != mBoundIPs.end(); ) {
+        auto current = iter_doNotUse;
+        ++iter_doNotUse;
+
+        if ((*current).second != muxSocket) continue;
+        mBoundIPs.erase(current);
+      }
+
+      for (auto iter_doNotUse = mRoutes.begin(); iter_doNotUse != mRoutes.end(); ) {
+        auto current = iter_doNotUse;
+        ++iter_doNotUse;
+
+        if ((*current).first.mLocalID != muxSocket->mID) continue;
+        mRoutes.erase(current);
+      }
+
+      if (muxSocket->mSocket) {
+        mSockets.erase(muxSocket->mSocket);
+
+        // read() may be draining the socket on the packet queue (without
+        // this lock) so the close itself is serialized onto that queue
+        auto pThis = mThisWeak.lock();
+        if (pThis) {
+          IICEGathererUDPMuxAsyncDelegateProxy::create(pThis)->onUDPMuxSocketClose(muxSocket->mSocket);
+        } else {
+          // being destroyed (thus no read can be in progress)
+          try {
+            muxSocket->mSocket->close();
+          } catch(Socket::Exceptions::Unspecified &) {
+          }
+        }
+      }
+
+      muxSocket->mGatherers.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    String ICEGathererUDPMux::extractLocalUsernameFrag(const STUNPacketPtr &stunPacket)
+    {
+      if (!stunPacket) return String();
+      if (stunPacket->mUsername.isEmpty()) return String();
+
+      auto pos = stunPacket->mUsername.find(':');
+      if (String::npos == pos) return String();
+
+      return stunPacket->mUsername.substr(0, pos);
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux::MuxSocket
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGathererUDPMux::MuxSocket::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGathererUDPMux::MuxSocket");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+      UseServicesHelper::debugAppend(resultEl, "bound ip", mBoundIP.string());
+      UseServicesHelper::debugAppend(resultEl, "socket", ((bool)mSocket));
+      UseServicesHelper::debugAppend(resultEl, "closing", mClosing.load());
+      UseServicesHelper::debugAppend(resultEl, "udp receive batch", mUDPReceiveBatch ? mUDPReceiveBatch->toDebug() : ElementPtr());
+      UseServicesHelper::debugAppend(resultEl, "gatherers", mGatherers.size());
+
+      return resultEl;
+    }
+
+  }
+}
@@ -0,0 +1,637 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#include <ortc/internal/ortc_ICEGathererWarmPool.h>
+#include <ortc/internal/ortc_ORTC.h>
+#include <ortc/internal/platform.h>
+
+#include <ortc/services/IHelper.h>
+#include <ortc/services/ISettings.h>
+
+#include <zsLib/Singleton.h>
+#include <zsLib/XML.h>
+
+namespace ortc { ZS_DECLARE_SUBSYSTEM(ortclib_icegatherer) }
+
+namespace ortc
+{
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::IHelper, UseServicesHelper)
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::ISettings, UseSettings)
+
+  using zsLib::Log;
+
+  namespace internal
+  {
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICEGathererWarmPool::ICEGathererWarmPool(
+                                             const make_private &,
+                                             IMessageQueuePtr queue
+                                             ) :
+      SharedRecursiveLock(SharedRecursiveLock::create()),
+      MessageQueueAssociator(queue)
+    {
+      ZS_LOG_BASIC(log("created"))
+
+      mSocketsPerInterface = UseSettings::getUInt(ORTC_SETTING_GATHERER_WARM_POOL_SOCKETS_PER_INTERFACE);
+      mInterfaceCacheExpiry = Seconds(UseSettings::getUInt(ORTC_SETTING_GATHERER_WARM_POOL_INTERFACE_CACHE_IN_SECONDS));
+      mReflexiveExpiry = Seconds(UseSettings::getUInt(ORTC_SETTING_GATHERER_WARM_POOL_REFLEXIVE_EXPIRY_IN_SECONDS));
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::init()
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (mReflexiveExpiry > Seconds()) {
+        Seconds sweep(mReflexiveExpiry / 3);
+        if (sweep < Seconds(1)) sweep = Seconds(1);
+        mTimer = Timer::create(mThisWeak.lock(), sweep);
+      }
+
+      ZS_LOG_DEBUG(debug("init"))
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererWarmPool::~ICEGathererWarmPool()
+    {
+      mThisWeak.reset();
+      ZS_LOG_BASIC(log("destroyed"))
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool => (friends)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGathererWarmPool::toDebug(ICEGathererWarmPoolPtr pool)
+    {
+      if (!pool) return ElementPtr();
+      return pool->toDebug();
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererWarmPoolPtr ICEGathererWarmPool::singleton()
+    {
+      AutoRecursiveLock lock(*UseServicesHelper::getGlobalLock());
+      static SingletonLazySharedPtr<ICEGathererWarmPool> singleton(create());
+      ICEGathererWarmPoolPtr result = singleton.singleton();
+
+      static zsLib::SingletonManager::Register registerSingleton("ortc::ICEGathererWarmPool", result);
+
+      if (!result) {
+        ZS_LOG_WARNING(Detail, slog("singleton gone"))
+      }
+
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGathererWarmPool::getInterfaces(HostInterfaceList &outInterfaces) const
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (mInterfaces.size() < 1) return false;
+      if (zsLib::now() > mInterfacesUpdated + mInterfaceCacheExpiry) {
+        ZS_LOG_TRACE(log("cached interfaces are stale") + ZS_PARAM("updated", mInterfacesUpdated))
+        return false;
+      }
+
+      outInterfaces = mInterfaces;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::notifyInterfaces(const HostInterfaceList &interfaces)
+    {
+      AutoRecursiveLock lock(*this);
+
+      IPAddressSet present;
+      for (auto iter = interfaces.begin(); iter != interfaces.end(); ++iter) {
+        IPAddress ip((*iter).mIP);
+        ip.setPort(0);
+        present.insert(ip);
+      }
+
+      for (auto iter_doNotUse = mWantedIPs.begin(); iter_doNotUse != mWantedIPs.end(); ) {
+        auto current = iter_doNotUse;
+        ++iter_doNotUse;
+
+        auto hostIP = (*current);
+        if (present.find(hostIP) != present.end()) continue;
+
+        ZS_LOG_DEBUG(log("interface is gone (thus dropping its pooled sockets)") + ZS_PARAM("ip", hostIP.string()))
+        closeAll(hostIP);
+        mWantedIPs.erase(current);
+      }
+
+      mInterfaces = interfaces;
+      mInterfacesUpdated = zsLib::now();
+
+      ZS_LOG_TRACE(log("interfaces updated") + ZS_PARAM("total", mInterfaces.size()))
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererWarmPool::SocketPtr ICEGathererWarmPool::takeUDPSocket(
+                                                                      IPAddress &ioBindIP,
+                                                                      ReflexiveMappingMap &outMappings
+                                                                      )
+    {
+      AutoRecursiveLock lock(*this);
+
+      IPAddress hostIP(ioBindIP);
+      hostIP.setPort(0);
+
+      if (0 == mSocketsPerInterface) return SocketPtr();
+
+      if (mWantedIPs.find(hostIP) == mWantedIPs.end()) {
+        mWantedIPs.insert(hostIP);
+        IWakeDelegateProxy::create(mThisWeak.lock())->onWake();
+      }
+
+      auto found = mPools.find(hostIP);
+      if ((found == mPools.end()) ||
+          ((*found).second.size() < 1)) {
+        ++mTotalMissed;
+        ZS_LOG_TRACE(log("no pooled socket available") + ZS_PARAM("ip", hostIP.string()))
+        return SocketPtr();
+      }
+
+      auto &pool = (*found).second;
+
+      auto expireBefore = zsLib::now() - mReflexiveExpiry;
+
+      // prefer a socket still carrying reflexive mappings
+      auto use = pool.begin();
+      for (auto iter = pool.begin(); iter != pool.end(); ++iter) {
+        auto &pooledSocket = *(*iter);
+        if (pooledSocket.mMappings.size() < 1) continue;
+        if (pooledSocket.mMappingsLearned < expireBefore) continue;
+        use = iter;
+        break;
+      }
+
+      auto pooledSocket = (*use);
+      pool.erase(use);
+      mSockets.erase(pooledSocket->mSocket);
+
+      if (pooledSocket->mMappingsLearned >= expireBefore) {
+        outMappings = pooledSocket->mMappings;
+      }
+
+      ioBindIP = pooledSocket->mBoundIP;
+      ++mTotalTaken;
+
+      ZS_LOG_DEBUG(log("handing out pooled socket") + pooledSocket->toDebug())
+
+      // replenish outside of the caller's bind path
+      IWakeDelegateProxy::create(mThisWeak.lock())->onWake();
+
+      return pooledSocket->mSocket;
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICEGathererWarmPool::returnUDPSocket(
+                                              const IPAddress &hostIP,
+                                              const IPAddress &boundIP,
+                                              SocketPtr socket,
+                                              const ReflexiveMappingMap &mappings
+                                              )
+    {
+      if (!socket) return false;
+
+      AutoRecursiveLock lock(*this);
+
+      IPAddress useHostIP(hostIP);
+      useHostIP.setPort(0);
+
+      if (mWantedIPs.find(useHostIP) == mWantedIPs.end()) {
+        ZS_LOG_TRACE(log("interface not pooled (thus socket will not be kept)") + ZS_PARAM("ip", useHostIP.string()))
+        return false;
+      }
+
+      auto &pool = mPools[useHostIP];
+      if (pool.size() >= mSocketsPerInterface) {
+        if (mappings.size() < 1) return false;
+
+        // a socket with fresh mappings is worth more than a plain one
+        PooledSocketPtr evict;
+        for (auto iter = pool.begin(); iter != pool.end(); ++iter) {
+          if ((*iter)->mMappings.size() > 0) continue;
+          evict = (*iter);
+          break;
+        }
+        if (!evict) return false;
+        close(evict);
+      }
+
+      PooledSocketPtr pooledSocket(make_shared<PooledSocket>());
+      pooledSocket->mHostIP = useHostIP;
+      pooledSocket->mBoundIP = boundIP;
+      pooledSocket->mSocket = socket;
+      pooledSocket->mMappings = mappings;
+      pooledSocket->mMappingsLearned = zsLib::now();
+
+      mPools[useHostIP].push_back(pooledSocket);
+      mSockets[socket] = pooledSocket;
+
+      socket->setDelegate(mThisWeak.lock());
+
+      // anything signalled while the socket changed hands must still be drained
+      ISocketDelegateProxy::create(mThisWeak.lock())->onReadReady(socket);
+
+      ++mTotalReturned;
+
+      ZS_LOG_DEBUG(log("socket returned to pool") + pooledSocket->toDebug())
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ICEGathererWarmPool::getTotalPooled(const IPAddress &hostIP) const
+    {
+      AutoRecursiveLock lock(*this);
+
+      IPAddress useHostIP(hostIP);
+      useHostIP.setPort(0);
+
+      auto found = mPools.find(useHostIP);
+      if (found == mPools.end()) return 0;
+      return (*found).second.size();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool => ISingletonManagerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::notifySingletonCleanup()
+    {
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool => IWakeDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::onWake()
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (!mThisWeak.lock()) return;
+
+      for (auto iter = mWantedIPs.begin(); iter != mWantedIPs.end(); ++iter) {
+        auto hostIP = (*iter);
+        auto &pool = mPools[hostIP];
+
+        while (pool.size() < mSocketsPerInterface) {
+          auto pooledSocket = bind(hostIP);
+          if (!pooledSocket) break;
+
+          pool.push_back(pooledSocket);
+          mSockets[pooledSocket->mSocket] = pooledSocket;
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool => ISocketDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::onReadReady(SocketPtr socket)
+    {
+      AutoRecursiveLock lock(*this);
+
+      auto found = mSockets.find(socket);
+      if (found == mSockets.end()) {
+        ZS_LOG_TRACE(log("read ready on socket no longer pooled"))
+        return;
+      }
+
+      // nobody owns this socket so whatever arrives is stale
+      BYTE buffer[1500];
+      size_t discarded = 0;
+
+      try {
+        while (true) {
+          IPAddress fromIP;
+          bool wouldBlock = false;
+          socket->receiveFrom(fromIP, buffer, sizeof(buffer), &wouldBlock);
+          if (wouldBlock) break;
+
+          // a zero length datagram is still a datagram (keep draining)
+          ++discarded;
+        }
+      } catch(Socket::Exceptions::Unspecified &error) {
+        ZS_LOG_WARNING(Debug, log("pooled socket receive error") + ZS_PARAM("error", error.errorCode()))
+        close((*found).second);
+        return;
+      }
+
+      if (discarded > 0) {
+        ZS_LOG_INSANE(log("discarded packets on pooled socket") + ZS_PARAM("total", discarded))
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::onWriteReady(SocketPtr socket)
+    {
+      ZS_LOG_INSANE(log("write ready (ignored)"))
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::onException(SocketPtr socket)
+    {
+      ZS_LOG_WARNING(Debug, log("pooled socket exception"))
+
+      AutoRecursiveLock lock(*this);
+
+      auto found = mSockets.find(socket);
+      if (found == mSockets.end()) return;
+
+      close((*found).second);
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool => ITimerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::onTimer(TimerPtr timer)
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (timer != mTimer) return;
+
+      auto expireBefore = zsLib::now() - mReflexiveExpiry;
+
+      size_t expired = 0;
+      for (auto iter = mSockets.begin(); iter != mSockets.end(); ++iter) {
+        auto &pooledSocket = *((*iter).second);
+        if (pooledSocket.mMappings.size() < 1) continue;
+        if (pooledSocket.mMappingsLearned >= expireBefore) continue;
+
+        pooledSocket.mMappings.clear();
+        ++expired;
+      }
+
+      if (expired > 0) {
+        ZS_LOG_TRACE(log("expired reflexive mappings") + ZS_PARAM("sockets", expired))
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool => (internal)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICEGathererWarmPoolPtr ICEGathererWarmPool::create()
+    {
+      ICEGathererWarmPoolPtr pThis(make_shared<ICEGathererWarmPool>(make_private {}, IORTCForInternal::queueORTC()));
+      pThis->mThisWeak = pThis;
+      pThis->init();
+      return pThis;
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICEGathererWarmPool::log(const char *message) const
+    {
+      ElementPtr objectEl = Element::create("ortc::ICEGathererWarmPool");
+      UseServicesHelper::debugAppend(objectEl, "id", mID);
+      return Log::Params(message, objectEl);
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICEGathererWarmPool::slog(const char *message)
+    {
+      return Log::Params(message, "ortc::ICEGathererWarmPool");
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICEGathererWarmPool::debug(const char *message) const
+    {
+      return Log::Params(message, toDebug());
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGathererWarmPool::toDebug() const
+    {
+      AutoRecursiveLock lock(*this);
+
+      ElementPtr resultEl = Element::create("ortc::ICEGathererWarmPool");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "sockets per interface", mSocketsPerInterface);
+      UseServicesHelper::debugAppend(resultEl, "interface cache expiry", mInterfaceCacheExpiry);
+      UseServicesHelper::debugAppend(resultEl, "reflexive expiry", mReflexiveExpiry);
+
+      UseServicesHelper::debugAppend(resultEl, "interfaces", mInterfaces.size());
+      UseServicesHelper::debugAppend(resultEl, "interfaces updated", mInterfacesUpdated);
+
+      UseServicesHelper::debugAppend(resultEl, "wanted ips", mWantedIPs.size());
+      UseServicesHelper::debugAppend(resultEl, "pools", mPools.size());
+      UseServicesHelper::debugAppend(resultEl, "sockets", mSockets.size());
+
+      UseServicesHelper::debugAppend(resultEl, "total taken", mTotalTaken);
+      UseServicesHelper::debugAppend(resultEl, "total missed", mTotalMissed);
+      UseServicesHelper::debugAppend(resultEl, "total returned", mTotalReturned);
+
+      UseServicesHelper::debugAppend(resultEl, "timer", mTimer ? mTimer->getID() : 0);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::cancel()
+    {
+      AutoRecursiveLock lock(*this);
+
+      ZS_LOG_DEBUG(log("cancel called"))
+
+      if (mTimer) {
+        mTimer->cancel();
+        mTimer.reset();
+      }
+
+      while (mSockets.size() > 0) {
+        close((*(mSockets.begin())).second);
+      }
+
+      mPools.clear();
+      mWantedIPs.clear();
+      mInterfaces.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    ICEGathererWarmPool::PooledSocketPtr ICEGathererWarmPool::bind(const IPAddress &hostIP)
+    {
+      SocketPtr socket;
+      IPAddress bindIP(hostIP);
+
+      try {
+        socket = Socket::createUDP(bindIP.isIPv6() ? Socket::Create::IPv6 : Socket::Create::IPv4);
+        socket->bind(bindIP);
+        socket->setBlocking(false);
+
+        try {
+#ifndef __QNX__
+          socket->setOptionFlag(Socket::SetOptionFlag::IgnoreSigPipe, true);
+#endif //ndef __QNX__
+        } catch(Socket::Exceptions::UnsupportedSocketOption &) {
+        }
+
+        IPAddress local = socket->getLocalAddress();
+        WORD bindPort = local.getPort();
+        ZS_THROW_CUSTOM_PROPERTIES_1_IF(Socket::Exceptions::Unspecified, 0 == bindPort, 0)
+
+        bindIP.setPort(bindPort);
+
+        socket->setDelegate(mThisWeak.lock());
+      } catch(Socket::Exceptions::Unspecified &error) {
+        ZS_LOG_WARNING(Detail, log("pool bind error") + ZS_PARAM("ip", bindIP.string()) + ZS_PARAM("error", error.errorCode()))
+        if (socket) {
+          try {
+            socket->close();
+          } catch(Socket::Exceptions::Unspecified &) {
+          }
+        }
+        return PooledSocketPtr();
+      }
+
+      PooledSocketPtr pooledSocket(make_shared<PooledSocket>());
+      pooledSocket->mHostIP = hostIP;
+      pooledSocket->mBoundIP = bindIP;
+      pooledSocket->mSocket = socket;
+
+      ZS_LOG_TRACE(log("pre-bound socket") + pooledSocket->toDebug())
+      return pooledSocket;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::close(PooledSocketPtr pooledSocket)
+    {
+      ZS_LOG_TRACE(log("closing pooled socket") + pooledSocket->toDebug())
+
+      auto found = mPools.find(pooledSocket->mHostIP);
+      if (found != mPools.end()) {
+        auto &pool = (*found).second;
+        for (auto iter = pool.begin(); iter != pool.end(); ++iter) {
+          if ((*iter) != pooledSocket) continue;
+          pool.erase(iter);
+          break;
+        }
+      }
+
+      if (pooledSocket->mSocket) {
+        mSockets.erase(pooledSocket->mSocket);
+        try {
+          pooledSocket->mSocket->close();
+        } catch(Socket::Exceptions::Unspecified &) {
+        }
+        pooledSocket->mSocket.reset();
+      }
+
+      pooledSocket->mMappings.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    void ICEGathererWarmPool::closeAll(const IPAddress &hostIP)
+    {
+      auto found = mPools.find(hostIP);
+      if (found == mPools.end()) return;
+
+      PooledSocketList pool = (*found).second;
+      for (auto iter = pool.begin(); iter != pool.end(); ++iter) {
+        close(*iter);
+      }
+
+      mPools.erase(hostIP);
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool::PooledSocket
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICEGathererWarmPool::PooledSocket::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICEGathererWarmPool::PooledSocket");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+      UseServicesHelper::debugAppend(resultEl, "host ip", mHostIP.string());
+      UseServicesHelper::debugAppend(resultEl, "bound ip", mBoundIP.string());
+      UseServicesHelper::debugAppend(resultEl, "socket", ((bool)mSocket));
+      UseServicesHelper::debugAppend(resultEl, "mappings", mMappings.size());
+      UseServicesHelper::debugAppend(resultEl, "mappings learned", mMappingsLearned);
+
+      return resultEl;
+    }
+
+  }
+}
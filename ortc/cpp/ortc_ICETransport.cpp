@@ -35,6 +35,7 @@
 #include <ortc/internal/ortc_ICETransportController.h>
 #include <ortc/internal/ortc_Helper.h>
 #include <ortc/internal/ortc_ORTC.h>
+#include <ortc/internal/ortc_StatsReport.h>
 #include <ortc/internal/ortc.events.h>
 #include <ortc/internal/platform.h>
 
@@ -68,6 +69,8 @@ namespace ortc
 
   namespace internal
   {
+    ZS_DECLARE_TYPEDEF_PTR(IStatsReportForInternal, UseStatsReport);
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -134,6 +137,12 @@ namespace ortc
       UseSettings::setBool(ORTC_SETTING_ICE_TRANSPORT_TEST_CANDIDATE_PAIRS_OF_LOWER_PREFERENCE, false);
 
       UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_MAX_BUFFERED_FOR_SECURE_TRANSPORT, 5);
+
+      UseSettings::setBool(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_BY_ROUND_TRIP_TIME, false);
+      UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_WARM_CANDIDATE_PAIRS, 3);
+      UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_IMPROVEMENT_PERCENTAGE, 25);
+      UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_CONSECUTIVE_SAMPLES, 3);
+      UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_HOLD_DOWN_IN_SECONDS, 10);
     }
 
     //-------------------------------------------------------------------------
@@ -192,6 +201,8 @@ namespace ortc
       mBlacklistConsent(UseSettings::getBool(ORTC_SETTING_ICE_TRANSPORT_BLACKLIST_AFTER_CONSENT_REMOVAL)),
       mKeepWarmTimeBase(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_KEEP_WARM_TIME_BASE_IN_MILLISECONDS)),
       mKeepWarmTimeRandomizedAddTime(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_KEEP_WARM_TIME_RANDOMIZED_ADD_TIME_IN_MILLISECONDS)),
+      mRenominate(UseSettings::getBool(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_BY_ROUND_TRIP_TIME)),
+      mRenomination(mID),
       mMaxBufferedPackets(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_MAX_BUFFERED_FOR_SECURE_TRANSPORT))
     {
       ZS_LOG_BASIC(debug("created"));
@@ -229,6 +240,12 @@ namespace ortc
     {
       AutoRecursiveLock lock(*this);
 
+      mTimerWheel = TimerWheel::singleton();
+      mTimerWheelDelegate = ITimerWheelDelegateProxy::createWeak(mThisWeak.lock());
+
+      mCheckPacer = ICECheckPacer::singleton();
+      mCheckPacerDelegate = IICECheckPacerDelegateProxy::createWeak(mThisWeak.lock());
+
       if (mGatherer) {
         mGatherer->installTransport(mThisWeak.lock(), String());
         mGathererSubscription = mGatherer->subscribe(mThisWeak.lock());
@@ -238,8 +255,10 @@ namespace ortc
           auto localCandidate = (*iter);
 
           CandidatePtr candidate(make_shared<Candidate>(localCandidate));
-          mLocalCandidates[candidate->hash()] = candidate;
+          mLocalCandidates[CandidateKey(candidate)] = candidate;
         }
+
+        mLocalICELite = mGatherer->isICELite();
       }
 
       wakeUp();
@@ -324,7 +343,7 @@ namespace ortc
       }
 
       PromiseWithStatsReportPtr promise = PromiseWithStatsReport::create(IORTCForInternal::queueDelegate());
-      IICETransportAsyncDelegateProxy::create(mThisWeak.lock())->onResolveStatsPromise(promise);
+      IICETransportAsyncDelegateProxy::create(mThisWeak.lock())->onResolveStatsPromise(promise, stats);
       return promise;
     }
 
@@ -535,7 +554,7 @@ namespace ortc
           auto localCandidate = (*iter);
 
           CandidatePtr candidate(make_shared<Candidate>(localCandidate));
-          mLocalCandidates[candidate->hash()] = candidate;
+          mLocalCandidates[CandidateKey(candidate)] = candidate;
         }
         mLocalCandidatesComplete = false;
         mLocalCandidatesHash.clear();
@@ -550,6 +569,26 @@ namespace ortc
         }
       }
 
+      mLocalICELite = mGatherer->isICELite();
+      if ((mLocalICELite) &&
+          (!mRemoteParameters.mICELite) &&
+          (IICETypes::Role_Controlled != mOptions.mRole)) {
+        ZS_LOG_DETAIL(log("ice lite agent must be controlled when remote is a full agent"))
+        mOptions.mRole = IICETypes::Role_Controlled;
+        mOptionsHash = mOptions.hash();
+        pruneAllCandidatePairs(true);
+      }
+      if ((!mLocalICELite) &&
+          (mRemoteParameters.mICELite) &&
+          (IICETypes::Role_Controlling != mOptions.mRole)) {
+        // RFC 8445 section 6.1.1 - the lite agent never sends checks so a
+        // role conflict would never be detected
+        ZS_LOG_DETAIL(log("full agent must be controlling when remote is an ice lite agent"))
+        mOptions.mRole = IICETypes::Role_Controlling;
+        mOptionsHash = mOptions.hash();
+        pruneAllCandidatePairs(true);
+      }
+
       wakeUp();
     }
 
@@ -632,7 +671,7 @@ namespace ortc
       {
         const Candidate *tempCandidate = dynamic_cast<const IICETypes::Candidate *>(&remoteCandidate);
         if (tempCandidate) {
-          auto hash = tempCandidate->hash();
+          CandidateKey hash(*tempCandidate);
           auto found = mRemoteCandidates.find(hash);
 
           ORTC_THROW_INVALID_PARAMETERS_IF(mComponent != tempCandidate->mComponent);
@@ -640,7 +679,7 @@ namespace ortc
           ZS_EVENTING_15(
                          x, i, Detail, IceTransportAddRemoteCandidate, ol, IceTransport, AddCandidate,
                          puid, id, mID,
-                         string, hash, hash,
+                         string, hash, hash.string(),
                          string, interfaceType, tempCandidate->mInterfaceType,
                          string, foundation, tempCandidate->mFoundation,
                          enum, component, tempCandidate->mComponent,
@@ -669,7 +708,7 @@ namespace ortc
           ZS_LOG_DEBUG(log("adding remote candidate") + tempCandidate->toDebug())
 
           CandidatePtr candidate(make_shared<Candidate>(*tempCandidate));
-          mRemoteCandidates[hash] = candidate;
+          mRemoteCandidates[CandidateKey(candidate)] = candidate;
           goto changed;
         }
 
@@ -722,7 +761,7 @@ namespace ortc
         auto tempCandidate = (*iter);
 
         CandidatePtr candidate(make_shared<Candidate>(tempCandidate));
-        auto hash = candidate->hash();
+        CandidateKey hash(candidate);
 
         ORTC_THROW_INVALID_PARAMETERS_IF(mComponent != candidate->mComponent);
 
@@ -745,7 +784,7 @@ namespace ortc
         ZS_EVENTING_15(
                        x, i, Detail, IceTransportRemoveRemoteCandidate, ol, IceTransport, RemoveCandidate,
                        puid, id, mID,
-                       string, hash, hash,
+                       string, hash, hash.string(),
                        string, interfaceType, candidate->mInterfaceType,
                        string, foundation, candidate->mFoundation,
                        enum, component, candidate->mComponent,
@@ -774,7 +813,7 @@ namespace ortc
         ZS_EVENTING_15(
                        x, i, Detail, IceTransportAddRemoteCandidate, ol, IceTransport, AddCandidate,
                        puid, id, mID,
-                       string, hash, hash,
+                       string, hash, hash.string(),
                        string, interfaceType, candidate->mInterfaceType,
                        string, foundation, candidate->mFoundation,
                        enum, component, candidate->mComponent,
@@ -821,7 +860,7 @@ namespace ortc
       {
         const Candidate *tempCandidate = dynamic_cast<const IICETypes::Candidate *>(&remoteCandidate);
         if (tempCandidate) {
-          auto hash = tempCandidate->hash();
+          CandidateKey hash(*tempCandidate);
           auto found = mRemoteCandidates.find(hash);
 
           ORTC_THROW_INVALID_PARAMETERS_IF(tempCandidate->mComponent != mComponent);
@@ -829,7 +868,7 @@ namespace ortc
           ZS_EVENTING_15(
                          x, i, Detail, IceTransportRemoveRemoteCandidate, ol, IceTransport, RemoveCandidate,
                          puid, id, mID,
-                         string, hash, hash,
+                         string, hash, hash.string(),
                          string, interfaceType, tempCandidate->mInterfaceType,
                          string, foundation, tempCandidate->mFoundation,
                          enum, component, tempCandidate->mComponent,
@@ -898,7 +937,7 @@ namespace ortc
 
       ORTC_THROW_INVALID_STATE_IF(isShuttingDown() || isShutdown())
 
-      auto hash = candidatePair.hash();
+      CandidatePairKey hash(candidatePair.mLocal, candidatePair.mRemote);
 
       auto found = mLegalRoutes.find(hash);
       if (found == mLegalRoutes.end()) {
@@ -906,11 +945,11 @@ namespace ortc
                       x, i, Detail, IceTransportKeepWarm, ol, IceTransport, Warm,
                       puid, id, mID,
                       string, reason, "not found",
-                      string, candidatePairHash, hash,
+                      string, candidatePairHash, hash.string(),
                       bool, keepWarm, keepWarm
                       );
 
-        ZS_LOG_DETAIL(log("did not find any route to keep warm") + candidatePair.toDebug() + ZS_PARAMIZE(hash))
+        ZS_LOG_DETAIL(log("did not find any route to keep warm") + candidatePair.toDebug() + ZS_PARAM("hash", hash.string()))
         return;
       }
 
@@ -921,7 +960,7 @@ namespace ortc
                       x, i, Detail, IceTransportKeepWarm, ol, IceTransport, Warm,
                       puid, id, mID,
                       string, reason, "blacklisted",
-                      string, candidatePairHash, hash,
+                      string, candidatePairHash, hash.string(),
                       bool, keepWarm, keepWarm
                       );
 
@@ -934,13 +973,13 @@ namespace ortc
                     x, i, Detail, IceTransportKeepWarm, ol, IceTransport, Warm,
                     puid, id, mID,
                     string, reason, "found",
-                    string, candidatePairHash, hash,
+                    string, candidatePairHash, hash.string(),
                     bool, keepWarm, keepWarm
                     );
 
       route->trace(__func__, "keep warm");
 
-      ZS_LOG_DETAIL(log("route found for keep warm") + route->toDebug() + ZS_PARAMIZE(keepWarm) + ZS_PARAMIZE(hash))
+      ZS_LOG_DETAIL(log("route found for keep warm") + route->toDebug() + ZS_PARAMIZE(keepWarm) + ZS_PARAM("hash", hash.string()))
 
       route->mKeepWarm = keepWarm;
 
@@ -1009,7 +1048,7 @@ namespace ortc
           return;
         }
 
-        mLastReceivedPacket = zsLib::now();
+        mLastReceivedPacket = Clock::coarseNow();
 
         if (mBlacklistConsent) {
           if (Time() != route->mLastReceivedCheck) {
@@ -1042,6 +1081,7 @@ namespace ortc
         }
 
         route->mLastReceivedCheck = mLastReceivedPacket;
+        ++(route->mTotalChecksReceived);
         if (Time() == route->mLastReceivedResponse) {
           if (route->mOutgoingCheck) {
             ZS_LOG_DEBUG(log("forcing a trigger check response immediately") + route->toDebug())
@@ -1055,10 +1095,17 @@ namespace ortc
             (route->isPending()) ||
             (route->isFailed()) ||
             (route->isIgnored())) {
-          if (mRemoteParameters.mUsernameFragment.hasData()) {
+          if (mLocalICELite) {
+            // RFC 8445 section 2.5 - a lite agent never sends checks of its
+            // own, a pair is valid once a check arrives on it
+            ZS_LOG_DETAIL(log("ice lite candidate pair is valid because of incoming request") + route->toDebug())
+            route->trace(__func__, "lite route valid (due to incoming request)");
+            setSucceeded(route);
+          } else if (mRemoteParameters.mUsernameFragment.hasData()) {
             ZS_LOG_DETAIL(log("going to activate candidate pair because of incoming request") + route->toDebug())
             route->trace(__func__, "activate route (due to incoming request)");
             setInProgress(route);
+            if (mCheckPacer) mCheckPacer->notifyCheckSent();  // triggered checks are not delayed but still count against the global rate
           } else {
             mNextActivationCausesAllRoutesThatReceivedChecksToActivate = true;
           }
@@ -1071,6 +1118,7 @@ namespace ortc
 
         ZS_LOG_TRACE(log("sending binding response to remote party") + route->toDebug() + response->toDebug())
         sendPacket(routerRoute, response);
+        ++(route->mTotalResponsesSent);
 
         if (IICETypes::Role_Controlled == mOptions.mRole) {
           if (packet->mUseCandidateIncluded) {
@@ -1139,6 +1187,26 @@ namespace ortc
 
       UseSecureTransportPtr transport;
 
+      // scope: established media on the active route is delivered without
+      // taking the lock (activity is sampled later by the slow path)
+      {
+        auto fastPath = std::atomic_load(&mFastPath);
+        if ((fastPath) &&
+            (fastPath->mDeliverDirect) &&
+            (fastPath->mRouterRouteID == routerRoute->mID)) {
+          transport = fastPath->mSecureTransport.lock();
+          if (transport) {
+            auto &route = *(fastPath->mRoute);
+            route.mFastPathLastReceivedMedia.store(Clock::coarseNow().time_since_epoch().count(), std::memory_order_relaxed);
+            ++(route.mPacketsReceived);
+            route.mBytesReceived += bufferSizeInBytes;
+            ++mPacketsReceived;
+            mBytesReceived += bufferSizeInBytes;
+            goto forward_attached_secure_transport;
+          }
+        }
+      }
+
       {
         AutoRecursiveLock lock(*this);
 
@@ -1156,8 +1224,12 @@ namespace ortc
           return;
         }
 
-        mLastReceivedPacket = zsLib::now();
+        mLastReceivedPacket = Clock::coarseNow();
         route->mLastReceivedMedia = mLastReceivedPacket;
+        ++(route->mPacketsReceived);
+        route->mBytesReceived += bufferSizeInBytes;
+        ++mPacketsReceived;
+        mBytesReceived += bufferSizeInBytes;
         updateAfterPacket(route);
 
         if (!mActiveRoute) {
@@ -1170,6 +1242,7 @@ namespace ortc
         if (!transport) {
           ZS_LOG_WARNING(Debug, log("no secure transport attached (packet is being buffered)"))
           mMustBufferPackets = true;
+          refreshFastPath();
         }
 
         if (mMustBufferPackets) {
@@ -1428,6 +1501,7 @@ namespace ortc
 
       mSecureTransportID = secureTransportID;
       mSecureTransport = transport;
+      refreshFastPath();
 
       IICETransportAsyncDelegateProxy::create(mThisWeak.lock())->onNotifyAttached(secureTransportID);
     }
@@ -1484,9 +1558,20 @@ namespace ortc
                     );
 
       UseICEGathererPtr gatherer;
+      RoutePtr route;
       RouterRoutePtr routerRoute;
 
+      // scope: send on the published active route without taking the lock
       {
+        auto fastPath = std::atomic_load(&mFastPath);
+        if (fastPath) {
+          gatherer = fastPath->mGatherer;
+          route = fastPath->mRoute;
+          routerRoute = fastPath->mRouterRoute;
+        }
+      }
+
+      if (!routerRoute) {
         AutoRecursiveLock lock(*this);
 
         if (!installGathererRoute(mActiveRoute)) {
@@ -1495,7 +1580,10 @@ namespace ortc
         }
 
         gatherer = mGatherer;
+        route = mActiveRoute;
         routerRoute = mActiveRoute->mGathererRoute;
+
+        refreshFastPath();
       }
 
       ZS_EVENTING_4(
@@ -1507,7 +1595,13 @@ namespace ortc
                     );
 
       routerRoute->trace(__func__, "gatherer to use this route to send secure packet");
-      return gatherer->sendPacket(*this, routerRoute, buffer, bufferSizeInBytes);
+      if (!gatherer->sendPacket(*this, routerRoute, buffer, bufferSizeInBytes)) return false;
+
+      ++(route->mPacketsSent);
+      route->mBytesSent += bufferSizeInBytes;
+      ++mPacketsSent;
+      mBytesSent += bufferSizeInBytes;
+      return true;
     }
 
     //-------------------------------------------------------------------------
@@ -1519,15 +1613,99 @@ namespace ortc
     #pragma mark
 
     //-------------------------------------------------------------------------
-    void ICETransport::onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise)
+    void ICETransport::onResolveStatsPromise(
+                                             IStatsProvider::PromiseWithStatsReportPtr promise,
+                                             IStatsReportTypes::StatsTypeSet stats
+                                             )
     {
-#define TODO_COMPLETE 1
-#define TODO_COMPLETE 2
-      promise->reject();
+      UseStatsReport::StatMap reportStats;
+
+      AutoRecursiveLock lock(*this);
+
+      if (isShutdown()) {
+        ZS_LOG_WARNING(Detail, log("requesting stats after shutdown"))
+        promise->reject();
+        return;
+      }
+
+      String transportID = string(mID);
+
+      if (stats.hasStatType(IStatsReportTypes::StatsType_ICETransport)) {
+        auto report = make_shared<IStatsReportTypes::ICETransportStats>();
+        report->mID = transportID;
+        report->mBytesSent = mBytesSent;
+        report->mBytesReceived = mBytesReceived;
+        if (mRTCPTransport) {
+          report->mRTCPTransportStatsID = string(mRTCPTransport->getID());
+        }
+        report->mActiveConnection = (bool)mActiveRoute;
+        if (mActiveRoute) {
+          report->mSelectedCandidatePairID = transportID + ":" + mActiveRoute->mCandidatePairHash.string();
+        }
+        reportStats[report->mID] = report;
+      }
+
+      if (stats.hasStatType(IStatsReportTypes::StatsType_LocalCandidate)) {
+        for (auto iter = mLocalCandidates.begin(); iter != mLocalCandidates.end(); ++iter) {
+          auto report = UseHelper::createCandidateStats(transportID + ":" + (*iter).first.string(), *((*iter).second));
+          report->mStatsType = IStatsReportTypes::StatsType_LocalCandidate;
+          reportStats[report->mID] = report;
+        }
+      }
+
+      if (stats.hasStatType(IStatsReportTypes::StatsType_RemoteCandidate)) {
+        for (auto iter = mRemoteCandidates.begin(); iter != mRemoteCandidates.end(); ++iter) {
+          auto report = UseHelper::createCandidateStats(transportID + ":" + (*iter).first.string(), *((*iter).second));
+          report->mStatsType = IStatsReportTypes::StatsType_RemoteCandidate;
+          reportStats[report->mID] = report;
+        }
+      }
+
+      if (stats.hasStatType(IStatsReportTypes::StatsType_CandidatePair)) {
+        bool localIsControlling = (IICETypes::Role_Controlling == mOptions.mRole);
+
+        for (auto iter = mLegalRoutes.begin(); iter != mLegalRoutes.end(); ++iter) {
+          auto route = (*iter).second;
+
+          auto report = make_shared<IStatsReportTypes::ICECandidatePairStats>();
+          report->mID = transportID + ":" + route->mCandidatePairHash.string();
+          report->mTransportID = transportID;
+          report->mLocalCandidateID = transportID + ":" + route->mCandidatePairHash.mLocal.string();
+          report->mRemoteCandidateID = transportID + ":" + route->mCandidatePairHash.mRemote.string();
+
+          switch (route->state()) {
+            case Route::State_New:
+            case Route::State_Frozen:       report->mState = IStatsReportTypes::StatsICECandidatePairState_Frozen; break;
+            case Route::State_Pending:      report->mState = IStatsReportTypes::StatsICECandidatePairState_Waiting; break;
+            case Route::State_InProgress:   report->mState = IStatsReportTypes::StatsICECandidatePairState_InProgress; break;
+            case Route::State_Succeeded:    report->mState = IStatsReportTypes::StatsICECandidatePairState_Succeeded; break;
+            case Route::State_Ignored:      report->mState = IStatsReportTypes::StatsICECandidatePairState_Cancelled; break;
+            case Route::State_Failed:
+            case Route::State_Blacklisted:  report->mState = IStatsReportTypes::StatsICECandidatePairState_Failed; break;
+          }
+
+          report->mPriority = route->getPreference(localIsControlling);
+          report->mNominated = (route == mActiveRoute);
+          report->mWritable = (Time() != route->mLastReceivedResponse);
+          report->mReadable = ((Time() != route->mLastReceivedCheck) || (Time() != route->mLastReceivedMedia) || (0 != route->mFastPathLastReceivedMedia.load()));
+          report->mBytesSent = route->mBytesSent;
+          report->mBytesReceived = route->mBytesReceived;
+          report->mRoundTripTime = static_cast<double>(route->mLastRoundTripMeasurement.count()) / 1000000.0;  // in seconds
+          report->mRequestsSent = route->mTotalChecksSent;
+          report->mRequestsReceived = route->mTotalChecksReceived;
+          report->mResponsesSent = route->mTotalResponsesSent;
+          report->mResponsesReceived = route->mTotalResponsesReceived;
+
+          reportStats[report->mID] = report;
+        }
+      }
+
+      promise->resolve(UseStatsReport::create(reportStats));
     }
 
     //-------------------------------------------------------------------------
     void ICETransport::onNotifyPacketRetried(
+                                             IPRouteKey routeKey,
                                              IICETypes::CandidatePtr localCandidate,
                                              IPAddress remoteIP,
                                              STUNPacketPtr stunPacket
@@ -1543,7 +1721,9 @@ namespace ortc
           return;
         }
 
-        routerRoute = mGathererRouter->findRoute(localCandidate, remoteIP, true);
+        // the route normally still exists so skip re-hashing the candidate
+        routerRoute = mGathererRouter->findRoute(routeKey);
+        if (!routerRoute) routerRoute = mGathererRouter->findRoute(localCandidate, remoteIP, true);
         if (!routerRoute) {
           ZS_LOG_WARNING(Detail, log("cannot handle packet as no route could be created") + localCandidate->toDebug() + ZS_PARAM("remote ip", remoteIP.string()) + stunPacket->toDebug())
           return;
@@ -1601,6 +1781,7 @@ namespace ortc
 
       mSecureTransportID = 0;
       mSecureTransport.reset();
+      refreshFastPath();
     }
 
     //-------------------------------------------------------------------------
@@ -1695,6 +1876,7 @@ namespace ortc
         }
 
         mMustBufferPackets = false;
+        refreshFastPath();
       }
     }
 
@@ -1740,6 +1922,8 @@ namespace ortc
 
       AutoRecursiveLock lock(*this);
 
+      sampleFastPathActivity();
+
       if (timer == mExpireRouteTimer) {
         ZS_EVENTING_3(
                       x, i, Trace, IceTransportInternalTimerEvent, ol, IceTransport, InternalEvent,
@@ -1768,38 +1952,115 @@ namespace ortc
                       puid, timerId, timer->getID(),
                       string, timerType, "activation timer"
                       );
-        handleActivationTimer();
+        requestPacedActivation();
         return;
       }
 
-      // scope: check keep warm timers
       {
-        auto found = mNextKeepWarmTimers.find(timer);
-        if (found == mNextKeepWarmTimers.end()) goto not_a_keep_warm_timer;
-
         ZS_EVENTING_3(
                       x, i, Trace, IceTransportInternalTimerEvent, ol, IceTransport, InternalEvent,
                       puid, id, mID,
                       puid, timerId, timer->getID(),
-                      string, timerType, "next keep warm timer"
+                      string, timerType, "obsolete timer"
                       );
 
-        RoutePtr route = (*found).second;
-        mNextKeepWarmTimers.erase(found);
-        handleNextKeepWarmTimer(route);
-        return;
+        ZS_LOG_WARNING(Trace, log("notified about an obsolete timer") + ZS_PARAM("timer id", timer->getID()));
       }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICETransport => ITimerWheelDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICETransport::onTimerWheelFired(TimerIDListPtr timers)
+    {
+      ZS_LOG_TRACE(log("timer wheel fired") + ZS_PARAM("timers", timers->size()))
+
+      AutoRecursiveLock lock(*this);
+
+      sampleFastPathActivity();
+
+      for (auto iter = timers->begin(); iter != timers->end(); ++iter) {
+        auto timerID = (*iter);
+
+        auto found = mNextKeepWarmTimers.find(timerID);
+        if (found == mNextKeepWarmTimers.end()) {
+          ZS_EVENTING_3(
+                        x, i, Trace, IceTransportInternalTimerEvent, ol, IceTransport, InternalEvent,
+                        puid, id, mID,
+                        puid, timerId, timerID,
+                        string, timerType, "obsolete timer"
+                        );
+          ZS_LOG_WARNING(Trace, log("notified about an obsolete wheel timer") + ZS_PARAM("timer id", timerID));
+          continue;
+        }
 
-    not_a_keep_warm_timer:
-      {
         ZS_EVENTING_3(
                       x, i, Trace, IceTransportInternalTimerEvent, ol, IceTransport, InternalEvent,
                       puid, id, mID,
-                      puid, timerId, timer->getID(),
-                      string, timerType, "obsolete timer"
+                      puid, timerId, timerID,
+                      string, timerType, "next keep warm timer"
                       );
 
-        ZS_LOG_WARNING(Trace, log("notified about an obsolete timer") + ZS_PARAM("timer id", timer->getID()));
+        RoutePtr route = (*found).second;
+        mNextKeepWarmTimers.erase(found);
+        requestPacedCheck(route);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICETransport => IICECheckPacerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ICETransport::onICECheckPacerGranted(RequestIDListPtr requests)
+    {
+      ZS_LOG_TRACE(log("check pacer granted") + ZS_PARAM("requests", requests->size()))
+
+      AutoRecursiveLock lock(*this);
+
+      if ((isShuttingDown()) ||
+          (isShutdown())) {
+        ZS_LOG_WARNING(Trace, log("check pacer granted slots after shutdown (thus ignoring)"))
+        return;
+      }
+
+      sampleFastPathActivity();
+
+      for (auto iter = requests->begin(); iter != requests->end(); ++iter) {
+        auto requestID = (*iter);
+
+        if (requestID == mPacedActivation) {
+          mPacedActivation = 0;
+          handleActivationTimer();
+          continue;
+        }
+
+        if (requestID == mPacedUseCandidate) {
+          mPacedUseCandidate = 0;
+          handleUseCandidate();
+          continue;
+        }
+
+        auto found = mPacedChecks.find(requestID);
+        if (found == mPacedChecks.end()) {
+          ZS_LOG_WARNING(Trace, log("check pacer granted an obsolete request") + ZS_PARAM("request id", requestID))
+          continue;
+        }
+
+        RoutePtr route = (*found).second;
+        mPacedChecks.erase(found);
+        route->mPacedCheck = 0;
+        handleNextKeepWarmTimer(route);
       }
     }
 
@@ -1918,7 +2179,7 @@ namespace ortc
 
       bool shouldRecalculate = false;
 
-      auto hash = candidate->hash();
+      CandidateKey hash(candidate);
 
       auto found = mLocalCandidates.find(hash);
       if (found != mLocalCandidates.end()) {
@@ -2019,7 +2280,7 @@ namespace ortc
         return;
       }
       
-      auto hash = candidate->hash();
+      CandidateKey hash(candidate);
 
       auto found = mLocalCandidates.find(hash);
       if (found == mLocalCandidates.end()) {
@@ -2120,6 +2381,8 @@ namespace ortc
 
           routerRoute = route->mGathererRoute;
           route->mLastSentCheck = zsLib::now();
+          ++(route->mTotalChecksSent);
+          ++(route->mCheckTransmissions);
         }
       }
 
@@ -2193,7 +2456,10 @@ namespace ortc
 
       fix(response);
 
-      mLastReceivedPacket = zsLib::now();
+      // precise arrival stamp for the round trip measurement (the shared
+      // mLastReceivedPacket may have been written with a coarse batch time)
+      Time arrival = Clock::now();
+      mLastReceivedPacket = arrival;
 
       if (STUNPacket::Class_ErrorResponse == response->mClass) {
         if (STUNPacket::ErrorCode_RoleConflict == response->mErrorCode) {
@@ -2231,14 +2497,16 @@ namespace ortc
         return true;
       }
 
-      route->mLastReceivedResponse = zsLib::now();
+      route->mLastReceivedResponse = arrival;
+      ++(route->mTotalResponsesReceived);
 
       if (route->mOutgoingCheck) {
         if (requester == route->mOutgoingCheck) {
           if (IICETypes::Role_Controlling == mOptions.mRole) {
             auto previousValue = route->mLastRoundTripMeasurement;
 
-            route->mLastRoundTripMeasurement = zsLib::toMicroseconds(getLatest(mLastReceivedPacket, route->mLastRoundTripCheck) - route->mLastRoundTripCheck);
+            route->mLastRoundTripMeasurement = zsLib::toMicroseconds(getLatest(arrival, route->mLastRoundTripCheck) - route->mLastRoundTripCheck);
+            updateRoundTrip(route);
             ZS_LOG_TRACE(log("updated route round trip time") + route->toDebug())
 
             if (Microseconds() != previousValue) {
@@ -2248,6 +2516,10 @@ namespace ortc
                 ZS_LOG_TRACE(log("magnitude difference in route measurement (pick route again)") + ZS_PARAM("previous", previousValue) + route->toDebug())
                 mForcePickRouteAgain = true;
                 wakeUp();
+              } else if (mRenominate) {
+                ZS_LOG_TRACE(log("new route measurement (re-evaluate renomination)") + route->toDebug())
+                mForcePickRouteAgain = true;
+                wakeUp();
               }
             } else {
               ZS_LOG_TRACE(log("first time a round trip measurement has happened (pick route again)") + route->toDebug())
@@ -2273,10 +2545,18 @@ namespace ortc
         }
       }
 
+      // when renominating only the fastest few routes keep running consent checks
+      if ((keptWarm) &&
+          (mRenominate) &&
+          (mActiveRoute != route) &&
+          (!route->mKeepWarm) &&
+          (Microseconds() != route->mSmoothedRoundTrip)) {
+        keptWarm = isRenominationWarmRoute(route);
+      }
+
       if ((keptWarm) &&
           (!route->mNextKeepWarm)) {
-        route->mNextKeepWarm = Timer::create(mThisWeak.lock(), zsLib::now() + mKeepWarmTimeBase + Milliseconds(UseServicesHelper::random(0, static_cast<size_t>(mKeepWarmTimeRandomizedAddTime.count()))));
-        mNextKeepWarmTimers[route->mNextKeepWarm] = route;
+        installKeepWarmTimer(route, zsLib::now() + mKeepWarmTimeBase + Milliseconds(UseServicesHelper::random(0, static_cast<size_t>(mKeepWarmTimeRandomizedAddTime.count()))));
 
         ZS_LOG_TRACE(log("installed keep warm timer") + route->toDebug())
       }
@@ -2384,6 +2664,7 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "force pick route again", mForcePickRouteAgain);
 
       UseServicesHelper::debugAppend(resultEl, "options hash", mOptionsHash);
+      UseServicesHelper::debugAppend(resultEl, "local ice lite", mLocalICELite);
       UseServicesHelper::debugAppend(resultEl, "options", mOptions.toDebug());
       UseServicesHelper::debugAppend(resultEl, "conflict resolver", mConflictResolver);
 
@@ -2404,6 +2685,9 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, mRouteStateTracker->toDebug());
 
       UseServicesHelper::debugAppend(resultEl, "activation timer", mActivationTimer ? mActivationTimer->getID() : 0);
+      UseServicesHelper::debugAppend(resultEl, "paced activation", mPacedActivation);
+      UseServicesHelper::debugAppend(resultEl, "paced use candidate", mPacedUseCandidate);
+      UseServicesHelper::debugAppend(resultEl, "paced checks", mPacedChecks.size());
       UseServicesHelper::debugAppend(resultEl, "activate routes that received checks", mNextActivationCausesAllRoutesThatReceivedChecksToActivate);
 
       UseServicesHelper::debugAppend(resultEl, "pending activation", mPendingActivation.size());
@@ -2411,6 +2695,7 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "frozen", mFrozen.size());
 
       UseServicesHelper::debugAppend(resultEl, "active route", mActiveRoute ? mActiveRoute->toDebug() : ElementPtr());
+      UseServicesHelper::debugAppend(resultEl, "fast path", (bool)std::atomic_load(&mFastPath));
 
       UseServicesHelper::debugAppend(resultEl, "warm routes", mWarmRoutes.size());
 
@@ -2434,6 +2719,9 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "keep warm time base", mKeepWarmTimeBase);
       UseServicesHelper::debugAppend(resultEl, "keep warm randomized add time", mKeepWarmTimeRandomizedAddTime);
 
+      UseServicesHelper::debugAppend(resultEl, "renominate", mRenominate);
+      UseServicesHelper::debugAppend(resultEl, "renomination", mRenomination.toDebug());
+
       UseServicesHelper::debugAppend(resultEl, "secure transport id", mSecureTransportID);
       UseServicesHelper::debugAppend(resultEl, "secure transport", (bool)(mSecureTransport.lock()));
       UseServicesHelper::debugAppend(resultEl, "secure transport (old)", (bool)(mSecureTransportOld.lock()));
@@ -2444,6 +2732,11 @@ namespace ortc
 
       UseServicesHelper::debugAppend(resultEl, "received username on ICE response packet", mSTUNPacketOptions.mBindResponseRequiresUsernameAttribute);
 
+      UseServicesHelper::debugAppend(resultEl, "packets sent", mPacketsSent.load());
+      UseServicesHelper::debugAppend(resultEl, "bytes sent", mBytesSent.load());
+      UseServicesHelper::debugAppend(resultEl, "packets received", mPacketsReceived.load());
+      UseServicesHelper::debugAppend(resultEl, "bytes received", mBytesReceived.load());
+
       return resultEl;
     }
 
@@ -2481,6 +2774,8 @@ namespace ortc
 
       ZS_EVENTING_1(x, i, Debug, IceTransportStep, ol, IceTransport, Step, puid, id, mID);
 
+      sampleFastPathActivity();
+
       if (!stepCalculateLegalPairs()) goto done;
       if (!stepPendingActivation()) goto done;
       if (!stepActivationTimer()) goto done;
@@ -2492,6 +2787,8 @@ namespace ortc
 
     done:
       {
+        refreshFastPath();
+
         if (!stepSetCurrentState()) return;
         if (!stepSetNeedsMoreCandidates()) return;
       }
@@ -2500,7 +2797,7 @@ namespace ortc
     //-------------------------------------------------------------------------
     bool ICETransport::stepCalculateLegalPairs()
     {
-      typedef std::map<Hash, CandidatePairPtr> CandidatePairMap;
+      typedef std::unordered_map<CandidatePairKey, CandidatePairPtr, CandidatePairKey::Hasher> CandidatePairMap;
 
       ZS_EVENTING_1(x, i, Debug, IceTransportStep, ol, IceTransport, Step, puid, id, mID);
 
@@ -2542,7 +2839,7 @@ namespace ortc
           candidatePair->mLocal = localCandidate;
           candidatePair->mRemote = remoteCandidate;
 
-          auto hash = candidatePair->hash();
+          CandidatePairKey hash(localCandidate, remoteCandidate);
 
           pairings[hash] = candidatePair;
         }
@@ -2570,7 +2867,7 @@ namespace ortc
       check_remote_reflexive:
         {
           // make sure local is still valid first
-          auto localCandidateHash = route->mCandidatePair->mLocal->hash();
+          CandidateKey localCandidateHash(*(route->mCandidatePair->mLocal));
           auto foundLocal = mLocalCandidates.find(localCandidateHash);
 
           if (foundLocal == mLocalCandidates.end()) {
@@ -2628,16 +2925,14 @@ namespace ortc
         installFoundation(route);
       }
 
-      SHA1Hasher hasher;
+      // order independent combination (the legal routes are not sorted)
+      ULONGLONG computedHash = 0;
 
       for (auto iter = mLegalRoutes.begin(); iter != mLegalRoutes.end(); ++iter) {
-        auto hash = (*iter).first;
-
-        hasher.update(hash);
-        hasher.update(":");
+        computedHash += (*iter).first.mHash;
       }
 
-      mComputedPairsHash = hasher.final();
+      mComputedPairsHash = string(computedHash) + ":" + string(mLegalRoutes.size());
       return true;
     }
 
@@ -2646,6 +2941,11 @@ namespace ortc
     {
       ZS_EVENTING_1(x, i, Debug, IceTransportStep, ol, IceTransport, Step, puid, id, mID);
 
+      if (mLocalICELite) {
+        ZS_LOG_TRACE(log("ice lite does not activate candidate pairs"))
+        return true;
+      }
+
       if (0 == mRouteStateTracker->count(Route::State_New)) {
         ZS_LOG_TRACE(log("no routes pending activation"))
         return true;
@@ -2660,7 +2960,6 @@ namespace ortc
 
       for (auto iter = mLegalRoutes.begin(); iter != mLegalRoutes.end(); ++iter)
       {
-        auto hash = (*iter).first;
         auto route = (*iter).second;
 
         if (route->state() != Route::State_New) continue;
@@ -2689,6 +2988,11 @@ namespace ortc
 
       auto now = zsLib::now();
 
+      if (mLocalICELite) {
+        ZS_LOG_TRACE(log("ice lite does not send connectivity checks"))
+        goto no_activation_timer;
+      }
+
       if (mRemoteParameters.mUsernameFragment.isEmpty()) {
         ZS_LOG_TRACE(log("cannot activate any candidates as remote username is not set"))
         goto no_activation_timer;
@@ -2726,6 +3030,10 @@ namespace ortc
           mActivationTimer->cancel();
           mActivationTimer.reset();
         }
+        if (0 != mPacedActivation) {
+          if (mCheckPacer) mCheckPacer->cancel(mPacedActivation);
+          mPacedActivation = 0;
+        }
         return true;
       }
 
@@ -2762,6 +3070,22 @@ namespace ortc
 
       mForcePickRouteAgain = false;
 
+      if ((mRenominate) &&
+          (mActiveRoute) &&
+          (mRenomination.isActiveRouteLive(getLastRemoteActivity(mActiveRoute), zsLib::now()))) {
+        // once a route is active it is only replaced by a route that is
+        // consistently faster (rather than by ICE priority); a silent active
+        // route falls through to the normal pick so inactivity failover works
+        const char *renominateReason = NULL;
+        auto route = pickRenominationRoute(renominateReason);
+        if (!route) {
+          ZS_LOG_TRACE(log("no renomination of active route") + mActiveRoute->toDebug())
+          return true;
+        }
+        setActive(route, renominateReason);
+        return true;
+      }
+
       auto now = zsLib::now();
 
       QWORD chosenPreference = 0;
@@ -2823,16 +3147,7 @@ namespace ortc
           return true;
         }
 
-        mActiveRoute = chosenRoute;
-        ZS_EVENTING_2(
-                      x, i, Debug, IceTransportCandidatePairChangedEvent, ol, IceTransport, Event,
-                      puid, id, mID,
-                      puid, activeRouteId, mActiveRoute->mID
-                      );
-
-        mActiveRoute->trace(__func__, reason);
-        ZS_LOG_DETAIL(log("new route chosen") + mActiveRoute->toDebug())
-        mSubscriptions.delegate()->onICETransportCandidatePairChanged(mThisWeak.lock(), cloneCandidatePair(mActiveRoute));
+        setActive(chosenRoute, reason);
       } else {
         ZS_LOG_TRACE(log("no change in preferred route"))
       }
@@ -2891,7 +3206,12 @@ namespace ortc
       mUseCandidateRoute = mActiveRoute;
       mUseCandidateRoute->trace(__func__, "nominate candidate");
 
-      mUseCandidateRequest = createBindRequest(mUseCandidateRoute, true);
+      removePacedUseCandidate();
+      if (!mCheckPacer) {
+        handleUseCandidate();
+        return true;
+      }
+      mPacedUseCandidate = mCheckPacer->request(mID, mCheckPacerDelegate, ICECheckPacer::Priority_High);
 
       return true;
     }
@@ -2951,6 +3271,11 @@ namespace ortc
     {
       ZS_EVENTING_1(x, i, Debug, IceTransportStep, ol, IceTransport, Step, puid, id, mID);
 
+      if (mLocalICELite) {
+        ZS_LOG_TRACE(log("ice lite relies on the remote party to keep routes warm"))
+        return true;
+      }
+
       if (mRemoteParameters.mUsernameFragment.isEmpty()) {
         ZS_LOG_TRACE(log("cannot warm routes as remote username is not set"))
         return true;
@@ -2961,6 +3286,13 @@ namespace ortc
         return true;
       }
 
+      if (mRenominate) {
+        // computed once per pass rather than once per route
+        RoundTripRouteMap routes;
+        getRenominationRoutes(routes);
+        mRenomination.updateWarmRoutes(routes);
+      }
+
       for (auto iter_doNotUse = mWarmRoutes.begin(); iter_doNotUse != mWarmRoutes.end();)
       {
         auto current = iter_doNotUse;
@@ -2972,6 +3304,7 @@ namespace ortc
         if (route->mKeepWarm) goto must_keep_warm;
         if (route == mActiveRoute) goto must_keep_warm;
         if (Microseconds() == route->mLastRoundTripMeasurement) goto must_keep_warm;  // need a round trip time measurement to happen
+        if ((mRenominate) && (isRenominationWarmRoute(route))) goto must_keep_warm;
 
         goto do_not_keep_warm;
 
@@ -2992,8 +3325,7 @@ namespace ortc
 
           ZS_LOG_DEBUG(log("installing keep warm timer") + route->toDebug())
 
-          route->mNextKeepWarm = Timer::create(mThisWeak.lock(), zsLib::now() + mKeepWarmTimeBase + Milliseconds(UseServicesHelper::random(0, static_cast<size_t>(mKeepWarmTimeRandomizedAddTime.count()))));
-          mNextKeepWarmTimers[route->mNextKeepWarm] = route;
+          installKeepWarmTimer(route, zsLib::now() + mKeepWarmTimeBase + Milliseconds(UseServicesHelper::random(0, static_cast<size_t>(mKeepWarmTimeRandomizedAddTime.count()))));
           continue;
         }
       do_not_keep_warm:
@@ -3278,19 +3610,26 @@ namespace ortc
       }
 
       mActiveRoute.reset();
+      std::atomic_store(&mFastPath, FastPathPtr());
 
       mWarmRoutes.clear();
 
       mGathererRoutes.clear();
 
       mOutgoingChecks.clear();
-      mNextKeepWarmTimers.clear();
+      clearKeepWarmTimers();
 
       mUseCandidateRoute.reset();
       if (mUseCandidateRequest) {
         mUseCandidateRequest->cancel();
         mUseCandidateRequest.reset();
       }
+      removePacedUseCandidate();
+
+      if (mCheckPacer) {
+        mCheckPacer->cancel(mPacedActivation);
+        mPacedActivation = 0;
+      }
 
       if (mLastReceivedPacketTimer) {
         mLastReceivedPacketTimer->cancel();
@@ -3406,6 +3745,7 @@ namespace ortc
             }
 
             mActiveRoute.reset();
+            refreshFastPath();
             expired = true;
           }
         }
@@ -3701,8 +4041,8 @@ namespace ortc
     void ICETransport::handleNextKeepWarmTimer(RoutePtr route)
     {
       if (route->mNextKeepWarm) {
-        route->mNextKeepWarm->cancel();
-        route->mNextKeepWarm.reset();
+        if (mTimerWheel) mTimerWheel->cancel(route->mNextKeepWarm);
+        route->mNextKeepWarm = 0;
       }
 
       if (route->mOutgoingCheck) {
@@ -3723,23 +4063,58 @@ namespace ortc
       ZS_LOG_INSANE(log("installed outgoing stun binding keep alive") + route->toDebug())
     }
 
+    //-----------------------------------------------------------------------
+    void ICETransport::handleUseCandidate()
+    {
+      if (!mUseCandidateRoute) {
+        ZS_LOG_TRACE(log("nominated route is gone (thus no use candidate request to send)"))
+        return;
+      }
+
+      if (mUseCandidateRequest) {
+        ZS_LOG_DEBUG(log("removing previous use candidate"))
+        mUseCandidateRequest->cancel();
+        mUseCandidateRequest.reset();
+      }
+
+      mUseCandidateRequest = createBindRequest(mUseCandidateRoute, true);
+    }
+
     //-----------------------------------------------------------------------
     void ICETransport::forceActive(RoutePtr route)
     {
       if (!route) return;
       if (route->mPrune) return;
+      if (mLocalICELite) return;
 
       if (route->mNextKeepWarm) return;
 
       route->trace(__func__, "forced active");
 
       // install a temporary keep warm timer (to force route activate sooner)
-      route->mNextKeepWarm = Timer::create(mThisWeak.lock(), zsLib::now() + Milliseconds(UseServicesHelper::random(0, static_cast<size_t>(mKeepWarmTimeRandomizedAddTime.count()))));
-      mNextKeepWarmTimers[route->mNextKeepWarm] = route;
+      installKeepWarmTimer(route, zsLib::now() + Milliseconds(UseServicesHelper::random(0, static_cast<size_t>(mKeepWarmTimeRandomizedAddTime.count()))));
 
       ZS_LOG_TRACE(log("forcing route to generate activity") + route->toDebug())
     }
 
+    //-----------------------------------------------------------------------
+    void ICETransport::setActive(
+                                 RoutePtr route,
+                                 const char *reason
+                                 )
+    {
+      mActiveRoute = route;
+      ZS_EVENTING_2(
+                    x, i, Debug, IceTransportCandidatePairChangedEvent, ol, IceTransport, Event,
+                    puid, id, mID,
+                    puid, activeRouteId, mActiveRoute->mID
+                    );
+
+      mActiveRoute->trace(__func__, reason);
+      ZS_LOG_DETAIL(log("new route chosen") + ZS_PARAM("reason", reason) + mActiveRoute->toDebug())
+      mSubscriptions.delegate()->onICETransportCandidatePairChanged(mThisWeak.lock(), cloneCandidatePair(mActiveRoute));
+    }
+
     //-----------------------------------------------------------------------
     void ICETransport::shutdown(RoutePtr route)
     {
@@ -3780,7 +4155,7 @@ namespace ortc
       mFrozen.clear();
       mGathererRoutes.clear();
       mOutgoingChecks.clear();
-      mNextKeepWarmTimers.clear();
+      clearKeepWarmTimers();
 
       mLastReceivedUseCandidate = Time();
       mLastReceivedPacket = Time();
@@ -3813,6 +4188,8 @@ namespace ortc
         // reactivate this killed route
         mActiveRoute = currentRoute;
       }
+
+      refreshFastPath();
     }
 
     //-------------------------------------------------------------------------
@@ -4159,6 +4536,7 @@ namespace ortc
         route->mKeepWarm = false;
 
         route->state(Route::State_Blacklisted);
+        if (route == mActiveRoute) refreshFastPath();
         wakeUp();
       }
     }
@@ -4253,6 +4631,7 @@ namespace ortc
 
         mSubscriptions.delegate()->onICETransportCandidatePairChanged(mThisWeak.lock(), cloneCandidatePair(mActiveRoute));
 
+        refreshFastPath();
         wakeUp();
       }
 
@@ -4270,6 +4649,84 @@ namespace ortc
       }
     }
 
+    //-------------------------------------------------------------------------
+    void ICETransport::refreshFastPath()
+    {
+      FastPathPtr current = std::atomic_load(&mFastPath);
+      if (current) {
+        // do not lose activity stamped on the previously published route
+        // (sampling can change the active route so reload afterwards)
+        sampleFastPathActivity(current->mRoute);
+        current = std::atomic_load(&mFastPath);
+      }
+
+      FastPathPtr fastPath;
+
+      if ((mActiveRoute) &&
+          (!mActiveRoute->isBlacklisted()) &&
+          (mActiveRoute->mGathererRoute) &&
+          (mGatherer) &&
+          (!isShutdown())) {
+
+        auto transport = mSecureTransport.lock();
+        bool deliverDirect = ((!mMustBufferPackets) && ((bool)transport));
+
+        if ((current) &&
+            (current->mRoute == mActiveRoute) &&
+            (current->mRouterRoute == mActiveRoute->mGathererRoute) &&
+            (current->mGatherer == mGatherer) &&
+            (current->mDeliverDirect == deliverDirect) &&
+            (current->mSecureTransportID == mSecureTransportID)) {
+          return;
+        }
+
+        fastPath = make_shared<FastPath>();
+        fastPath->mRoute = mActiveRoute;
+        fastPath->mRouterRoute = mActiveRoute->mGathererRoute;
+        fastPath->mRouterRouteID = mActiveRoute->mGathererRoute->mID;
+        fastPath->mGatherer = mGatherer;
+        fastPath->mDeliverDirect = deliverDirect;
+        fastPath->mSecureTransport = transport;
+        fastPath->mSecureTransportID = mSecureTransportID;
+      }
+
+      if ((!current) && (!fastPath)) return;
+
+      ZS_LOG_TRACE(log("publishing media fast path") + ZS_PARAM("route", fastPath ? fastPath->mRoute->mID : 0) + ZS_PARAM("deliver direct", fastPath ? fastPath->mDeliverDirect : false))
+      std::atomic_store(&mFastPath, fastPath);
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::sampleFastPathActivity()
+    {
+      auto fastPath = std::atomic_load(&mFastPath);
+      if (fastPath) {
+        sampleFastPathActivity(fastPath->mRoute);
+      }
+      if ((mActiveRoute) &&
+          ((!fastPath) || (fastPath->mRoute != mActiveRoute))) {
+        sampleFastPathActivity(mActiveRoute);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::sampleFastPathActivity(RoutePtr route)
+    {
+      if (!route) return;
+
+      auto stamp = route->mFastPathLastReceivedMedia.exchange(0, std::memory_order_relaxed);
+      if (0 == stamp) return;
+
+      Time received = Time(Time::duration(stamp));
+      if (received > route->mLastReceivedMedia) route->mLastReceivedMedia = received;
+      if (received > mLastReceivedPacket) mLastReceivedPacket = received;
+
+      if (route->isBlacklisted()) return;
+
+      // consent / route selection handling that the fast path skipped
+      updateAfterPacket(route);
+    }
+
     //-------------------------------------------------------------------------
     bool ICETransport::installGathererRoute(RoutePtr route)
     {
@@ -4422,6 +4879,7 @@ namespace ortc
     {
       if (route == mActiveRoute) {
         mActiveRoute.reset();
+        refreshFastPath();
         wakeUp();
       }
       if (route == mUseCandidateRoute) {
@@ -4429,6 +4887,7 @@ namespace ortc
           mUseCandidateRequest->cancel();
           mUseCandidateRequest.reset();
         }
+        removePacedUseCandidate();
         mUseCandidateRoute.reset();
         wakeUp();
       }
@@ -4458,6 +4917,7 @@ namespace ortc
       route->mOutgoingCheck.reset();
 
       route->mLastRoundTripCheck = Time();
+      route->mCheckTransmissions = 0;
     }
 
     //-------------------------------------------------------------------------
@@ -4475,11 +4935,32 @@ namespace ortc
 
       route->trace(__func__, "removing fatherer route");
       route->mGathererRoute.reset();
+
+      if (route == mActiveRoute) refreshFastPath();
     }
     
+    //-------------------------------------------------------------------------
+    void ICETransport::installKeepWarmTimer(
+                                            RoutePtr route,
+                                            Time fireAt
+                                            )
+    {
+      if (mLocalICELite) return;
+
+      if (!mTimerWheel) {
+        ZS_LOG_WARNING(Debug, log("timer wheel is gone (thus cannot install keep warm timer)") + route->toDebug())
+        return;
+      }
+
+      route->mNextKeepWarm = mTimerWheel->arm(mTimerWheelDelegate, fireAt);
+      mNextKeepWarmTimers[route->mNextKeepWarm] = route;
+    }
+
     //-------------------------------------------------------------------------
     void ICETransport::removeKeepWarmTimer(RoutePtr route)
     {
+      removePacedCheck(route);
+
       if (!route->mNextKeepWarm) return;
 
       auto found = mNextKeepWarmTimers.find(route->mNextKeepWarm);
@@ -4488,8 +4969,82 @@ namespace ortc
         mNextKeepWarmTimers.erase(found);
       }
 
-      route->mNextKeepWarm->cancel();
-      route->mNextKeepWarm.reset();
+      if (mTimerWheel) mTimerWheel->cancel(route->mNextKeepWarm);
+      route->mNextKeepWarm = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::clearKeepWarmTimers()
+    {
+      for (auto iter = mNextKeepWarmTimers.begin(); iter != mNextKeepWarmTimers.end(); ++iter) {
+        auto route = (*iter).second;
+        if (mTimerWheel) mTimerWheel->cancel((*iter).first);
+        route->mNextKeepWarm = 0;
+      }
+      mNextKeepWarmTimers.clear();
+
+      for (auto iter = mPacedChecks.begin(); iter != mPacedChecks.end(); ++iter) {
+        auto route = (*iter).second;
+        if (mCheckPacer) mCheckPacer->cancel((*iter).first);
+        route->mPacedCheck = 0;
+        route->mNextKeepWarm = 0;
+      }
+      mPacedChecks.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::requestPacedActivation()
+    {
+      if (0 != mPacedActivation) {
+        ZS_LOG_TRACE(log("activation is already waiting on the check pacer"))
+        return;
+      }
+
+      if (!mCheckPacer) {
+        handleActivationTimer();
+        return;
+      }
+
+      mPacedActivation = mCheckPacer->request(mID, mCheckPacerDelegate);
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::requestPacedCheck(RoutePtr route)
+    {
+      if (0 != route->mPacedCheck) return;
+
+      // keep warm / consent checks on succeeded routes are already spread by
+      // their randomized timers; pacing them would cap how many routes the
+      // process can keep alive at the global check rate
+      if ((!mCheckPacer) ||
+          (route->isSucceeded())) {
+        handleNextKeepWarmTimer(route);
+        return;
+      }
+
+      // route->mNextKeepWarm stays set while waiting so the route is still
+      // seen as having a keep warm check scheduled
+      route->mPacedCheck = mCheckPacer->request(mID, mCheckPacerDelegate);
+      mPacedChecks[route->mPacedCheck] = route;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::removePacedCheck(RoutePtr route)
+    {
+      if (0 == route->mPacedCheck) return;
+
+      mPacedChecks.erase(route->mPacedCheck);
+      if (mCheckPacer) mCheckPacer->cancel(route->mPacedCheck);
+      route->mPacedCheck = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::removePacedUseCandidate()
+    {
+      if (0 == mPacedUseCandidate) return;
+
+      if (mCheckPacer) mCheckPacer->cancel(mPacedUseCandidate);
+      mPacedUseCandidate = 0;
     }
 
     //-------------------------------------------------------------------------
@@ -4515,13 +5070,10 @@ namespace ortc
     {
       if (!localCandidate) return RoutePtr();
 
-      auto hash = localCandidate->hash();
-
       for (auto iter = mLegalRoutes.begin(); iter != mLegalRoutes.end(); ++iter) {
         auto route = (*iter).second;
 
-        auto localCandidateHash = route->mCandidatePair->mLocal->hash();
-        if (localCandidateHash != hash) continue;
+        if (!CandidateKey::isEqual(*(route->mCandidatePair->mLocal), *localCandidate)) continue;
 
         auto remoteIP = route->mCandidatePair->mRemote->ip();
 
@@ -4539,16 +5091,12 @@ namespace ortc
     {
       if (!localCandidate) return RoutePtr();
 
-      String hash = localCandidate->hash();
-
       RoutePtr closeEnoughRoute;
 
       for (auto iter = mLegalRoutes.begin(); iter != mLegalRoutes.end(); ++iter) {
         auto route = (*iter).second;
 
-        String localCandidateHash = route->mCandidatePair->mLocal->hash(false);
-
-        if (localCandidateHash != hash) continue;
+        if (!CandidateKey::isEqual(*(route->mCandidatePair->mLocal), *localCandidate, false)) continue;
 
         ZS_LOG_INSANE(log("found local candidate match (but not remote yet)") + route->toDebug())
 
@@ -4580,6 +5128,65 @@ namespace ortc
       return getLatest(lastest, route->mLastReceivedResponse);
     }
 
+    //-------------------------------------------------------------------------
+    void ICETransport::updateRoundTrip(RoutePtr route)
+    {
+      // a check that needed retransmissions counts as partially lost
+      size_t transmissions = (route->mCheckTransmissions > 0 ? route->mCheckTransmissions : 1);
+      double lossSample = static_cast<double>(transmissions - 1) / static_cast<double>(transmissions);
+      route->mSmoothedLoss += (lossSample - route->mSmoothedLoss) / 8.0;
+      route->mCheckTransmissions = 0;
+
+      ++(route->mRoundTripSamples);
+
+      if (Microseconds() == route->mSmoothedRoundTrip) {
+        route->mSmoothedRoundTrip = route->mLastRoundTripMeasurement;
+        return;
+      }
+
+      route->mSmoothedRoundTrip = Microseconds(((route->mSmoothedRoundTrip.count() * 7) + route->mLastRoundTripMeasurement.count()) / 8);
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::getRenominationRoutes(RoundTripRouteMap &outRoutes) const
+    {
+      auto now = zsLib::now();
+
+      for (auto iter = mWarmRoutes.begin(); iter != mWarmRoutes.end(); ++iter) {
+        auto route = (*iter).second;
+
+        if (route->mPrune) continue;
+        if (!route->isSucceeded()) continue;
+
+        auto roundTrip = route->getEffectiveRoundTrip();
+        if (Microseconds() == roundTrip) continue;
+
+        auto lastRemoteActivity = getLastRemoteActivity(route);
+        if (Time() == lastRemoteActivity) continue;
+        if (lastRemoteActivity + mNoPacketsReceivedRecheckTime + mNoPacketsReceivedRecheckTime < now) continue;
+
+        outRoutes.insert(RoundTripRouteMap::value_type(roundTrip, route));
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICETransport::isRenominationWarmRoute(RoutePtr route) const
+    {
+      // uses the set computed on the last keep warm / pick route pass
+      return mRenomination.isWarmRoute(route);
+    }
+
+    //-------------------------------------------------------------------------
+    ICETransport::RoutePtr ICETransport::pickRenominationRoute(const char * &outReason)
+    {
+      RoundTripRouteMap routes;
+      getRenominationRoutes(routes);
+
+      mRenomination.updateWarmRoutes(routes);
+
+      return mRenomination.pick(routes, mActiveRoute, zsLib::now(), outReason);
+    }
+
     //-------------------------------------------------------------------------
     ISTUNRequesterPtr ICETransport::createBindRequest(
                                                       RoutePtr route,
@@ -4710,6 +5317,13 @@ namespace ortc
                                                     STUNPacketPtr packet
                                                     )
     {
+      if ((mLocalICELite) &&
+          (!mRemoteParameters.mICELite)) {
+        // a lite agent facing a full agent is always controlled
+        if (packet->mIceControlledIncluded) goto respond_with_conflict;
+        return false;
+      }
+
       if (packet->mIceControllingIncluded) {
         if (IICETypes::Role_Controlled == mOptions.mRole) {
           ZS_LOG_TRACE(log("no conflict in role detected"))
@@ -4762,7 +5376,7 @@ namespace ortc
         wakeUp();
 
         ZS_LOG_WARNING(Debug, log("will retry conflicting packet again after recomputing candidate pairings") + routerRoute->toDebug() + packet->toDebug())
-        IICETransportAsyncDelegateProxy::create(mThisWeak.lock())->onNotifyPacketRetried(routerRoute->mLocalCandidate, routerRoute->mRemoteIP, packet);
+        IICETransportAsyncDelegateProxy::create(mThisWeak.lock())->onNotifyPacketRetried(routerRoute->mKey, routerRoute->mLocalCandidate, routerRoute->mRemoteIP, packet);
       }
       return true;
     }
@@ -4837,7 +5451,7 @@ namespace ortc
         route->mCandidatePair = make_shared<CandidatePair>();
         route->mCandidatePair->mLocal = make_shared<Candidate>(*(routerRoute->mLocalCandidate));
         route->mCandidatePair->mRemote = remoteCandidate;
-        route->mCandidatePairHash = route->mCandidatePair->hash();
+        route->mCandidatePairHash = CandidatePairKey(route->mCandidatePair->mLocal, route->mCandidatePair->mRemote);
 
         route->trace("added missing route (because of incoming stun packet)");
         packet->trace(__func__);
@@ -4878,7 +5492,7 @@ namespace ortc
           return;
         }
 
-        mLastReceivedPacket = zsLib::now();
+        mLastReceivedPacket = Clock::coarseNow();
         route->mLastReceivedMedia = mLastReceivedPacket;
         updateAfterPacket(route);
 
@@ -4978,7 +5592,7 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "id", mID);
 
       UseServicesHelper::debugAppend(resultEl, mCandidatePair ? mCandidatePair->toDebug() : ElementPtr());
-      UseServicesHelper::debugAppend(resultEl, "candidate pair hash", mCandidatePairHash);
+      UseServicesHelper::debugAppend(resultEl, "candidate pair hash", mCandidatePairHash.string());
 
       UseServicesHelper::debugAppend(resultEl, "state", toString(mState));
 
@@ -4993,10 +5607,26 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "prune", mPrune);
       UseServicesHelper::debugAppend(resultEl, "keep warm", mKeepWarm);
       UseServicesHelper::debugAppend(resultEl, "outgoing check", mOutgoingCheck ? mOutgoingCheck->getID() : 0);
-      UseServicesHelper::debugAppend(resultEl, "keep warm timer", mNextKeepWarm ? mNextKeepWarm->getID() : 0);
+      UseServicesHelper::debugAppend(resultEl, "keep warm timer", mNextKeepWarm);
 
       UseServicesHelper::debugAppend(resultEl, "last round trip check", mLastRoundTripCheck);
       UseServicesHelper::debugAppend(resultEl, "last round trip measurement", mLastRoundTripMeasurement);
+      UseServicesHelper::debugAppend(resultEl, "smoothed round trip", mSmoothedRoundTrip);
+      UseServicesHelper::debugAppend(resultEl, "smoothed loss", mSmoothedLoss);
+      UseServicesHelper::debugAppend(resultEl, "check transmissions", mCheckTransmissions);
+      UseServicesHelper::debugAppend(resultEl, "round trip samples", mRoundTripSamples);
+      UseServicesHelper::debugAppend(resultEl, "compared round trip samples", mComparedRoundTripSamples);
+      UseServicesHelper::debugAppend(resultEl, "consecutive better samples", mConsecutiveBetterSamples);
+
+      UseServicesHelper::debugAppend(resultEl, "total checks sent", mTotalChecksSent);
+      UseServicesHelper::debugAppend(resultEl, "total checks received", mTotalChecksReceived);
+      UseServicesHelper::debugAppend(resultEl, "total responses sent", mTotalResponsesSent);
+      UseServicesHelper::debugAppend(resultEl, "total responses received", mTotalResponsesReceived);
+
+      UseServicesHelper::debugAppend(resultEl, "packets sent", mPacketsSent.load());
+      UseServicesHelper::debugAppend(resultEl, "bytes sent", mBytesSent.load());
+      UseServicesHelper::debugAppend(resultEl, "packets received", mPacketsReceived.load());
+      UseServicesHelper::debugAppend(resultEl, "bytes received", mBytesReceived.load());
 
       UseServicesHelper::debugAppend(resultEl, "frozen promise", (bool)mFrozenPromise);
       UseServicesHelper::debugAppend(resultEl, "dependent promises", mDependentPromises.size());
@@ -5017,6 +5647,16 @@ namespace ortc
       return priority;
     }
 
+    //-------------------------------------------------------------------------
+    Microseconds ICETransport::Route::getEffectiveRoundTrip() const
+    {
+      if (Microseconds() == mSmoothedRoundTrip) return Microseconds();
+
+      // lost checks inflate the expected delivery time of the route
+      double loss = (mSmoothedLoss > 0.9 ? 0.9 : mSmoothedLoss);
+      return Microseconds(static_cast<Microseconds::rep>(static_cast<double>(mSmoothedRoundTrip.count()) / (1.0 - loss)));
+    }
+
     //-------------------------------------------------------------------------
     QWORD ICETransport::Route::getActivationPriority(
                                                      bool localIsControlling,
@@ -5060,7 +5700,7 @@ namespace ortc
                              string/callingMethod, function,
                              string/message, message,
                              puid/outerObjectId, ((bool)mTracker) ? mTracker->mOuterObjectID : 0,
-                             string/localCandidatePairHash, mCandidatePairHash,
+                             string/localCandidatePairHash, mCandidatePairHash.string(),
                              string/localInterfaceType, mCandidatePair->mLocal->mInterfaceType,
                              string/localFoundation, mCandidatePair->mLocal->mFoundation,
                              dword/localPriority, mCandidatePair->mLocal->mPriority,
@@ -5092,7 +5732,7 @@ namespace ortc
                              bool/prune, mPrune,
                              bool/keepWarm, mKeepWarm,
                              puid/outgoingCheckStunRequeter, ((bool)mOutgoingCheck) ? mOutgoingCheck->getID() : 0,
-                             puid/nextKeepWarmStunRequester, ((bool)mNextKeepWarm) ? mNextKeepWarm->getID() : 0,
+                             puid/nextKeepWarmTimerId, mNextKeepWarm,
                              bool/frozenPromise, (bool)mFrozenPromise,
                              size_t/totalDependentPromises, mDependentPromises.size(),
                              duration/lastRecievedCheck, zsLib::timeSinceEpoch<Milliseconds>(mLastReceivedCheck).count(),
@@ -5176,6 +5816,133 @@ namespace ortc
       return (mStates[state]);
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICETransport::Renomination
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ICETransport::Renomination::Renomination(PUID outerObjectID) :
+      mOuterObjectID(outerObjectID),
+      mWarmCandidatePairs(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_WARM_CANDIDATE_PAIRS)),
+      mImprovementPercentage(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_IMPROVEMENT_PERCENTAGE)),
+      mConsecutiveSamples(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_CONSECUTIVE_SAMPLES)),
+      mHoldDown(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_HOLD_DOWN_IN_SECONDS)),
+      mActivityWindow(UseSettings::getUInt(ORTC_SETTING_ICE_TRANSPORT_NO_PACKETS_RECEVIED_RECHECK_CANDIDATES_IN_SECONDS))
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr ICETransport::Renomination::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::ICETransport::Renomination");
+
+      UseServicesHelper::debugAppend(resultEl, "warm candidate pairs", mWarmCandidatePairs);
+      UseServicesHelper::debugAppend(resultEl, "improvement percentage", mImprovementPercentage);
+      UseServicesHelper::debugAppend(resultEl, "consecutive samples", mConsecutiveSamples);
+      UseServicesHelper::debugAppend(resultEl, "hold down", mHoldDown);
+      UseServicesHelper::debugAppend(resultEl, "activity window", mActivityWindow);
+      UseServicesHelper::debugAppend(resultEl, "last renomination", mLastRenomination);
+      UseServicesHelper::debugAppend(resultEl, "warm routes", mWarmRoutes.size());
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICETransport::Renomination::isActiveRouteLive(
+                                                       const Time &lastRemoteActivity,
+                                                       const Time &now
+                                                       ) const
+    {
+      if (Time() == lastRemoteActivity) return false;
+      return (lastRemoteActivity + mActivityWindow >= now);
+    }
+
+    //-------------------------------------------------------------------------
+    void ICETransport::Renomination::updateWarmRoutes(const RoundTripRouteMap &routes)
+    {
+      mWarmRoutes.clear();
+
+      size_t index = 0;
+      for (auto iter = routes.begin(); (iter != routes.end()) && (index < mWarmCandidatePairs); ++iter, ++index) {
+        mWarmRoutes.insert((*iter).second->mID);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool ICETransport::Renomination::isWarmRoute(RoutePtr route) const
+    {
+      if (!route) return false;
+      return mWarmRoutes.end() != mWarmRoutes.find(route->mID);
+    }
+
+    //-------------------------------------------------------------------------
+    ICETransport::RoutePtr ICETransport::Renomination::pick(
+                                                            const RoundTripRouteMap &routes,
+                                                            RoutePtr activeRoute,
+                                                            const Time &now,
+                                                            const char * &outReason
+                                                            )
+    {
+      if (!activeRoute) return RoutePtr();
+      if (routes.size() < 1) return RoutePtr();
+
+      auto activeRoundTrip = activeRoute->getEffectiveRoundTrip();
+      if (Microseconds() == activeRoundTrip) return RoutePtr();
+
+      auto bestRoundTrip = (*(routes.begin())).first;
+      auto best = (*(routes.begin())).second;
+
+      for (auto iter = routes.begin(); iter != routes.end(); ++iter) {
+        auto route = (*iter).second;
+        if (route != best) route->mConsecutiveBetterSamples = 0;
+      }
+
+      if (best == activeRoute) return RoutePtr();
+
+      // hysteresis: the best route must beat the active route by a margin...
+      if (static_cast<QWORD>(bestRoundTrip.count()) * (100 + mImprovementPercentage) >= static_cast<QWORD>(activeRoundTrip.count()) * 100) {
+        best->mConsecutiveBetterSamples = 0;
+        return RoutePtr();
+      }
+
+      // ...for several samples in a row (re-evaluating without a new
+      // measurement of the route does not count as another sample)...
+      if (best->mRoundTripSamples != best->mComparedRoundTripSamples) {
+        best->mComparedRoundTripSamples = best->mRoundTripSamples;
+        ++(best->mConsecutiveBetterSamples);
+      }
+      if (best->mConsecutiveBetterSamples < mConsecutiveSamples) {
+        ZS_LOG_TRACE(log("route is faster than active route (awaiting more samples)") + ZS_PARAM("samples", best->mConsecutiveBetterSamples) + ZS_PARAM("active round trip", activeRoundTrip) + best->toDebug())
+        return RoutePtr();
+      }
+
+      // ...and not too soon after the last switch
+      if ((Time() != mLastRenomination) &&
+          (mLastRenomination + mHoldDown > now)) {
+        ZS_LOG_TRACE(log("route is faster than active route (but renomination is being held down)") + ZS_PARAM("last renomination", mLastRenomination) + best->toDebug())
+        return RoutePtr();
+      }
+
+      best->mConsecutiveBetterSamples = 0;
+      mLastRenomination = now;
+
+      ZS_LOG_DEBUG(log("renominating to faster route") + ZS_PARAM("active round trip", activeRoundTrip) + ZS_PARAM("new round trip", bestRoundTrip) + best->toDebug())
+      outReason = "route has consistently lower round trip time and loss than active route";
+      return best;
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params ICETransport::Renomination::log(const char *message) const
+    {
+      ElementPtr objectEl = Element::create("ortc::ICETransport::Renomination");
+      UseServicesHelper::debugAppend(objectEl, "outer object id", mOuterObjectID);
+      return Log::Params(message, objectEl);
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
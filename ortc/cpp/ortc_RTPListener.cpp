@@ -37,6 +37,7 @@
 #include <ortc/internal/ortc_RTCPPacket.h>
 #include <ortc/internal/ortc_SRTPSDESTransport.h>
 #include <ortc/internal/ortc_RTPTypes.h>
+#include <ortc/internal/ortc_Helper.h>
 #include <ortc/internal/ortc_ORTC.h>
 #include <ortc/internal/ortc.events.h>
 #include <ortc/internal/platform.h>
@@ -690,7 +691,7 @@ namespace ortc
                         size, size, bufferLengthInBytes
                         );
 
-          mBufferedRTCPPackets.push_back(TimeRTCPPacketPair(zsLib::now(), rtcpPacket));
+          mBufferedRTCPPackets.push_back(TimeRTCPPacketPair(Clock::coarseNow(), rtcpPacket));
 
           receivers = mReceivers;
           senders = mSenders;
@@ -707,7 +708,7 @@ namespace ortc
 
         expireRTPPackets();
 
-        Time tick = zsLib::now();
+        Time tick = Clock::coarseNow();
 
         ASSERT(IICETypes::Component_RTP == viaComponent);
 
@@ -1550,7 +1551,7 @@ namespace ortc
     //-------------------------------------------------------------------------
     void RTPListener::expireRTPPackets()
     {
-      auto tick = zsLib::now();
+      auto tick = Clock::coarseNow();
 
       while (mBufferedRTPPackets.size() > 0) {
         auto &info = mBufferedRTPPackets.front();
@@ -1583,7 +1584,7 @@ namespace ortc
     //-------------------------------------------------------------------------
     void RTPListener::expireRTCPPackets()
     {
-      auto tick = zsLib::now();
+      auto tick = Clock::coarseNow();
 
       while (mBufferedRTCPPackets.size() > 0) {
         auto &info = mBufferedRTCPPackets.front();
@@ -1913,7 +1914,7 @@ namespace ortc
               if (outReceiverInfo) {
                 // look at the latest time the master SSRC was used
 
-                auto tick = zsLib::now();
+                auto tick = Clock::coarseNow();
 
                 auto diffLast = tick - lastMatchUsageTime;
                 auto diffCurrent = tick - ssrcInfo->mLastUsage;
@@ -2463,7 +2464,7 @@ namespace ortc
         return ssrcInfo;
       }
 
-      ssrcInfo->mLastUsage = zsLib::now();
+      ssrcInfo->mLastUsage = Clock::coarseNow();
 
       if (ioReceiverInfo) {
         ssrcInfo->mReceiverInfo = ioReceiverInfo;
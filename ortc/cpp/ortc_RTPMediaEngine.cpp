@@ -30,6 +30,7 @@
  */
 
 #include <ortc/internal/ortc_RTPMediaEngine.h>
+#include <ortc/internal/ortc_ICEGatherer.h>
 #include <ortc/internal/ortc_MediaStreamTrack.h>
 #include <ortc/internal/ortc_RTPReceiverChannelAudio.h>
 #include <ortc/internal/ortc_RTPReceiverChannelVideo.h>
@@ -1582,6 +1583,33 @@ namespace ortc
       webrtcTrace(Log::Severity::Informational, Log::Level::Basic, msg.c_str());
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark RTPMediaEngine::PacerSendBurst
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    int64_t RTPMediaEngine::PacerSendBurst::TimeUntilNextProcess()
+    {
+      return mPacer->TimeUntilNextProcess();
+    }
+
+    //-------------------------------------------------------------------------
+    void RTPMediaEngine::PacerSendBurst::Process()
+    {
+      ICEGatherer::SendBurst sendBurst;
+      mPacer->Process();
+    }
+
+    //-------------------------------------------------------------------------
+    void RTPMediaEngine::PacerSendBurst::ProcessThreadAttached(webrtc::ProcessThread *processThread)
+    {
+      mPacer->ProcessThreadAttached(processThread);
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -3011,7 +3039,8 @@ namespace ortc
       mModuleProcessThread->Start();
       mModuleProcessThread->RegisterModule(mCallStats.get());
       mModuleProcessThread->RegisterModule(mCongestionController.get());
-      mPacerThread->RegisterModule(mCongestionController->pacer());
+      mPacerSendBurst.reset(new PacerSendBurst(mCongestionController->pacer()));
+      mPacerThread->RegisterModule(mPacerSendBurst.get());
       mPacerThread->RegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mPacerThread->Start();
 
@@ -3060,7 +3089,7 @@ namespace ortc
       }
 
       mPacerThread->Stop();
-      mPacerThread->DeRegisterModule(mCongestionController->pacer());
+      mPacerThread->DeRegisterModule(mPacerSendBurst.get());
       mPacerThread->DeRegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mModuleProcessThread->DeRegisterModule(mCongestionController.get());
       mModuleProcessThread->DeRegisterModule(mCallStats.get());
@@ -3612,7 +3641,8 @@ namespace ortc
       mModuleProcessThread->Start();
       mModuleProcessThread->RegisterModule(mCallStats.get());
       mModuleProcessThread->RegisterModule(mCongestionController.get());
-      mPacerThread->RegisterModule(mCongestionController->pacer());
+      mPacerSendBurst.reset(new PacerSendBurst(mCongestionController->pacer()));
+      mPacerThread->RegisterModule(mPacerSendBurst.get());
       mPacerThread->RegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mPacerThread->Start();
 
@@ -3656,7 +3686,7 @@ namespace ortc
       }
 
       mPacerThread->Stop();
-      mPacerThread->DeRegisterModule(mCongestionController->pacer());
+      mPacerThread->DeRegisterModule(mPacerSendBurst.get());
       mPacerThread->DeRegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mModuleProcessThread->DeRegisterModule(mCongestionController.get());
       mModuleProcessThread->DeRegisterModule(mCallStats.get());
@@ -4207,7 +4237,8 @@ namespace ortc
       mModuleProcessThread->Start();
       mModuleProcessThread->RegisterModule(mCallStats.get());
       mModuleProcessThread->RegisterModule(mCongestionController.get());
-      mPacerThread->RegisterModule(mCongestionController->pacer());
+      mPacerSendBurst.reset(new PacerSendBurst(mCongestionController->pacer()));
+      mPacerThread->RegisterModule(mPacerSendBurst.get());
       mPacerThread->RegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mPacerThread->Start();
 
@@ -4246,7 +4277,7 @@ namespace ortc
         mReceiveStream->Stop();
 
       mPacerThread->Stop();
-      mPacerThread->DeRegisterModule(mCongestionController->pacer());
+      mPacerThread->DeRegisterModule(mPacerSendBurst.get());
       mPacerThread->DeRegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mModuleProcessThread->DeRegisterModule(mCongestionController.get());
       mModuleProcessThread->DeRegisterModule(mCallStats.get());
@@ -4768,7 +4799,8 @@ namespace ortc
       mModuleProcessThread->Start();
       mModuleProcessThread->RegisterModule(mCallStats.get());
       mModuleProcessThread->RegisterModule(mCongestionController.get());
-      mPacerThread->RegisterModule(mCongestionController->pacer());
+      mPacerSendBurst.reset(new PacerSendBurst(mCongestionController->pacer()));
+      mPacerThread->RegisterModule(mPacerSendBurst.get());
       mPacerThread->RegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mPacerThread->Start();
 
@@ -4809,7 +4841,7 @@ namespace ortc
         mSendStream->Stop();
 
       mPacerThread->Stop();
-      mPacerThread->DeRegisterModule(mCongestionController->pacer());
+      mPacerThread->DeRegisterModule(mPacerSendBurst.get());
       mPacerThread->DeRegisterModule(mCongestionController->GetRemoteBitrateEstimator(true));
       mModuleProcessThread->DeRegisterModule(mCongestionController.get());
       mModuleProcessThread->DeRegisterModule(mCallStats.get());
@@ -38,6 +38,7 @@
 #include <ortc/internal/ortc_RTPPacket.h>
 #include <ortc/internal/ortc_RTCPPacket.h>
 #include <ortc/internal/ortc_RTPTypes.h>
+#include <ortc/internal/ortc_Helper.h>
 #include <ortc/internal/ortc_SRTPSDESTransport.h>
 #include <ortc/internal/ortc_ORTC.h>
 #include <ortc/internal/ortc_StatsReport.h>
@@ -1611,7 +1612,7 @@ namespace ortc
 
         expireRTPPackets();
 
-        Time tick = zsLib::now();
+        Time tick = Clock::coarseNow();
 
         // provide some modest buffering
         mBufferedRTPPackets.push_back(TimeRTPPacketPair(tick, packet));
@@ -2639,7 +2640,7 @@ namespace ortc
         return ssrcInfo;
       }
 
-      ssrcInfo->mLastUsage = zsLib::now();
+      ssrcInfo->mLastUsage = Clock::coarseNow();
 
       if (ioChannelHolder) {
         ssrcInfo->mChannelHolder = ioChannelHolder;
@@ -2791,7 +2792,7 @@ namespace ortc
     //-------------------------------------------------------------------------
     void RTPReceiver::expireRTPPackets()
     {
-      auto tick = zsLib::now();
+      auto tick = Clock::coarseNow();
 
       while (mBufferedRTPPackets.size() > 0) {
         auto packetTime = mBufferedRTPPackets.front().first;
@@ -3122,7 +3123,7 @@ namespace ortc
               if (outChannelInfo) {
                 // look at the latest time the master SSRC was used
 
-                auto tick = zsLib::now();
+                auto tick = Clock::coarseNow();
 
                 auto diffLast = tick - lastMatchUsageTime;
                 auto diffCurrent = tick - ssrcInfo->mLastUsage;
@@ -3357,7 +3358,7 @@ namespace ortc
           if (foundChannelInfo) {
             // look at the latest time the master SSRC was used
 
-            auto tick = zsLib::now();
+            auto tick = Clock::coarseNow();
 
             auto diffLast = tick - lastMatchUsageTime;
             auto diffCurrent = tick - ssrcInfo->mLastUsage;
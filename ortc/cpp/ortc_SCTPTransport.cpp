@@ -35,6 +35,7 @@
 #include <ortc/internal/ortc_DataChannel.h>
 #include <ortc/internal/ortc_ICETransport.h>
 #include <ortc/internal/ortc_Helper.h>
+#include <ortc/internal/ortc_StatsReport.h>
 #include <ortc/internal/ortc_ORTC.h>
 #include <ortc/internal/ortc.events.h>
 #include <ortc/internal/platform.h>
@@ -54,6 +55,7 @@
 
 #include <usrsctp.h>
 
+#include <chrono>
 #include <sstream>
 
 //#include <netinet/sctp_os.h>
@@ -84,6 +86,19 @@ enum WindowsErrorCompatibility {
   ((sizeof(a) / sizeof(*(a))) /                     \
   static_cast<size_t>(!(sizeof(a) % sizeof(*(a)))))
 
+// slots are sized for a typical MTU-bound DTLS record up front so the setup
+// burst fills the ring without growing individual buffers
+#define ORTC_SCTP_TRANSPORT_PENDING_INCOMING_INITIAL_SLOTS (16)
+#define ORTC_SCTP_TRANSPORT_PENDING_INCOMING_SLOT_SIZE (1500)
+
+// slot buffers are shared by every transport in the process
+#define ORTC_SCTP_TRANSPORT_PENDING_INCOMING_POOL_PREALLOCATED (64)
+#define ORTC_SCTP_TRANSPORT_PENDING_INCOMING_POOL_MAX (1024)
+
+// a stalled queue (or suspended process) must not expire every usrsctp timer
+// in one burst when it resumes
+#define ORTC_SCTP_INIT_MAX_TIMER_ADVANCE_IN_MILLISECONDS (100)
+
 namespace ortc { ZS_DECLARE_SUBSYSTEM(ortclib_sctp_datachannel) }
 
 namespace ortc
@@ -108,6 +123,7 @@ namespace ortc
     struct SCTPHelper;
 
     ZS_DECLARE_TYPEDEF_PTR(SCTPHelper, UseSCTPHelper)
+    ZS_DECLARE_TYPEDEF_PTR(IStatsReportForInternal, UseStatsReport)
 
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -125,6 +141,32 @@ namespace ortc
       SCTP_EWOULDBLOCK = EWOULDBLOCK
     };
 
+    //-------------------------------------------------------------------------
+    static bool toStreamScheduler(
+                                  const String &name,
+                                  uint32_t &outScheduler
+                                  )
+    {
+      static struct {
+        const char *mName;
+        uint32_t mScheduler;
+      } schedulers[] = {
+        {"fcfs", SCTP_SS_FIRST_COME},
+        {"round-robin", SCTP_SS_ROUND_ROBIN},
+        {"round-robin-packet", SCTP_SS_ROUND_ROBIN_PACKET},
+        {"priority", SCTP_SS_PRIORITY},
+        {"fair-bandwidth", SCTP_SS_FAIR_BANDWITH},
+      };
+
+      for (size_t index = 0; index < ARRAY_SIZE(schedulers); ++index) {
+        if (0 == name.compareNoCase(schedulers[index].mName)) {
+          outScheduler = schedulers[index].mScheduler;
+          return true;
+        }
+      }
+      return false;
+    }
+
     //-------------------------------------------------------------------------
     const char *toString(SCTPPayloadProtocolIdentifier ppid)
     {
@@ -182,6 +224,7 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "ordered", mOrdered);
       UseServicesHelper::debugAppend(resultEl, "max packet lifetime (ms)", mMaxPacketLifetime);
       UseServicesHelper::debugAppend(resultEl, "max retransmits", mMaxRetransmits);
+      UseServicesHelper::debugAppend(resultEl, "priority", mPriority);
       UseServicesHelper::debugAppend(resultEl, "buffer", mBuffer ? mBuffer->SizeInBytes() : 0);
 
       return resultEl;
@@ -272,9 +315,79 @@ namespace ortc
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     #pragma mark
-    #pragma mark SCTPInit
+    #pragma mark PendingIncomingPool
     #pragma mark
 
+    // Process wide free list of slot buffers for packets that arrive before
+    // an SCTP socket is open. Buffers are preallocated and handed back once a
+    // transport drains its ring so association setup never allocates per
+    // packet.
+    class PendingIncomingPool
+    {
+    public:
+      typedef std::vector<SecureByteBlockPtr> BufferVector;
+
+      //-----------------------------------------------------------------------
+      PendingIncomingPool()
+      {
+        mFree.reserve(ORTC_SCTP_TRANSPORT_PENDING_INCOMING_POOL_MAX);
+        for (size_t index = 0; index < ORTC_SCTP_TRANSPORT_PENDING_INCOMING_POOL_PREALLOCATED; ++index) {
+          mFree.push_back(make_shared<SecureByteBlock>(ORTC_SCTP_TRANSPORT_PENDING_INCOMING_SLOT_SIZE));
+        }
+      }
+
+      //-----------------------------------------------------------------------
+      static PendingIncomingPool &singleton()
+      {
+        static PendingIncomingPool pool;
+        return pool;
+      }
+
+      //-----------------------------------------------------------------------
+      SecureByteBlockPtr acquire(size_t bufferLengthInBytes)
+      {
+        if (bufferLengthInBytes <= ORTC_SCTP_TRANSPORT_PENDING_INCOMING_SLOT_SIZE) {
+          AutoLock lock(mLock);
+          if (mFree.size() > 0) {
+            SecureByteBlockPtr result = mFree.back();
+            mFree.pop_back();
+            return result;
+          }
+        }
+
+        // pool exhausted (or an oversized packet) so fall back to the heap
+        ++mTotalAllocated;
+        return make_shared<SecureByteBlock>(bufferLengthInBytes > ORTC_SCTP_TRANSPORT_PENDING_INCOMING_SLOT_SIZE ? bufferLengthInBytes : ORTC_SCTP_TRANSPORT_PENDING_INCOMING_SLOT_SIZE);
+      }
+
+      //-----------------------------------------------------------------------
+      void release(SecureByteBlockPtr &buffer)
+      {
+        if (!buffer) return;
+
+        if (ORTC_SCTP_TRANSPORT_PENDING_INCOMING_SLOT_SIZE == buffer->SizeInBytes()) {
+          AutoLock lock(mLock);
+          if (mFree.size() < ORTC_SCTP_TRANSPORT_PENDING_INCOMING_POOL_MAX) mFree.push_back(buffer);
+        }
+        buffer.reset();
+      }
+
+      //-----------------------------------------------------------------------
+      size_t totalFree() const
+      {
+        AutoLock lock(mLock);
+        return mFree.size();
+      }
+
+      //-----------------------------------------------------------------------
+      size_t totalAllocated() const {return mTotalAllocated;}
+
+    protected:
+      mutable Lock mLock;
+      BufferVector mFree;
+      std::atomic<size_t> mTotalAllocated {};
+    };
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -287,7 +400,9 @@ namespace ortc
     // https://chromium.googlesource.com/external/webrtc/+/master/talk/media/sctp/sctpdataengine.cc
     // https://chromium.googlesource.com/external/webrtc/+/master/talk/media/sctp/sctpdataengine.h
 
-    class SCTPInit : public ISingletonManagerDelegate
+    class SCTPInit : public MessageQueueAssociator,
+                     public ISingletonManagerDelegate,
+                     public zsLib::ITimerDelegate
     {
     public:
       friend class SCTPTransport;
@@ -300,8 +415,16 @@ namespace ortc
 
     public:
       //-----------------------------------------------------------------------
-      SCTPInit(const make_private &)
+      SCTPInit(
+               const make_private &,
+               IMessageQueuePtr queue
+               ) :
+        MessageQueueAssociator(queue),
+        mDriveFromPacketQueues(UseSettings::getBool(ORTC_SETTING_SCTP_TRANSPORT_DRIVE_FROM_PACKET_QUEUES)),
+        mTimerInterval(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_TIMER_INTERVAL_IN_MILLISECONDS))
       {
+        if (Milliseconds() == mTimerInterval) mTimerInterval = Milliseconds(10);
+
         ZS_EVENTING_1(x, i, Detail, SctpInitCreate, ol, SctpInit, Start, puid, id, mID);
         ZS_LOG_BASIC(log("created"))
       }
@@ -314,7 +437,16 @@ namespace ortc
 
         // First argument is udp_encapsulation_port, which is not releveant for our
         // AF_CONN use of sctp.
-        usrsctp_init(0, OnSctpOutboundPacket, debug_sctp_printf);
+        if (mDriveFromPacketQueues) {
+          // no usrsctp timer thread; timers are advanced from onTimer() on a
+          // packet queue instead
+          usrsctp_init_nothreads(0, OnSctpOutboundPacket, debug_sctp_printf);
+
+          mLastTimerTick = std::chrono::steady_clock::now();
+          mTimer = Timer::create(mThisWeak.lock(), mTimerInterval);
+        } else {
+          usrsctp_init(0, OnSctpOutboundPacket, debug_sctp_printf);
+        }
 
         // To turn on/off detailed SCTP debugging. You will also need to have the
         // SCTP_DEBUG cpp defines flag.
@@ -343,13 +475,16 @@ namespace ortc
         // is cricket::kMaxSctpSid.
         usrsctp_sysctl_set_sctp_nr_outgoing_streams_default(SafeInt<uint32_t>(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_SESSIONS_PER_PORT)));
 
+        // preallocate the shared pending packet slots before any association starts
+        PendingIncomingPool::singleton();
+
         mInitialized = true;
       }
 
       //-----------------------------------------------------------------------
       static SCTPInitPtr create()
       {
-        SCTPInitPtr pThis(make_shared<SCTPInit>(make_private{}));
+        SCTPInitPtr pThis(make_shared<SCTPInit>(make_private{}, IORTCForInternal::queuePacket()));
         pThis->mThisWeak = pThis;
         pThis->init();
         return pThis;
@@ -393,6 +528,53 @@ namespace ortc
         cancel();
       }
 
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark SCTPInit => ITimerDelegate
+      #pragma mark
+
+      //-----------------------------------------------------------------------
+      virtual void onTimer(TimerPtr timer) override
+      {
+        uint32_t elapsed {};
+
+        {
+          AutoRecursiveLock lock(mLock);
+          if (timer != mTimer) return;
+
+          // monotonic so wall clock adjustments never jump the SCTP timers
+          auto tick = std::chrono::steady_clock::now();
+          auto delta = std::chrono::duration_cast<Milliseconds>(tick - mLastTimerTick).count();
+          if (delta <= 0) return;
+
+          if (delta > ORTC_SCTP_INIT_MAX_TIMER_ADVANCE_IN_MILLISECONDS) {
+            ZS_LOG_WARNING(Debug, log("timer fired late (clamping advance)") + ZS_PARAM("elapsed (ms)", delta))
+            elapsed = ORTC_SCTP_INIT_MAX_TIMER_ADVANCE_IN_MILLISECONDS;
+            mLastTimerTick = tick;
+          } else {
+            elapsed = static_cast<uint32_t>(delta);
+
+            // carry any sub-millisecond remainder into the next tick
+            mLastTimerTick += Milliseconds(elapsed);
+          }
+        }
+
+        // outside the lock as expiring timers call back into the transports
+        usrsctp_handle_timers(elapsed);
+      }
+
+    public:
+      //-----------------------------------------------------------------------
+      static IMessageQueuePtr transportQueue()
+      {
+        // associations are spread round robin across the packet queues so
+        // data channel load is not funnelled through one thread
+        if (UseSettings::getBool(ORTC_SETTING_SCTP_TRANSPORT_DRIVE_FROM_PACKET_QUEUES)) return IORTCForInternal::queuePacket();
+        return IORTCForInternal::queueORTC();
+      }
+
+    protected:
+
       //-----------------------------------------------------------------------
       #pragma mark
       #pragma mark SCTPInit => usrscpt callbacks
@@ -486,27 +668,34 @@ namespace ortc
             case SCTP_PPID_NONE:
             default: {
               ZS_LOG_WARNING(Trace, slog("incoming protocol identifier type was not understood (dropping packet)") + ZS_PARAM("ppid", ppid))
+              free(data);
               return 1;
             }
           }
         }
 
-        SCTPPacketIncomingPtr packet(make_shared<SCTPPacketIncoming>());
+        // takes ownership of the receive buffer (no copy on the usrsctp thread)
+        SCTPTransport::InboundMessage *message = new SCTPTransport::InboundMessage;
 
-        packet->mType = ppid;
-        packet->mSessionID = rcv.rcv_sid;
-        packet->mSequenceNumber = rcv.rcv_ssn;
-        packet->mTimestamp = rcv.rcv_tsn;
-        packet->mFlags = flags;
-        packet->mBuffer = UseServicesHelper::convertToBuffer((const BYTE *)data, length);
+        message->mType = ppid;
+        message->mSessionID = rcv.rcv_sid;
+        message->mSequenceNumber = rcv.rcv_ssn;
+        message->mTimestamp = rcv.rcv_tsn;
+        message->mFlags = flags;
+        message->mData = data;
+        message->mSize = length;
 
         if (!transport) {
           ZS_LOG_WARNING(Trace, slog("transport is gone (thus cannot receive packet)") + ZS_PARAM("socket", ((PTRNUMBER)sock)) + ZS_PARAM("length", length) + ZS_PARAM("flags", flags) + ZS_PARAM("ulp", ((PTRNUMBER)ulp_info)))
+          delete message;
           errno = ESHUTDOWN;
           return -1;
         }
 
-        ISCTPTransportAsyncDelegateProxy::create(transport)->onIncomingPacket(packet);
+        // only the message that finds the queue empty schedules a drain
+        if (transport->mInboundQueue.push(message)) {
+          ISCTPTransportAsyncDelegateProxy::create(transport)->onDeliverInboundMessages();
+        }
         return 0;
       }
       
@@ -544,6 +733,11 @@ namespace ortc
 
         UseServicesHelper::debugAppend(resultEl, "id", mID);
 
+        UseServicesHelper::debugAppend(resultEl, "drive from packet queues", mDriveFromPacketQueues);
+        UseServicesHelper::debugAppend(resultEl, "timer interval", mTimerInterval);
+        UseServicesHelper::debugAppend(resultEl, "timer", mTimer ? mTimer->getID() : 0);
+        UseServicesHelper::debugAppend(resultEl, "since last timer tick", std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - mLastTimerTick));
+
         return resultEl;
       }
 
@@ -554,6 +748,14 @@ namespace ortc
 
         ZS_LOG_DEBUG(log("cancel called"))
 
+        {
+          AutoRecursiveLock lock(mLock);
+          if (mTimer) {
+            mTimer->cancel();
+            mTimer.reset();
+          }
+        }
+
         bool initialized = mInitialized.exchange(false);
         if (!initialized) return;
 
@@ -578,6 +780,11 @@ namespace ortc
       SCTPInitWeakPtr mThisWeak;
 
       std::atomic<bool> mInitialized{ false };
+
+      bool mDriveFromPacketQueues {};
+      Milliseconds mTimerInterval {};
+      TimerPtr mTimer;
+      std::chrono::steady_clock::time_point mLastTimerTick;
     };
 
     //-------------------------------------------------------------------------
@@ -593,6 +800,14 @@ namespace ortc
     {
       // http://tools.ietf.org/html/draft-ietf-rtcweb-data-channel-05#section-6.2
       UseSettings::setUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_SESSIONS_PER_PORT, kMaxSctpSid);
+
+      // https://tools.ietf.org/html/rfc8260
+      UseSettings::setBool(ORTC_SETTING_SCTP_TRANSPORT_MESSAGE_INTERLEAVING, true);
+
+      UseSettings::setString(ORTC_SETTING_SCTP_TRANSPORT_STREAM_SCHEDULER, "round-robin");
+
+      UseSettings::setBool(ORTC_SETTING_SCTP_TRANSPORT_DRIVE_FROM_PACKET_QUEUES, false);
+      UseSettings::setUInt(ORTC_SETTING_SCTP_TRANSPORT_TIMER_INTERVAL_IN_MILLISECONDS, 10);
     }
 
     //-------------------------------------------------------------------------
@@ -673,6 +888,7 @@ namespace ortc
       SharedRecursiveLock(SharedRecursiveLock::create()),
       mSCTPInit(SCTPInit::singleton()),
       mMaxSessionsPerPort(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_SESSIONS_PER_PORT)),
+      mMaxIncomingMessageSize(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_MESSAGE_SIZE)),
       mListener(listener),
       mSecureTransport(secureTransport),
       mIncoming(0 != localPort),
@@ -771,9 +987,20 @@ namespace ortc
     //-------------------------------------------------------------------------
     IStatsProvider::PromiseWithStatsReportPtr SCTPTransport::getStats(const StatsTypeSet &stats) const
     {
-#define TODO_COMPLETE 1
-#define TODO_COMPLETE 2
-      return PromiseWithStatsReport::createRejected(IORTCForInternal::queueDelegate());
+      if (!stats.hasStatType(IStatsReportTypes::StatsType_SCTPTransport)) {
+        return PromiseWithStatsReport::createRejected(IORTCForInternal::queueDelegate());
+      }
+
+      AutoRecursiveLock lock(*this);
+      if ((isShutdown()) ||
+          (isShuttingDown())) {
+        ZS_LOG_WARNING(Debug, log("cannot collect stats while shutdown / shutting down"));
+        return PromiseWithStatsReport::createRejected(IORTCForInternal::queueDelegate());
+      }
+
+      PromiseWithStatsReportPtr promise = PromiseWithStatsReport::create(IORTCForInternal::queueDelegate());
+      ISCTPTransportAsyncDelegateProxy::create(mThisWeak.lock())->onResolveStatsPromise(promise, stats);
+      return promise;
     }
 
 
@@ -811,7 +1038,7 @@ namespace ortc
       UseListenerPtr listener = SCTPTransportListener::convert(dataTransport);
       ORTC_THROW_INVALID_STATE_IF(!listener)
 
-      SCTPTransportPtr pThis(make_shared<SCTPTransport>(make_private {}, IORTCForInternal::queueORTC(), listener, useSecureTransport));
+      SCTPTransportPtr pThis(make_shared<SCTPTransport>(make_private {}, SCTPInit::transportQueue(), listener, useSecureTransport));
       pThis->mThisWeak = pThis;
       pThis->mThisSocket = new SCTPTransportWeakPtr(pThis);
 
@@ -1028,6 +1255,7 @@ namespace ortc
         ioSessionID = sessionID;
         ioDataChannel = dataChannel;
         mSessions[sessionID] = dataChannel;
+        sessionOpened(sessionID);
 
         ZS_EVENTING_3(
                       x, i, Detail, SctpTransportRegisterNewDataChannel, ol, SctpTransport, Info,
@@ -1065,6 +1293,7 @@ namespace ortc
       ioDataChannel = dataChannel;
       ioSessionID = sessionID;
       mSessions[sessionID] = dataChannel;
+      sessionOpened(sessionID);
 
       ZS_EVENTING_3(
                     x, i, Detail, SctpTransportRegisterNewDataChannel, ol, SctpTransport, Info,
@@ -1250,6 +1479,7 @@ namespace ortc
             return;
           }
           mSessions.erase(found);
+          sessionClosed(sessionID);
           wasActive = true;
         }
       }
@@ -1299,7 +1529,7 @@ namespace ortc
                                                         WORD remotePort
                                                         )
     {
-      SCTPTransportPtr pThis(make_shared<SCTPTransport>(make_private {}, IORTCForInternal::queueORTC(), listener, secureTransport, localPort, remotePort));
+      SCTPTransportPtr pThis(make_shared<SCTPTransport>(make_private {}, SCTPInit::transportQueue(), listener, secureTransport, localPort, remotePort));
       pThis->mThisWeak = pThis;
       pThis->mThisSocket = new SCTPTransportWeakPtr(pThis);
       pThis->init();
@@ -1334,9 +1564,12 @@ namespace ortc
           }
 
           if (!mCapabilities) goto queue_packet;
-          if (mPendingIncomingBuffers.size() > 0) goto queue_packet;
           if (!mSocket) goto queue_packet;
 
+          // anything buffered during setup must be delivered first to keep
+          // packet order; do it now rather than waiting for the next step
+          if (!mPendingIncoming.isEmpty()) deliverPendingIncoming();
+
           usrsctp_conninput(mThisSocket, buffer, bufferLengthInBytes, 0);
 
           return true;
@@ -1351,7 +1584,7 @@ namespace ortc
                         size, size, bufferLengthInBytes
                         );
 
-          mPendingIncomingBuffers.push(make_shared<SecureByteBlock>(buffer, bufferLengthInBytes));
+          mPendingIncoming.push(buffer, bufferLengthInBytes);
           return true;
         }
       }
@@ -1448,104 +1681,98 @@ namespace ortc
     #pragma mark
 
     //-------------------------------------------------------------------------
-    void SCTPTransport::onIncomingPacket(SCTPPacketIncomingPtr packet)
+    void SCTPTransport::onDeliverInboundMessages()
     {
-      ZS_EVENTING_7(
-                    x, i, Trace, SctpTransportReceivedIncomingPacket, ol, SctpTransport, Receive,
-                    puid, id, mID,
-                    word, sessionId, packet->mSessionID,
-                    word, sequenceNumber, packet->mSequenceNumber,
-                    dword, timestamp, packet->mTimestamp,
-                    int, flags, packet->mFlags,
-                    buffer, data, ((bool)packet->mBuffer) ? packet->mBuffer->BytePtr() : NULL,
-                    size, size, ((bool)packet->mBuffer) ? SafeInt<unsigned int>(packet->mBuffer->SizeInBytes()) : 0
-                    );
+      PacketIncomingList packets;
 
-      ZS_LOG_TRACE(log("on incoming packet") + packet->toDebug())
+      // scope: copy out of the usrsctp buffers without holding the lock
+      {
+        auto message = mInboundQueue.popAll();
+        while (message) {
+          auto next = message->mNext;
+          packets.push_back(message->toPacket());
+          delete message;
+          message = next;
+        }
+      }
 
-      if (0 != (packet->mFlags & MSG_NOTIFICATION)) {
-        ZS_LOG_TRACE(log("incoming packet is a notification packet") + packet->toDebug())
+      if (packets.size() < 1) return;
 
-        if (!packet->mBuffer) {
-          ZS_LOG_WARNING(Detail, log("incoming notification packet missing data") + packet->toDebug())
-          return;
-        }
+      ZS_LOG_TRACE(log("delivering inbound messages") + ZS_PARAM("total", packets.size()))
 
-        const sctp_notification &notification = reinterpret_cast<const sctp_notification&>(*(packet->mBuffer->BytePtr()));
-        ZS_THROW_INVALID_ASSUMPTION_IF(notification.sn_header.sn_length != packet->mBuffer->SizeInBytes())
+      auto iter = packets.begin();
+      while (iter != packets.end()) {
+        DataChannelPacketList deliveries;
 
-        AutoRecursiveLock lock(*this);
-        handleNotificationPacket(notification);
-        return;
-      }
+        // scope: resolve a run of messages with a single lock
+        {
+          AutoRecursiveLock lock(*this);
 
-      UseDataChannelPtr dataChannel;
+          for (; iter != packets.end(); ++iter) {
+            auto packet = (*iter);
 
-      {
-        AutoRecursiveLock lock(*this);
+            ZS_EVENTING_7(
+                          x, i, Trace, SctpTransportReceivedIncomingPacket, ol, SctpTransport, Receive,
+                          puid, id, mID,
+                          word, sessionId, packet->mSessionID,
+                          word, sequenceNumber, packet->mSequenceNumber,
+                          dword, timestamp, packet->mTimestamp,
+                          int, flags, packet->mFlags,
+                          buffer, data, ((bool)packet->mBuffer) ? packet->mBuffer->BytePtr() : NULL,
+                          size, size, ((bool)packet->mBuffer) ? SafeInt<unsigned int>(packet->mBuffer->SizeInBytes()) : 0
+                          );
 
-        // scope: check active sessions
-        {
-          auto found = mSessions.find(packet->mSessionID);
-          if (found != mSessions.end()) {
-            dataChannel = (*found).second;
-            goto forward_to_data_channel;
-          }
-        }
+            ZS_LOG_TRACE(log("on incoming packet") + packet->toDebug())
 
-        // scope: check pending reset
-        {
-          auto found = mPendingResetSessions.find(packet->mSessionID);
-          if (found != mPendingResetSessions.end()) {
-            dataChannel = (*found).second;
-            goto forward_to_data_channel;
-          }
-        }
+            if (0 != (packet->mFlags & MSG_NOTIFICATION)) {
+              // data received ahead of a notification must reach its data channel first
+              if (deliveries.size() > 0) break;
 
-        // scope: check queued reset
-        {
-          auto found = mQueuedResetSessions.find(packet->mSessionID);
-          if (found != mQueuedResetSessions.end()) {
-            dataChannel = (*found).second;
-            goto forward_to_data_channel;
-          }
-        }
+              ZS_LOG_TRACE(log("incoming packet is a notification packet") + packet->toDebug())
 
-        // not found anywhere
-        dataChannel = UseDataChannel::create(mThisWeak.lock(), packet->mSessionID);
+              if (!packet->mBuffer) {
+                ZS_LOG_WARNING(Detail, log("incoming notification packet missing data") + packet->toDebug())
+                continue;
+              }
 
-        ZS_LOG_TRACE(log("creating new incoming data channel") + ZS_PARAM("data channel", dataChannel->getID()) + packet->toDebug())
+              const sctp_notification &notification = reinterpret_cast<const sctp_notification&>(*(packet->mBuffer->BytePtr()));
+              ZS_THROW_INVALID_ASSUMPTION_IF(notification.sn_header.sn_length != packet->mBuffer->SizeInBytes())
 
-        if (mSessions.size() >= mMaxSessionsPerPort) {
-          ZS_LOG_ERROR(Detail, log("too many session active") + packet->toDebug())
-          dataChannel->requestShutdown();
-          mQueuedResetSessions[packet->mSessionID] = dataChannel;
-          goto forward_to_data_channel;
+              handleNotificationPacket(notification);
+              continue;
+            }
+
+            packet = reassembleIncoming(packet);
+            if (!packet) continue;
+
+            auto dataChannel = findOrCreateIncomingDataChannel(*packet);
+            if (!dataChannel) {
+              ZS_LOG_WARNING(Detail, log("data channel is not known (likely already closed)") + packet->toDebug());
+              continue;
+            }
+
+            deliveries.push_back(DataChannelPacketPair(dataChannel, packet));
+          }
         }
 
-        mSessions[packet->mSessionID] = dataChannel;
-        goto forward_to_data_channel;
-      }
+        for (auto iterDelivery = deliveries.begin(); iterDelivery != deliveries.end(); ++iterDelivery) {
+          auto &dataChannel = (*iterDelivery).first;
+          auto &packet = (*iterDelivery).second;
 
-    forward_to_data_channel:
-      {
-        if (!dataChannel) {
-          ZS_LOG_WARNING(Detail, log("data channel is not known (likely already closed)") + packet->toDebug());
-          return;
+          ZS_EVENTING_8(
+                        x, i, Trace, SctpTransportDeliverIncomingPacket, ol, SctpTransport, Deliver,
+                        puid, id, mID,
+                        puid, dataChannelId, dataChannel->getID(),
+                        word, sessionId, packet->mSessionID,
+                        word, sequenceNumber, packet->mSequenceNumber,
+                        dword, timestamp, packet->mTimestamp,
+                        int, flags, packet->mFlags,
+                        buffer, data, ((bool)packet->mBuffer) ? packet->mBuffer->BytePtr() : NULL,
+                        size, size, ((bool)packet->mBuffer) ? SafeInt<unsigned int>(packet->mBuffer->SizeInBytes()) : 0
+                        );
+          ZS_LOG_TRACE(log("forwarding to data channel") + ZS_PARAM("data channel", dataChannel->getID()) + packet->toDebug());
+          dataChannel->handleSCTPPacket(packet);
         }
-        ZS_EVENTING_8(
-                      x, i, Trace, SctpTransportDeliverIncomingPacket, ol, SctpTransport, Deliver,
-                      puid, id, mID,
-                      puid, dataChannelId, dataChannel->getID(),
-                      word, sessionId, packet->mSessionID,
-                      word, sequenceNumber, packet->mSequenceNumber,
-                      dword, timestamp, packet->mTimestamp,
-                      int, flags, packet->mFlags,
-                      buffer, data, ((bool)packet->mBuffer) ? packet->mBuffer->BytePtr() : NULL,
-                      size, size, ((bool)packet->mBuffer) ? SafeInt<unsigned int>(packet->mBuffer->SizeInBytes()) : 0          
-                      );
-        ZS_LOG_TRACE(log("forwarding to data channel") + ZS_PARAM("data channel", dataChannel->getID()) + packet->toDebug());
-        dataChannel->handleSCTPPacket(packet);
       }
     }
 
@@ -1558,6 +1785,69 @@ namespace ortc
       cancel();
     }
 
+    //-------------------------------------------------------------------------
+    void SCTPTransport::onResolveStatsPromise(
+                                              IStatsProvider::PromiseWithStatsReportPtr promise,
+                                              IStatsReportTypes::StatsTypeSet stats
+                                              )
+    {
+      UseStatsReport::StatMap reportStats;
+
+      AutoRecursiveLock lock(*this);
+
+      if (isShutdown()) {
+        ZS_LOG_WARNING(Detail, log("requesting stats after shutdown"))
+        promise->reject();
+        return;
+      }
+
+      auto total = make_shared<IStatsReportTypes::SCTPTransportStats>();
+      total->mID = string(mID);
+      total->mDataChannelsOpened = mDataChannelsOpened;
+      total->mDataChannelsClosed = mDataChannelsClosed;
+      total->mStreamScheduler = mStreamScheduler;
+
+      if (mSocket) {
+        // primary path metrics are what matter for throughput diagnosis (the
+        // AF_CONN association is single homed so no other path exists)
+        struct sctp_status status {};
+        socklen_t size = sizeof(status);
+        if (0 == usrsctp_getsockopt(mSocket, IPPROTO_SCTP, SCTP_STATUS, &status, &size)) {
+          total->mCongestionWindow = status.sstat_primary.spinfo_cwnd;
+          total->mSmoothedRoundTripTime = Milliseconds(status.sstat_primary.spinfo_srtt);
+          total->mRetransmissionTimeout = Milliseconds(status.sstat_primary.spinfo_rto);
+          total->mPathMTU = status.sstat_primary.spinfo_mtu;
+          total->mReceiverWindow = status.sstat_rwnd;
+          total->mUnackedData = status.sstat_unackdata;
+          total->mPendingData = status.sstat_penddata;
+        } else {
+          ZS_LOG_WARNING(Debug, log("unable to fetch SCTP_STATUS for stats") + ZS_PARAM("errno", errno))
+        }
+      }
+
+      // one report per active stream plus the association wide totals
+      for (auto iter = mStreamStats.begin(); iter != mStreamStats.end(); ++iter) {
+        auto sessionID = (*iter).first;
+        auto &stream = (*iter).second;
+
+        auto report = make_shared<IStatsReportTypes::SCTPTransportStats>();
+        report->mID = string(mID) + ":" + string(sessionID);
+        report->mStreamScheduler = mStreamScheduler;
+        report->mStreamPriority = stream.mAppliedPriority.hasValue() ? stream.mAppliedPriority.value() : 0;
+        report->mMessagesSent = stream.mMessagesSent;
+        report->mBytesSent = stream.mBytesSent;
+
+        total->mMessagesSent += report->mMessagesSent;
+        total->mBytesSent += report->mBytesSent;
+
+        reportStats[report->mID] = report;
+      }
+
+      reportStats[total->mID] = total;
+
+      promise->resolve(UseStatsReport::create(reportStats));
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -1673,7 +1963,15 @@ namespace ortc
       UseServicesHelper::debugAppend(resultEl, "connected", mConnected);
       UseServicesHelper::debugAppend(resultEl, "write ready", mWriteReady);
 
-      UseServicesHelper::debugAppend(resultEl, "pending incoming buffers", mPendingIncomingBuffers.size());
+      UseServicesHelper::debugAppend(resultEl, "pending incoming", mPendingIncoming.toDebug());
+
+      UseServicesHelper::debugAppend(resultEl, "message interleaving", mMessageInterleaving);
+      UseServicesHelper::debugAppend(resultEl, "stream scheduler", mStreamScheduler);
+      UseServicesHelper::debugAppend(resultEl, "stream priorities", mStreamPriorities);
+      UseServicesHelper::debugAppend(resultEl, "streams", mStreamStats.size());
+      UseServicesHelper::debugAppend(resultEl, "data channels opened", mDataChannelsOpened);
+      UseServicesHelper::debugAppend(resultEl, "data channels closed", mDataChannelsClosed);
+      UseServicesHelper::debugAppend(resultEl, "partial incoming", mPartialIncoming.size());
 
       return resultEl;
     }
@@ -1846,29 +2144,39 @@ namespace ortc
 
       ORTC_THROW_INVALID_STATE_IF(!mSocket)
 
-      if (mPendingIncomingBuffers.size() < 1) {
+      if (mPendingIncoming.isEmpty()) {
         ZS_LOG_TRACE(log("no pending packets to deliver"))
         return true;
       }
 
-      ZS_LOG_DEBUG(log("delivering pending packets") + ZS_PARAM("pending packets", mPendingIncomingBuffers.size()))
+      if (!mCapabilities) {
+        ZS_LOG_TRACE(log("waiting for capabilities before delivering pending packets"))
+        return true;
+      }
+
+      deliverPendingIncoming();
+      return true;
+    }
 
-      BufferQueue pending = mPendingIncomingBuffers;
-      mPendingIncomingBuffers = BufferQueue();
+    //-------------------------------------------------------------------------
+    void SCTPTransport::deliverPendingIncoming()
+    {
+      ZS_LOG_DEBUG(log("delivering pending packets") + ZS_PARAM("pending packets", mPendingIncoming.size()))
 
-      while (pending.size() > 0) {
-        SecureByteBlockPtr buffer = pending.front();
-        handleDataPacket(buffer->BytePtr(), buffer->SizeInBytes());
+      while (!mPendingIncoming.isEmpty()) {
+        auto &slot = mPendingIncoming.front();
+        usrsctp_conninput(mThisSocket, slot.mBuffer->BytePtr(), slot.mSize, 0);
         ZS_EVENTING_3(
                       x, i, Trace, SctpTransportDisposeBufferedIncomingDataPacket, ol, SctpTransport, Dispose,
                       puid, id, mID,
-                      buffer, data, buffer->BytePtr(),
-                      size, size, buffer->SizeInBytes()
+                      buffer, data, slot.mBuffer->BytePtr(),
+                      size, size, slot.mSize
                       );
-        pending.pop();
+        mPendingIncoming.popFront();
       }
 
-      return true;
+      // the socket is open so nothing will be buffered again
+      mPendingIncoming.release();
     }
 
     //-------------------------------------------------------------------------
@@ -2088,7 +2396,9 @@ namespace ortc
         mWaitingToSend.pop();
       }
 
-      mPendingIncomingBuffers = BufferQueue();
+      mPendingIncoming.release();
+      mPartialIncoming.clear();
+      mStreamStats.clear();
 
       auto listener = mListener.lock();
       if (listener) {
@@ -2237,6 +2547,53 @@ namespace ortc
         return false;
       }
 
+      // I-DATA allows fragments of a large message to be interleaved with
+      // messages on other streams. usrsctp aborts an association whose peer
+      // does not agree so it is only offered when both sides advertise it
+      // (otherwise plain DATA chunks are used).
+      mMessageInterleaving = (UseSettings::getBool(ORTC_SETTING_SCTP_TRANSPORT_MESSAGE_INTERLEAVING)) &&
+                             ((bool)mCapabilities) &&
+                             (mCapabilities->mMessageInterleaving);
+      if (mMessageInterleaving) {
+        int fragmentInterleave = 2;
+        if (usrsctp_setsockopt(sock, IPPROTO_SCTP, SCTP_FRAGMENT_INTERLEAVE, &fragmentInterleave, sizeof(fragmentInterleave))) {
+          ZS_LOG_ERROR(Detail, log("failed to set SCTP_FRAGMENT_INTERLEAVE") + ZS_PARAM("errno", errno))
+          return false;
+        }
+
+        struct sctp_assoc_value interleaving {};
+        interleaving.assoc_id = SCTP_FUTURE_ASSOC;
+        interleaving.assoc_value = 1;
+        if (usrsctp_setsockopt(sock, IPPROTO_SCTP, SCTP_INTERLEAVING_SUPPORTED, &interleaving, sizeof(interleaving))) {
+          ZS_LOG_ERROR(Detail, log("failed to set SCTP_INTERLEAVING_SUPPORTED") + ZS_PARAM("errno", errno))
+          return false;
+        }
+        ZS_LOG_DEBUG(log("message interleaving (I-DATA) enabled"))
+      }
+
+      // Replace the default (first come first served) stream scheduler so a
+      // bulk channel cannot monopolize the association. "priority" is strict
+      // (a busy higher priority channel starves lower ones) so it is opt-in.
+      mStreamScheduler = UseSettings::getString(ORTC_SETTING_SCTP_TRANSPORT_STREAM_SCHEDULER);
+      mStreamPriorities = false;
+      if (mStreamScheduler.hasData()) {
+        uint32_t scheduler {};
+        if (!toStreamScheduler(mStreamScheduler, scheduler)) {
+          ZS_LOG_WARNING(Detail, log("stream scheduler is not understood (using usrsctp default)") + ZS_PARAM("scheduler", mStreamScheduler))
+          mStreamScheduler.clear();
+        } else {
+          struct sctp_assoc_value ss {};
+          ss.assoc_id = SCTP_FUTURE_ASSOC;
+          ss.assoc_value = scheduler;
+          if (usrsctp_setsockopt(sock, IPPROTO_SCTP, SCTP_PLUGGABLE_SS, &ss, sizeof(ss))) {
+            ZS_LOG_WARNING(Detail, log("failed to set SCTP_PLUGGABLE_SS (using usrsctp default)") + ZS_PARAM("scheduler", mStreamScheduler) + ZS_PARAM("errno", errno))
+            mStreamScheduler.clear();
+          } else {
+            mStreamPriorities = (SCTP_SS_PRIORITY == scheduler);
+          }
+        }
+      }
+
       struct sctp_paddrparams params = {{0}};
       params.spp_assoc_id = 0;
       params.spp_flags = SPP_PMTUD_DISABLE;
@@ -2308,6 +2665,9 @@ namespace ortc
         return false;
       }
 
+      auto &stream = mStreamStats[inPacket.mSessionID];
+      applyStreamPriority(socket, inPacket, stream);
+
       struct sctp_sendv_spa spa = {};
 
       spa.sendv_flags |= SCTP_SEND_SNDINFO_VALID;
@@ -2348,10 +2708,59 @@ namespace ortc
         return false;
       }
 
+      ++stream.mMessagesSent;
+      stream.mBytesSent += (inPacket.mBuffer ? inPacket.mBuffer->SizeInBytes() : 0);
+
       ZS_LOG_INSANE(log("sctp outgoing data sent successfully"))
       return true;
     }
 
+    //-------------------------------------------------------------------------
+    void SCTPTransport::applyStreamPriority(
+                                            struct socket *socket,
+                                            const SCTPPacketOutgoing &packet,
+                                            StreamStats &stream
+                                            )
+    {
+      if (!mStreamPriorities) return;
+
+      if (stream.mAppliedPriority.hasValue()) {
+        if (stream.mAppliedPriority.value() == packet.mPriority) return;
+      }
+
+      // the usrsctp priority scheduler serves the lowest value first
+      struct sctp_stream_value value {};
+      value.assoc_id = SCTP_ALL_ASSOC;
+      value.stream_id = packet.mSessionID;
+      value.stream_value = static_cast<uint16_t>(0xFFFF - packet.mPriority);
+
+      if (usrsctp_setsockopt(socket, IPPROTO_SCTP, SCTP_SS_VALUE, &value, sizeof(value))) {
+        // not recorded so the next send on the stream tries again (e.g. once
+        // the stream exists after an outgoing stream reconfiguration)
+        ZS_LOG_WARNING(Debug, log("failed to set SCTP_SS_VALUE") + ZS_PARAM("session id", packet.mSessionID) + ZS_PARAM("priority", packet.mPriority) + ZS_PARAM("errno", errno))
+        return;
+      }
+
+      ZS_LOG_TRACE(log("stream priority applied") + ZS_PARAM("session id", packet.mSessionID) + ZS_PARAM("priority", packet.mPriority))
+
+      // only re-applied when the channel's priority changes
+      stream.mAppliedPriority = packet.mPriority;
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransport::sessionOpened(SessionID sessionID)
+    {
+      ++mDataChannelsOpened;
+      mStreamStats.erase(sessionID);
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransport::sessionClosed(SessionID sessionID)
+    {
+      ++mDataChannelsClosed;
+      mStreamStats.erase(sessionID);
+    }
+
     //-------------------------------------------------------------------------
     void SCTPTransport::notifyWriteReady()
     {
@@ -2377,6 +2786,110 @@ namespace ortc
       }
     }
 
+    //-------------------------------------------------------------------------
+    SCTPTransport::UseDataChannelPtr SCTPTransport::findOrCreateIncomingDataChannel(const SCTPPacketIncoming &packet)
+    {
+      // scope: check active sessions
+      {
+        auto found = mSessions.find(packet.mSessionID);
+        if (found != mSessions.end()) return (*found).second;
+      }
+
+      // scope: check pending reset
+      {
+        auto found = mPendingResetSessions.find(packet.mSessionID);
+        if (found != mPendingResetSessions.end()) return (*found).second;
+      }
+
+      // scope: check queued reset
+      {
+        auto found = mQueuedResetSessions.find(packet.mSessionID);
+        if (found != mQueuedResetSessions.end()) return (*found).second;
+      }
+
+      // not found anywhere
+      auto dataChannel = UseDataChannel::create(mThisWeak.lock(), packet.mSessionID);
+
+      ZS_LOG_TRACE(log("creating new incoming data channel") + ZS_PARAM("data channel", dataChannel->getID()) + packet.toDebug())
+
+      if (mSessions.size() >= mMaxSessionsPerPort) {
+        ZS_LOG_ERROR(Detail, log("too many session active") + packet.toDebug())
+        dataChannel->requestShutdown();
+        mQueuedResetSessions[packet.mSessionID] = dataChannel;
+        return dataChannel;
+      }
+
+      mSessions[packet.mSessionID] = dataChannel;
+      sessionOpened(packet.mSessionID);
+      return dataChannel;
+    }
+
+    //-------------------------------------------------------------------------
+    SCTPPacketIncomingPtr SCTPTransport::reassembleIncoming(SCTPPacketIncomingPtr packet)
+    {
+      // usrsctp hands over a message in pieces once it exceeds the partial
+      // delivery point; with I-DATA pieces of different streams interleave.
+      bool complete = (0 != (packet->mFlags & MSG_EOR));
+
+      auto found = mPartialIncoming.find(packet->mSessionID);
+      if (found == mPartialIncoming.end()) {
+        if (complete) return packet;
+
+        ZS_LOG_TRACE(log("holding partial incoming message") + packet->toDebug())
+        found = mPartialIncoming.insert(PartialIncomingMap::value_type(packet->mSessionID, PartialIncoming())).first;
+      }
+
+      PartialIncoming &partial = (*found).second;
+
+      if (partial.mDiscarding) {
+        // swallow the remainder of an oversized message (its stream is being reset)
+        if (complete) mPartialIncoming.erase(found);
+        return SCTPPacketIncomingPtr();
+      }
+
+      partial.mTotalSize += (packet->mBuffer ? packet->mBuffer->SizeInBytes() : 0);
+
+      if ((0 != mMaxIncomingMessageSize) &&
+          (partial.mTotalSize > mMaxIncomingMessageSize)) {
+        ZS_LOG_ERROR(Detail, log("partial incoming message exceeds max message size (resetting stream)") + ZS_PARAM("size", partial.mTotalSize) + ZS_PARAM("max", mMaxIncomingMessageSize) + packet->toDebug())
+
+        partial.mPieces.clear();
+        partial.mDiscarding = true;
+        if (complete) mPartialIncoming.erase(found);
+
+        auto foundSession = mSessions.find(packet->mSessionID);
+        if (foundSession != mSessions.end()) {
+          auto dataChannel = (*foundSession).second;
+          dataChannel->requestShutdown();
+        }
+        return SCTPPacketIncomingPtr();
+      }
+
+      PacketIncomingList &pieces = partial.mPieces;
+      pieces.push_back(packet);
+
+      if (!complete) return SCTPPacketIncomingPtr();
+
+      size_t totalSize = partial.mTotalSize;
+
+      SCTPPacketIncomingPtr result(make_shared<SCTPPacketIncoming>(*(pieces.front())));
+      result->mFlags = packet->mFlags;
+      result->mBuffer = make_shared<SecureByteBlock>(totalSize);
+
+      BYTE *pos = result->mBuffer->BytePtr();
+      for (auto iter = pieces.begin(); iter != pieces.end(); ++iter) {
+        auto &piece = (*iter);
+        if (!piece->mBuffer) continue;
+        memcpy(pos, piece->mBuffer->BytePtr(), piece->mBuffer->SizeInBytes());
+        pos += piece->mBuffer->SizeInBytes();
+      }
+
+      ZS_LOG_TRACE(log("reassembled partial incoming message") + ZS_PARAM("pieces", pieces.size()) + result->toDebug())
+
+      mPartialIncoming.erase(found);
+      return result;
+    }
+
     //-------------------------------------------------------------------------
     void SCTPTransport::handleNotificationPacket(const sctp_notification &notification)
     {
@@ -2523,6 +3036,7 @@ namespace ortc
               ZS_LOG_DEBUG(log("remote party is closing session") + ZS_PARAM("session id", sessionID))
               dataChannel->requestShutdown();
               mSessions.erase(found);
+              sessionClosed(sessionID);
 
               auto objectID = dataChannel->getID();
               auto foundAnnounced = mAnnouncedIncomingDataChannels.find(objectID);
@@ -2546,6 +3060,164 @@ namespace ortc
       }
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SCTPTransport::InboundMessage
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    SCTPTransport::InboundMessage::~InboundMessage()
+    {
+      if (mData) {
+        free(mData);
+        mData = NULL;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    SCTPPacketIncomingPtr SCTPTransport::InboundMessage::toPacket() const
+    {
+      SCTPPacketIncomingPtr packet(make_shared<SCTPPacketIncoming>());
+
+      packet->mType = mType;
+      packet->mSessionID = mSessionID;
+      packet->mSequenceNumber = mSequenceNumber;
+      packet->mTimestamp = mTimestamp;
+      packet->mFlags = mFlags;
+      packet->mBuffer = UseServicesHelper::convertToBuffer(static_cast<const BYTE *>(mData), mSize);
+
+      return packet;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SCTPTransport::InboundQueue
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    SCTPTransport::InboundQueue::~InboundQueue()
+    {
+      auto message = popAll();
+      while (message) {
+        auto next = message->mNext;
+        delete message;
+        message = next;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool SCTPTransport::InboundQueue::push(InboundMessage *message)
+    {
+      auto head = mHead.load(std::memory_order_relaxed);
+      do {
+        message->mNext = head;
+      } while (!mHead.compare_exchange_weak(head, message, std::memory_order_release, std::memory_order_relaxed));
+
+      return NULL == head;
+    }
+
+    //-------------------------------------------------------------------------
+    SCTPTransport::InboundMessage *SCTPTransport::InboundQueue::popAll()
+    {
+      InboundMessage *stack = mHead.exchange(NULL, std::memory_order_acquire);
+
+      // the stack is newest first; reverse it into arrival order
+      InboundMessage *result = NULL;
+      while (stack) {
+        auto next = stack->mNext;
+        stack->mNext = result;
+        result = stack;
+        stack = next;
+      }
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SCTPTransport::PendingIncomingRing
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void SCTPTransport::PendingIncomingRing::push(
+                                                  const BYTE *buffer,
+                                                  size_t bufferLengthInBytes
+                                                  )
+    {
+      if (mSize == mSlots.size()) grow();
+
+      auto &slot = mSlots[(mHead + mSize) & (mSlots.size() - 1)];
+      slot.mBuffer = PendingIncomingPool::singleton().acquire(bufferLengthInBytes);
+      memcpy(slot.mBuffer->BytePtr(), buffer, bufferLengthInBytes);
+      slot.mSize = bufferLengthInBytes;
+      ++mSize;
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransport::PendingIncomingRing::popFront()
+    {
+      if (0 == mSize) return;
+
+      auto &slot = mSlots[mHead];
+      PendingIncomingPool::singleton().release(slot.mBuffer);
+      slot.mSize = 0;
+      mHead = (mHead + 1) & (mSlots.size() - 1);
+      --mSize;
+      if (0 == mSize) mHead = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransport::PendingIncomingRing::release()
+    {
+      // hand any undelivered slots back to the shared pool
+      for (auto iter = mSlots.begin(); iter != mSlots.end(); ++iter) {
+        PendingIncomingPool::singleton().release((*iter).mBuffer);
+      }
+
+      SlotVector empty;
+      mSlots.swap(empty);
+      mHead = 0;
+      mSize = 0;
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr SCTPTransport::PendingIncomingRing::toDebug() const
+    {
+      ElementPtr resultEl = Element::create("ortc::SCTPTransport::PendingIncomingRing");
+
+      UseServicesHelper::debugAppend(resultEl, "size", mSize);
+      UseServicesHelper::debugAppend(resultEl, "capacity", mSlots.size());
+      UseServicesHelper::debugAppend(resultEl, "head", mHead);
+      UseServicesHelper::debugAppend(resultEl, "pool free", PendingIncomingPool::singleton().totalFree());
+      UseServicesHelper::debugAppend(resultEl, "pool heap allocations", PendingIncomingPool::singleton().totalAllocated());
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransport::PendingIncomingRing::grow()
+    {
+      size_t capacity = mSlots.size() > 0 ? (mSlots.size() * 2) : ORTC_SCTP_TRANSPORT_PENDING_INCOMING_INITIAL_SLOTS;
+
+      SlotVector slots(capacity);
+      for (size_t index = 0; index < mSize; ++index) {
+        auto &source = mSlots[(mHead + index) & (mSlots.size() - 1)];
+        slots[index].mBuffer = source.mBuffer;
+        slots[index].mSize = source.mSize;
+      }
+
+      mSlots.swap(slots);
+      mHead = 0;
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -2604,6 +3276,7 @@ namespace ortc
     UseHelper::getElementValue(elem, "ortc::ISCTPTransportTypes::Capabilities", "maxPort", mMaxPort);
     UseHelper::getElementValue(elem, "ortc::ISCTPTransportTypes::Capabilities", "maxUsablePorts", mMaxUsablePorts);
     UseHelper::getElementValue(elem, "ortc::ISCTPTransportTypes::Capabilities", "maxSessionsPerPort", mMaxSessionsPerPort);
+    UseHelper::getElementValue(elem, "ortc::ISCTPTransportTypes::Capabilities", "messageInterleaving", mMessageInterleaving);
   }
 
   //---------------------------------------------------------------------------
@@ -2618,6 +3291,7 @@ namespace ortc
     UseHelper::adoptElementValue(elem, "maxPort", mMaxPort);
     UseHelper::adoptElementValue(elem, "maxUsablePorts", mMaxUsablePorts);
     UseHelper::adoptElementValue(elem, "maxSessionsPerPort", mMaxSessionsPerPort);
+    UseHelper::adoptElementValue(elem, "messageInterleaving", mMessageInterleaving);
 
     if (!elem->hasChildren()) return ElementPtr();
 
@@ -2645,6 +3319,8 @@ namespace ortc
     hasher.update(mMaxUsablePorts);
     hasher.update(":");
     hasher.update(mMaxSessionsPerPort);
+    hasher.update(":");
+    hasher.update(mMessageInterleaving);
     return hasher.final();
   }
 
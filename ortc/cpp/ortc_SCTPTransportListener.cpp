@@ -326,6 +326,7 @@ namespace ortc
       result->mMaxPort = SafeInt<decltype(result->mMaxPort)>(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_LISTENER_MAX_PORT));
       result->mMaxUsablePorts = SafeInt<decltype(result->mMaxUsablePorts)>(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_LISTENER_MAX_PORTS));
       result->mMaxSessionsPerPort = SafeInt<decltype(result->mMaxSessionsPerPort)>(UseSettings::getUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_SESSIONS_PER_PORT));
+      result->mMessageInterleaving = UseSettings::getBool(ORTC_SETTING_SCTP_TRANSPORT_MESSAGE_INTERLEAVING);
       return result;
     }
 
@@ -433,15 +434,14 @@ namespace ortc
             return;
           }
 
-          auto foundLocalPort = mAllocatedLocalPorts.find(localPort);
-          if (foundLocalPort != mAllocatedLocalPorts.end()) {
+          if (mAllocatedLocalPorts.isAllocated(localPort)) {
             ZS_LOG_WARNING(Detail, log("port already in use (and mapped to a different remote port)") + ZS_PARAM("local port", localPort) + ZS_PARAM("remote port", remotePort) + ZS_PARAM("tuple id", tupleID))
             ioTransport = UseSCTPTransportPtr();
             return;
           }
 
-          allocatePort(mAllocatedLocalPorts, localPort);
-          allocatePort(mAllocatedRemotePorts, remotePort);
+          mAllocatedLocalPorts.allocate(localPort);
+          mAllocatedRemotePorts.allocate(remotePort);
 
           ioLocalPort = localPort;
           ioRemotePort = remotePort;
@@ -495,33 +495,13 @@ namespace ortc
                                                   WORD remotePort
                                                   )
     {
-      AutoRecursiveLock lock(*this);
-
-      if (isShutdown()) {
-        ZS_LOG_WARNING(Detail, log("cannot announce transport (as shutting down)"))
-        return;
-      }
-
-      auto tuple = UseListenerHelper::createTuple(localPort, remotePort);
-      auto found = mTransports.find(tuple);
-      if (found == mTransports.end()) {
-        ZS_LOG_WARNING(Detail, log("cannot announce incoming transport (as transport was not found in transport list)"))
-        return;
-      }
+      // called with the transport's lock held (and possibly from another
+      // queue) so never take the listener lock here; the listener starts
+      // transports while holding its own lock
+      auto pThis = mThisWeak.lock();
+      if (!pThis) return;
 
-      ZS_EVENTING_4(
-                    x, i, Detail, SctpTransportListenerSctpTransportEvent, ol, SctpTransportListener, InternalEvent,
-                    puid, id, mID,
-                    puid, secureTransportId, transport->getID(),
-                    word, localPort, localPort,
-                    word, remotePort, remotePort
-                    );
-
-      ZS_LOG_DEBUG(log("announcing incoming transport") + ZS_PARAM("transport", transport->getID()))
-
-      mSubscriptions.delegate()->onSCTPTransport(SCTPTransport::convert(transport));
-
-      mAnnouncedTransports[transport->getID()] = transport;
+      ISCTPTransportListenerAsyncDelegateProxy::create(pThis)->onAnnounceTransport(transport, localPort, remotePort);
     }
 
     //-------------------------------------------------------------------------
@@ -531,48 +511,11 @@ namespace ortc
                                                WORD remotePort
                                                )
     {
-      ZS_EVENTING_4(
-                    x, i, Detail, SctpTransportListenerSctpTransportShutdownEvent, ol, SctpTransportListener, InternalEvent,
-                    puid, id, mID,
-                    puid, sctpTransportId, transport.getID(),
-                    word, localPort, localPort,
-                    word, remotePort, remotePort
-                    );
+      // see announceTransport
+      auto pThis = mThisWeak.lock();
+      if (!pThis) return;
 
-      AutoRecursiveLock lock(*this);
-
-      if (isShutdown()) {
-        ZS_LOG_TRACE(log("ignoring SCTP transport shutdown notification"))
-        return;
-      }
-
-      auto tuple = UseListenerHelper::createTuple(localPort, remotePort);
-
-      ZS_LOG_DETAIL(log("notified shutdown of SCTP transport") + ZS_PARAM("tuple", tuple) + ZS_PARAM("local port", localPort) + ZS_PARAM("remote port", remotePort) + ZS_PARAM("transport id", transport.getID()))
-
-      {
-        auto found = mTransports.find(tuple);
-        if (found != mTransports.end()) {
-          auto registeredTransport = (*found).second;
-          if (registeredTransport->getID() == transport.getID()) {
-            deallocatePort(mAllocatedLocalPorts, localPort);
-            deallocatePort(mAllocatedRemotePorts, remotePort);
-            mTransports.erase(found);
-          }
-        }
-      }
-
-      {
-        auto found = mAnnouncedTransports.find(transport.getID());
-        if (found != mAnnouncedTransports.end()) mAnnouncedTransports.erase(found);
-      }
-
-      {
-        auto found = mPendingTransports.find(transport.getID());
-        if (found != mPendingTransports.end()) mPendingTransports.erase(found);
-      }
-
-      IWakeDelegateProxy::create(mThisWeak.lock())->onWake();
+      ISCTPTransportListenerAsyncDelegateProxy::create(pThis)->onTransportShutdown(transport.getID(), localPort, remotePort);
     }
 
     //-------------------------------------------------------------------------
@@ -643,8 +586,8 @@ namespace ortc
           } else {
             mPendingTransports[transport->getID()] = transport;
           }
-          allocatePort(mAllocatedLocalPorts, localPort);
-          allocatePort(mAllocatedRemotePorts, remotePort);
+          mAllocatedLocalPorts.allocate(localPort);
+          mAllocatedRemotePorts.allocate(remotePort);
           mTransports[tupleID] = transport;
         } else {
           transport = (*found).second;
@@ -669,6 +612,93 @@ namespace ortc
     #pragma mark SCTPTransport => ISCTPTransportListenerAsyncDelegate
     #pragma mark
 
+    //-------------------------------------------------------------------------
+    void SCTPTransportListener::onAnnounceTransport(
+                                                    UseSCTPTransportPtr transport,
+                                                    WORD localPort,
+                                                    WORD remotePort
+                                                    )
+    {
+      AutoRecursiveLock lock(*this);
+
+      if (isShutdown()) {
+        ZS_LOG_WARNING(Detail, log("cannot announce transport (as shutting down)"))
+        return;
+      }
+
+      auto tuple = UseListenerHelper::createTuple(localPort, remotePort);
+      auto found = mTransports.find(tuple);
+      if (found == mTransports.end()) {
+        ZS_LOG_WARNING(Detail, log("cannot announce incoming transport (as transport was not found in transport list)"))
+        return;
+      }
+
+      ZS_EVENTING_4(
+                    x, i, Detail, SctpTransportListenerSctpTransportEvent, ol, SctpTransportListener, InternalEvent,
+                    puid, id, mID,
+                    puid, secureTransportId, transport->getID(),
+                    word, localPort, localPort,
+                    word, remotePort, remotePort
+                    );
+
+      ZS_LOG_DEBUG(log("announcing incoming transport") + ZS_PARAM("transport", transport->getID()))
+
+      mSubscriptions.delegate()->onSCTPTransport(SCTPTransport::convert(transport));
+
+      mAnnouncedTransports[transport->getID()] = transport;
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransportListener::onTransportShutdown(
+                                                    PUID transportID,
+                                                    WORD localPort,
+                                                    WORD remotePort
+                                                    )
+    {
+      ZS_EVENTING_4(
+                    x, i, Detail, SctpTransportListenerSctpTransportShutdownEvent, ol, SctpTransportListener, InternalEvent,
+                    puid, id, mID,
+                    puid, sctpTransportId, transportID,
+                    word, localPort, localPort,
+                    word, remotePort, remotePort
+                    );
+
+      AutoRecursiveLock lock(*this);
+
+      if (isShutdown()) {
+        ZS_LOG_TRACE(log("ignoring SCTP transport shutdown notification"))
+        return;
+      }
+
+      auto tuple = UseListenerHelper::createTuple(localPort, remotePort);
+
+      ZS_LOG_DETAIL(log("notified shutdown of SCTP transport") + ZS_PARAM("tuple", tuple) + ZS_PARAM("local port", localPort) + ZS_PARAM("remote port", remotePort) + ZS_PARAM("transport id", transportID))
+
+      {
+        auto found = mTransports.find(tuple);
+        if (found != mTransports.end()) {
+          auto registeredTransport = (*found).second;
+          if (registeredTransport->getID() == transportID) {
+            deallocatePort(mAllocatedLocalPorts, localPort);
+            deallocatePort(mAllocatedRemotePorts, remotePort);
+            mTransports.erase(found);
+          }
+        }
+      }
+
+      {
+        auto found = mAnnouncedTransports.find(transportID);
+        if (found != mAnnouncedTransports.end()) mAnnouncedTransports.erase(found);
+      }
+
+      {
+        auto found = mPendingTransports.find(transportID);
+        if (found != mPendingTransports.end()) mPendingTransports.erase(found);
+      }
+
+      IWakeDelegateProxy::create(mThisWeak.lock())->onWake();
+    }
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -837,7 +867,7 @@ namespace ortc
             }
             {
               auto found = mAnnouncedTransports.find(transport->getID());
-              if (found != mAnnouncedTransports.end()) mPendingTransports.erase(found);
+              if (found != mAnnouncedTransports.end()) mAnnouncedTransports.erase(found);
             }
             continue;
           }
@@ -923,75 +953,98 @@ namespace ortc
     //-------------------------------------------------------------------------
     WORD SCTPTransportListener::allocateLocalPort(WORD remotePort)
     {
-      WORD maxSearching = mMaxAllocationPort - mMinAllocationPort;
+      DWORD maxSearching = static_cast<DWORD>(mMaxAllocationPort - mMinAllocationPort);
 
       while (true) {
+        if (mAllocatedLocalPorts.isAllocated(mCurrentAllocationPort)) goto next_port;
+        if ((0 == remotePort) &&
+            (mAllocatedRemotePorts.isAllocated(mCurrentAllocationPort))) goto next_port;
 
+        goto found_port;
+
+      next_port:
         {
-          auto found = mAllocatedLocalPorts.find(mCurrentAllocationPort);
-          if (found != mAllocatedLocalPorts.end()) goto next_port;
-        }
+          DWORD step = mNextAllocationIncremement;
 
-        if (0 == remotePort) {
-          auto found = mAllocatedRemotePorts.find(mCurrentAllocationPort);
-          if (found != mAllocatedRemotePorts.end()) goto next_port;
-        }
+          if (1 == step) {
+            QWORD used = mAllocatedLocalPorts.block(mCurrentAllocationPort);
+            if (0 == remotePort) used |= mAllocatedRemotePorts.block(mCurrentAllocationPort);
 
-        goto found_port;
+            // every port in this block is taken so skip to the next block
+            if (~static_cast<QWORD>(0) == used) step = AllocatedPorts::BitsPerBlock - (mCurrentAllocationPort % AllocatedPorts::BitsPerBlock);
+          }
 
-      next_port:
-        mCurrentAllocationPort = mCurrentAllocationPort + mNextAllocationIncremement;
+          DWORD next = static_cast<DWORD>(mCurrentAllocationPort) + step;
 
-        if (mCurrentAllocationPort < mMinAllocationPort) mCurrentAllocationPort = mMinAllocationPort + (mCurrentAllocationPort % 2);
-        if (mCurrentAllocationPort > mMaxAllocationPort) mCurrentAllocationPort = mMinAllocationPort + (mCurrentAllocationPort % 2);
+          // only ports inside the allocation range count towards the search
+          DWORD searched = step;
+          if ((next > static_cast<DWORD>(mMaxAllocationPort) + 1) &&
+              (mCurrentAllocationPort <= mMaxAllocationPort)) searched = static_cast<DWORD>(mMaxAllocationPort) + 1 - mCurrentAllocationPort;
 
-        if (0 == maxSearching) return 0;
-        --maxSearching;
+          if ((next < mMinAllocationPort) || (next > mMaxAllocationPort)) next = mMinAllocationPort + (next % 2);
+          mCurrentAllocationPort = static_cast<WORD>(next);
+
+          if (maxSearching < searched) return 0;
+          maxSearching -= searched;
+        }
       }
 
     found_port:
       {
-        allocatePort(mAllocatedLocalPorts, mCurrentAllocationPort);
+        mAllocatedLocalPorts.allocate(mCurrentAllocationPort);
         if (0 == remotePort) remotePort = mCurrentAllocationPort;
-        allocatePort(mAllocatedRemotePorts, remotePort);
+        mAllocatedRemotePorts.allocate(remotePort);
       }
 
       return mCurrentAllocationPort;
     }
 
     //-------------------------------------------------------------------------
-    void SCTPTransportListener::allocatePort(
-                                             AllocatedPortMap &useMap,
-                                             WORD port
-                                             )
+    void SCTPTransportListener::deallocatePort(
+                                               AllocatedPorts &ports,
+                                               WORD port
+                                               )
     {
-      auto found = useMap.find(port);
-      if (found == useMap.end()) {
-        useMap[port] = 1;
-        return;
-      }
+      if (ports.deallocate(port)) return;
+      ZS_LOG_ERROR(Debug, log("allocation was not found") + ZS_PARAM("port", port))
+    }
 
-      size_t &total = (*found).second;
-      ++total;
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SCTPTransportListener::AllocatedPorts
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void SCTPTransportListener::AllocatedPorts::allocate(WORD port)
+    {
+      mInUse[port / BitsPerBlock] |= bit(port);
+      ++(mTotals[port]);
     }
 
     //-------------------------------------------------------------------------
-    void SCTPTransportListener::deallocatePort(
-                                               AllocatedPortMap &useMap,
-                                               WORD port
-                                               )
+    bool SCTPTransportListener::AllocatedPorts::deallocate(WORD port)
     {
-      auto found = useMap.find(port);
-      if (found == useMap.end()) {
-        ZS_LOG_ERROR(Debug, log("allocation was not found") + ZS_PARAM("port", port))
-        return;
-      }
+      auto found = mTotals.find(port);
+      if (found == mTotals.end()) return false;
 
       size_t &total = (*found).second;
       --total;
 
-      if (0 != total) return;
-      useMap.erase(found);
+      if (0 != total) return true;
+
+      mTotals.erase(found);
+      mInUse[port / BitsPerBlock] &= ~bit(port);
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void SCTPTransportListener::AllocatedPorts::clear()
+    {
+      memset(&(mInUse[0]), 0, sizeof(mInUse));
+      mTotals.clear();
     }
 
     //-------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include <ortc/internal/ortc_DataChannel.h>
 #include <ortc/internal/ortc_DTMFSender.h>
 #include <ortc/internal/ortc_DTLSTransport.h>
+#include <ortc/internal/ortc_ICECheckPacer.h>
 #include <ortc/internal/ortc_ICEGatherer.h>
 #include <ortc/internal/ortc_ICETransport.h>
 #include <ortc/internal/ortc_Identity.h>
@@ -55,6 +56,7 @@
 #include <ortc/internal/ortc_SCTPTransportListener.h>
 #include <ortc/internal/ortc_SRTPTransport.h>
 #include <ortc/internal/ortc_SRTPSDESTransport.h>
+#include <ortc/internal/ortc_TimerWheel.h>
 
 #include <ortc/services/IHelper.h>
 #include <ortc/services/ISettings.h>
@@ -164,6 +166,7 @@ namespace ortc
       IDataChannelForSettings::applyDefaults();
       IDTMFSenderForSettings::applyDefaults();
       IDTLSTransportForSettings::applyDefaults();
+      IICECheckPacerForSettings::applyDefaults();
       IICEGathererForSettings::applyDefaults();
       IICETransportForSettings::applyDefaults();
       IIdentityForSettings::applyDefaults();
@@ -184,6 +187,7 @@ namespace ortc
       ISCTPTransportListenerForSettings::applyDefaults();
       ISRTPTransportForSettings::applyDefaults();
       ISRTPSDESTransportForSettings::applyDefaults();
+      ITimerWheelForSettings::applyDefaults();
 
       {
         AutoRecursiveLock lock(mLock);
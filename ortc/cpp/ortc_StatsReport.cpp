@@ -1209,7 +1209,18 @@ namespace ortc
   IStatsReportTypes::SCTPTransportStats::SCTPTransportStats(const SCTPTransportStats &op2) :
     Stats(op2),
     mDataChannelsOpened(op2.mDataChannelsOpened),
-    mDataChannelsClosed(op2.mDataChannelsClosed)
+    mDataChannelsClosed(op2.mDataChannelsClosed),
+    mStreamScheduler(op2.mStreamScheduler),
+    mStreamPriority(op2.mStreamPriority),
+    mMessagesSent(op2.mMessagesSent),
+    mBytesSent(op2.mBytesSent),
+    mCongestionWindow(op2.mCongestionWindow),
+    mSmoothedRoundTripTime(op2.mSmoothedRoundTripTime),
+    mRetransmissionTimeout(op2.mRetransmissionTimeout),
+    mPathMTU(op2.mPathMTU),
+    mReceiverWindow(op2.mReceiverWindow),
+    mUnackedData(op2.mUnackedData),
+    mPendingData(op2.mPendingData)
   {
   }
 
@@ -1223,6 +1234,17 @@ namespace ortc
 
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "dataChannelsOpened", mDataChannelsOpened);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "dataChannelsClosed", mDataChannelsClosed);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "streamScheduler", mStreamScheduler);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "streamPriority", mStreamPriority);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "messagesSent", mMessagesSent);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "bytesSent", mBytesSent);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "congestionWindow", mCongestionWindow);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "smoothedRoundTripTime", mSmoothedRoundTripTime);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "retransmissionTimeout", mRetransmissionTimeout);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "pathMtu", mPathMTU);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "receiverWindow", mReceiverWindow);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "unackedData", mUnackedData);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::SCTPTransportStats", "pendingData", mPendingData);
   }
 
   //---------------------------------------------------------------------------
@@ -1245,6 +1267,17 @@ namespace ortc
 
     UseHelper::adoptElementValue(rootEl, "dataChannelsOpened", mDataChannelsOpened);
     UseHelper::adoptElementValue(rootEl, "dataChannelsClosed", mDataChannelsClosed);
+    UseHelper::adoptElementValue(rootEl, "streamScheduler", mStreamScheduler, false);
+    UseHelper::adoptElementValue(rootEl, "streamPriority", mStreamPriority);
+    UseHelper::adoptElementValue(rootEl, "messagesSent", mMessagesSent);
+    UseHelper::adoptElementValue(rootEl, "bytesSent", mBytesSent);
+    UseHelper::adoptElementValue(rootEl, "congestionWindow", mCongestionWindow);
+    UseHelper::adoptElementValue(rootEl, "smoothedRoundTripTime", mSmoothedRoundTripTime);
+    UseHelper::adoptElementValue(rootEl, "retransmissionTimeout", mRetransmissionTimeout);
+    UseHelper::adoptElementValue(rootEl, "pathMtu", mPathMTU);
+    UseHelper::adoptElementValue(rootEl, "receiverWindow", mReceiverWindow);
+    UseHelper::adoptElementValue(rootEl, "unackedData", mUnackedData);
+    UseHelper::adoptElementValue(rootEl, "pendingData", mPendingData);
 
     if (!rootEl->hasChildren()) return ElementPtr();
 
@@ -1269,6 +1302,28 @@ namespace ortc
     hasher.update(mDataChannelsOpened);
     hasher.update(":");
     hasher.update(mDataChannelsClosed);
+    hasher.update(":");
+    hasher.update(mStreamScheduler);
+    hasher.update(":");
+    hasher.update(mStreamPriority);
+    hasher.update(":");
+    hasher.update(mMessagesSent);
+    hasher.update(":");
+    hasher.update(mBytesSent);
+    hasher.update(":");
+    hasher.update(mCongestionWindow);
+    hasher.update(":");
+    hasher.update(mSmoothedRoundTripTime);
+    hasher.update(":");
+    hasher.update(mRetransmissionTimeout);
+    hasher.update(":");
+    hasher.update(mPathMTU);
+    hasher.update(":");
+    hasher.update(mReceiverWindow);
+    hasher.update(":");
+    hasher.update(mUnackedData);
+    hasher.update(":");
+    hasher.update(mPendingData);
 
     return hasher.final();
   }
@@ -1278,8 +1333,19 @@ namespace ortc
   {
     Stats::eventTrace(timestamp);
 
-    internal::reportInt32(mID, timestamp, "dataChannelsOpen", SafeInt<int32>(mDataChannelsOpened));
-    internal::reportInt32(mID, timestamp, "dataChannelsClosed", SafeInt<int32>(mDataChannelsClosed));
+    internal::reportInt64(mID, timestamp, "dataChannelsOpen", SafeInt<int64>(mDataChannelsOpened));
+    internal::reportInt64(mID, timestamp, "dataChannelsClosed", SafeInt<int64>(mDataChannelsClosed));
+    internal::reportString(mID, timestamp, "streamScheduler", mStreamScheduler);
+    internal::reportInt32(mID, timestamp, "streamPriority", SafeInt<int32>(mStreamPriority));
+    internal::reportInt64(mID, timestamp, "messagesSent", SafeInt<int64>(mMessagesSent));
+    internal::reportInt64(mID, timestamp, "bytesSent", SafeInt<int64>(mBytesSent));
+    internal::reportInt32(mID, timestamp, "congestionWindow", SafeInt<int32>(mCongestionWindow));
+    internal::reportInt64(mID, timestamp, "smoothedRoundTripTime", SafeInt<int64>(mSmoothedRoundTripTime.count()));
+    internal::reportInt64(mID, timestamp, "retransmissionTimeout", SafeInt<int64>(mRetransmissionTimeout.count()));
+    internal::reportInt32(mID, timestamp, "pathMtu", SafeInt<int32>(mPathMTU));
+    internal::reportInt32(mID, timestamp, "receiverWindow", SafeInt<int32>(mReceiverWindow));
+    internal::reportInt32(mID, timestamp, "unackedData", SafeInt<int32>(mUnackedData));
+    internal::reportInt32(mID, timestamp, "pendingData", SafeInt<int32>(mPendingData));
   }
 
 
@@ -1632,7 +1698,9 @@ namespace ortc
     mMessagesSent(op2.mMessagesSent),
     mBytesSent(op2.mBytesSent),
     mMessagesReceived(op2.mMessagesReceived),
-    mBytesReceived(op2.mBytesReceived)
+    mBytesReceived(op2.mBytesReceived),
+    mBufferedAmount(op2.mBufferedAmount),
+    mBufferedAmountHighWaterMark(op2.mBufferedAmountHighWaterMark)
   {
   }
 
@@ -1660,6 +1728,8 @@ namespace ortc
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::DataChannelStats", "bytesSent", mBytesSent);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::DataChannelStats", "messagesReceived", mMessagesReceived);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::DataChannelStats", "bytesReceived", mBytesReceived);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::DataChannelStats", "bufferedAmount", mBufferedAmount);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::DataChannelStats", "bufferedAmountHighWaterMark", mBufferedAmountHighWaterMark);
   }
 
   //---------------------------------------------------------------------------
@@ -1688,6 +1758,8 @@ namespace ortc
     UseHelper::adoptElementValue(rootEl, "bytesSent", mBytesSent);
     UseHelper::adoptElementValue(rootEl, "messagesReceived", mMessagesReceived);
     UseHelper::adoptElementValue(rootEl, "bytesReceived", mBytesReceived);
+    UseHelper::adoptElementValue(rootEl, "bufferedAmount", mBufferedAmount);
+    UseHelper::adoptElementValue(rootEl, "bufferedAmountHighWaterMark", mBufferedAmountHighWaterMark);
 
     if (!rootEl->hasChildren()) return ElementPtr();
 
@@ -1725,6 +1797,10 @@ namespace ortc
     hasher.update(":");
     hasher.update(mBytesReceived);
     hasher.update(":");
+    hasher.update(mBufferedAmount);
+    hasher.update(":");
+    hasher.update(mBufferedAmountHighWaterMark);
+    hasher.update(":");
 
     return hasher.final();
   }
@@ -1742,6 +1818,8 @@ namespace ortc
     internal::reportInt64(mID, timestamp, "bytesSent", SafeInt<int64>(mBytesSent));
     internal::reportInt32(mID, timestamp, "messagesReceived", SafeInt<int32>(mMessagesReceived));
     internal::reportInt64(mID, timestamp, "bytesReceived", SafeInt<int64>(mBytesReceived));
+    internal::reportInt64(mID, timestamp, "bufferedAmount", SafeInt<int64>(mBufferedAmount));
+    internal::reportInt64(mID, timestamp, "bufferedAmountHighWaterMark", SafeInt<int64>(mBufferedAmountHighWaterMark));
   }
 
   //---------------------------------------------------------------------------
@@ -1757,7 +1835,17 @@ namespace ortc
     Stats(op2),
     mBytesSent(op2.mBytesSent),
     mBytesReceived(op2.mBytesReceived),
-    mRTCPGathererStatsID(op2.mRTCPGathererStatsID)
+    mPacketsSent(op2.mPacketsSent),
+    mPacketsReceived(op2.mPacketsReceived),
+    mPacketsDiscarded(op2.mPacketsDiscarded),
+    mSendWouldBlock(op2.mSendWouldBlock),
+    mRTCPGathererStatsID(op2.mRTCPGathererStatsID),
+    mTimeToFirstHostCandidate(op2.mTimeToFirstHostCandidate),
+    mTimeToFirstServerReflexiveCandidate(op2.mTimeToFirstServerReflexiveCandidate),
+    mTimeToFirstRelayCandidate(op2.mTimeToFirstRelayCandidate),
+    mTimeToGatheringComplete(op2.mTimeToGatheringComplete),
+    mWarmPoolSocketsAdopted(op2.mWarmPoolSocketsAdopted),
+    mWarmPoolReflexiveMappingsAdopted(op2.mWarmPoolReflexiveMappingsAdopted)
   {
   }
 
@@ -1771,7 +1859,17 @@ namespace ortc
 
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "bytesSent", mBytesSent);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "bytesReceived", mBytesReceived);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "packetsSent", mPacketsSent);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "packetsReceived", mPacketsReceived);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "packetsDiscarded", mPacketsDiscarded);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "sendWouldBlock", mSendWouldBlock);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "rtcpGathererStatsId", mRTCPGathererStatsID);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "timeToFirstHostCandidate", mTimeToFirstHostCandidate);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "timeToFirstServerReflexiveCandidate", mTimeToFirstServerReflexiveCandidate);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "timeToFirstRelayCandidate", mTimeToFirstRelayCandidate);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "timeToGatheringComplete", mTimeToGatheringComplete);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "warmPoolSocketsAdopted", mWarmPoolSocketsAdopted);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICEGathererStats", "warmPoolReflexiveMappingsAdopted", mWarmPoolReflexiveMappingsAdopted);
   }
 
   //---------------------------------------------------------------------------
@@ -1794,7 +1892,17 @@ namespace ortc
 
     UseHelper::adoptElementValue(rootEl, "bytesSent", mBytesSent);
     UseHelper::adoptElementValue(rootEl, "bytesReceived", mBytesReceived);
+    UseHelper::adoptElementValue(rootEl, "packetsSent", mPacketsSent);
+    UseHelper::adoptElementValue(rootEl, "packetsReceived", mPacketsReceived);
+    UseHelper::adoptElementValue(rootEl, "packetsDiscarded", mPacketsDiscarded);
+    UseHelper::adoptElementValue(rootEl, "sendWouldBlock", mSendWouldBlock);
     UseHelper::adoptElementValue(rootEl, "rtcpGathererStatsId", mRTCPGathererStatsID, false);
+    UseHelper::adoptElementValue(rootEl, "timeToFirstHostCandidate", mTimeToFirstHostCandidate);
+    UseHelper::adoptElementValue(rootEl, "timeToFirstServerReflexiveCandidate", mTimeToFirstServerReflexiveCandidate);
+    UseHelper::adoptElementValue(rootEl, "timeToFirstRelayCandidate", mTimeToFirstRelayCandidate);
+    UseHelper::adoptElementValue(rootEl, "timeToGatheringComplete", mTimeToGatheringComplete);
+    UseHelper::adoptElementValue(rootEl, "warmPoolSocketsAdopted", mWarmPoolSocketsAdopted);
+    UseHelper::adoptElementValue(rootEl, "warmPoolReflexiveMappingsAdopted", mWarmPoolReflexiveMappingsAdopted);
 
     if (!rootEl->hasChildren()) return ElementPtr();
 
@@ -1820,8 +1928,28 @@ namespace ortc
     hasher.update(":");
     hasher.update(mBytesReceived);
     hasher.update(":");
+    hasher.update(mPacketsSent);
+    hasher.update(":");
+    hasher.update(mPacketsReceived);
+    hasher.update(":");
+    hasher.update(mPacketsDiscarded);
+    hasher.update(":");
+    hasher.update(mSendWouldBlock);
+    hasher.update(":");
     hasher.update(mRTCPGathererStatsID);
     hasher.update(":");
+    hasher.update(mTimeToFirstHostCandidate);
+    hasher.update(":");
+    hasher.update(mTimeToFirstServerReflexiveCandidate);
+    hasher.update(":");
+    hasher.update(mTimeToFirstRelayCandidate);
+    hasher.update(":");
+    hasher.update(mTimeToGatheringComplete);
+    hasher.update(":");
+    hasher.update(mWarmPoolSocketsAdopted);
+    hasher.update(":");
+    hasher.update(mWarmPoolReflexiveMappingsAdopted);
+    hasher.update(":");
 
     return hasher.final();
   }
@@ -1832,8 +1960,18 @@ namespace ortc
     Stats::eventTrace(timestamp);
 
     internal::reportInt64(mID, timestamp, "bytesSent", SafeInt<int64>(mBytesSent));
-    internal::reportInt64(mID, timestamp, "bytesSent", SafeInt<int64>(mBytesReceived));
+    internal::reportInt64(mID, timestamp, "bytesReceived", SafeInt<int64>(mBytesReceived));
+    internal::reportInt64(mID, timestamp, "packetsSent", SafeInt<int64>(mPacketsSent));
+    internal::reportInt64(mID, timestamp, "packetsReceived", SafeInt<int64>(mPacketsReceived));
+    internal::reportInt64(mID, timestamp, "packetsDiscarded", SafeInt<int64>(mPacketsDiscarded));
+    internal::reportInt64(mID, timestamp, "sendWouldBlock", SafeInt<int64>(mSendWouldBlock));
     internal::reportString(mID, timestamp, "rtcpGathererStatsId", mRTCPGathererStatsID);
+    internal::reportInt64(mID, timestamp, "timeToFirstHostCandidate", SafeInt<int64>(mTimeToFirstHostCandidate.count()));
+    internal::reportInt64(mID, timestamp, "timeToFirstServerReflexiveCandidate", SafeInt<int64>(mTimeToFirstServerReflexiveCandidate.count()));
+    internal::reportInt64(mID, timestamp, "timeToFirstRelayCandidate", SafeInt<int64>(mTimeToFirstRelayCandidate.count()));
+    internal::reportInt64(mID, timestamp, "timeToGatheringComplete", SafeInt<int64>(mTimeToGatheringComplete.count()));
+    internal::reportInt64(mID, timestamp, "warmPoolSocketsAdopted", SafeInt<int64>(mWarmPoolSocketsAdopted));
+    internal::reportInt64(mID, timestamp, "warmPoolReflexiveMappingsAdopted", SafeInt<int64>(mWarmPoolReflexiveMappingsAdopted));
   }
 
 
@@ -2253,7 +2391,11 @@ namespace ortc
     mBytesReceived(op2.mBytesReceived),
     mRoundTripTime(op2.mRoundTripTime),
     mAvailableOutgoingBitrate(op2.mAvailableOutgoingBitrate),
-    mAvailableIncomingBitrate(op2.mAvailableIncomingBitrate)
+    mAvailableIncomingBitrate(op2.mAvailableIncomingBitrate),
+    mRequestsSent(op2.mRequestsSent),
+    mRequestsReceived(op2.mRequestsReceived),
+    mResponsesSent(op2.mResponsesSent),
+    mResponsesReceived(op2.mResponsesReceived)
   {
   }
 
@@ -2290,6 +2432,10 @@ namespace ortc
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "roundTripTime", mRoundTripTime);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "availableOutgoingBitrate", mAvailableOutgoingBitrate);
     UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "availableIncomingBitrate", mAvailableIncomingBitrate);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "requestsSent", mRequestsSent);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "requestsReceived", mRequestsReceived);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "responsesSent", mResponsesSent);
+    UseHelper::getElementValue(rootEl, "ortc::IStatsReportTypes::ICECandidatePairStats", "responsesReceived", mResponsesReceived);
   }
 
   //---------------------------------------------------------------------------
@@ -2323,6 +2469,10 @@ namespace ortc
     UseHelper::adoptElementValue(rootEl, "roundTripTime", mRoundTripTime);
     UseHelper::adoptElementValue(rootEl, "availableOutgoingBitrate", mAvailableOutgoingBitrate);
     UseHelper::adoptElementValue(rootEl, "availableIncomingBitrate", mAvailableIncomingBitrate);
+    UseHelper::adoptElementValue(rootEl, "requestsSent", mRequestsSent);
+    UseHelper::adoptElementValue(rootEl, "requestsReceived", mRequestsReceived);
+    UseHelper::adoptElementValue(rootEl, "responsesSent", mResponsesSent);
+    UseHelper::adoptElementValue(rootEl, "responsesReceived", mResponsesReceived);
 
     if (!rootEl->hasChildren()) return ElementPtr();
 
@@ -2368,6 +2518,14 @@ namespace ortc
     hasher.update(":");
     hasher.update(mAvailableIncomingBitrate);
     hasher.update(":");
+    hasher.update(mRequestsSent);
+    hasher.update(":");
+    hasher.update(mRequestsReceived);
+    hasher.update(":");
+    hasher.update(mResponsesSent);
+    hasher.update(":");
+    hasher.update(mResponsesReceived);
+    hasher.update(":");
 
     return hasher.final();
   }
@@ -2390,6 +2548,10 @@ namespace ortc
     internal::reportFloat(mID, timestamp, "roundTripTime", static_cast<float>(mRoundTripTime));
     internal::reportFloat(mID, timestamp, "availableOutgoingBitrate", static_cast<float>(mAvailableOutgoingBitrate));
     internal::reportFloat(mID, timestamp, "availableIncomingBitrate", static_cast<float>(mAvailableIncomingBitrate));
+    internal::reportInt64(mID, timestamp, "requestsSent", SafeInt<int64>(mRequestsSent));
+    internal::reportInt64(mID, timestamp, "requestsReceived", SafeInt<int64>(mRequestsReceived));
+    internal::reportInt64(mID, timestamp, "responsesSent", SafeInt<int64>(mResponsesSent));
+    internal::reportInt64(mID, timestamp, "responsesReceived", SafeInt<int64>(mResponsesReceived));
   }
 
   //---------------------------------------------------------------------------
@@ -0,0 +1,480 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#include <ortc/internal/ortc_TimerWheel.h>
+#include <ortc/internal/ortc_ORTC.h>
+#include <ortc/internal/platform.h>
+
+#include <ortc/services/IHelper.h>
+#include <ortc/services/ISettings.h>
+
+#include <zsLib/Singleton.h>
+#include <zsLib/XML.h>
+
+#include <map>
+
+namespace ortc { ZS_DECLARE_SUBSYSTEM(ortclib) }
+
+namespace ortc
+{
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::IHelper, UseServicesHelper)
+  ZS_DECLARE_TYPEDEF_PTR(ortc::services::ISettings, UseSettings)
+
+  using zsLib::Log;
+
+  namespace internal
+  {
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ITimerWheelForSettings
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void ITimerWheelForSettings::applyDefaults()
+    {
+      UseSettings::setUInt(ORTC_SETTING_TIMER_WHEEL_TICK_IN_MILLISECONDS, 50);
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerWheel
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    TimerWheel::TimerWheel(
+                           const make_private &,
+                           IMessageQueuePtr queue
+                           ) :
+      SharedRecursiveLock(SharedRecursiveLock::create()),
+      MessageQueueAssociator(queue),
+      mStartTime(zsLib::now())
+    {
+      ZS_LOG_BASIC(log("created"))
+
+      mTickDuration = Milliseconds(UseSettings::getUInt(ORTC_SETTING_TIMER_WHEEL_TICK_IN_MILLISECONDS));
+      if (mTickDuration < Milliseconds(1)) mTickDuration = Milliseconds(1);
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::init()
+    {
+      AutoRecursiveLock lock(*this);
+      ZS_LOG_DEBUG(debug("init"))
+    }
+
+    //-------------------------------------------------------------------------
+    TimerWheel::~TimerWheel()
+    {
+      mThisWeak.reset();
+      ZS_LOG_BASIC(log("destroyed"))
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerWheel => (friends)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    ElementPtr TimerWheel::toDebug(TimerWheelPtr wheel)
+    {
+      if (!wheel) return ElementPtr();
+      return wheel->toDebug();
+    }
+
+    //-------------------------------------------------------------------------
+    TimerWheelPtr TimerWheel::singleton()
+    {
+      AutoRecursiveLock lock(*UseServicesHelper::getGlobalLock());
+      static SingletonLazySharedPtr<TimerWheel> singleton(create());
+      TimerWheelPtr result = singleton.singleton();
+
+      static zsLib::SingletonManager::Register registerSingleton("ortc::TimerWheel", result);
+
+      if (!result) {
+        ZS_LOG_WARNING(Detail, slog("singleton gone"))
+      }
+
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    TimerWheel::TimerID TimerWheel::arm(
+                                        ITimerWheelDelegatePtr delegate,
+                                        Time fireAt
+                                        )
+    {
+      ZS_THROW_INVALID_ARGUMENT_IF(!delegate)
+
+      AutoRecursiveLock lock(*this);
+
+      if (!mTimer) {
+        // the wheel was idle so re-align the current tick with the clock
+        Time tickNow = zsLib::now();
+        mCurrentTick = (tickNow > mStartTime ? static_cast<Tick>((tickNow - mStartTime) / mTickDuration) : 0);
+        mTimer = Timer::create(mThisWeak.lock(), mTickDuration);
+        ++mTotalSystemTimers;
+      }
+
+      EntryPtr entry(make_shared<Entry>());
+      entry->mID = zsLib::createPUID();
+      entry->mDelegate = delegate;
+      entry->mExpiry = toTick(fireAt);
+
+      place(entry);
+      mEntries[entry->mID] = entry;
+
+      ++mTotalArmed;
+      if (mEntries.size() > mPeakActiveTimers) mPeakActiveTimers = mEntries.size();
+
+      ZS_LOG_INSANE(log("armed timer") + ZS_PARAM("timer id", entry->mID) + ZS_PARAM("expiry tick", entry->mExpiry) + ZS_PARAM("current tick", mCurrentTick))
+
+      return entry->mID;
+    }
+
+    //-------------------------------------------------------------------------
+    TimerWheel::TimerID TimerWheel::arm(
+                                        ITimerWheelDelegatePtr delegate,
+                                        Milliseconds fireIn
+                                        )
+    {
+      return arm(delegate, zsLib::now() + fireIn);
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::cancel(TimerID timerID)
+    {
+      if (0 == timerID) return;
+
+      AutoRecursiveLock lock(*this);
+
+      auto found = mEntries.find(timerID);
+      if (found == mEntries.end()) return;
+
+      EntryPtr entry = (*found).second;
+      mEntries.erase(found);
+
+      remove(*entry);
+      ++mTotalCancelled;
+
+      ZS_LOG_INSANE(log("cancelled timer") + ZS_PARAM("timer id", timerID))
+    }
+
+    //-------------------------------------------------------------------------
+    TimerWheel::Stats TimerWheel::getStats() const
+    {
+      AutoRecursiveLock lock(*this);
+
+      Stats result;
+      result.mActiveTimers = mEntries.size();
+      result.mPeakActiveTimers = mPeakActiveTimers;
+      result.mTotalArmed = mTotalArmed;
+      result.mTotalCancelled = mTotalCancelled;
+      result.mTotalFired = mTotalFired;
+      result.mTotalCallbacks = mTotalCallbacks;
+      result.mTotalSystemTimers = mTotalSystemTimers;
+      result.mTotalWakeUps = mTotalWakeUps;
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerWheel => ISingletonManagerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::notifySingletonCleanup()
+    {
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerWheel => ITimerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::onTimer(TimerPtr timer)
+    {
+      typedef std::pair<ITimerWheelDelegatePtr, TimerIDListPtr> DelegateTimersPair;
+      typedef std::map<ITimerWheelDelegate *, DelegateTimersPair> DelegateTimersMap;
+
+      DelegateTimersMap fired;
+
+      // scope: advance the wheel to the current time
+      {
+        AutoRecursiveLock lock(*this);
+
+        if (timer != mTimer) {
+          ZS_LOG_WARNING(Debug, log("notified about obsolete timer") + ZS_PARAM("timer id", timer->getID()))
+          return;
+        }
+
+        ++mTotalWakeUps;
+
+        Time tickNow = zsLib::now();
+        Tick nowTick = (tickNow > mStartTime ? static_cast<Tick>((tickNow - mStartTime) / mTickDuration) : 0);
+
+        EntryList expired;
+        advance(nowTick, expired);
+
+        for (auto iter = expired.begin(); iter != expired.end(); ++iter) {
+          auto &entry = (*iter);
+          auto &pair = fired[entry->mDelegate.get()];
+          if (!pair.second) {
+            pair.first = entry->mDelegate;
+            pair.second = make_shared<TimerIDList>();
+          }
+          pair.second->push_back(entry->mID);
+        }
+
+        mTotalFired += expired.size();
+        mTotalCallbacks += fired.size();
+
+        if (mEntries.size() < 1) {
+          ZS_LOG_TRACE(log("no timers armed (wheel going idle)"))
+          mTimer->cancel();
+          mTimer.reset();
+        }
+      }
+
+      for (auto iter = fired.begin(); iter != fired.end(); ++iter) {
+        auto &pair = (*iter).second;
+        try {
+          pair.first->onTimerWheelFired(pair.second);
+        } catch (const ITimerWheelDelegateProxy::Exceptions::DelegateGone &) {
+          ZS_LOG_WARNING(Trace, log("delegate gone"))
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerWheel => (internal)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    TimerWheelPtr TimerWheel::create()
+    {
+      TimerWheelPtr pThis(make_shared<TimerWheel>(make_private {}, IORTCForInternal::queueORTC()));
+      pThis->mThisWeak = pThis;
+      pThis->init();
+      return pThis;
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params TimerWheel::log(const char *message) const
+    {
+      ElementPtr objectEl = Element::create("ortc::TimerWheel");
+      UseServicesHelper::debugAppend(objectEl, "id", mID);
+      return Log::Params(message, objectEl);
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params TimerWheel::slog(const char *message)
+    {
+      return Log::Params(message, "ortc::TimerWheel");
+    }
+
+    //-------------------------------------------------------------------------
+    Log::Params TimerWheel::debug(const char *message) const
+    {
+      return Log::Params(message, toDebug());
+    }
+
+    //-------------------------------------------------------------------------
+    ElementPtr TimerWheel::toDebug() const
+    {
+      AutoRecursiveLock lock(*this);
+
+      ElementPtr resultEl = Element::create("ortc::TimerWheel");
+
+      UseServicesHelper::debugAppend(resultEl, "id", mID);
+
+      UseServicesHelper::debugAppend(resultEl, "tick duration", mTickDuration);
+      UseServicesHelper::debugAppend(resultEl, "start time", mStartTime);
+      UseServicesHelper::debugAppend(resultEl, "current tick", mCurrentTick);
+
+      UseServicesHelper::debugAppend(resultEl, "active timers", mEntries.size());
+      UseServicesHelper::debugAppend(resultEl, "peak active timers", mPeakActiveTimers);
+      UseServicesHelper::debugAppend(resultEl, "timer", mTimer ? mTimer->getID() : 0);
+
+      UseServicesHelper::debugAppend(resultEl, "total armed", mTotalArmed);
+      UseServicesHelper::debugAppend(resultEl, "total cancelled", mTotalCancelled);
+      UseServicesHelper::debugAppend(resultEl, "total fired", mTotalFired);
+      UseServicesHelper::debugAppend(resultEl, "total callbacks", mTotalCallbacks);
+
+      // before (one system timer per armed timer) vs. after (the wheel)
+      UseServicesHelper::debugAppend(resultEl, "per timer system timers", mTotalArmed);
+      UseServicesHelper::debugAppend(resultEl, "per timer wake ups", mTotalFired);
+      UseServicesHelper::debugAppend(resultEl, "wheel system timers", mTotalSystemTimers);
+      UseServicesHelper::debugAppend(resultEl, "wheel wake ups", mTotalWakeUps);
+
+      return resultEl;
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::cancel()
+    {
+      AutoRecursiveLock lock(*this);
+
+      ZS_LOG_DEBUG(log("cancel called"))
+
+      if (mTimer) {
+        mTimer->cancel();
+        mTimer.reset();
+      }
+
+      for (size_t level = 0; level < ORTC_TIMER_WHEEL_LEVELS; ++level) {
+        for (size_t slot = 0; slot < ORTC_TIMER_WHEEL_SLOTS_PER_LEVEL; ++slot) {
+          mSlots[level][slot].clear();
+        }
+      }
+      mEntries.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    TimerWheel::Tick TimerWheel::toTick(Time when) const
+    {
+      if (when <= mStartTime) return 0;
+
+      // round up so a timer never fires before its requested time
+      auto elapsed = when - mStartTime;
+      auto ticks = static_cast<Tick>(elapsed / mTickDuration);
+      if (elapsed % mTickDuration != decltype(elapsed)::zero()) ++ticks;
+      return ticks;
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::place(EntryPtr entry)
+    {
+      if (entry->mExpiry <= mCurrentTick) entry->mExpiry = mCurrentTick + 1;
+
+      Tick delta = entry->mExpiry - mCurrentTick;
+      Tick position = entry->mExpiry;
+
+      size_t level = 0;
+      for (; level < ORTC_TIMER_WHEEL_LEVELS - 1; ++level) {
+        if (delta < (static_cast<Tick>(1) << (ORTC_TIMER_WHEEL_BITS_PER_LEVEL * (level + 1)))) break;
+      }
+
+      if (ORTC_TIMER_WHEEL_LEVELS - 1 == level) {
+        // beyond the wheel's range; park in the farthest top level slot and
+        // re-place when that slot cascades
+        Tick maxDelta = (static_cast<Tick>(1) << (ORTC_TIMER_WHEEL_BITS_PER_LEVEL * ORTC_TIMER_WHEEL_LEVELS)) - 1;
+        if (delta > maxDelta) position = mCurrentTick + maxDelta;
+      }
+
+      size_t slot = static_cast<size_t>((position >> (ORTC_TIMER_WHEEL_BITS_PER_LEVEL * level)) & (ORTC_TIMER_WHEEL_SLOTS_PER_LEVEL - 1));
+
+      auto &slotList = mSlots[level][slot];
+      entry->mLevel = level;
+      entry->mSlot = slot;
+      entry->mPosition = slotList.insert(slotList.end(), entry);
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::remove(Entry &entry)
+    {
+      mSlots[entry.mLevel][entry.mSlot].erase(entry.mPosition);
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::cascade(size_t level)
+    {
+      size_t slot = static_cast<size_t>((mCurrentTick >> (ORTC_TIMER_WHEEL_BITS_PER_LEVEL * level)) & (ORTC_TIMER_WHEEL_SLOTS_PER_LEVEL - 1));
+
+      // higher levels drain first so their entries can land in this slot
+      if ((0 == slot) &&
+          (level + 1 < ORTC_TIMER_WHEEL_LEVELS)) {
+        cascade(level + 1);
+      }
+
+      EntryList pending;
+      pending.swap(mSlots[level][slot]);
+
+      for (auto iter = pending.begin(); iter != pending.end(); ++iter) {
+        place(*iter);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerWheel::advance(
+                             Tick toTick,
+                             EntryList &outExpired
+                             )
+    {
+      while (mCurrentTick < toTick) {
+        ++mCurrentTick;
+
+        size_t slot = static_cast<size_t>(mCurrentTick & (ORTC_TIMER_WHEEL_SLOTS_PER_LEVEL - 1));
+        if (0 == slot) cascade(1);
+
+        EntryList pending;
+        pending.swap(mSlots[0][slot]);
+
+        for (auto iter = pending.begin(); iter != pending.end(); ++iter) {
+          auto &entry = (*iter);
+          if (entry->mExpiry > mCurrentTick) {
+            place(entry);
+            continue;
+          }
+          mEntries.erase(entry->mID);
+          outExpired.push_back(entry);
+        }
+
+        if (mEntries.size() < 1) {
+          mCurrentTick = toTick;
+          break;
+        }
+      }
+    }
+
+  }
+}
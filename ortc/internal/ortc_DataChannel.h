@@ -120,13 +120,17 @@ namespace ortc
     {
       virtual void onRequestShutdown() = 0;
       virtual void onNotifiedClosed() = 0;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) = 0;
     };
   }
 }
 
 ZS_DECLARE_PROXY_BEGIN(ortc::internal::IDataChannelAsyncDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsProvider::PromiseWithStatsReportPtr, PromiseWithStatsReportPtr)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsReportTypes::StatsTypeSet, StatsTypeSet)
 ZS_DECLARE_PROXY_METHOD_0(onRequestShutdown)
 ZS_DECLARE_PROXY_METHOD_0(onNotifiedClosed)
+ZS_DECLARE_PROXY_METHOD_2(onResolveStatsPromise, PromiseWithStatsReportPtr, StatsTypeSet)
 ZS_DECLARE_PROXY_END()
 
 namespace ortc
@@ -169,7 +173,7 @@ namespace ortc
       ZS_DECLARE_STRUCT_PTR(TearAwayData)
 
       typedef std::list<SCTPPacketIncomingPtr> BufferIncomingList;
-      typedef std::list<SCTPPacketOutgoingPtr> BufferOutgoingList;
+      ZS_DECLARE_STRUCT_PTR(OutgoingRing)
 
     public:
       DataChannel(
@@ -237,6 +241,15 @@ namespace ortc
                         const BYTE *buffer,
                         size_t bufferSizeInBytes
                         ) override;
+      virtual void send(SecureByteBlockPtr data) override;
+      virtual void sendPartial(
+                               SecureByteBlockPtr chunk,
+                               bool lastChunk
+                               ) override;
+      virtual void sendPartial(
+                               const String &chunk,
+                               bool lastChunk
+                               ) override;
 
       //-----------------------------------------------------------------------
       #pragma mark
@@ -280,6 +293,7 @@ namespace ortc
 
       virtual void onRequestShutdown() override;
       virtual void onNotifiedClosed() override;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) override;
 
       //-----------------------------------------------------------------------
       #pragma mark
@@ -330,8 +344,8 @@ namespace ortc
 
       bool send(
                 SCTPPayloadProtocolIdentifier ppid,
-                const BYTE *buffer,
-                size_t bufferSizeInBytes
+                SecureByteBlockPtr buffer,
+                bool streamChunk = false
                 );
 
       void sendControlOpen();
@@ -360,6 +374,38 @@ namespace ortc
         IDataChannelSubscriptionPtr mDefaultSubscription;
       };
 
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark DataChannel::OutgoingRing
+      #pragma mark
+
+      // Buffered outgoing packets kept in a power-of-two ring of slots so
+      // queueing and consuming are O(1) without a node allocation per send;
+      // control packets can still be queued ahead of pending data.
+      struct OutgoingRing
+      {
+        typedef std::vector<SCTPPacketOutgoingPtr> PacketVector;
+
+        PacketVector mSlots;
+        size_t mHead {};
+        size_t mSize {};
+
+        size_t size() const {return mSize;}
+        bool isEmpty() const {return 0 == mSize;}
+
+        SCTPPacketOutgoingPtr front() const;
+
+        void pushBack(SCTPPacketOutgoingPtr packet);
+        void pushFront(SCTPPacketOutgoingPtr packet);
+        void popFront();
+        void clear();
+
+        ElementPtr toDebug() const;
+
+      protected:
+        void grow();
+      };
+
     protected:
       //-----------------------------------------------------------------------
       #pragma mark
@@ -392,12 +438,20 @@ namespace ortc
       ParametersPtr mParameters;
 
       BufferIncomingList mIncomingData;
-      BufferOutgoingList mOutgoingData;
+      OutgoingRing mOutgoingData;
       size_t mOutgoingBufferFillSize {};
+      size_t mOutgoingBufferFillSizeHighWaterMark {};
       size_t mBufferedAmountLowThreshold {};
       bool mBufferedAmountLowThresholdFired {};
 
+      unsigned long mMessagesSent {};
+      unsigned long long mBytesSent {};
+      unsigned long mMessagesReceived {};
+      unsigned long long mBytesReceived {};
+
       PromisePtr mSendReady;
+
+      Optional<SCTPPayloadProtocolIdentifier> mPartialSendType;
     };
 
     //-------------------------------------------------------------------------
@@ -445,6 +499,7 @@ ZS_DECLARE_TEAR_AWAY_TYPEDEF(ortc::IDataTransportPtr, IDataTransportPtr)
 ZS_DECLARE_TEAR_AWAY_TYPEDEF(ortc::IDataChannelTypes::ParametersPtr, ParametersPtr)
 ZS_DECLARE_TEAR_AWAY_TYPEDEF(ortc::IDataChannelTypes::States, States)
 ZS_DECLARE_TEAR_AWAY_TYPEDEF(ortc::SecureByteBlock, SecureByteBlock)
+ZS_DECLARE_TEAR_AWAY_TYPEDEF(ortc::SecureByteBlockPtr, SecureByteBlockPtr)
 ZS_DECLARE_TEAR_AWAY_TYPEDEF(zsLib::String, String)
 ZS_DECLARE_TEAR_AWAY_TYPEDEF(zsLib::BYTE, BYTE)
 ZS_DECLARE_TEAR_AWAY_METHOD_CONST_RETURN_1(getStats, PromiseWithStatsReportPtr, const StatsTypeSet &)
@@ -462,4 +517,7 @@ ZS_DECLARE_TEAR_AWAY_METHOD_0(close)
 ZS_DECLARE_TEAR_AWAY_METHOD_1(send, const String &)
 ZS_DECLARE_TEAR_AWAY_METHOD_1(send, const SecureByteBlock &)
 ZS_DECLARE_TEAR_AWAY_METHOD_2(send, const BYTE *, size_t)
+ZS_DECLARE_TEAR_AWAY_METHOD_1(send, SecureByteBlockPtr)
+ZS_DECLARE_TEAR_AWAY_METHOD_2(sendPartial, SecureByteBlockPtr, bool)
+ZS_DECLARE_TEAR_AWAY_METHOD_2(sendPartial, const String &, bool)
 ZS_DECLARE_TEAR_AWAY_END()
@@ -34,6 +34,8 @@
 
 #include <ortc/internal/types.h>
 #include <ortc/IHelper.h>
+#include <ortc/IICETypes.h>
+#include <ortc/IStatsReport.h>
 
 namespace ortc
 {
@@ -141,6 +143,171 @@ namespace ortc
       static void adoptElementValue(ElementPtr elem, const char *subElementName, const Optional<Milliseconds> &value);
       static void adoptElementValue(ElementPtr elem, const char *subElementName, const Optional<Microseconds> &value);
 
+      static IStatsReportTypes::ICECandidateAttributesPtr createCandidateStats(
+                                                                               const String &statsID,
+                                                                               const IICETypes::Candidate &candidate
+                                                                               );
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IPRouteKey
+    #pragma mark
+
+    // compact binary (local object id, remote IP:port) key suitable for
+    // hashed containers (avoids string hashes and tree walks per packet)
+    struct IPRouteKey
+    {
+      struct Hasher
+      {
+        size_t operator()(const IPRouteKey &key) const {return key.hash();}
+      };
+
+      PUID mLocalID {};
+      ULONGLONG mIP[2] {};
+      WORD mPort {};
+
+      IPRouteKey() {}
+      IPRouteKey(
+                 PUID localID,
+                 const IPAddress &remoteIP
+                 );
+      IPRouteKey(
+                 const void *localObject,   // identity only (the container must keep the object alive)
+                 const IPAddress &remoteIP
+                 );
+
+      bool operator==(const IPRouteKey &op2) const;
+      bool operator!=(const IPRouteKey &op2) const {return !(*this == op2);}
+
+      size_t hash() const;
+      ElementPtr toDebug() const;
+    };
+
+    //-------------------------------------------------------------------------
+    struct IPAddressHasher
+    {
+      size_t operator()(const IPAddress &ip) const {return IPRouteKey(PUID(), ip).hash();}
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark CandidateKey
+    #pragma mark
+
+    // internal identity of an ICE candidate; a 64-bit structural hash is
+    // used for bucketing and the candidate fields are compared on a hash
+    // match (IICETypes::Candidate::hash() remains the external fingerprint)
+    struct CandidateKey
+    {
+      struct Hasher
+      {
+        size_t operator()(const CandidateKey &key) const {return static_cast<size_t>(key.mHash);}
+      };
+
+      ULONGLONG mHash {};
+      const IICETypes::Candidate *mCandidate {};
+      IICETypes::CandidatePtr mHold;    // keeps mCandidate alive when key is stored in a container
+      bool mIncludePriorities {true};
+
+      CandidateKey() {}
+      CandidateKey(
+                   IICETypes::CandidatePtr candidate,
+                   bool includePriorities = true
+                   );
+      CandidateKey(
+                   const IICETypes::Candidate &candidate,   // lookup only (candidate is not held)
+                   bool includePriorities = true
+                   );
+
+      bool hasData() const {return NULL != mCandidate;}
+
+      bool operator==(const CandidateKey &op2) const;
+      bool operator!=(const CandidateKey &op2) const {return !(*this == op2);}
+
+      String string() const;
+
+      static ULONGLONG hash(
+                            const IICETypes::Candidate &candidate,
+                            bool includePriorities = true
+                            );
+      static bool isEqual(
+                          const IICETypes::Candidate &op1,
+                          const IICETypes::Candidate &op2,
+                          bool includePriorities = true
+                          );
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark CandidatePairKey
+    #pragma mark
+
+    struct CandidatePairKey
+    {
+      struct Hasher
+      {
+        size_t operator()(const CandidatePairKey &key) const {return static_cast<size_t>(key.mHash);}
+      };
+
+      ULONGLONG mHash {};
+      CandidateKey mLocal;
+      CandidateKey mRemote;
+
+      CandidatePairKey() {}
+      CandidatePairKey(
+                       IICETypes::CandidatePtr local,
+                       IICETypes::CandidatePtr remote
+                       );
+
+      bool hasData() const {return mLocal.hasData() && mRemote.hasData();}
+
+      bool operator==(const CandidatePairKey &op2) const;
+      bool operator!=(const CandidatePairKey &op2) const {return !(*this == op2);}
+
+      String string() const;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark Clock
+    #pragma mark
+
+    // now() reads the system clock (zsLib::now(), not a monotonic clock) and
+    // is meant for round trip and arrival time measurements. coarseNow() returns the time captured when the
+    // current receive batch began on this thread, which is close enough for
+    // per-packet bookkeeping (last usage, buffering expiry). Outside of a
+    // batch coarseNow() falls back to now().
+    class Clock
+    {
+    public:
+      // open on the stack around the handling of a batch of received
+      // packets (nested batches share the outermost batch's time)
+      class Batch
+      {
+      public:
+        Batch();
+        ~Batch();
+
+      private:
+        Batch(const Batch &) = delete;
+        Batch &operator=(const Batch &) = delete;
+      };
+
+      static Time now() {return zsLib::now();}
+      static Time coarseNow();
     };
   }
 }
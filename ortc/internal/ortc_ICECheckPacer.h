@@ -0,0 +1,292 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#pragma once
+
+#include <ortc/internal/types.h>
+
+#include <zsLib/Timer.h>
+
+#include <list>
+#include <unordered_map>
+
+#define ORTC_SETTING_ICE_CHECK_PACER_CHECKS_PER_SECOND "ortc/ice-check-pacer/checks-per-second"
+#define ORTC_SETTING_ICE_CHECK_PACER_BURST "ortc/ice-check-pacer/burst"
+#define ORTC_SETTING_ICE_CHECK_PACER_TICK_IN_MILLISECONDS "ortc/ice-check-pacer/tick-in-milliseconds"
+
+namespace ortc
+{
+  namespace internal
+  {
+    ZS_DECLARE_INTERACTION_PTR(IICECheckPacerForSettings)
+
+    ZS_DECLARE_INTERACTION_PROXY(IICECheckPacerDelegate)
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IICECheckPacerForSettings
+    #pragma mark
+
+    interaction IICECheckPacerForSettings
+    {
+      ZS_DECLARE_TYPEDEF_PTR(IICECheckPacerForSettings, ForSettings)
+
+      static void applyDefaults();
+
+      virtual ~IICECheckPacerForSettings() {}
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IICECheckPacerDelegate
+    #pragma mark
+
+    interaction IICECheckPacerDelegate
+    {
+      typedef PUID RequestID;
+      typedef std::list<RequestID> RequestIDList;
+      ZS_DECLARE_PTR(RequestIDList)
+
+      // every request belonging to this delegate that was granted a check
+      // slot on the same pacer tick is delivered in one call (on the
+      // delegate's queue)
+      virtual void onICECheckPacerGranted(RequestIDListPtr requests) = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICECheckPacer
+    #pragma mark
+
+    // Process wide connectivity check pacer (the global Ta). Every ICE
+    // transport asks for a slot before starting a new check; slots are
+    // handed out from a token bucket at a fixed rate, high priority
+    // requests first, then round-robin across transports so a single
+    // transport with many candidate pairs cannot starve the others.
+    class ICECheckPacer : public SharedRecursiveLock,
+                          public MessageQueueAssociator,
+                          public ISingletonManagerDelegate,
+                          public IICECheckPacerForSettings,
+                          public zsLib::ITimerDelegate
+    {
+    protected:
+      struct make_private {};
+
+    public:
+      friend interaction IICECheckPacerForSettings;
+
+      typedef IICECheckPacerDelegate::RequestID RequestID;
+      typedef IICECheckPacerDelegate::RequestIDList RequestIDList;
+      typedef IICECheckPacerDelegate::RequestIDListPtr RequestIDListPtr;
+      typedef PUID OwnerID;
+
+      enum Priorities
+      {
+        Priority_High,      // triggered checks and nominations
+        Priority_Normal,    // ordinary checks (keep warm checks on succeeded routes are not paced)
+
+        Priority_Last = Priority_Normal,
+      };
+
+      static const char *toString(Priorities priority);
+
+      ZS_DECLARE_STRUCT_PTR(Entry)
+      ZS_DECLARE_STRUCT_PTR(Owner)
+      ZS_DECLARE_STRUCT_PTR(Metrics)
+
+      typedef std::list<EntryPtr> EntryList;
+      typedef std::unordered_map<RequestID, EntryPtr> EntryMap;
+      typedef std::list<OwnerPtr> OwnerList;
+      typedef std::unordered_map<OwnerID, OwnerPtr> OwnerMap;
+
+    public:
+      ICECheckPacer(
+                    const make_private &,
+                    IMessageQueuePtr queue
+                    );
+
+    protected:
+      void init();
+
+    public:
+      ~ICECheckPacer();
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer => (friends)
+      #pragma mark
+
+      static ElementPtr toDebug(ICECheckPacerPtr pacer);
+
+      static ICECheckPacerPtr singleton();
+
+      virtual PUID getID() const {return mID;}
+
+      // delegate should be a proxy (e.g. IICECheckPacerDelegateProxy::createWeak(...))
+      virtual RequestID request(
+                                OwnerID ownerID,
+                                IICECheckPacerDelegatePtr delegate,
+                                Priorities priority = Priority_Normal
+                                );
+      virtual void cancel(RequestID requestID);
+
+      // account for a check that had to be sent without waiting for a slot
+      virtual void notifyCheckSent();
+
+      virtual MetricsPtr getMetrics() const;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer => ISingletonManagerDelegate
+      #pragma mark
+
+      virtual void notifySingletonCleanup() override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer => ITimerDelegate
+      #pragma mark
+
+      virtual void onTimer(TimerPtr timer) override;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer => (internal)
+      #pragma mark
+
+      static ICECheckPacerPtr create();
+
+      Log::Params log(const char *message) const;
+      static Log::Params slog(const char *message);
+      Log::Params debug(const char *message) const;
+      ElementPtr toDebug() const;
+
+      void cancel();
+
+      void refill();
+      void grant();
+      void remove(Entry &entry);
+
+    public:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer::Entry
+      #pragma mark
+
+      struct Entry
+      {
+        RequestID mID {};
+        OwnerPtr mOwner;
+        Priorities mPriority {Priority_Normal};
+        Time mQueued;
+
+        EntryList::iterator mPosition;
+      };
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer::Owner
+      #pragma mark
+
+      struct Owner
+      {
+        OwnerID mID {};
+        IICECheckPacerDelegatePtr mDelegate;
+
+        EntryList mQueue[Priority_Last + 1];
+
+        bool mInRotation[Priority_Last + 1] {};
+        OwnerList::iterator mRotationPosition[Priority_Last + 1];
+      };
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer::Metrics
+      #pragma mark
+
+      struct Metrics
+      {
+        size_t mQueueDepth[Priority_Last + 1] {};
+        size_t mMaxQueueDepth {};
+        size_t mOwners {};
+
+        size_t mTotalRequested {};
+        size_t mTotalGranted {};
+        size_t mTotalCancelled {};
+        size_t mTotalSentUnpaced {};
+
+        Milliseconds mMaxQueueDelay {};
+
+        ElementPtr toDebug() const;
+      };
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICECheckPacer (data)
+      #pragma mark
+
+      AutoPUID mID;
+      ICECheckPacerWeakPtr mThisWeak;
+
+      size_t mChecksPerSecond {};
+      double mBurst {};
+      Milliseconds mTickDuration {};
+
+      double mTokens {};
+      Time mLastRefill;
+
+      EntryMap mEntries;
+      OwnerMap mOwners;
+      OwnerList mRotation[Priority_Last + 1];
+
+      TimerPtr mTimer;
+
+      Metrics mMetrics;
+    };
+  }
+}
+
+ZS_DECLARE_PROXY_BEGIN(ortc::internal::IICECheckPacerDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::IICECheckPacerDelegate::RequestIDListPtr, RequestIDListPtr)
+ZS_DECLARE_PROXY_METHOD_1(onICECheckPacerGranted, RequestIDListPtr)
+ZS_DECLARE_PROXY_END()
@@ -36,6 +36,7 @@
 #include <ortc/IICEGatherer.h>
 
 #include <ortc/internal/ortc_ICEGathererRouter.h>
+#include <ortc/internal/ortc_Helper.h>
 
 #include <ortc/services/IBackOffTimer.h>
 #include <ortc/services/IDNS.h>
@@ -50,6 +51,8 @@
 
 #include <cryptopp/queue.h>
 
+#include <unordered_map>
+
 #define ORTC_SETTING_GATHERER_INTERFACE_NAME_MAPPING  "ortc/gatherer/interface-name-mapping"
 #define ORTC_SETTING_GATHERER_USERNAME_FRAG_LENGTH  "ortc/gatherer/username-frag-length"
 #define ORTC_SETTING_GATHERER_PASSWORD_LENGTH  "ortc/gatherer/password-length"
@@ -86,12 +89,35 @@
 
 #define ORTC_SETTING_GATHERER_RECHECK_IP_ADDRESSES_IN_SECONDS "ortc/gatherer/recheck-ip-addresses-in-seconds"
 
+#define ORTC_SETTING_GATHERER_MAX_UDP_RECEIVE_BATCH_SIZE "ortc/gatherer/max-udp-receive-batch-size"
+#define ORTC_SETTING_GATHERER_UDP_RECEIVE_BUFFER_SIZE_IN_BYTES "ortc/gatherer/udp-receive-buffer-size-in-bytes"
+#define ORTC_SETTING_GATHERER_MAX_UDP_SEND_BATCH_SIZE "ortc/gatherer/max-udp-send-batch-size"
+#define ORTC_SETTING_GATHERER_UDP_SEND_SEGMENTATION_OFFLOAD "ortc/gatherer/udp-send-segmentation-offload"
+#define ORTC_SETTING_GATHERER_UDP_REUSE_PORT_SOCKETS_PER_HOST_PORT "ortc/gatherer/udp-reuse-port-sockets-per-host-port"
+
+#define ORTC_SETTING_GATHERER_UDP_MUX "ortc/gatherer/udp-mux"
+#define ORTC_SETTING_GATHERER_UDP_MUX_PORT "ortc/gatherer/udp-mux-port"
+#define ORTC_SETTING_GATHERER_UDP_MUX_ROUTE_EXPIRY_IN_SECONDS "ortc/gatherer/udp-mux-route-expiry-in-seconds"
+
+#define ORTC_SETTING_GATHERER_WARM_POOL "ortc/gatherer/warm-pool"
+#define ORTC_SETTING_GATHERER_WARM_POOL_SOCKETS_PER_INTERFACE "ortc/gatherer/warm-pool-sockets-per-interface"
+#define ORTC_SETTING_GATHERER_WARM_POOL_INTERFACE_CACHE_IN_SECONDS "ortc/gatherer/warm-pool-interface-cache-in-seconds"
+#define ORTC_SETTING_GATHERER_WARM_POOL_REFLEXIVE_EXPIRY_IN_SECONDS "ortc/gatherer/warm-pool-reflexive-expiry-in-seconds"
+
+#define ORTC_ICEGATHERER_MAX_UDP_RECEIVE_BATCH_SIZE (64)
+#define ORTC_ICEGATHERER_MAX_UDP_SEND_BATCH_SIZE (64)
+
+#define ORTC_ICEGATHERER_MAX_TCP_FRAME_SIZE (0xFFFF + sizeof(WORD))     // RFC 4571 length prefix plus largest payload
+#define ORTC_ICEGATHERER_MIN_TCP_RECEIVE_SPACE (4096)
+#define ORTC_ICEGATHERER_INITIAL_TCP_SEND_RING_SIZE (4096)
+
 namespace ortc
 {
   namespace internal
   {
     ZS_DECLARE_INTERACTION_PTR(IICETransportForICEGatherer)
     ZS_DECLARE_INTERACTION_PROXY(IGathererAsyncDelegate)
+    ZS_DECLARE_INTERACTION_PROXY(IGathererReusePortReaderAsyncDelegate)
 
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -148,6 +174,7 @@ namespace ortc
       virtual IICEGathererSubscriptionPtr subscribe(IICEGathererDelegatePtr delegate) = 0;
 
       virtual bool isContinousGathering() const = 0;
+      virtual bool isICELite() const = 0;
       virtual String getUsernameFrag() const = 0;
       virtual String getPassword() const = 0;
 
@@ -168,6 +195,35 @@ namespace ortc
       virtual void notifyLikelyReflexiveActivity(RouterRoutePtr routerRoute) = 0;
     };
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IICEGathererForUDPMux
+    #pragma mark
+
+    interaction IICEGathererForUDPMux
+    {
+      ZS_DECLARE_TYPEDEF_PTR(IICEGathererForUDPMux, ForUDPMux)
+
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::Socket, Socket)
+
+      virtual PUID getID() const = 0;
+
+      virtual void notifyUDPMuxPacket(
+                                      SocketPtr socket,
+                                      const IPAddress &fromIP,
+                                      const BYTE *buffer,
+                                      size_t bufferSizeInBytes,
+                                      STUNPacketPtr stunPacket
+                                      ) = 0;
+
+      // the shared socket failed and was closed by the mux (the host port
+      // must be rebound)
+      virtual void notifyUDPMuxSocketClosed(SocketPtr socket) = 0;
+    };
+
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -184,7 +240,22 @@ namespace ortc
                                                        UseICETransportPtr transport,
                                                        PUID routerRouteID
                                                        )  = 0;
-      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise) = 0;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IGathererReusePortReaderAsyncDelegate
+    #pragma mark
+
+    interaction IGathererReusePortReaderAsyncDelegate
+    {
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::Socket, Socket)
+
+      virtual void onReusePortReaderClose(SocketPtr socket) = 0;
     };
 
     //-------------------------------------------------------------------------
@@ -201,6 +272,7 @@ namespace ortc
                         public IICEGatherer,
                         public IICEGathererForSettings,
                         public IICEGathererForICETransport,
+                        public IICEGathererForUDPMux,
                         public IGathererAsyncDelegate,
                         public IWakeDelegate,
                         public IDNSDelegate,
@@ -220,6 +292,7 @@ namespace ortc
       friend interaction IICEGathererFactory;
       friend interaction IICEGathererForSettings;
       friend interaction IICEGathererForICETransport;
+      friend interaction IICEGathererForUDPMux;
 
       typedef IICEGatherer::States States;
 
@@ -276,11 +349,29 @@ namespace ortc
       static const char *toString(PreferenceTypes family);
       static PreferenceTypes toPreferenceType(const char *family);
 
+      // open on the stack around a burst of packet handling; UDP packets
+      // queued for sending while a burst is open on the calling thread are
+      // batched and flushed on that thread when the outermost burst closes
+      // (outside a burst every packet is sent immediately)
+      class SendBurst
+      {
+      public:
+        SendBurst();
+        ~SendBurst();
+
+        static bool isOpen();
+
+      private:
+        SendBurst(const SendBurst &) = delete;
+        SendBurst &operator=(const SendBurst &) = delete;
+      };
+
       ZS_DECLARE_TYPEDEF_PTR(IICETransportForICEGatherer, UseICETransport)
       ZS_DECLARE_TYPEDEF_PTR(ortc::services::ISTUNDiscovery, UseSTUNDiscovery)
       ZS_DECLARE_TYPEDEF_PTR(ortc::services::ITURNSocket, UseTURNSocket)
       ZS_DECLARE_TYPEDEF_PTR(ortc::services::IBackOffTimer, UseBackOffTimer)
       ZS_DECLARE_TYPEDEF_PTR(zsLib::Socket, Socket)
+      ZS_DECLARE_TYPEDEF_PTR(IICEGathererForUDPMux, ForUDPMux)
       ZS_DECLARE_TYPEDEF_PTR(IICETypes::Candidate, Candidate)
       ZS_DECLARE_TYPEDEF_PTR(IICETypes::CandidateList, CandidateList)
       ZS_DECLARE_TYPEDEF_PTR(ICEGathererRouter::Route, RouterRoute)
@@ -288,11 +379,18 @@ namespace ortc
       typedef std::list<IPAddress> IPAddressList;
 
       ZS_DECLARE_CLASS_PTR(HostIPSorter)
+      ZS_DECLARE_STRUCT_PTR(SocketStats)
       ZS_DECLARE_STRUCT_PTR(HostPort)
       ZS_DECLARE_STRUCT_PTR(ReflexivePort)
       ZS_DECLARE_STRUCT_PTR(RelayPort)
       ZS_DECLARE_STRUCT_PTR(TCPPort)
       ZS_DECLARE_STRUCT_PTR(BufferedPacket)
+      ZS_DECLARE_STRUCT_PTR(UDPReceiveBatch)
+      ZS_DECLARE_STRUCT_PTR(UDPSendBatch)
+      ZS_DECLARE_STRUCT_PTR(TCPReceiveBuffer)
+      ZS_DECLARE_STRUCT_PTR(TCPSendRing)
+      ZS_DECLARE_CLASS_PTR(ReusePortReader)
+      ZS_DECLARE_STRUCT_PTR(ReusePortSocket)
       ZS_DECLARE_STRUCT_PTR(Route)
       ZS_DECLARE_STRUCT_PTR(InstalledTransport)
       ZS_DECLARE_STRUCT_PTR(Preference)
@@ -309,15 +407,17 @@ namespace ortc
       typedef WORD LocalPreference;
       typedef std::map<Foundation, LocalPreference> FoundationToLocalPreferenceMap;
 
-      typedef String CandidateHash;
+      typedef CandidateKey CandidateHash;
       typedef std::pair<CandidatePtr, CandidateHash> CandidatePair;
-      typedef std::map<CandidateHash, CandidatePair> CandidateMap;
+      typedef std::unordered_map<CandidateHash, CandidatePair, CandidateHash::Hasher> CandidateMap;
 
       typedef std::list<ReflexivePortPtr> ReflexivePortList;
+      typedef String ServerHash;
+      typedef std::map<ServerHash, IPAddress> ReflexiveMappingMap;
       typedef std::map<TimerPtr, HostAndReflexivePortPair> TimerToReflexivePortMap;
 
       typedef std::list<RelayPortPtr> RelayPortList;
-      typedef std::map<IPAddress, RelayPortPtr> IPToRelayPortMap;
+      typedef std::unordered_map<IPAddress, RelayPortPtr, IPAddressHasher> IPToRelayPortMap;
       typedef std::map<TimerPtr, HostAndRelayPortPair> TimerToRelayPortMap;
 
       typedef std::pair<HostPortPtr, TCPPortPtr> HostAndTCPPortPair;
@@ -326,6 +426,8 @@ namespace ortc
 
       typedef std::list<BufferedPacketPtr> BufferedPacketList;
 
+      typedef std::list<ReusePortSocketPtr> ReusePortSocketList;
+
       typedef String UsernameFragment;
       typedef PUID TransportID;
       typedef std::map<UsernameFragment, InstalledTransportPtr> TransportMap;
@@ -335,10 +437,8 @@ namespace ortc
       typedef PUID RouteID;
       typedef std::map<RouteID, RoutePtr> RouteMap;
 
-      typedef std::pair<CandidatePtr, IPAddress> LocalCandidateRemoteIPPair;
-      typedef std::map<LocalCandidateRemoteIPPair, RoutePtr> LocalCandidateRemoteIPRouteMap;
-
-      typedef CryptoPP::ByteQueue ByteQueue;
+      typedef IPRouteKey LocalCandidateRemoteIPPair;    // keyed by local candidate pointer identity (kept alive by the route)
+      typedef std::unordered_map<LocalCandidateRemoteIPPair, RoutePtr, IPRouteKey::Hasher> LocalCandidateRemoteIPRouteMap;
 
     public:
       struct ConstructorOptions
@@ -431,6 +531,7 @@ namespace ortc
       // (duplicate) virtual CandidateListPtr getLocalCandidates() const = 0;
 
       virtual bool isContinousGathering() const override;
+      virtual bool isICELite() const override;
       virtual String getUsernameFrag() const override {return mUsernameFrag;}
       virtual String getPassword() const override {return mPassword;}
 
@@ -448,6 +549,23 @@ namespace ortc
 
       virtual void notifyLikelyReflexiveActivity(RouterRoutePtr routerRoute) override;
 
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer => IICEGathererForUDPMux
+      #pragma mark
+
+      // (duplicate) virtual PUID getID() const;
+
+      virtual void notifyUDPMuxPacket(
+                                      SocketPtr socket,
+                                      const IPAddress &fromIP,
+                                      const BYTE *buffer,
+                                      size_t bufferSizeInBytes,
+                                      STUNPacketPtr stunPacket
+                                      ) override;
+
+      virtual void notifyUDPMuxSocketClosed(SocketPtr socket) override;
+
       //-----------------------------------------------------------------------
       #pragma mark
       #pragma mark ICEGatherer => IGathererAsyncDelegate
@@ -458,7 +576,7 @@ namespace ortc
                                                        PUID routerRouteID
                                                        ) override;
 
-      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise) override;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) override;
 
       //-----------------------------------------------------------------------
       #pragma mark
@@ -671,6 +789,7 @@ namespace ortc
 
         String mOptionsHash;
         CandidatePtr mCandidate;
+        bool mCandidateFromWarmPool {false};  // offered from a cached mapping until STUN discovery confirms it
 
         Time mLastActivity;
         TimerPtr mInactivityTimer;
@@ -704,6 +823,28 @@ namespace ortc
         ElementPtr toDebug() const;
       };
 
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::SocketStats
+      #pragma mark
+
+      // counters are updated from the socket read / send paths without
+      // holding the gatherer lock
+      struct SocketStats
+      {
+        std::atomic<ULONGLONG> mPacketsSent {};
+        std::atomic<ULONGLONG> mBytesSent {};
+        std::atomic<ULONGLONG> mPacketsReceived {};
+        std::atomic<ULONGLONG> mBytesReceived {};
+        std::atomic<ULONGLONG> mPacketsDiscarded {};
+        std::atomic<ULONGLONG> mSendWouldBlock {};
+
+        ElementPtr toDebug() const;
+      };
+
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
@@ -722,7 +863,12 @@ namespace ortc
         CandidatePtr mCandidateUDP;
         IPAddress mBoundUDPIP;
         SocketPtr mBoundUDPSocket;
+        UDPReceiveBatchPtr mUDPReceiveBatch;
+        UDPSendBatchPtr mUDPSendBatch;
+        SocketStats mUDPStats;
+        ReusePortSocketList mReusePortSockets;
         UseBackOffTimerPtr mBindUDPBackOffTimer;
+        RouteWeakPtr mLastRoute;    // last route hit by data received on this host port (steady-state media skips the route map)
         
         CandidatePtr mCandidateTCPPassive;
         CandidatePtr mCandidateTCPActive;
@@ -735,6 +881,7 @@ namespace ortc
 
         String mReflexiveOptionsHash;
         ReflexivePortList mReflexivePorts;
+        ReflexiveMappingMap mWarmPoolMappings;
 
         String mRelayOptionsHash;
         RelayPortList mRelayPorts;
@@ -745,6 +892,154 @@ namespace ortc
         ElementPtr toDebug() const;
       };
 
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::ReusePortReader
+      #pragma mark
+
+      // receives socket events for an additional SO_REUSEPORT socket on
+      // its own packet queue and forwards them to the gatherer (which does
+      // not hold its lock while reading); the socket is only ever closed
+      // from the same queue so a close can never land in the middle of a read
+      class ReusePortReader : public MessageQueueAssociator,
+                              public zsLib::ISocketDelegate,
+                              public IGathererReusePortReaderAsyncDelegate
+      {
+      public:
+        ReusePortReader(
+                        IMessageQueuePtr queue,
+                        ICEGathererPtr gatherer
+                        );
+
+        static void close(
+                          ReusePortReaderPtr reader,
+                          SocketPtr socket
+                          );
+
+        virtual void onReadReady(SocketPtr socket) override;
+        virtual void onWriteReady(SocketPtr socket) override;
+        virtual void onException(SocketPtr socket) override;
+
+        virtual void onReusePortReaderClose(SocketPtr socket) override;
+
+      protected:
+        ICEGathererWeakPtr mGatherer;
+        std::atomic<bool> mClosing {false};
+      };
+
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::ReusePortSocket
+      #pragma mark
+
+      struct ReusePortSocket
+      {
+        AutoPUID mID;
+
+        SocketPtr mSocket;
+        UDPReceiveBatchPtr mUDPReceiveBatch;
+        ReusePortReaderPtr mReader;
+
+        ElementPtr toDebug() const;
+      };
+
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::TCPReceiveBuffer
+      #pragma mark
+
+      // RFC 4571 framed data is received straight into this buffer and
+      // frames are handed out as pointers into it (no copy). Only the
+      // trailing partial frame is ever moved (back to the start of the
+      // buffer) when the free space at the end runs low.
+      struct TCPReceiveBuffer
+      {
+        AutoPUID mID;
+
+        SecureByteBlock mBuffer;      // room for two maximum sized frames
+        size_t mHead {};              // first byte not yet parsed
+        size_t mTail {};              // one past the last byte received
+
+        size_t mTotalFrames {};
+        size_t mTotalCompactions {};
+        size_t mTotalCompactedBytes {};
+
+        TCPReceiveBuffer();
+
+        size_t size() const {return mTail - mHead;}
+        void clear() {mHead = mTail = 0;}
+
+        size_t receive(
+                       Socket &socket,
+                       bool &outWouldBlock
+                       ) throw (Socket::Exceptions::Unspecified);
+
+        // frame stays valid until the next receive()
+        bool nextFrame(
+                       const BYTE * &outFrame,
+                       size_t &outFrameSize
+                       );
+
+        ElementPtr toDebug() const;
+      };
+
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::TCPSendRing
+      #pragma mark
+
+      // Outgoing RFC 4571 frames (length prefix included) are written into a
+      // ring which grows as needed; pending data is at most two contiguous
+      // regions and is handed to the socket with a single gathered send
+      // (sendmsg with MSG_NOSIGNAL where available, otherwise writev).
+      struct TCPSendRing
+      {
+        SecureByteBlock mBuffer;
+        size_t mHead {};              // first unsent byte
+        size_t mSize {};              // total unsent bytes
+
+        size_t mTotalFrames {};
+        size_t mTotalSystemCalls {};
+        size_t mTotalGrowths {};
+
+        size_t size() const {return mSize;}
+        bool isEmpty() const {return 0 == mSize;}
+        void clear() {mHead = mSize = 0;}
+
+        // first contiguous region of unsent data
+        const BYTE *peek(size_t &outSize) const;
+
+        void queue(
+                   const BYTE *buffer,
+                   size_t bufferSizeInBytes
+                   );
+        size_t send(
+                    Socket &socket,
+                    bool &outWouldBlock
+                    ) throw (Socket::Exceptions::Unspecified);
+
+        ElementPtr toDebug() const;
+
+      protected:
+        void grow(size_t required);
+        void put(
+                 const BYTE *buffer,
+                 size_t bufferSizeInBytes
+                 );
+      };
+
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
@@ -764,8 +1059,8 @@ namespace ortc
 
         IPAddress mRemoteIP;
         SocketPtr mSocket;
-        ByteQueue mIncomingBuffer;
-        ByteQueue mOutgoingBuffer;
+        TCPReceiveBufferPtr mIncomingBuffer {make_shared<TCPReceiveBuffer>()};
+        TCPSendRing mOutgoingBuffer;
 
         TransportID mTransportID {0};
         UseICETransportWeakPtr mTransport;
@@ -793,7 +1088,113 @@ namespace ortc
 
         ElementPtr toDebug() const;
       };
-      
+
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::UDPReceiveBatch
+      #pragma mark
+
+      struct UDPReceiveBatch
+      {
+        struct Packet
+        {
+          IPAddress mFromIP;
+          BYTE *mBuffer {};
+          size_t mSize {};
+
+          bool mRelayMapped {false};
+          UseTURNSocketPtr mTURNSocket;
+        };
+
+        typedef std::vector<Packet> PacketVector;
+
+        AutoPUID mID;
+
+        size_t mMaxPackets {};
+        size_t mBufferSize {};
+
+        SecureByteBlock mBuffers;     // one contiguous block of mMaxPackets * mBufferSize, re-used between reads
+        PacketVector mPackets;        // always mMaxPackets in size
+        size_t mTotalPackets {};
+        size_t mLastTruncated {};     // datagrams dropped by the most recent receive()
+
+        size_t mTotalBatches {};
+        size_t mTotalTruncated {};
+
+        UDPReceiveBatch(
+                        size_t maxPackets,
+                        size_t bufferSize
+                        );
+
+        size_t receive(
+                       Socket &socket,
+                       bool &outWouldBlock
+                       ) throw (Socket::Exceptions::Unspecified);
+        void reset();
+
+        ElementPtr toDebug() const;
+      };
+
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGatherer::UDPSendBatch
+      #pragma mark
+
+      struct UDPSendBatch
+      {
+        struct Packet
+        {
+          IPAddress mRemoteIP;
+          BYTE *mBuffer {};
+          size_t mSize {};
+        };
+
+        typedef std::vector<Packet> PacketVector;
+
+        AutoPUID mID;
+
+        size_t mMaxPackets {};
+        size_t mBufferSize {};
+        bool mSegmentationOffload {};
+
+        SecureByteBlock mBuffers;     // one contiguous block of mMaxPackets * mBufferSize, re-used between flushes
+        PacketVector mPackets;        // always mMaxPackets in size
+        size_t mTotalPackets {};
+        bool mBlocked {};             // last flush could not send everything; send directly until a send succeeds
+
+        size_t mTotalFlushes {};
+        size_t mTotalSystemCalls {};
+        size_t mTotalSent {};
+        size_t mTotalDropped {};
+
+        UDPSendBatch(
+                     size_t maxPackets,
+                     size_t bufferSize,
+                     bool segmentationOffload
+                     );
+
+        bool isEmpty() const {return 0 == mTotalPackets;}
+        bool isFull() const {return mTotalPackets >= mMaxPackets;}
+
+        bool queue(
+                   const IPAddress &remoteIP,
+                   const BYTE *buffer,
+                   size_t bufferSizeInBytes
+                   );
+        size_t flush(
+                     Socket &socket,
+                     const IPAddress &boundIP
+                     ) throw (Socket::Exceptions::Unspecified);
+
+        ElementPtr toDebug() const;
+      };
+
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
@@ -981,6 +1382,22 @@ namespace ortc
                 HostPortPtr hostPort,
                 SocketPtr socket
                 );
+      bool read(
+                HostPortPtr hostPort,
+                SocketPtr socket,
+                UDPReceiveBatch &batch
+                );
+      void handleUDPPacket(
+                           HostPortPtr hostPort,
+                           SocketPtr socket,
+                           CandidatePtr localCandidate,
+                           const IPAddress &fromIP,
+                           const BYTE *buffer,
+                           size_t bufferSizeInBytes,
+                           STUNPacketPtr stunPacket,
+                           bool relayMapped,
+                           UseTURNSocketPtr turnSocket
+                           );
       void read(
                 HostPort &hostPort,
                 TCPPort &tcpPort
@@ -990,6 +1407,18 @@ namespace ortc
                  HostPort &hostPort,
                  SocketPtr socket
                  );
+
+      bool enableReusePort(SocketPtr socket);
+      void bindReusePortSockets(HostPortPtr hostPort);
+      void closeReusePortSockets(HostPort &hostPort);
+      ReusePortSocketPtr findReusePortSocket(
+                                             HostPort &hostPort,
+                                             SocketPtr socket
+                                             ) const;
+      UDPReceiveBatchPtr findUDPReceiveBatch(
+                                             HostPort &hostPort,
+                                             SocketPtr socket
+                                             ) const;
       bool writeIfTCPPort(SocketPtr socket);
 
       void close(
@@ -1010,7 +1439,8 @@ namespace ortc
                                 CandidatePtr localCandidate,
                                 const IPAddress &remoteIP,
                                 const BYTE *buffer,
-                                size_t bufferSizeInBytes
+                                size_t bufferSizeInBytes,
+                                HostPortPtr hostPort = HostPortPtr()
                                 );
 
       CandidatePtr findSentFromLocalCandidate(RouterRoutePtr routerRoute);
@@ -1027,14 +1457,33 @@ namespace ortc
 
       void fix(STUNPacketPtr stunPacket) const;
 
+      void clearLastRoutes();
+
       void removeAllRelatedRoutes(
                                   TransportID transportID,
                                   UseICETransportPtr transportIfAvailable
                                   );
 
+      void learnUDPMuxRoute(
+                            CandidatePtr localCandidate,
+                            const IPAddress &remoteIP
+                            );
+
+      bool queueUDPPacket(
+                          HostPortPtr hostPort,
+                          const IPAddress &remoteIP,
+                          const BYTE *buffer,
+                          size_t bufferSizeInBytes
+                          );
+      bool flushUDPSendBatch(HostPort &hostPort);
+      static void registerSendBurst(
+                                    ICEGathererPtr gatherer,
+                                    HostPortPtr hostPort
+                                    );
+
       bool sendUDPPacket(
+                         HostPort &hostPort,
                          SocketPtr socket,
-                         const IPAddress &boundIP,
                          const IPAddress &remoteIP,
                          const BYTE *buffer,
                          size_t bufferSizeInBytes
@@ -1133,6 +1582,27 @@ namespace ortc
       size_t mMaxTCPBufferingSizePendingConnection {};
       size_t mMaxTCPBufferingSizeConnected {};
 
+      size_t mMaxUDPReceiveBatchSize {};
+      size_t mUDPReceiveBufferSize {};
+
+      size_t mMaxUDPSendBatchSize {};
+      bool mUDPSendSegmentationOffload {};
+
+      size_t mUDPReusePortSockets {};
+
+      ICEGathererUDPMuxPtr mUDPMux;
+
+      ICEGathererWarmPoolPtr mWarmPool;
+      bool mWarmPoolInterfacesUsed {false};
+      size_t mWarmPoolSocketsAdopted {};
+      size_t mWarmPoolReflexiveMappingsAdopted {};
+
+      Time mGatherStarted;
+      Time mFirstHostCandidate;
+      Time mFirstServerReflexiveCandidate;
+      Time mFirstRelayCandidate;
+      Time mGatherCompleted;
+
       TimerPtr mCleanUpBufferingTimer;
       Seconds mMaxBufferingTime {};
       size_t mMaxTotalBuffers {};
@@ -1176,6 +1646,12 @@ namespace ortc
 ZS_DECLARE_PROXY_BEGIN(ortc::internal::IGathererAsyncDelegate)
 ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::IGathererAsyncDelegate::UseICETransportPtr, UseICETransportPtr)
 ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsProvider::PromiseWithStatsReportPtr, PromiseWithStatsReportPtr)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsReportTypes::StatsTypeSet, StatsTypeSet)
 ZS_DECLARE_PROXY_METHOD_2(onNotifyDeliverRouteBufferedPackets, UseICETransportPtr, PUID)
-ZS_DECLARE_PROXY_METHOD_1(onResolveStatsPromise, PromiseWithStatsReportPtr)
+ZS_DECLARE_PROXY_METHOD_2(onResolveStatsPromise, PromiseWithStatsReportPtr, StatsTypeSet)
+ZS_DECLARE_PROXY_END()
+
+ZS_DECLARE_PROXY_BEGIN(ortc::internal::IGathererReusePortReaderAsyncDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::IGathererReusePortReaderAsyncDelegate::SocketPtr, SocketPtr)
+ZS_DECLARE_PROXY_METHOD_1(onReusePortReaderClose, SocketPtr)
 ZS_DECLARE_PROXY_END()
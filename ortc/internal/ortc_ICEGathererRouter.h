@@ -32,12 +32,14 @@
 #pragma once
 
 #include <ortc/internal/types.h>
+#include <ortc/internal/ortc_Helper.h>
 
 #include <ortc/IICEGatherer.h>
 
 #include <zsLib/Timer.h>
 
 #include <tuple>
+#include <unordered_map>
 
 namespace ortc
 {
@@ -60,12 +62,14 @@ namespace ortc
 
     public:
       ZS_DECLARE_STRUCT_PTR(Route)
+      struct RouteEntry;
 
       ZS_DECLARE_TYPEDEF_PTR(IICETypes::Candidate, Candidate)
 
-      typedef String LocalCandidateHash;
-      typedef std::pair<LocalCandidateHash, IPAddress> CandidateRemoteIPPair;
-      typedef std::map<CandidateRemoteIPPair, RouteWeakPtr> CandidateRemoteIPToRouteMap;
+      typedef CandidateKey LocalCandidateHash;
+      typedef PUID LocalCandidateID;
+      typedef std::unordered_map<LocalCandidateHash, LocalCandidateID, LocalCandidateHash::Hasher> LocalCandidateIDMap;
+      typedef std::unordered_map<IPRouteKey, RouteEntry, IPRouteKey::Hasher> CandidateRemoteIPToRouteMap;
 
     public:
       ICEGathererRouter(
@@ -96,6 +100,10 @@ namespace ortc
                                  bool createRouteIfNeeded
                                  );
 
+      // lookup by the key computed when the route was created (no candidate
+      // hashing); returns null if the route is gone
+      virtual RoutePtr findRoute(const IPRouteKey &routeKey);
+
     protected:
       //-----------------------------------------------------------------------
       #pragma mark
@@ -117,6 +125,11 @@ namespace ortc
 
       void cancel();
 
+      LocalCandidateID findLocalCandidateID(
+                                            const LocalCandidateHash &hash,
+                                            bool createIfNeeded
+                                            );
+
     public:
       //-----------------------------------------------------------------------
       #pragma mark
@@ -130,10 +143,25 @@ namespace ortc
         CandidatePtr mLocalCandidate;
         IPAddress mRemoteIP;
 
+        IPRouteKey mKey;    // compact (interned local candidate, remote address) id
+
         void trace(const char *function, const char *message = NULL) const;
         ElementPtr toDebug() const;
       };
 
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererRouter::RouteEntry
+      #pragma mark
+
+      struct RouteEntry
+      {
+        RouteWeakPtr mRoute;
+
+        LocalCandidateHash mLocalCandidateHash;
+        IPAddress mRemoteIP;
+      };
+
     protected:
       //-----------------------------------------------------------------------
       #pragma mark
@@ -143,6 +171,7 @@ namespace ortc
       AutoPUID mID;
       ICEGathererRouterWeakPtr mThisWeak;
 
+      LocalCandidateIDMap mLocalCandidateIDs;   // interned so routes are keyed by a compact id rather than the candidate hash string
       CandidateRemoteIPToRouteMap mRoutes;
 
       TimerPtr mTimer;
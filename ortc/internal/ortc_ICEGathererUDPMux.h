@@ -0,0 +1,266 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#pragma once
+
+#include <ortc/internal/types.h>
+#include <ortc/internal/ortc_Helper.h>
+#include <ortc/internal/ortc_ICEGatherer.h>
+
+#include <zsLib/Socket.h>
+#include <zsLib/Timer.h>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace ortc
+{
+  namespace internal
+  {
+    ZS_DECLARE_INTERACTION_PROXY(IICEGathererUDPMuxAsyncDelegate)
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark IICEGathererUDPMuxAsyncDelegate
+    #pragma mark
+
+    interaction IICEGathererUDPMuxAsyncDelegate
+    {
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::Socket, Socket)
+
+      virtual void onUDPMuxSocketClose(SocketPtr socket) = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererUDPMux
+    #pragma mark
+
+    // One UDP socket per interface shared by every gatherer in the process
+    // (enabled with ORTC_SETTING_GATHERER_UDP_MUX). Incoming STUN is
+    // demultiplexed by the local USERNAME fragment, everything else by the
+    // remote address learned from authenticated STUN requests and installed
+    // routes. Associated RTCP gatherers share their RTP gatherer's username
+    // fragment and are never attached to the mux. Sockets are read on the
+    // packet queue without the lock so they are only ever closed from that
+    // same queue (see onUDPMuxSocketClose).
+    class ICEGathererUDPMux : public SharedRecursiveLock,
+                              public MessageQueueAssociator,
+                              public ISingletonManagerDelegate,
+                              public zsLib::ISocketDelegate,
+                              public zsLib::ITimerDelegate,
+                              public IICEGathererUDPMuxAsyncDelegate
+    {
+    protected:
+      struct make_private {};
+
+    public:
+      ZS_DECLARE_TYPEDEF_PTR(IICEGathererForUDPMux, UseGatherer)
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::Socket, Socket)
+      ZS_DECLARE_TYPEDEF_PTR(ICEGatherer::UDPReceiveBatch, UDPReceiveBatch)
+
+      ZS_DECLARE_STRUCT_PTR(MuxSocket)
+      ZS_DECLARE_STRUCT_PTR(MuxRoute)
+
+      typedef PUID GathererID;
+      typedef String UsernameFragment;
+      typedef std::map<GathererID, UseGathererWeakPtr> GathererMap;
+      typedef std::list<UseGathererPtr> GathererList;
+
+      typedef std::unordered_map<UsernameFragment, MuxRoute, std::hash<std::string> > UsernameFragmentToGathererMap;
+      typedef std::unordered_map<IPRouteKey, MuxRoute, IPRouteKey::Hasher> RouteMap;
+      typedef std::map<SocketPtr, MuxSocketPtr> SocketMap;
+      typedef std::map<IPAddress, MuxSocketPtr> BoundIPMap;
+
+    public:
+      ICEGathererUDPMux(
+                        const make_private &,
+                        IMessageQueuePtr queue
+                        );
+
+    protected:
+      void init();
+
+    public:
+      ~ICEGathererUDPMux();
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux => (friends)
+      #pragma mark
+
+      static ElementPtr toDebug(ICEGathererUDPMuxPtr mux);
+
+      static ICEGathererUDPMuxPtr singleton();
+
+      virtual PUID getID() const {return mID;}
+
+      virtual SocketPtr bind(
+                             UseGathererPtr gatherer,
+                             const String &usernameFrag,
+                             IPAddress &ioBindIP
+                             );
+      virtual void unbind(
+                          GathererID gathererID,
+                          SocketPtr socket
+                          );
+      virtual void unregisterGatherer(
+                                      GathererID gathererID,
+                                      const String &usernameFrag
+                                      );
+
+      virtual void learnRoute(
+                              SocketPtr socket,
+                              const IPAddress &remoteIP,
+                              UseGathererPtr gatherer
+                              );
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux => ISingletonManagerDelegate
+      #pragma mark
+
+      virtual void notifySingletonCleanup() override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux => ISocketDelegate
+      #pragma mark
+
+      virtual void onReadReady(SocketPtr socket) override;
+      virtual void onWriteReady(SocketPtr socket) override;
+      virtual void onException(SocketPtr socket) override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux => ITimerDelegate
+      #pragma mark
+
+      virtual void onTimer(TimerPtr timer) override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux => IICEGathererUDPMuxAsyncDelegate
+      #pragma mark
+
+      virtual void onUDPMuxSocketClose(SocketPtr socket) override;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux => (internal)
+      #pragma mark
+
+      static ICEGathererUDPMuxPtr create();
+
+      Log::Params log(const char *message) const;
+      static Log::Params slog(const char *message);
+      Log::Params debug(const char *message) const;
+      ElementPtr toDebug() const;
+
+      void cancel();
+
+      bool read(MuxSocketPtr muxSocket);
+      void close(MuxSocketPtr muxSocket);
+
+      static String extractLocalUsernameFrag(const STUNPacketPtr &stunPacket);
+
+    public:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux::MuxSocket
+      #pragma mark
+
+      struct MuxSocket
+      {
+        AutoPUID mID;
+
+        IPAddress mBoundIP;
+        SocketPtr mSocket;        // never reset (read without the lock)
+        UDPReceiveBatchPtr mUDPReceiveBatch;
+        std::atomic<bool> mClosing {false};
+
+        GathererMap mGatherers;
+
+        ElementPtr toDebug() const;
+      };
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux::MuxRoute
+      #pragma mark
+
+      struct MuxRoute
+      {
+        GathererID mGathererID {};
+        UseGathererWeakPtr mGatherer;
+        Time mLastUsed;
+      };
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererUDPMux (data)
+      #pragma mark
+
+      AutoPUID mID;
+      ICEGathererUDPMuxWeakPtr mThisWeak;
+
+      WORD mMuxPort {};
+      Seconds mRouteExpiry {};
+
+      size_t mMaxUDPReceiveBatchSize {};
+      size_t mUDPReceiveBufferSize {};
+
+      STUNPacket::ParseOptions mSTUNPacketParseOptions;
+
+      BoundIPMap mBoundIPs;
+      SocketMap mSockets;
+
+      UsernameFragmentToGathererMap mUsernameFrags;
+      RouteMap mRoutes;
+
+      TimerPtr mTimer;
+    };
+  }
+}
+
+ZS_DECLARE_PROXY_BEGIN(ortc::internal::IICEGathererUDPMuxAsyncDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::IICEGathererUDPMuxAsyncDelegate::SocketPtr, SocketPtr)
+ZS_DECLARE_PROXY_METHOD_1(onUDPMuxSocketClose, SocketPtr)
+ZS_DECLARE_PROXY_END()
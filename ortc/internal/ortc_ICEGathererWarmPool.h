@@ -0,0 +1,229 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#pragma once
+
+#include <ortc/internal/types.h>
+#include <ortc/internal/ortc_ICEGatherer.h>
+
+#include <zsLib/Socket.h>
+#include <zsLib/Timer.h>
+
+namespace ortc
+{
+  namespace internal
+  {
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ICEGathererWarmPool
+    #pragma mark
+
+    // Process wide cache shared by every gatherer (enabled with
+    // ORTC_SETTING_GATHERER_WARM_POOL). Holds the last interface enumeration
+    // and a few pre-bound UDP sockets per interface so a new gatherer can
+    // produce host candidates without waiting on enumeration or bind. Sockets
+    // given back by a gatherer keep their server reflexive mappings for a
+    // short while so the next owner can offer them before STUN completes.
+    class ICEGathererWarmPool : public SharedRecursiveLock,
+                                public MessageQueueAssociator,
+                                public ISingletonManagerDelegate,
+                                public IWakeDelegate,
+                                public zsLib::ISocketDelegate,
+                                public zsLib::ITimerDelegate
+    {
+    protected:
+      struct make_private {};
+
+    public:
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::Socket, Socket)
+      ZS_DECLARE_TYPEDEF_PTR(ICEGatherer::ReflexiveMappingMap, ReflexiveMappingMap)
+
+      ZS_DECLARE_STRUCT_PTR(HostInterface)
+      ZS_DECLARE_STRUCT_PTR(PooledSocket)
+
+      typedef std::list<HostInterface> HostInterfaceList;
+      typedef std::list<PooledSocketPtr> PooledSocketList;
+      typedef std::map<IPAddress, PooledSocketList> HostIPToPooledSocketsMap;
+      typedef std::map<SocketPtr, PooledSocketPtr> SocketMap;
+      typedef std::set<IPAddress> IPAddressSet;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool::HostInterface
+      #pragma mark
+
+      struct HostInterface
+      {
+        String mName;
+        IPAddress mIP;
+        bool mIsTemporaryIP {false};
+      };
+
+    public:
+      ICEGathererWarmPool(
+                          const make_private &,
+                          IMessageQueuePtr queue
+                          );
+
+    protected:
+      void init();
+
+    public:
+      ~ICEGathererWarmPool();
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool => (friends)
+      #pragma mark
+
+      static ElementPtr toDebug(ICEGathererWarmPoolPtr pool);
+
+      static ICEGathererWarmPoolPtr singleton();
+
+      virtual PUID getID() const {return mID;}
+
+      virtual bool getInterfaces(HostInterfaceList &outInterfaces) const;
+      virtual void notifyInterfaces(const HostInterfaceList &interfaces);
+
+      virtual SocketPtr takeUDPSocket(
+                                      IPAddress &ioBindIP,
+                                      ReflexiveMappingMap &outMappings
+                                      );
+      virtual bool returnUDPSocket(
+                                   const IPAddress &hostIP,
+                                   const IPAddress &boundIP,
+                                   SocketPtr socket,
+                                   const ReflexiveMappingMap &mappings
+                                   );
+
+      virtual size_t getTotalPooled(const IPAddress &hostIP) const;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool => ISingletonManagerDelegate
+      #pragma mark
+
+      virtual void notifySingletonCleanup() override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool => IWakeDelegate
+      #pragma mark
+
+      virtual void onWake() override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool => ISocketDelegate
+      #pragma mark
+
+      virtual void onReadReady(SocketPtr socket) override;
+      virtual void onWriteReady(SocketPtr socket) override;
+      virtual void onException(SocketPtr socket) override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool => ITimerDelegate
+      #pragma mark
+
+      virtual void onTimer(TimerPtr timer) override;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool => (internal)
+      #pragma mark
+
+      static ICEGathererWarmPoolPtr create();
+
+      Log::Params log(const char *message) const;
+      static Log::Params slog(const char *message);
+      Log::Params debug(const char *message) const;
+      ElementPtr toDebug() const;
+
+      void cancel();
+
+      PooledSocketPtr bind(const IPAddress &hostIP);
+      void close(PooledSocketPtr pooledSocket);
+      void closeAll(const IPAddress &hostIP);
+
+    public:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool::PooledSocket
+      #pragma mark
+
+      struct PooledSocket
+      {
+        AutoPUID mID;
+
+        IPAddress mHostIP;
+        IPAddress mBoundIP;
+        SocketPtr mSocket;
+
+        ReflexiveMappingMap mMappings;
+        Time mMappingsLearned;
+
+        ElementPtr toDebug() const;
+      };
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICEGathererWarmPool (data)
+      #pragma mark
+
+      AutoPUID mID;
+      ICEGathererWarmPoolWeakPtr mThisWeak;
+
+      size_t mSocketsPerInterface {};
+      Seconds mInterfaceCacheExpiry {};
+      Seconds mReflexiveExpiry {};
+
+      HostInterfaceList mInterfaces;
+      Time mInterfacesUpdated;
+
+      IPAddressSet mWantedIPs;
+      HostIPToPooledSocketsMap mPools;
+      SocketMap mSockets;
+
+      ULONGLONG mTotalTaken {};
+      ULONGLONG mTotalMissed {};
+      ULONGLONG mTotalReturned {};
+
+      TimerPtr mTimer;
+    };
+  }
+}
@@ -34,6 +34,9 @@
 #include <ortc/internal/types.h>
 
 #include <ortc/internal/ortc_ICEGathererRouter.h>
+#include <ortc/internal/ortc_Helper.h>
+#include <ortc/internal/ortc_ICECheckPacer.h>
+#include <ortc/internal/ortc_TimerWheel.h>
 
 #include <ortc/IICETransport.h>
 #include <ortc/IICEGatherer.h>
@@ -45,6 +48,7 @@
 #include <zsLib/Timer.h>
 
 #include <queue>
+#include <set>
 
 #define ORTC_SETTING_ICE_TRANSPORT_MAX_CANDIDATE_PAIRS_TO_TEST  "ortc/ice-transport/max-candidate-pairs-to-test"
 
@@ -63,6 +67,12 @@
 
 #define ORTC_SETTING_ICE_TRANSPORT_MAX_BUFFERED_FOR_SECURE_TRANSPORT "ortc/ice-transport/max-buffered-packets-for-secure-transport"
 
+#define ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_BY_ROUND_TRIP_TIME "ortc/ice-transport/renominate-by-round-trip-time"
+#define ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_WARM_CANDIDATE_PAIRS "ortc/ice-transport/renominate-warm-candidate-pairs"
+#define ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_IMPROVEMENT_PERCENTAGE "ortc/ice-transport/renominate-improvement-percentage"
+#define ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_CONSECUTIVE_SAMPLES "ortc/ice-transport/renominate-consecutive-samples"
+#define ORTC_SETTING_ICE_TRANSPORT_RENOMINATE_HOLD_DOWN_IN_SECONDS "ortc/ice-transport/renominate-hold-down-in-seconds"
+
 namespace ortc
 {
   namespace internal
@@ -227,8 +237,9 @@ namespace ortc
 
     interaction IICETransportAsyncDelegate
     {
-      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise) = 0;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) = 0;
       virtual void onNotifyPacketRetried(
+                                         IPRouteKey routeKey,
                                          IICETypes::CandidatePtr localCandidate,
                                          IPAddress remoteIP,
                                          STUNPacketPtr stunPacket
@@ -261,6 +272,8 @@ namespace ortc
                          public IICETransportAsyncDelegate,
                          public IWakeDelegate,
                          public zsLib::ITimerDelegate,
+                         public ITimerWheelDelegate,
+                         public IICECheckPacerDelegate,
                          public zsLib::IPromiseSettledDelegate,
                          public IICEGathererDelegate,
                          public ortc::services::ISTUNRequesterDelegate
@@ -280,6 +293,7 @@ namespace ortc
       ZS_DECLARE_STRUCT_PTR(RouteStateTracker)
       ZS_DECLARE_STRUCT_PTR(Route)
       ZS_DECLARE_STRUCT_PTR(ReasonNoMoreRelationship)
+      ZS_DECLARE_STRUCT_PTR(FastPath)
 
       ZS_DECLARE_TYPEDEF_PTR(ortc::services::ISTUNRequester, ISTUNRequester)
       ZS_DECLARE_TYPEDEF_PTR(IICEGathererForICETransport, UseICEGatherer)
@@ -290,18 +304,19 @@ namespace ortc
       ZS_DECLARE_TYPEDEF_PTR(ISecureTransportForICETransport, UseSecureTransport)
       ZS_DECLARE_TYPEDEF_PTR(ICEGathererRouter::Route, RouterRoute)
 
-      typedef String Hash;
-      typedef std::map<Hash, CandidatePtr> CandidateMap;
+      typedef std::unordered_map<CandidateKey, CandidatePtr, CandidateKey::Hasher> CandidateMap;
 
-      typedef std::map<Hash, RoutePtr> RouteMap;
+      typedef std::unordered_map<CandidatePairKey, RoutePtr, CandidatePairKey::Hasher> RouteMap;
 
       typedef PUID RouteID;
       typedef QWORD SortPriority;
       typedef std::map<SortPriority, RoutePtr> SortedRouteMap;
 
       typedef std::map<RouteID, RoutePtr> RouteIDMap;
+      typedef std::multimap<Microseconds, RoutePtr> RoundTripRouteMap;
       typedef std::map<ISTUNRequesterPtr, RoutePtr> STUNCheckMap;
-      typedef std::map<TimerPtr, RoutePtr> TimerRouteMap;
+      typedef std::unordered_map<TimerWheel::TimerID, RoutePtr> TimerRouteMap;
+      typedef std::unordered_map<ICECheckPacer::RequestID, RoutePtr> PacedRouteMap;
       typedef std::map<PromisePtr, RoutePtr> PromiseRouteMap;
 
       typedef std::list<PromisePtr> PromiseList;
@@ -488,8 +503,9 @@ namespace ortc
       #pragma mark ICETransport => IICETransportAsyncDelegate
       #pragma mark
 
-      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise) override;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) override;
       virtual void onNotifyPacketRetried(
+                                         IPRouteKey routeKey,
                                          IICETypes::CandidatePtr localCandidate,
                                          IPAddress remoteIP,
                                          STUNPacketPtr stunPacket
@@ -515,6 +531,20 @@ namespace ortc
 
       virtual void onTimer(TimerPtr timer) override;
 
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICETransport => ITimerWheelDelegate
+      #pragma mark
+
+      virtual void onTimerWheelFired(TimerIDListPtr timers) override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark ICETransport => IICECheckPacerDelegate
+      #pragma mark
+
+      virtual void onICECheckPacerGranted(RequestIDListPtr requests) override;
+
       //-----------------------------------------------------------------------
       #pragma mark
       #pragma mark ICETransport => IPromiseSettledDelegate
@@ -600,7 +630,7 @@ namespace ortc
         AutoPUID mID;
 
         CandidatePairPtr mCandidatePair;
-        String mCandidatePairHash;
+        CandidatePairKey mCandidatePairHash;
 
         RouteStateTrackerPtr mTracker;
 
@@ -614,10 +644,13 @@ namespace ortc
         Time mLastReceivedMedia;
         Time mLastReceivedResponse;
 
+        std::atomic<Time::duration::rep> mFastPathLastReceivedMedia {0};  // stamped without the lock by the media fast path (sampled into mLastReceivedMedia)
+
         bool mPrune {false};
         bool mKeepWarm {false};
         ISTUNRequesterPtr mOutgoingCheck;
-        TimerPtr mNextKeepWarm;
+        TimerWheel::TimerID mNextKeepWarm {};
+        ICECheckPacer::RequestID mPacedCheck {};
 
         PromisePtr mFrozenPromise;
         PromiseList mDependentPromises;
@@ -625,12 +658,30 @@ namespace ortc
         Time mLastRoundTripCheck;
         Microseconds mLastRoundTripMeasurement {};
 
+        Microseconds mSmoothedRoundTrip {};     // 1/8 gain moving average of the round trip measurements
+        double mSmoothedLoss {};                // 1/8 gain moving average of check retransmissions (0..1)
+        size_t mCheckTransmissions {};          // transmissions of the outstanding outgoing check
+        size_t mRoundTripSamples {};            // round trip samples taken (see updateRoundTrip)
+        size_t mComparedRoundTripSamples {};    // value of mRoundTripSamples at the last renomination comparison
+        size_t mConsecutiveBetterSamples {};    // samples in a row this route beat the active route
+
+        size_t mTotalChecksSent {};
+        size_t mTotalChecksReceived {};
+        size_t mTotalResponsesSent {};
+        size_t mTotalResponsesReceived {};
+
+        std::atomic<ULONGLONG> mPacketsSent {};       // counted without the lock by the media fast path
+        std::atomic<ULONGLONG> mBytesSent {};
+        std::atomic<ULONGLONG> mPacketsReceived {};
+        std::atomic<ULONGLONG> mBytesReceived {};
+
         Route(RouteStateTrackerPtr tracker);
         ~Route();
 
         ElementPtr toDebug() const;
 
         QWORD getPreference(bool localIsControlling) const;
+        Microseconds getEffectiveRoundTrip() const;
         QWORD getActivationPriority(
                                     bool localIsControlling,
                                     bool useUnfreezePreference
@@ -674,10 +725,63 @@ namespace ortc
         size_t count(States state);
       };
 
+      struct Renomination
+      {
+        typedef std::set<RouteID> RouteIDSet;
+
+        PUID mOuterObjectID {};
+
+        size_t mWarmCandidatePairs {};
+        size_t mImprovementPercentage {};
+        size_t mConsecutiveSamples {};
+        Seconds mHoldDown {};
+        Seconds mActivityWindow {};   // the active route must have remote activity this recently
+
+        Time mLastRenomination;
+        RouteIDSet mWarmRoutes;     // fastest few routes as of the last pass
+
+        Renomination(PUID outerObjectID = 0);
+
+        ElementPtr toDebug() const;
+
+        bool isActiveRouteLive(
+                               const Time &lastRemoteActivity,
+                               const Time &now
+                               ) const;
+
+        void updateWarmRoutes(const RoundTripRouteMap &routes);
+        bool isWarmRoute(RoutePtr route) const;
+
+        RoutePtr pick(
+                      const RoundTripRouteMap &routes,  // renomination candidates sorted by effective round trip
+                      RoutePtr activeRoute,
+                      const Time &now,
+                      const char * &outReason
+                      );
+
+      protected:
+        Log::Params log(const char *message) const;
+      };
+
       struct ReasonNoMoreRelationship : public Any
       {
       };
 
+      // immutable snapshot of the active route published for the media
+      // fast path (read with std::atomic_load, never modified once published)
+      struct FastPath
+      {
+        RoutePtr mRoute;
+        RouterRoutePtr mRouterRoute;
+        PUID mRouterRouteID {};
+
+        UseICEGathererPtr mGatherer;
+
+        bool mDeliverDirect {false};
+        UseSecureTransportWeakPtr mSecureTransport;
+        PUID mSecureTransportID {};
+      };
+
     protected:
       //-----------------------------------------------------------------------
       #pragma mark
@@ -721,8 +825,18 @@ namespace ortc
       void handleLastReceivedPacket();
       void handleActivationTimer();
       void handleNextKeepWarmTimer(RoutePtr route);
+      void handleUseCandidate();
+
+      void requestPacedActivation();
+      void requestPacedCheck(RoutePtr route);
+      void removePacedCheck(RoutePtr route);
+      void removePacedUseCandidate();
 
       void forceActive(RoutePtr route);
+      void setActive(
+                     RoutePtr route,
+                     const char *reason
+                     );
       void shutdown(RoutePtr route);
 
       void pruneAllCandidatePairs(bool keepActiveAlive);
@@ -741,6 +855,10 @@ namespace ortc
 
       void updateAfterPacket(RoutePtr route);
 
+      void refreshFastPath();
+      void sampleFastPathActivity();
+      void sampleFastPathActivity(RoutePtr route);
+
       bool installGathererRoute(RoutePtr route);
 
       void installFoundation(RoutePtr route);
@@ -757,7 +875,12 @@ namespace ortc
       void removePendingActivation(RoutePtr route);
       void removeOutgoingCheck(RoutePtr route);
       void removeGathererRoute(RoutePtr route);
+      void installKeepWarmTimer(
+                                RoutePtr route,
+                                Time fireAt
+                                );
       void removeKeepWarmTimer(RoutePtr route);
+      void clearKeepWarmTimers();
       void removeWarm(RoutePtr route);
 
       RoutePtr findRoute(
@@ -771,6 +894,11 @@ namespace ortc
                                 );
       Time getLastRemoteActivity(RoutePtr route) const;
 
+      void updateRoundTrip(RoutePtr route);
+      void getRenominationRoutes(RoundTripRouteMap &outRoutes) const;
+      bool isRenominationWarmRoute(RoutePtr route) const;
+      RoutePtr pickRenominationRoute(const char * &outReason);
+
       ISTUNRequesterPtr createBindRequest(
                                           RoutePtr route,
                                           bool useCandidate = false,
@@ -847,6 +975,7 @@ namespace ortc
 
       String mOptionsHash;
       Options mOptions;
+      bool mLocalICELite {false};
       QWORD mConflictResolver {};
 
       String mRemoteParametersHash;
@@ -866,6 +995,16 @@ namespace ortc
       RouteStateTrackerPtr mRouteStateTracker;
 
       TimerPtr mActivationTimer;
+
+      TimerWheelPtr mTimerWheel;
+      ITimerWheelDelegatePtr mTimerWheelDelegate;
+
+      ICECheckPacerPtr mCheckPacer;
+      IICECheckPacerDelegatePtr mCheckPacerDelegate;
+      ICECheckPacer::RequestID mPacedActivation {};
+      ICECheckPacer::RequestID mPacedUseCandidate {};
+      PacedRouteMap mPacedChecks;
+
       bool mNextActivationCausesAllRoutesThatReceivedChecksToActivate {false};
 
       SortedRouteMap mPendingActivation;
@@ -873,6 +1012,7 @@ namespace ortc
       PromiseRouteMap mFrozen;
 
       RoutePtr mActiveRoute;
+      FastPathPtr mFastPath;  // warning: only access via std::atomic_load / std::atomic_store
 
       RouteMap mWarmRoutes;   // these are reported as available (and gone when removed)
 
@@ -897,6 +1037,9 @@ namespace ortc
       Milliseconds mKeepWarmTimeBase {};
       Milliseconds mKeepWarmTimeRandomizedAddTime {};
 
+      bool mRenominate {false};
+      Renomination mRenomination;
+
       PUID mSecureTransportID {0};
       UseSecureTransportWeakPtr mSecureTransport;
       UseSecureTransportWeakPtr mSecureTransportOld;
@@ -906,6 +1049,11 @@ namespace ortc
       PacketQueue mBufferedPackets;
 
       STUNPacket::Options mSTUNPacketOptions;
+
+      std::atomic<ULONGLONG> mPacketsSent {};         // counted without the lock by the media fast path
+      std::atomic<ULONGLONG> mBytesSent {};
+      std::atomic<ULONGLONG> mPacketsReceived {};
+      std::atomic<ULONGLONG> mBytesReceived {};
     };
 
     //-------------------------------------------------------------------------
@@ -932,11 +1080,13 @@ namespace ortc
 
 ZS_DECLARE_PROXY_BEGIN(ortc::internal::IICETransportAsyncDelegate)
 ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsProvider::PromiseWithStatsReportPtr, PromiseWithStatsReportPtr)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsReportTypes::StatsTypeSet, StatsTypeSet)
 ZS_DECLARE_PROXY_TYPEDEF(ortc::IICETypes::CandidatePtr, CandidatePtr)
 ZS_DECLARE_PROXY_TYPEDEF(zsLib::IPAddress, IPAddress)
 ZS_DECLARE_PROXY_TYPEDEF(ortc::services::STUNPacketPtr, STUNPacketPtr)
-ZS_DECLARE_PROXY_METHOD_1(onResolveStatsPromise, PromiseWithStatsReportPtr)
-ZS_DECLARE_PROXY_METHOD_3(onNotifyPacketRetried, CandidatePtr, IPAddress, STUNPacketPtr)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::IPRouteKey, IPRouteKey)
+ZS_DECLARE_PROXY_METHOD_2(onResolveStatsPromise, PromiseWithStatsReportPtr, StatsTypeSet)
+ZS_DECLARE_PROXY_METHOD_4(onNotifyPacketRetried, IPRouteKey, CandidatePtr, IPAddress, STUNPacketPtr)
 ZS_DECLARE_PROXY_METHOD_0(onWarmRoutesChanged)
 ZS_DECLARE_PROXY_METHOD_1(onNotifyAttached, PUID)
 ZS_DECLARE_PROXY_METHOD_1(onNotifyDetached, PUID)
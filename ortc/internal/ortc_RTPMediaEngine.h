@@ -1037,6 +1037,31 @@ namespace ortc
         virtual void OnLogMessage(const std::string& message) override;
       };
 
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark RTPMediaEngine::PacerSendBurst
+      #pragma mark
+
+      // registered with the pacer thread in place of the pacer; every packet
+      // paced out during one Process() pass is sent on the pacer thread so
+      // the pass is wrapped in an ICEGatherer::SendBurst and its UDP packets
+      // are flushed together when the pass completes
+      class PacerSendBurst : public webrtc::Module
+      {
+      public:
+        PacerSendBurst(webrtc::Module *pacer) : mPacer(pacer) {}
+
+        virtual int64_t TimeUntilNextProcess() override;
+        virtual void Process() override;
+        virtual void ProcessThreadAttached(webrtc::ProcessThread *processThread) override;
+
+      protected:
+        webrtc::Module *mPacer;
+      };
+
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
       //-----------------------------------------------------------------------
@@ -1404,6 +1429,7 @@ namespace ortc
         webrtc::VieRemb mRemb;
         rtc::scoped_ptr<webrtc::CallStats> mCallStats;
         rtc::scoped_ptr<webrtc::CongestionController> mCongestionController;
+        rtc::scoped_ptr<PacerSendBurst> mPacerSendBurst;
         rtc::scoped_ptr<webrtc::BitrateAllocator> mBitrateAllocator;
 
         bool mShuttingDown {false};
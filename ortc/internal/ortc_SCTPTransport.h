@@ -47,7 +47,19 @@
 
 #include <usrsctp.h>
 
+#include <atomic>
+
 #define ORTC_SETTING_SCTP_TRANSPORT_MAX_SESSIONS_PER_PORT "ortc/sctp/max-sessions-per-port"
+#define ORTC_SETTING_SCTP_TRANSPORT_MESSAGE_INTERLEAVING "ortc/sctp/message-interleaving"
+
+// "fcfs", "round-robin" (default), "round-robin-packet", "priority" or
+// "fair-bandwidth"; data channel priorities only apply with "priority"
+#define ORTC_SETTING_SCTP_TRANSPORT_STREAM_SCHEDULER "ortc/sctp/stream-scheduler"
+
+// true = usrsctp runs without its own threads; its timers are driven from an
+// ORTC timer and associations are spread across the packet queues
+#define ORTC_SETTING_SCTP_TRANSPORT_DRIVE_FROM_PACKET_QUEUES "ortc/sctp/drive-from-packet-queues"
+#define ORTC_SETTING_SCTP_TRANSPORT_TIMER_INTERVAL_IN_MILLISECONDS "ortc/sctp/timer-interval-in-milliseconds"
 
 namespace ortc
 {
@@ -134,6 +146,7 @@ namespace ortc
       bool                mOrdered {true};
       Milliseconds        mMaxPacketLifetime {};
       Optional<DWORD>     mMaxRetransmits;
+      WORD                mPriority {};
       SecureByteBlockPtr  mBuffer;
 
       ElementPtr toDebug() const;
@@ -259,8 +272,9 @@ namespace ortc
 
     interaction ISCTPTransportAsyncDelegate
     {
-      virtual void onIncomingPacket(SCTPPacketIncomingPtr packet) = 0;
+      virtual void onDeliverInboundMessages() = 0;
       virtual void onNotifiedToShutdown() = 0;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) = 0;
     };
 
     //-------------------------------------------------------------------------
@@ -296,9 +310,11 @@ namespace ortc
 }
 
 ZS_DECLARE_PROXY_BEGIN(ortc::internal::ISCTPTransportAsyncDelegate)
-ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::SCTPPacketIncomingPtr, SCTPPacketIncomingPtr)
-ZS_DECLARE_PROXY_METHOD_1(onIncomingPacket, SCTPPacketIncomingPtr)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsProvider::PromiseWithStatsReportPtr, PromiseWithStatsReportPtr)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::IStatsReportTypes::StatsTypeSet, StatsTypeSet)
+ZS_DECLARE_PROXY_METHOD_0(onDeliverInboundMessages)
 ZS_DECLARE_PROXY_METHOD_0(onNotifiedToShutdown)
+ZS_DECLARE_PROXY_METHOD_2(onResolveStatsPromise, PromiseWithStatsReportPtr, StatsTypeSet)
 ZS_DECLARE_PROXY_END()
 
 ZS_DECLARE_PROXY_BEGIN(ortc::internal::ISCTPTransportForDataChannelDelegate)
@@ -352,6 +368,12 @@ namespace ortc
       ZS_DECLARE_TYPEDEF_PTR(ISCTPTransportTypes::Capabilities, Capabilities);
 
       ZS_DECLARE_STRUCT_PTR(TearAwayData)
+      ZS_DECLARE_STRUCT_PTR(InboundMessage)
+      ZS_DECLARE_CLASS_PTR(InboundQueue)
+
+      typedef std::list<SCTPPacketIncomingPtr> PacketIncomingList;
+      typedef std::pair<UseDataChannelPtr, SCTPPacketIncomingPtr> DataChannelPacketPair;
+      typedef std::list<DataChannelPacketPair> DataChannelPacketList;
 
       typedef PUID DataChannelID;
       typedef std::map<DataChannelID, UseDataChannelPtr> DataChannelMap;
@@ -361,7 +383,21 @@ namespace ortc
 
       typedef std::queue<PromisePtr> PromiseQueue;
 
-      typedef std::queue<SecureByteBlockPtr> BufferQueue;
+      struct PartialIncoming
+      {
+        PacketIncomingList mPieces;
+        size_t mTotalSize {};
+        bool mDiscarding {false};
+      };
+      typedef std::map<SessionID, PartialIncoming> PartialIncomingMap;
+
+      struct StreamStats
+      {
+        Optional<WORD> mAppliedPriority;
+        unsigned long long mMessagesSent {};
+        unsigned long long mBytesSent {};
+      };
+      typedef std::map<SessionID, StreamStats> StreamStatsMap;
 
       enum InternalStates
       {
@@ -532,8 +568,9 @@ namespace ortc
       #pragma mark SCTPTransport => ISCTPTransportAsyncDelegate
       #pragma mark
 
-      virtual void onIncomingPacket(SCTPPacketIncomingPtr packet) override;
+      virtual void onDeliverInboundMessages() override;
       virtual void onNotifiedToShutdown() override;
+      virtual void onResolveStatsPromise(IStatsProvider::PromiseWithStatsReportPtr promise, IStatsReportTypes::StatsTypeSet stats) override;
 
       //-----------------------------------------------------------------------
       #pragma mark
@@ -563,6 +600,7 @@ namespace ortc
       bool stepSecureTransport();
       bool stepOpen();
       bool stepDeliverIncomingPackets();
+      void deliverPendingIncoming();
       bool stepConnected();
       bool stepResetStream();
 
@@ -582,6 +620,16 @@ namespace ortc
                        );
       void notifyWriteReady();
 
+      UseDataChannelPtr findOrCreateIncomingDataChannel(const SCTPPacketIncoming &packet);
+      void applyStreamPriority(
+                               struct socket *socket,
+                               const SCTPPacketOutgoing &packet,
+                               StreamStats &stream
+                               );
+      void sessionOpened(SessionID sessionID);
+      void sessionClosed(SessionID sessionID);
+      SCTPPacketIncomingPtr reassembleIncoming(SCTPPacketIncomingPtr packet);
+
       void handleNotificationPacket(const sctp_notification &notification);
       void handleNotificationAssocChange(const sctp_assoc_change &change);
       void handleStreamResetEvent(const sctp_stream_reset_event &event);
@@ -599,6 +647,84 @@ namespace ortc
         ISCTPTransportSubscriptionPtr mDefaultSubscription;
       };
 
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark SCTPTransport::InboundMessage
+      #pragma mark
+
+      // a message as handed over by usrsctp; the receive buffer is owned
+      // (usrsctp allocates it for the callback) and released with free()
+      struct InboundMessage
+      {
+        InboundMessage *mNext {};
+
+        SCTPPayloadProtocolIdentifier mType {SCTP_PPID_NONE};
+        WORD mSessionID {};
+        WORD mSequenceNumber {};
+        DWORD mTimestamp {};
+        int mFlags {};
+
+        void *mData {};
+        size_t mSize {};
+
+        ~InboundMessage();
+
+        SCTPPacketIncomingPtr toPacket() const;
+      };
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark SCTPTransport::InboundQueue
+      #pragma mark
+
+      // lock-free multiple producer (usrsctp threads) / single consumer (the
+      // transport's queue); producers push onto an atomic stack and the
+      // consumer takes the entire stack in one exchange
+      class InboundQueue
+      {
+      public:
+        ~InboundQueue();
+
+        bool push(InboundMessage *message);   // true if the queue was empty (a drain must be scheduled)
+        InboundMessage *popAll();             // oldest message first
+
+      protected:
+        std::atomic<InboundMessage *> mHead {};
+      };
+
+      // Packets arriving before the socket is open are copied into a
+      // power-of-two ring of slots whose buffers come from a process wide
+      // preallocated pool; buffers go back to the pool as they are drained.
+      class PendingIncomingRing
+      {
+      public:
+        struct Slot
+        {
+          SecureByteBlockPtr mBuffer;
+          size_t mSize {};
+        };
+        typedef std::vector<Slot> SlotVector;
+
+        size_t size() const {return mSize;}
+        bool isEmpty() const {return 0 == mSize;}
+
+        const Slot &front() const {return mSlots[mHead];}
+
+        void push(const BYTE *buffer, size_t bufferLengthInBytes);
+        void popFront();
+        void release();
+
+        ElementPtr toDebug() const;
+
+      protected:
+        void grow();
+
+      protected:
+        SlotVector mSlots;
+        size_t mHead {};
+        size_t mSize {};
+      };
+
     protected:
       //-----------------------------------------------------------------------
       #pragma mark
@@ -611,6 +737,7 @@ namespace ortc
 
       SCTPInitPtr mSCTPInit;
       size_t mMaxSessionsPerPort {};
+      size_t mMaxIncomingMessageSize {};
 
       ISCTPTransportDelegateSubscriptions mSubscriptions;
 
@@ -632,6 +759,9 @@ namespace ortc
       SCTPTransportWeakPtr *mThisSocket {};
 
       bool mIncoming {false};
+      bool mMessageInterleaving {false};
+      String mStreamScheduler;
+      bool mStreamPriorities {false};
 
       struct socket *mSocket {};
 
@@ -657,7 +787,14 @@ namespace ortc
       bool mConnected {false};
       bool mWriteReady {false};
 
-      BufferQueue mPendingIncomingBuffers;
+      PendingIncomingRing mPendingIncoming;
+
+      InboundQueue mInboundQueue;
+      PartialIncomingMap mPartialIncoming;
+
+      StreamStatsMap mStreamStats;
+      unsigned long mDataChannelsOpened {};
+      unsigned long mDataChannelsClosed {};
     };
 
     //-------------------------------------------------------------------------
@@ -44,6 +44,8 @@
 #include <zsLib/ProxySubscriptions.h>
 #include <zsLib/TearAway.h>
 
+#include <unordered_map>
+
 #include <usrsctp.h>
 
 #define ORTC_SETTING_SCTP_TRANSPORT_MAX_MESSAGE_SIZE      "ortc/sctp/max-message-size"
@@ -131,12 +133,29 @@ namespace ortc
 
     interaction ISCTPTransportListenerAsyncDelegate
     {
+      ZS_DECLARE_TYPEDEF_PTR(ISCTPTransportForSCTPTransportListener, UseSCTPTransport)
+
+      virtual void onAnnounceTransport(
+                                       UseSCTPTransportPtr transport,
+                                       WORD localPort,
+                                       WORD remotePort
+                                       ) = 0;
+
+      virtual void onTransportShutdown(
+                                       PUID transportID,
+                                       WORD localPort,
+                                       WORD remotePort
+                                       ) = 0;
+
       virtual ~ISCTPTransportListenerAsyncDelegate() {};
     };
   }
 }
 
 ZS_DECLARE_PROXY_BEGIN(ortc::internal::ISCTPTransportListenerAsyncDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::ISCTPTransportListenerAsyncDelegate::UseSCTPTransportPtr, UseSCTPTransportPtr)
+ZS_DECLARE_PROXY_METHOD_3(onAnnounceTransport, UseSCTPTransportPtr, WORD, WORD)
+ZS_DECLARE_PROXY_METHOD_3(onTransportShutdown, PUID, WORD, WORD)
 ZS_DECLARE_PROXY_END()
 
 namespace ortc
@@ -174,14 +193,46 @@ namespace ortc
       ZS_DECLARE_TYPEDEF_PTR(ISCTPTransportForSCTPTransportListener, UseSCTPTransport)
 
       typedef DWORD LocalRemoteTupleID;
-      typedef std::map<LocalRemoteTupleID, UseSCTPTransportPtr> TransportMap;
+      typedef std::unordered_map<LocalRemoteTupleID, UseSCTPTransportPtr> TransportMap;
 
       typedef std::pair<LocalRemoteTupleID, UseSCTPTransportPtr> TupleSCTPTransportPair;
 
       typedef PUID SCTPTransportID;
-      typedef std::map<SCTPTransportID, UseSCTPTransportPtr> TransportIDMap;
+      typedef std::unordered_map<SCTPTransportID, UseSCTPTransportPtr> TransportIDMap;
+      typedef std::map<SCTPTransportID, UseSCTPTransportPtr> OrderedTransportIDMap;   // announce order must be preserved
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark SCTPTransportListener::AllocatedPorts
+      #pragma mark
+
+      // Reference counted set of ports with a bitmap of the ports in use so
+      // the allocator can skip whole blocks of taken ports at once.
+      class AllocatedPorts
+      {
+      public:
+        enum Constants
+        {
+          BitsPerBlock = 64,
+          TotalBlocks = 65536 / BitsPerBlock,
+        };
+
+        void allocate(WORD port);
+        bool deallocate(WORD port);
+
+        bool isAllocated(WORD port) const {return 0 != (mInUse[port / BitsPerBlock] & bit(port));}
+        QWORD block(WORD port) const      {return mInUse[port / BitsPerBlock];}
 
-      typedef std::map<WORD, size_t> AllocatedPortMap;
+        size_t size() const               {return mTotals.size();}
+        void clear();
+
+      protected:
+        static QWORD bit(WORD port)       {return static_cast<QWORD>(1) << (port % BitsPerBlock);}
+
+      protected:
+        QWORD mInUse[TotalBlocks] {};
+        std::unordered_map<WORD, size_t> mTotals;
+      };
 
     public:
       SCTPTransportListener(
@@ -270,6 +321,18 @@ namespace ortc
       #pragma mark SCTPTransportListener => ISCTPTransportListenerAsyncDelegate
       #pragma mark
 
+      virtual void onAnnounceTransport(
+                                       UseSCTPTransportPtr transport,
+                                       WORD localPort,
+                                       WORD remotePort
+                                       ) override;
+
+      virtual void onTransportShutdown(
+                                       PUID transportID,
+                                       WORD localPort,
+                                       WORD remotePort
+                                       ) override;
+
       //-----------------------------------------------------------------------
       #pragma mark
       #pragma mark SCTPTransportListener => IWakeDelegate
@@ -300,12 +363,8 @@ namespace ortc
                                                               );
 
       WORD allocateLocalPort(WORD remotePort);
-      void allocatePort(
-                        AllocatedPortMap &useMap,
-                        WORD port
-                        );
       void deallocatePort(
-                          AllocatedPortMap &useMap,
+                          AllocatedPorts &ports,
                           WORD port
                           );
 
@@ -327,10 +386,10 @@ namespace ortc
 
       TransportMap mTransports;
       TransportIDMap mPendingTransports;
-      TransportIDMap mAnnouncedTransports;
+      OrderedTransportIDMap mAnnouncedTransports;
 
-      AllocatedPortMap mAllocatedLocalPorts;
-      AllocatedPortMap mAllocatedRemotePorts;
+      AllocatedPorts mAllocatedLocalPorts;
+      AllocatedPorts mAllocatedRemotePorts;
 
       size_t mMaxPorts {};
 
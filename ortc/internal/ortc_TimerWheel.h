@@ -0,0 +1,261 @@
+/*
+
+ Copyright (c) 2016, Hookflash Inc. / Hookflash Inc.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ The views and conclusions contained in the software and documentation are those
+ of the authors and should not be interpreted as representing official policies,
+ either expressed or implied, of the FreeBSD Project.
+ 
+ */
+
+#pragma once
+
+#include <ortc/internal/types.h>
+
+#include <zsLib/Timer.h>
+
+#include <list>
+#include <unordered_map>
+
+#define ORTC_SETTING_TIMER_WHEEL_TICK_IN_MILLISECONDS "ortc/timer-wheel/tick-in-milliseconds"
+
+#define ORTC_TIMER_WHEEL_BITS_PER_LEVEL (6)
+#define ORTC_TIMER_WHEEL_SLOTS_PER_LEVEL (1 << ORTC_TIMER_WHEEL_BITS_PER_LEVEL)
+#define ORTC_TIMER_WHEEL_LEVELS (4)
+
+namespace ortc
+{
+  namespace internal
+  {
+    ZS_DECLARE_INTERACTION_PTR(ITimerWheelForSettings)
+
+    ZS_DECLARE_INTERACTION_PROXY(ITimerWheelDelegate)
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ITimerWheelForSettings
+    #pragma mark
+
+    interaction ITimerWheelForSettings
+    {
+      ZS_DECLARE_TYPEDEF_PTR(ITimerWheelForSettings, ForSettings)
+
+      static void applyDefaults();
+
+      virtual ~ITimerWheelForSettings() {}
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark ITimerWheelDelegate
+    #pragma mark
+
+    interaction ITimerWheelDelegate
+    {
+      typedef PUID TimerID;
+      typedef std::list<TimerID> TimerIDList;
+      ZS_DECLARE_PTR(TimerIDList)
+
+      // every timer belonging to this delegate that expired on the same
+      // wheel tick is delivered in one call (on the delegate's queue)
+      virtual void onTimerWheelFired(TimerIDListPtr timers) = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerWheel
+    #pragma mark
+
+    // Shared hierarchical timer wheel (one zsLib timer for the process).
+    // Arming and cancelling are O(1); the wheel only ticks while at least one
+    // timer is armed. Use it for large numbers of coarse (tick resolution)
+    // per-object timers such as ICE keep-warm checks.
+    class TimerWheel : public SharedRecursiveLock,
+                       public MessageQueueAssociator,
+                       public ISingletonManagerDelegate,
+                       public ITimerWheelForSettings,
+                       public zsLib::ITimerDelegate
+    {
+    protected:
+      struct make_private {};
+
+    public:
+      friend interaction ITimerWheelForSettings;
+
+      typedef ITimerWheelDelegate::TimerID TimerID;
+      typedef ITimerWheelDelegate::TimerIDList TimerIDList;
+      typedef ITimerWheelDelegate::TimerIDListPtr TimerIDListPtr;
+      typedef ULONGLONG Tick;
+
+      ZS_DECLARE_STRUCT_PTR(Entry)
+
+      typedef std::list<EntryPtr> EntryList;
+      typedef std::unordered_map<TimerID, EntryPtr> EntryMap;
+
+      struct Stats
+      {
+        size_t mActiveTimers {};
+        size_t mPeakActiveTimers {};    // system timers needed at once with one timer per object
+        size_t mTotalArmed {};          // system timers created with one timer per object
+        size_t mTotalCancelled {};
+        size_t mTotalFired {};          // wake ups with one timer per object
+        size_t mTotalCallbacks {};
+        size_t mTotalSystemTimers {};   // system timers created by the wheel
+        size_t mTotalWakeUps {};        // wheel ticks actually serviced
+      };
+
+    public:
+      TimerWheel(
+                 const make_private &,
+                 IMessageQueuePtr queue
+                 );
+
+    protected:
+      void init();
+
+    public:
+      ~TimerWheel();
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark TimerWheel => (friends)
+      #pragma mark
+
+      static ElementPtr toDebug(TimerWheelPtr wheel);
+
+      static TimerWheelPtr singleton();
+
+      virtual PUID getID() const {return mID;}
+
+      // delegate should be a proxy (e.g. ITimerWheelDelegateProxy::createWeak(...))
+      virtual TimerID arm(
+                          ITimerWheelDelegatePtr delegate,
+                          Time fireAt
+                          );
+      virtual TimerID arm(
+                          ITimerWheelDelegatePtr delegate,
+                          Milliseconds fireIn
+                          );
+      virtual void cancel(TimerID timerID);
+
+      virtual Stats getStats() const;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark TimerWheel => ISingletonManagerDelegate
+      #pragma mark
+
+      virtual void notifySingletonCleanup() override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark TimerWheel => ITimerDelegate
+      #pragma mark
+
+      virtual void onTimer(TimerPtr timer) override;
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark TimerWheel => (internal)
+      #pragma mark
+
+      static TimerWheelPtr create();
+
+      Log::Params log(const char *message) const;
+      static Log::Params slog(const char *message);
+      Log::Params debug(const char *message) const;
+      ElementPtr toDebug() const;
+
+      void cancel();
+
+      Tick toTick(Time when) const;
+      void place(EntryPtr entry);
+      void remove(Entry &entry);
+      void cascade(size_t level);
+      void advance(
+                   Tick toTick,
+                   EntryList &outExpired
+                   );
+
+    public:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark TimerWheel::Entry
+      #pragma mark
+
+      struct Entry
+      {
+        TimerID mID {};
+        ITimerWheelDelegatePtr mDelegate;
+        Tick mExpiry {};
+
+        size_t mLevel {};
+        size_t mSlot {};
+        EntryList::iterator mPosition;
+      };
+
+    protected:
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark TimerWheel (data)
+      #pragma mark
+
+      AutoPUID mID;
+      TimerWheelWeakPtr mThisWeak;
+
+      Milliseconds mTickDuration {};
+      Time mStartTime;
+      Tick mCurrentTick {};
+
+      EntryList mSlots[ORTC_TIMER_WHEEL_LEVELS][ORTC_TIMER_WHEEL_SLOTS_PER_LEVEL];
+      EntryMap mEntries;
+
+      TimerPtr mTimer;
+
+      size_t mPeakActiveTimers {};
+      size_t mTotalArmed {};
+      size_t mTotalCancelled {};
+      size_t mTotalFired {};
+      size_t mTotalCallbacks {};
+      size_t mTotalSystemTimers {};
+      size_t mTotalWakeUps {};
+    };
+  }
+}
+
+ZS_DECLARE_PROXY_BEGIN(ortc::internal::ITimerWheelDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(ortc::internal::ITimerWheelDelegate::TimerIDListPtr, TimerIDListPtr)
+ZS_DECLARE_PROXY_METHOD_1(onTimerWheelFired, TimerIDListPtr)
+ZS_DECLARE_PROXY_END()
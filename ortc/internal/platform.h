@@ -42,6 +42,11 @@
 #undef HAVE_SPRINTF_S
 #undef HAVE_GETADAPTERADDRESSES
 #undef HAVE_GETIFADDRS
+#undef HAVE_RECVMMSG
+#undef HAVE_SENDMMSG
+#undef HAVE_UDP_SEGMENT
+#undef HAVE_SO_REUSEPORT
+#undef HAVE_WRITEV
 
 
 #ifdef _WIN32
@@ -85,6 +90,7 @@
 #define HAVE_SYS_TYPES_H 1
 #define HAVE_IFADDRS_H 1
 #define HAVE_GETIFADDRS 1
+#define HAVE_WRITEV 1
 
 #endif //__QNX__
 
@@ -99,6 +105,7 @@
 #define HAVE_GETIFADDRS 1
 #define HAVE_NET_IF_H 1
 #define HAVE_TGMATH_H
+#define HAVE_WRITEV 1
 #if TARGET_OS_IPHONE
 // iphone OS
 #else
@@ -116,6 +123,11 @@
 #define HAVE_NET_IF_H 1
 #define HAVE_NETINIT6_IN6_VAR_H 1
 #define HAVE_GETIFADDRS 1
+#define HAVE_RECVMMSG 1
+#define HAVE_SENDMMSG 1
+#define HAVE_UDP_SEGMENT 1
+#define HAVE_SO_REUSEPORT 1
+#define HAVE_WRITEV 1
 
 #ifdef _ANDROID
 
@@ -123,6 +135,9 @@
 
 // Android does not support these features
 #undef HAVE_IFADDRS_H
+#undef HAVE_RECVMMSG
+#undef HAVE_SENDMMSG
+#undef HAVE_UDP_SEGMENT
 
 #endif //_ANDROID
 #endif //_LINUX
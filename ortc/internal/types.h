@@ -120,8 +120,11 @@ namespace ortc
     ZS_DECLARE_CLASS_PTR(DataChannel)
     ZS_DECLARE_CLASS_PTR(DTMFSender)
     ZS_DECLARE_CLASS_PTR(DTLSTransport)
+    ZS_DECLARE_CLASS_PTR(ICECheckPacer)
     ZS_DECLARE_CLASS_PTR(ICEGatherer)
     ZS_DECLARE_CLASS_PTR(ICEGathererRouter)
+    ZS_DECLARE_CLASS_PTR(ICEGathererUDPMux)
+    ZS_DECLARE_CLASS_PTR(ICEGathererWarmPool)
     ZS_DECLARE_CLASS_PTR(ICETransport)
     ZS_DECLARE_CLASS_PTR(ICETransportController)
     ZS_DECLARE_CLASS_PTR(Identity)
@@ -141,6 +144,7 @@ namespace ortc
     ZS_DECLARE_CLASS_PTR(SCTPTransport)
     ZS_DECLARE_CLASS_PTR(SRTPSDESTransport)
     ZS_DECLARE_CLASS_PTR(SRTPTransport)
+    ZS_DECLARE_CLASS_PTR(TimerWheel)
 
 
     ZS_DECLARE_INTERACTION_PROXY(ISecureTransportDelegate)
@@ -35,10 +35,17 @@
 #include <ortc/IICEGatherer.h>
 #include <ortc/ISettings.h>
 
+#include <ortc/internal/ortc_ICEGatherer.h>
+#include <ortc/internal/ortc_ICEGathererUDPMux.h>
+#include <ortc/internal/ortc_ICEGathererWarmPool.h>
+#include <ortc/internal/platform.h>
+
 #include <ortc/services/IHelper.h>
 
 #include <zsLib/XML.h>
 
+#include <set>
+
 #include "config.h"
 #include "testing.h"
 
@@ -70,6 +77,7 @@ namespace ortc
       public:
         typedef String Hash;
         typedef std::map<Hash, CandidatePtr> CandidateMap;
+        typedef std::set<WORD> PortSet;
 
         struct Expectations {
           ULONG mStateNew {0};
@@ -134,6 +142,18 @@ namespace ortc
           return pThis;
         }
 
+        //---------------------------------------------------------------------
+        static ICEGathererTesterPtr createAssociated(
+                                                     IMessageQueuePtr queue,
+                                                     ICEGathererTesterPtr rtpTester
+                                                     )
+        {
+          ICEGathererTesterPtr pThis(new ICEGathererTester(queue));
+          pThis->mThisWeak = pThis;
+          pThis->initAssociated(rtpTester);
+          return pThis;
+        }
+
         //---------------------------------------------------------------------
         ICEGathererTester(IMessageQueuePtr queue) :
           SharedRecursiveLock(SharedRecursiveLock::create()),
@@ -163,6 +183,18 @@ namespace ortc
           mGatherer = IICEGatherer::create(mThisWeak.lock(), options);
         }
 
+        //---------------------------------------------------------------------
+        void initAssociated(ICEGathererTesterPtr rtpTester)
+        {
+          AutoRecursiveLock lock(*this);
+          IICEGathererPtr rtpGatherer;
+          {
+            AutoRecursiveLock rtpLock(*rtpTester);
+            rtpGatherer = rtpTester->mGatherer;
+          }
+          mGatherer = rtpGatherer->createAssociatedGatherer(mThisWeak.lock());
+        }
+
         //---------------------------------------------------------------------
         bool matches(const Expectations &op2)
         {
@@ -195,6 +227,13 @@ namespace ortc
         //---------------------------------------------------------------------
         Expectations getExpectations() const {return mExpectations;}
 
+        //---------------------------------------------------------------------
+        PortSet getUDPHostPorts()
+        {
+          AutoRecursiveLock lock(*this);
+          return mUDPHostPorts;
+        }
+
         //---------------------------------------------------------------------
         virtual void onICEGathererStateChange(
                                               IICEGathererPtr gatherer,
@@ -235,7 +274,11 @@ namespace ortc
             case IICETypes::CandidateType_Host:
             {
               switch (candidate->mProtocol) {
-                case IICETypes::Protocol_UDP: ++mExpectations.mCandidatesUDPHost; break;
+                case IICETypes::Protocol_UDP: {
+                  ++mExpectations.mCandidatesUDPHost;
+                  mUDPHostPorts.insert(candidate->mPort);
+                  break;
+                }
                 case IICETypes::Protocol_TCP: {
                   switch (candidate->mTCPType) {
                     case IICETypes::TCPCandidateType_Active:    ++mExpectations.mCandidatesTCPHostActive; break;
@@ -312,6 +355,80 @@ namespace ortc
         Expectations mExpectations;
 
         CandidateMap mCandidates;
+        PortSet mUDPHostPorts;
+      };
+
+      ZS_DECLARE_CLASS_PTR(FakeMuxGatherer)
+
+      //-----------------------------------------------------------------------
+      // stands in for a gatherer attached to the UDP mux and records what
+      // the mux dispatched to it
+      class FakeMuxGatherer : public SharedRecursiveLock,
+                              public ortc::internal::IICEGathererForUDPMux
+      {
+      public:
+        ZS_DECLARE_TYPEDEF_PTR(ortc::internal::STUNPacket, STUNPacket)
+
+      public:
+        FakeMuxGatherer() :
+          SharedRecursiveLock(SharedRecursiveLock::create())
+        {
+        }
+
+        virtual PUID getID() const override {return mID;}
+
+        //---------------------------------------------------------------------
+        virtual void notifyUDPMuxPacket(
+                                        SocketPtr socket,
+                                        const IPAddress &fromIP,
+                                        const BYTE *buffer,
+                                        size_t bufferSizeInBytes,
+                                        STUNPacketPtr stunPacket
+                                        ) override
+        {
+          AutoRecursiveLock lock(*this);
+          if (stunPacket) {
+            ++mSTUNPackets;
+            mLastUsername = stunPacket->mUsername;
+          } else {
+            ++mMediaPackets;
+          }
+          mLastFromIP = fromIP;
+        }
+
+        //---------------------------------------------------------------------
+        virtual void notifyUDPMuxSocketClosed(SocketPtr socket) override
+        {
+          AutoRecursiveLock lock(*this);
+          ++mSocketsClosed;
+        }
+
+        //---------------------------------------------------------------------
+        bool waitFor(
+                     ULONG stunPackets,
+                     ULONG mediaPackets
+                     )
+        {
+          for (ULONG loop = 0; loop < 50; ++loop) {
+            {
+              AutoRecursiveLock lock(*this);
+              if ((mSTUNPackets >= stunPackets) &&
+                  (mMediaPackets >= mediaPackets)) return true;
+            }
+            TESTING_SLEEP(100)
+          }
+          return false;
+        }
+
+      public:
+        AutoPUID mID;
+
+        ULONG mSTUNPackets {};
+        ULONG mMediaPackets {};
+        ULONG mSocketsClosed {};
+
+        String mLastUsername;
+        IPAddress mLastFromIP;
       };
 
     }
@@ -336,6 +453,7 @@ void doTestICEGatherer()
   size_t totalHostIPs = UseSettings::getUInt("tester/total-host-ips");
 
   ICEGathererTesterPtr testObject1;
+  ICEGathererTesterPtr testObject2;
 
   TESTING_STDOUT() << "WAITING:      Waiting for ICE testing to complete (max wait is 180 seconds).\n";
 
@@ -425,12 +543,43 @@ void doTestICEGatherer()
           testObject1 = ICEGathererTester::create(thread, options);
           break;
         }
+        case 6: {
+          // RTP and associated RTCP gatherers share a username fragment; only
+          // the RTP gatherer may attach to the shared UDP socket
+          ortc::ISettings::setBool("ortc/gatherer/udp-mux", true);
+
+          testObject1 = ICEGathererTester::create(thread);
+          testObject2 = ICEGathererTester::createAssociated(thread, testObject1);
+          break;
+        }
+        case 7: {
+          // two independent gatherers attach to the same shared UDP socket
+          ortc::ISettings::setBool("ortc/gatherer/udp-mux", true);
+
+          testObject1 = ICEGathererTester::create(thread);
+          testObject2 = ICEGathererTester::create(thread);
+          break;
+        }
+        case 8: {
+          // an ice lite gatherer ignores its servers and only gathers host candidates
+          String url = String("stun:") + ORTC_TEST_STUN_SERVER;
+
+          ortc::IICEGatherer::Server server;
+          server.mURLs.push_back(url);
+          ortc::IICEGatherer::Options options;
+          options.mICEServers.push_back(server);
+          options.mICELite = true;
+
+          testObject1 = ICEGathererTester::create(thread, options);
+          break;
+        }
         default:  quit = true; break;
       }
       if (quit) break;
 
       expecting = 0;
       expecting += (testObject1 ? 1 : 0);
+      expecting += (testObject2 ? 1 : 0);
 
       ULONG found = 0;
       ULONG lastFound = 0;
@@ -486,10 +635,25 @@ void doTestICEGatherer()
             }
             break;
           }
+          case 6:
+          case 7: {
+            if (7 == totalWait) {
+              testObject2->close();
+              testObject1->close();
+            }
+            break;
+          }
+          case 8: {
+            if (7 == totalWait) {
+              testObject1->close();
+            }
+            break;
+          }
         }
 
         if (0 == found) {
           found += (testObject1 ? (testObject1->matches(expectations1) ? 1 : 0) : 0);
+          found += (testObject2 ? (testObject2->matches(expectations1) ? 1 : 0) : 0);
         }
 
         if (lastFound != found) {
@@ -525,8 +689,44 @@ void doTestICEGatherer()
           TESTING_CHECK(testObject1->matches(expectations1))
           break;
         }
+        case 6: {
+          TESTING_CHECK(testObject1->matches(expectations1))
+          TESTING_CHECK(testObject2->matches(expectations1))
+
+          // the RTCP gatherer must own its own UDP ports and never the mux's
+          auto rtpPorts = testObject1->getUDPHostPorts();
+          auto rtcpPorts = testObject2->getUDPHostPorts();
+          TESTING_CHECK(rtpPorts.size() > 0)
+          TESTING_CHECK(rtcpPorts.size() > 0)
+          for (auto iter = rtcpPorts.begin(); iter != rtcpPorts.end(); ++iter) {
+            TESTING_CHECK(rtpPorts.end() == rtpPorts.find(*iter))
+          }
+
+          ortc::ISettings::setBool("ortc/gatherer/udp-mux", false);
+          break;
+        }
+        case 7: {
+          TESTING_CHECK(testObject1->matches(expectations1))
+          TESTING_CHECK(testObject2->matches(expectations1))
+
+          auto ports1 = testObject1->getUDPHostPorts();
+          auto ports2 = testObject2->getUDPHostPorts();
+          TESTING_CHECK(1 == ports1.size())
+          TESTING_CHECK(ports1 == ports2)
+
+          ortc::ISettings::setBool("ortc/gatherer/udp-mux", false);
+          break;
+        }
+        case 8: {
+          auto expectations = testObject1->getExpectations();
+          TESTING_CHECK(testObject1->matches(expectations1))
+          TESTING_CHECK(0 == expectations.mCandidatesSrflex)
+          TESTING_CHECK(0 == expectations.mCandidatesRelay)
+          break;
+        }
       }
       testObject1.reset();
+      testObject2.reset();
 
       ++step;
     } while (true);
@@ -552,3 +752,274 @@ void doTestICEGatherer()
   zsLib::proxyDump();
   TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
 }
+
+void doTestICEGathererUDPMux()
+{
+  if (!ORTC_TEST_DO_ICE_GATHERER_UDP_MUX_TEST) return;
+
+  using ortc::test::gatherer::FakeMuxGatherer;
+  using ortc::test::gatherer::FakeMuxGathererPtr;
+
+  typedef ortc::internal::ICEGathererUDPMux UseUDPMux;
+  typedef ortc::internal::STUNPacket STUNPacket;
+  typedef zsLib::Socket Socket;
+  typedef zsLib::IPAddress IPAddress;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+
+  auto mux = UseUDPMux::singleton();
+  TESTING_CHECK(mux)
+
+  FakeMuxGathererPtr gatherer1(std::make_shared<FakeMuxGatherer>());
+  FakeMuxGathererPtr gatherer2(std::make_shared<FakeMuxGatherer>());
+
+  // both gatherers share one socket (and thus one port) per interface
+  IPAddress bindIP1("127.0.0.1");
+  IPAddress bindIP2("127.0.0.1");
+  auto socket1 = mux->bind(gatherer1, "ufrag1", bindIP1);
+  auto socket2 = mux->bind(gatherer2, "ufrag2", bindIP2);
+  TESTING_CHECK(socket1)
+  TESTING_CHECK(socket1 == socket2)
+  TESTING_CHECK(0 != bindIP1.getPort())
+  TESTING_CHECK(bindIP1 == bindIP2)
+
+  auto remote1 = Socket::createUDP(Socket::Create::IPv4);
+  auto remote2 = Socket::createUDP(Socket::Create::IPv4);
+  remote1->bind(IPAddress("127.0.0.1"));
+  remote2->bind(IPAddress("127.0.0.1"));
+  IPAddress remoteIP1 = remote1->getLocalAddress();
+  IPAddress remoteIP2 = remote2->getLocalAddress();
+
+  auto sendSTUN = [&bindIP1](zsLib::SocketPtr remote, const char *username) {
+    auto request = STUNPacket::createRequest(STUNPacket::Method_Binding);
+    request->mCredentialMechanism = STUNPacket::CredentialMechanisms_ShortTerm;
+    request->mUsername = username;
+    request->mPassword = "password";
+    auto packet = request->packetize(STUNPacket::RFC_5245_ICE);
+    remote->sendTo(bindIP1, packet->BytePtr(), packet->SizeInBytes());
+  };
+  auto sendMedia = [&bindIP1](zsLib::SocketPtr remote) {
+    zsLib::BYTE media[160] {};
+    media[0] = 0x80;    // RTP version 2 (never parses as STUN)
+    remote->sendTo(bindIP1, media, sizeof(media));
+  };
+
+  // STUN requests are demultiplexed by the local username fragment
+  sendSTUN(remote1, "ufrag1:remote1");
+  sendSTUN(remote2, "ufrag2:remote2");
+  TESTING_CHECK(gatherer1->waitFor(1, 0))
+  TESTING_CHECK(gatherer2->waitFor(1, 0))
+  TESTING_EQUAL(gatherer1->mLastUsername, String("ufrag1:remote1"))
+  TESTING_EQUAL(gatherer2->mLastUsername, String("ufrag2:remote2"))
+  TESTING_CHECK(remoteIP1 == gatherer1->mLastFromIP)
+  TESTING_CHECK(remoteIP2 == gatherer2->mLastFromIP)
+
+  // media only follows a route once the owning gatherer installs it
+  sendMedia(remote1);
+  TESTING_SLEEP(500)
+  TESTING_CHECK(0 == gatherer1->mMediaPackets)
+  TESTING_CHECK(0 == gatherer2->mMediaPackets)
+
+  mux->learnRoute(socket1, remoteIP1, gatherer1);
+  mux->learnRoute(socket1, remoteIP2, gatherer2);
+
+  sendMedia(remote1);
+  sendMedia(remote2);
+  sendMedia(remote2);
+  TESTING_CHECK(gatherer1->waitFor(1, 1))
+  TESTING_CHECK(gatherer2->waitFor(1, 2))
+  TESTING_SLEEP(500)
+  TESTING_CHECK(1 == gatherer1->mMediaPackets)
+  TESTING_CHECK(2 == gatherer2->mMediaPackets)
+  TESTING_CHECK(remoteIP1 == gatherer1->mLastFromIP)
+  TESTING_CHECK(remoteIP2 == gatherer2->mLastFromIP)
+
+  mux->unregisterGatherer(gatherer1->getID(), "ufrag1");
+  mux->unregisterGatherer(gatherer2->getID(), "ufrag2");
+  mux->unbind(gatherer1->getID(), socket1);
+  mux->unbind(gatherer2->getID(), socket2);
+
+  remote1->close();
+  remote2->close();
+
+  TESTING_SLEEP(1000)
+
+  TESTING_UNINSTALL_LOGGER();
+}
+
+void doTestICEGathererUDPSendBatch()
+{
+  if (!ORTC_TEST_DO_ICE_GATHERER_UDP_SEND_BATCH_TEST) return;
+
+  typedef ortc::internal::ICEGatherer::UDPSendBatch UDPSendBatch;
+  typedef zsLib::Socket Socket;
+  typedef zsLib::IPAddress IPAddress;
+
+  TESTING_INSTALL_LOGGER();
+
+  const size_t totalPackets = 8;
+
+  auto receiver = Socket::createUDP(Socket::Create::IPv4);
+  auto sender = Socket::createUDP(Socket::Create::IPv4);
+  receiver->bind(IPAddress("127.0.0.1"));
+  sender->bind(IPAddress("127.0.0.1"));
+  receiver->setBlocking(false);
+  sender->setBlocking(false);
+
+  IPAddress receiverIP = receiver->getLocalAddress();
+  IPAddress senderIP = sender->getLocalAddress();
+
+  // what a send burst accumulates before it is flushed
+  UDPSendBatch batch(totalPackets, 1500, false);
+  for (size_t index = 0; index < totalPackets; ++index) {
+    zsLib::BYTE packet[1200] {};
+    packet[0] = static_cast<zsLib::BYTE>(index);
+    TESTING_CHECK(batch.queue(receiverIP, packet, sizeof(packet)))
+  }
+  TESTING_CHECK(batch.isFull())
+
+  auto sent = batch.flush(*sender, senderIP);
+  TESTING_CHECK(totalPackets == sent)
+  TESTING_CHECK(batch.isEmpty())
+  TESTING_CHECK(totalPackets == batch.mTotalSent)
+  TESTING_CHECK(0 == batch.mTotalDropped)
+
+  TESTING_STDOUT() << "UDP SEND BATCH: " << batch.mTotalSent << " datagrams in " << batch.mTotalSystemCalls << " system call(s)\n";
+
+#ifdef HAVE_SENDMMSG
+  TESTING_CHECK(batch.mTotalSystemCalls < batch.mTotalSent)
+#endif //HAVE_SENDMMSG
+
+  // every datagram arrives intact and in order
+  TESTING_SLEEP(100)
+  for (size_t index = 0; index < totalPackets; ++index) {
+    zsLib::BYTE buffer[1500] {};
+    IPAddress fromIP;
+    bool wouldBlock = false;
+    auto read = receiver->receiveFrom(fromIP, buffer, sizeof(buffer), &wouldBlock);
+    TESTING_CHECK(1200 == read)
+    TESTING_CHECK(static_cast<zsLib::BYTE>(index) == buffer[0])
+    TESTING_CHECK(senderIP == fromIP)
+  }
+
+  receiver->close();
+  sender->close();
+
+  TESTING_UNINSTALL_LOGGER();
+}
+
+void doTestICEGathererWarmPool()
+{
+  if (!ORTC_TEST_DO_ICE_GATHERER_WARM_POOL_TEST) return;
+
+  typedef ortc::internal::ICEGathererWarmPool UseWarmPool;
+  typedef zsLib::Socket Socket;
+  typedef zsLib::IPAddress IPAddress;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+  UseSettings::setBool(ORTC_SETTING_GATHERER_WARM_POOL, true);
+
+  const size_t socketsPerInterface = UseSettings::getUInt(ORTC_SETTING_GATHERER_WARM_POOL_SOCKETS_PER_INTERFACE);
+  TESTING_CHECK(socketsPerInterface > 0)
+
+  {
+    auto pool = UseWarmPool::singleton();
+    TESTING_CHECK(pool)
+
+    IPAddress hostIP("127.0.0.1");
+
+    // the first ask for an interface only registers it; the pool binds in the background
+    {
+      IPAddress bindIP(hostIP);
+      UseWarmPool::ReflexiveMappingMap mappings;
+      auto socket = pool->takeUDPSocket(bindIP, mappings);
+      if (socket) socket->close();
+    }
+
+    TESTING_SLEEP(500)
+    TESTING_CHECK(socketsPerInterface == pool->getTotalPooled(hostIP))
+
+    // hands out a socket that is already bound
+    IPAddress boundIP(hostIP);
+    UseWarmPool::ReflexiveMappingMap mappings;
+    auto socket = pool->takeUDPSocket(boundIP, mappings);
+    TESTING_CHECK(socket)
+    if (!socket) {
+      UseSettings::setBool(ORTC_SETTING_GATHERER_WARM_POOL, false);
+      TESTING_UNINSTALL_LOGGER();
+      return;
+    }
+
+    TESTING_CHECK(0 != boundIP.getPort())
+    TESTING_CHECK(boundIP == socket->getLocalAddress())
+    TESTING_CHECK(0 == mappings.size())
+
+    // refills behind the taker
+    TESTING_SLEEP(500)
+    TESTING_CHECK(socketsPerInterface == pool->getTotalPooled(hostIP))
+
+    {
+      auto client = Socket::createUDP(Socket::Create::IPv4);
+      client->bind(IPAddress("127.0.0.1"));
+      client->setBlocking(false);
+
+      zsLib::BYTE packet[100] {};
+
+      // datagrams that arrive while the socket changes hands...
+      for (size_t index = 0; index < 5; ++index) {
+        client->sendTo(boundIP, packet, sizeof(packet));
+      }
+      TESTING_SLEEP(100)
+
+      // ...are drained once it is back in the pool (a socket with fresh
+      // mappings displaces a plain pooled one)
+      UseWarmPool::ReflexiveMappingMap returnMappings;
+      returnMappings["stun:stun.example.com"] = IPAddress("192.0.2.1:40000");
+      TESTING_CHECK(pool->returnUDPSocket(hostIP, boundIP, socket, returnMappings))
+      TESTING_CHECK(socketsPerInterface == pool->getTotalPooled(hostIP))
+
+      TESTING_SLEEP(500)
+      {
+        zsLib::BYTE buffer[1500] {};
+        IPAddress fromIP;
+        bool wouldBlock = false;
+        socket->receiveFrom(fromIP, buffer, sizeof(buffer), &wouldBlock);
+        TESTING_CHECK(wouldBlock)
+      }
+
+      // ...as is anything that arrives while it sits in the pool
+      for (size_t index = 0; index < 5; ++index) {
+        client->sendTo(boundIP, packet, sizeof(packet));
+      }
+      TESTING_SLEEP(500)
+      {
+        zsLib::BYTE buffer[1500] {};
+        IPAddress fromIP;
+        bool wouldBlock = false;
+        socket->receiveFrom(fromIP, buffer, sizeof(buffer), &wouldBlock);
+        TESTING_CHECK(wouldBlock)
+      }
+
+      client->close();
+    }
+
+    // the socket carrying mappings is preferred and its mappings come with it
+    {
+      IPAddress bindIP(hostIP);
+      UseWarmPool::ReflexiveMappingMap takenMappings;
+      auto taken = pool->takeUDPSocket(bindIP, takenMappings);
+      TESTING_CHECK(taken == socket)
+      TESTING_CHECK(bindIP == boundIP)
+      TESTING_CHECK(1 == takenMappings.size())
+      if (taken) taken->close();
+    }
+  }
+
+  UseSettings::setBool(ORTC_SETTING_GATHERER_WARM_POOL, false);
+
+  TESTING_UNINSTALL_LOGGER();
+}
@@ -36,10 +36,15 @@
 #include <ortc/IICETransport.h>
 #include <ortc/ISettings.h>
 
+#include <ortc/internal/ortc_ICETransport.h>
+#include <ortc/internal/ortc_TimerWheel.h>
+
 #include <ortc/services/IHelper.h>
 
 #include <zsLib/XML.h>
 
+#include <set>
+
 #include "config.h"
 #include "testing.h"
 
@@ -55,6 +60,9 @@ using namespace zsLib::XML;
 
 ZS_DECLARE_TYPEDEF_PTR(ortc::ISettings, UseSettings)
 ZS_DECLARE_TYPEDEF_PTR(ortc::services::IHelper, UseServicesHelper)
+ZS_DECLARE_TYPEDEF_PTR(ortc::internal::ICETransport, UseICETransport)
+ZS_DECLARE_TYPEDEF_PTR(ortc::internal::TimerWheel, UseTimerWheel)
+ZS_DECLARE_TYPEDEF_PTR(ortc::internal::ICECheckPacer, UseICECheckPacer)
 
 namespace ortc
 {
@@ -445,6 +453,14 @@ namespace ortc
         //-----------------------------------------------------------------------
         Expectations getExpectations() const {return mExpectations;}
 
+        //-----------------------------------------------------------------------
+        IICETypes::Roles role()
+        {
+          AutoRecursiveLock lock(*this);
+          TESTING_CHECK(mTransport)
+          return mTransport->role();
+        }
+
         //-----------------------------------------------------------------------
         void setRemote(ICEGathererTesterPtr remoteGathererTester)
         {
@@ -632,6 +648,178 @@ namespace ortc
 ZS_DECLARE_USING_PTR(ortc::test::transport, ICEGathererTester)
 ZS_DECLARE_USING_PTR(ortc::test::transport, ICETransportTester)
 
+namespace ortc
+{
+  namespace test
+  {
+    namespace transport
+    {
+      ZS_DECLARE_CLASS_PTR(TimerWheelTester)
+      ZS_DECLARE_CLASS_PTR(ICECheckPacerTester)
+
+      //-----------------------------------------------------------------------
+      static void reportTimerWheel(
+                                   const char *name,
+                                   const UseTimerWheel::Stats &before
+                                   )
+      {
+        UseTimerWheel::Stats after = UseTimerWheel::singleton()->getStats();
+
+        TESTING_STDOUT() << "TIMER WHEEL:  " << name << "\n";
+        TESTING_STDOUT() << "TIMER WHEEL:    timers armed " << (after.mTotalArmed - before.mTotalArmed) << ", fired " << (after.mTotalFired - before.mTotalFired) << ", cancelled " << (after.mTotalCancelled - before.mTotalCancelled) << ", peak active " << after.mPeakActiveTimers << "\n";
+        TESTING_STDOUT() << "TIMER WHEEL:    one system timer per timer: " << (after.mTotalArmed - before.mTotalArmed) << " system timers, " << (after.mTotalFired - before.mTotalFired) << " wake ups\n";
+        TESTING_STDOUT() << "TIMER WHEEL:    shared timer wheel:         " << (after.mTotalSystemTimers - before.mTotalSystemTimers) << " system timers, " << (after.mTotalWakeUps - before.mTotalWakeUps) << " wake ups, " << (after.mTotalCallbacks - before.mTotalCallbacks) << " callbacks\n";
+      }
+
+      //-----------------------------------------------------------------------
+      class TimerWheelTester : public SharedRecursiveLock,
+                               public zsLib::MessageQueueAssociator,
+                               public ortc::internal::ITimerWheelDelegate
+      {
+      public:
+        typedef ortc::internal::ITimerWheelDelegate::TimerID TimerID;
+        typedef std::set<TimerID> TimerIDSet;
+
+        TimerWheelTester(IMessageQueuePtr queue) :
+          SharedRecursiveLock(SharedRecursiveLock::create()),
+          MessageQueueAssociator(queue)
+        {
+        }
+
+        static TimerWheelTesterPtr create(IMessageQueuePtr queue)
+        {
+          TimerWheelTesterPtr pThis(std::make_shared<TimerWheelTester>(queue));
+          pThis->mThisWeak = pThis;
+          return pThis;
+        }
+
+        void arm(
+                 UseTimerWheelPtr wheel,
+                 zsLib::Milliseconds fireIn
+                 )
+        {
+          AutoRecursiveLock lock(*this);
+          mArmed.insert(wheel->arm(ortc::internal::ITimerWheelDelegateProxy::createWeak(mThisWeak.lock()), fireIn));
+        }
+
+        void cancel(UseTimerWheelPtr wheel)
+        {
+          AutoRecursiveLock lock(*this);
+          if (mArmed.size() < 1) return;
+          auto timerID = *(mArmed.begin());
+          wheel->cancel(timerID);
+          mArmed.erase(mArmed.begin());
+        }
+
+        virtual void onTimerWheelFired(TimerIDListPtr timers) override
+        {
+          AutoRecursiveLock lock(*this);
+          ++mCallbacks;
+          for (auto iter = timers->begin(); iter != timers->end(); ++iter) {
+            auto found = mArmed.find(*iter);
+            if (found == mArmed.end()) {
+              ++mUnexpected;
+              continue;
+            }
+            mArmed.erase(found);
+            ++mFired;
+          }
+        }
+
+        size_t fired() const {AutoRecursiveLock lock(*this); return mFired;}
+        size_t callbacks() const {AutoRecursiveLock lock(*this); return mCallbacks;}
+        size_t unexpected() const {AutoRecursiveLock lock(*this); return mUnexpected;}
+        size_t pending() const {AutoRecursiveLock lock(*this); return mArmed.size();}
+
+      protected:
+        TimerWheelTesterWeakPtr mThisWeak;
+
+        TimerIDSet mArmed;
+        size_t mFired {};
+        size_t mCallbacks {};
+        size_t mUnexpected {};
+      };
+
+      //-----------------------------------------------------------------------
+      // stands in for one ICE transport asking the global pacer for check slots
+      class ICECheckPacerTester : public SharedRecursiveLock,
+                                  public zsLib::MessageQueueAssociator,
+                                  public ortc::internal::IICECheckPacerDelegate
+      {
+      public:
+        typedef ortc::internal::IICECheckPacerDelegate::RequestID RequestID;
+        typedef std::set<RequestID> RequestIDSet;
+
+        ICECheckPacerTester(IMessageQueuePtr queue) :
+          SharedRecursiveLock(SharedRecursiveLock::create()),
+          MessageQueueAssociator(queue)
+        {
+        }
+
+        static ICECheckPacerTesterPtr create(IMessageQueuePtr queue)
+        {
+          ICECheckPacerTesterPtr pThis(std::make_shared<ICECheckPacerTester>(queue));
+          pThis->mThisWeak = pThis;
+          return pThis;
+        }
+
+        void request(
+                     UseICECheckPacerPtr pacer,
+                     size_t total
+                     )
+        {
+          AutoRecursiveLock lock(*this);
+          auto delegate = ortc::internal::IICECheckPacerDelegateProxy::createWeak(mThisWeak.lock());
+          for (size_t index = 0; index < total; ++index) {
+            mPending.insert(pacer->request(mID, delegate));
+          }
+        }
+
+        // what a transport does with its outstanding requests on teardown
+        size_t cancelAll(UseICECheckPacerPtr pacer)
+        {
+          AutoRecursiveLock lock(*this);
+          size_t total = mPending.size();
+          for (auto iter = mPending.begin(); iter != mPending.end(); ++iter) {
+            pacer->cancel(*iter);
+          }
+          mPending.clear();
+          return total;
+        }
+
+        virtual void onICECheckPacerGranted(RequestIDListPtr requests) override
+        {
+          AutoRecursiveLock lock(*this);
+          for (auto iter = requests->begin(); iter != requests->end(); ++iter) {
+            auto found = mPending.find(*iter);
+            if (found == mPending.end()) {
+              ++mUnexpected;
+              continue;
+            }
+            mPending.erase(found);
+            ++mGranted;
+          }
+        }
+
+        size_t granted() const {AutoRecursiveLock lock(*this); return mGranted;}
+        size_t unexpected() const {AutoRecursiveLock lock(*this); return mUnexpected;}
+        size_t pending() const {AutoRecursiveLock lock(*this); return mPending.size();}
+
+      protected:
+        AutoPUID mID;
+        ICECheckPacerTesterWeakPtr mThisWeak;
+
+        RequestIDSet mPending;
+        size_t mGranted {};
+        size_t mUnexpected {};
+      };
+    }
+  }
+}
+
+ZS_DECLARE_USING_PTR(ortc::test::transport, TimerWheelTester)
+ZS_DECLARE_USING_PTR(ortc::test::transport, ICECheckPacerTester)
+
 
 void doTestICETransport()
 {
@@ -647,6 +835,8 @@ void doTestICETransport()
 
   size_t totalHostIPs = UseSettings::getUInt("tester/total-host-ips");
 
+  UseTimerWheel::Stats timerWheelBefore = UseTimerWheel::singleton()->getStats();
+
   ICEGathererTesterPtr testGathererObject1;
   ICETransportTesterPtr testTransportObject1;
 
@@ -736,6 +926,23 @@ void doTestICETransport()
             testTransportObject2 = ICETransportTester::create(thread, testGathererObject2);
           }
 
+          testTransportObject1->setRemote(testGathererObject2);
+          testTransportObject2->setRemote(testGathererObject1);
+          break;
+        }
+        case 1: {
+          // a full agent (1) against an ice lite agent (2)
+          testGathererObject1 = ICEGathererTester::create(thread);
+          testTransportObject1 = ICETransportTester::create(thread, testGathererObject1);
+
+          {
+            ortc::IICEGatherer::Options options;
+            options.mICELite = true;
+
+            testGathererObject2 = ICEGathererTester::create(thread, options);
+            testTransportObject2 = ICETransportTester::create(thread, testGathererObject2);
+          }
+
           testTransportObject1->setRemote(testGathererObject2);
           testTransportObject2->setRemote(testGathererObject1);
           break;
@@ -833,11 +1040,25 @@ void doTestICETransport()
             break;
           }
           case 1: {
-            if (7 == totalWait) {
-              if (testGathererObject1) testGathererObject1->close();
-              if (testGathererObject2) testGathererObject2->close();
+            if (5 == totalWait) {
+              ortc::IICETransportTypes::Options options1;
+              ortc::IICETransportTypes::Options options2;
+
+              // both ask for the wrong role; the full agent must end up controlling
+              options1.mRole = ortc::IICETypes::Role_Controlled;
+              options2.mRole = ortc::IICETypes::Role_Controlling;
+
+              testTransportObject1->start(options1);
+              testTransportObject2->start(options2);
+            }
+            if (30 == totalWait) {
+              TESTING_CHECK(ortc::IICETypes::Role_Controlling == testTransportObject1->role())
+              TESTING_CHECK(ortc::IICETypes::Role_Controlled == testTransportObject2->role())
+
               if (testTransportObject1) testTransportObject1->close();
               if (testTransportObject2) testTransportObject2->close();
+              if (testGathererObject1) testGathererObject1->close();
+              if (testGathererObject2) testGathererObject2->close();
             }
 
             break;
@@ -910,6 +1131,8 @@ void doTestICETransport()
   TESTING_STDOUT() << "WAITING:      All ICE transports have finished. Waiting for 'bogus' events to process (10 second wait).\n";
   TESTING_SLEEP(10000)
 
+  ortc::test::transport::reportTimerWheel("ICE TRANSPORT", timerWheelBefore);
+
   // wait for shutdown
   {
     IMessageQueue::size_type count = 0;
@@ -927,3 +1150,358 @@ void doTestICETransport()
   zsLib::proxyDump();
   TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
 }
+
+namespace ortc
+{
+  namespace test
+  {
+    namespace transport
+    {
+      //-----------------------------------------------------------------------
+      static void sampleRoundTrip(
+                                  UseICETransport::RoutePtr route,
+                                  zsLib::Milliseconds roundTrip
+                                  )
+      {
+        route->mSmoothedRoundTrip = zsLib::toMicroseconds(roundTrip);
+        ++(route->mRoundTripSamples);
+      }
+
+      //-----------------------------------------------------------------------
+      static void sortRoutes(
+                             UseICETransport::RoundTripRouteMap &outRoutes,
+                             UseICETransport::RoutePtr route1,
+                             UseICETransport::RoutePtr route2
+                             )
+      {
+        outRoutes.clear();
+        outRoutes.insert(UseICETransport::RoundTripRouteMap::value_type(route1->getEffectiveRoundTrip(), route1));
+        outRoutes.insert(UseICETransport::RoundTripRouteMap::value_type(route2->getEffectiveRoundTrip(), route2));
+      }
+    }
+  }
+}
+
+void doTestICETransportRenomination()
+{
+  if (!ORTC_TEST_DO_ICE_TRANSPORT_RENOMINATION_TEST) return;
+
+  using ortc::test::transport::sampleRoundTrip;
+  using ortc::test::transport::sortRoutes;
+
+  typedef UseICETransport::Route Route;
+  typedef UseICETransport::RoutePtr RoutePtr;
+  typedef UseICETransport::RoundTripRouteMap RoundTripRouteMap;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+
+  auto tracker = std::make_shared<UseICETransport::RouteStateTracker>(0);
+
+  UseICETransport::Renomination renomination(0);
+  renomination.mWarmCandidatePairs = 1;
+  renomination.mImprovementPercentage = 25;
+  renomination.mConsecutiveSamples = 3;
+  renomination.mHoldDown = zsLib::Seconds(10);
+
+  // two succeeded candidate pairs with different round trip times
+  RoutePtr first = std::make_shared<Route>(tracker);
+  RoutePtr second = std::make_shared<Route>(tracker);
+  first->state(Route::State_Succeeded);
+  second->state(Route::State_Succeeded);
+
+  RoutePtr active = first;
+  RoundTripRouteMap routes;
+  const char *reason = NULL;
+  auto now = zsLib::now();
+
+  sampleRoundTrip(first, zsLib::Milliseconds(100));
+
+  // hysteresis: 10% faster is inside the 25% margin so no switch happens
+  for (int loop = 0; loop < 5; ++loop) {
+    sampleRoundTrip(second, zsLib::Milliseconds(90));
+    sortRoutes(routes, first, second);
+    TESTING_CHECK(!renomination.pick(routes, active, now, reason))
+  }
+  TESTING_CHECK(0 == second->mConsecutiveBetterSamples)
+
+  // re-evaluating without a new measurement does not count as a sample
+  sampleRoundTrip(second, zsLib::Milliseconds(50));
+  sortRoutes(routes, first, second);
+  TESTING_CHECK(!renomination.pick(routes, active, now, reason))
+  TESTING_CHECK(!renomination.pick(routes, active, now, reason))
+  TESTING_CHECK(1 == second->mConsecutiveBetterSamples)
+
+  renomination.updateWarmRoutes(routes);
+  TESTING_CHECK(renomination.isWarmRoute(second))
+  TESTING_CHECK(!renomination.isWarmRoute(first))
+
+  // switch once the faster route wins enough samples in a row
+  sampleRoundTrip(second, zsLib::Milliseconds(50));
+  sortRoutes(routes, first, second);
+  TESTING_CHECK(!renomination.pick(routes, active, now, reason))
+
+  sampleRoundTrip(second, zsLib::Milliseconds(50));
+  sortRoutes(routes, first, second);
+  auto picked = renomination.pick(routes, active, now, reason);
+  TESTING_CHECK(second == picked)
+  TESTING_CHECK(NULL != reason)
+  TESTING_CHECK(now == renomination.mLastRenomination)
+
+  active = second;
+
+  // hold-down: the old route becomes much faster but the switch waits
+  for (int loop = 0; loop < 3; ++loop) {
+    sampleRoundTrip(first, zsLib::Milliseconds(20));
+    sortRoutes(routes, first, second);
+    TESTING_CHECK(!renomination.pick(routes, active, now + zsLib::Seconds(1), reason))
+  }
+  TESTING_CHECK(3 == first->mConsecutiveBetterSamples)
+
+  picked = renomination.pick(routes, active, now + zsLib::Seconds(11), reason);
+  TESTING_CHECK(first == picked)
+
+  // a silenced active route no longer holds off the normal (failover) pick
+  renomination.mActivityWindow = zsLib::Seconds(2);
+  active = first;
+  first->mLastReceivedResponse = now;
+  TESTING_CHECK(renomination.isActiveRouteLive(first->mLastReceivedResponse, now + zsLib::Seconds(1)))
+  TESTING_CHECK(!renomination.isActiveRouteLive(first->mLastReceivedResponse, now + zsLib::Seconds(3)))
+  TESTING_CHECK(!renomination.isActiveRouteLive(zsLib::Time(), now))
+
+  TESTING_UNINSTALL_LOGGER();
+}
+
+void doTestTimerWheel()
+{
+  if (!ORTC_TEST_DO_TIMER_WHEEL_TEST) return;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+
+  zsLib::MessageQueueThreadPtr thread(zsLib::MessageQueueThread::createBasic());
+
+  const size_t totalPerTester = 500;
+  const size_t totalCancelled = 50;
+
+  {
+    auto wheel = UseTimerWheel::singleton();
+    TESTING_CHECK(wheel)
+
+    // let any earlier test's timers drain so the wheel starts idle
+    TESTING_SLEEP(2000)
+
+    UseTimerWheel::Stats before = wheel->getStats();
+    TESTING_CHECK(0 == before.mActiveTimers)
+
+    TimerWheelTesterPtr tester1 = TimerWheelTester::create(thread);
+    TimerWheelTesterPtr tester2 = TimerWheelTester::create(thread);
+
+    // spread the timers over one second like a burst of keep-warm checks
+    for (size_t index = 0; index < totalPerTester; ++index) {
+      tester1->arm(wheel, zsLib::Milliseconds(500 + (index % 1000)));
+      tester2->arm(wheel, zsLib::Milliseconds(500 + ((index * 7) % 1000)));
+    }
+    for (size_t index = 0; index < totalCancelled; ++index) {
+      tester1->cancel(wheel);
+    }
+
+    TESTING_SLEEP(3000)
+
+    TESTING_CHECK(totalPerTester - totalCancelled == tester1->fired())
+    TESTING_CHECK(totalPerTester == tester2->fired())
+    TESTING_CHECK(0 == tester1->pending())
+    TESTING_CHECK(0 == tester2->pending())
+    TESTING_CHECK(0 == tester1->unexpected())
+    TESTING_CHECK(0 == tester2->unexpected())
+
+    UseTimerWheel::Stats after = wheel->getStats();
+
+    // all the timers were driven by one system timer; expiries sharing a
+    // tick were coalesced into fewer wake ups and callbacks
+    TESTING_CHECK(0 == after.mActiveTimers)
+    TESTING_CHECK(1 == after.mTotalSystemTimers - before.mTotalSystemTimers)
+    TESTING_CHECK((totalPerTester * 2) == after.mTotalArmed - before.mTotalArmed)
+    TESTING_CHECK(totalCancelled == after.mTotalCancelled - before.mTotalCancelled)
+    TESTING_CHECK((totalPerTester * 2) - totalCancelled == after.mTotalFired - before.mTotalFired)
+    TESTING_CHECK(after.mTotalWakeUps - before.mTotalWakeUps < after.mTotalFired - before.mTotalFired)
+    TESTING_CHECK(tester1->callbacks() + tester2->callbacks() == after.mTotalCallbacks - before.mTotalCallbacks)
+    TESTING_CHECK(after.mPeakActiveTimers >= totalPerTester * 2)
+
+    ortc::test::transport::reportTimerWheel("KEEP WARM BURST", before);
+  }
+
+  // wait for shutdown
+  {
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+
+    thread->waitForShutdown();
+  }
+  TESTING_UNINSTALL_LOGGER();
+}
+
+void doTestICECheckPacer()
+{
+  if (!ORTC_TEST_DO_ICE_CHECK_PACER_TEST) return;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+
+  // keep warm checks every ~0.5 seconds so an unpaced keep warm is obvious
+  UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_KEEP_WARM_TIME_BASE_IN_MILLISECONDS, 500);
+  UseSettings::setUInt(ORTC_SETTING_ICE_TRANSPORT_KEEP_WARM_TIME_RANDOMIZED_ADD_TIME_IN_MILLISECONDS, 100);
+
+  zsLib::MessageQueueThreadPtr thread(zsLib::MessageQueueThread::createBasic());
+
+  const size_t checksPerSecond = UseSettings::getUInt(ORTC_SETTING_ICE_CHECK_PACER_CHECKS_PER_SECOND);
+  const size_t burst = UseSettings::getUInt(ORTC_SETTING_ICE_CHECK_PACER_BURST);
+
+  {
+    auto pacer = UseICECheckPacer::singleton();
+    TESTING_CHECK(pacer)
+
+    // let the bucket fill back up to its burst
+    TESTING_SLEEP(500)
+
+    // pacing rate: one transport with far more checks than a second allows
+    {
+      ICECheckPacerTesterPtr tester = ICECheckPacerTester::create(thread);
+
+      tester->request(pacer, checksPerSecond * 2);
+      TESTING_SLEEP(1000)
+
+      size_t granted = tester->granted();
+      TESTING_STDOUT() << "CHECK PACER:  " << granted << " checks granted in one second (rate " << checksPerSecond << "/s, burst " << burst << ")\n";
+
+      TESTING_CHECK(granted >= burst + (checksPerSecond * 7 / 10))
+      TESTING_CHECK(granted <= burst + (checksPerSecond * 13 / 10))
+      TESTING_CHECK(tester->pending() > 0)
+
+      // cancel on teardown: nothing more is granted and the pacer forgets the owner
+      auto metricsBefore = pacer->getMetrics();
+      size_t cancelled = tester->cancelAll(pacer);
+      auto metricsAfter = pacer->getMetrics();
+
+      TESTING_CHECK(cancelled > 0)
+      TESTING_CHECK(cancelled == metricsAfter->mTotalCancelled - metricsBefore->mTotalCancelled)
+      TESTING_CHECK(0 == metricsAfter->mOwners)
+      TESTING_CHECK(0 == metricsAfter->mQueueDepth[UseICECheckPacer::Priority_High])
+      TESTING_CHECK(0 == metricsAfter->mQueueDepth[UseICECheckPacer::Priority_Normal])
+
+      granted = tester->granted();
+      TESTING_SLEEP(500)
+      TESTING_CHECK(granted == tester->granted())
+      TESTING_CHECK(0 == tester->unexpected())
+    }
+
+    // fairness: a transport arriving behind a large backlog is served
+    // round-robin rather than after the backlog drains
+    {
+      ICECheckPacerTesterPtr busy = ICECheckPacerTester::create(thread);
+      ICECheckPacerTesterPtr quiet = ICECheckPacerTester::create(thread);
+
+      const size_t totalQuiet = 20;
+
+      busy->request(pacer, checksPerSecond * 2);
+      quiet->request(pacer, totalQuiet);
+
+      for (size_t wait = 0; (wait < 300) && (quiet->pending() > 0); ++wait) {
+        TESTING_SLEEP(10)
+      }
+
+      size_t busyGranted = busy->granted();
+      TESTING_STDOUT() << "CHECK PACER:  quiet transport finished " << quiet->granted() << " checks while busy transport got " << busyGranted << "\n";
+
+      TESTING_CHECK(totalQuiet == quiet->granted())
+      TESTING_CHECK(busyGranted <= totalQuiet + burst + 4)
+      TESTING_CHECK(busy->pending() > 0)
+
+      busy->cancelAll(pacer);
+      TESTING_CHECK(0 == pacer->getMetrics()->mOwners)
+      TESTING_CHECK(0 == busy->unexpected())
+      TESTING_CHECK(0 == quiet->unexpected())
+    }
+
+    // keep warm exemption: once connected, the succeeded route's keep warm
+    // checks go out without asking the pacer for a slot
+    {
+      ICEGathererTesterPtr gatherer1 = ICEGathererTester::create(thread);
+      ICEGathererTesterPtr gatherer2 = ICEGathererTester::create(thread);
+      ICETransportTesterPtr transport1 = ICETransportTester::create(thread, gatherer1);
+      ICETransportTesterPtr transport2 = ICETransportTester::create(thread, gatherer2);
+
+      transport1->setRemote(gatherer2);
+      transport2->setRemote(gatherer1);
+
+      TESTING_SLEEP(5000)
+
+      {
+        ortc::IICETransportTypes::Options options1;
+        ortc::IICETransportTypes::Options options2;
+
+        options1.mRole = ortc::IICETypes::Role_Controlling;
+        options2.mRole = ortc::IICETypes::Role_Controlled;
+
+        transport1->start(options1);
+        transport2->start(options2);
+      }
+
+      for (size_t wait = 0; wait < 30; ++wait) {
+        if ((transport1->getExpectations().mStateCompleted > 0) &&
+            (transport2->getExpectations().mStateCompleted > 0)) break;
+        TESTING_SLEEP(1000)
+      }
+      TESTING_CHECK(transport1->getExpectations().mStateCompleted > 0)
+      TESTING_CHECK(transport2->getExpectations().mStateCompleted > 0)
+
+      // let the remaining checks finish before measuring
+      TESTING_SLEEP(5000)
+
+      auto metricsBefore = pacer->getMetrics();
+      TESTING_SLEEP(10000)
+      auto metricsAfter = pacer->getMetrics();
+
+      // two transports keeping one route warm every ~0.55 seconds for ten
+      // seconds would have requested ~36 slots if keep warm were paced
+      size_t requested = metricsAfter->mTotalRequested - metricsBefore->mTotalRequested;
+      TESTING_STDOUT() << "CHECK PACER:  " << requested << " slots requested while connected routes were kept warm\n";
+      TESTING_CHECK(requested < 16)
+
+      // cancel on teardown: closing the transports leaves nothing queued
+      transport1->close();
+      transport2->close();
+      gatherer1->close();
+      gatherer2->close();
+
+      TESTING_SLEEP(2000)
+
+      auto metricsClosed = pacer->getMetrics();
+      TESTING_CHECK(0 == metricsClosed->mOwners)
+      TESTING_CHECK(0 == metricsClosed->mQueueDepth[UseICECheckPacer::Priority_High])
+      TESTING_CHECK(0 == metricsClosed->mQueueDepth[UseICECheckPacer::Priority_Normal])
+    }
+  }
+
+  // wait for shutdown
+  {
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+
+    thread->waitForShutdown();
+  }
+  TESTING_UNINSTALL_LOGGER();
+}
@@ -35,6 +35,8 @@
 #include "TestSCTP.h"
 #include <ortc/ISCTPTransport.h>
 #include <ortc/ISettings.h>
+#include <ortc/internal/ortc_SCTPTransport.h>
+#include <ortc/internal/ortc_SCTPTransportListener.h>
 
 #include <zsLib/XML.h>
 
@@ -42,6 +44,9 @@
 #include "testing.h"
 #include <zsLib/date.h>
 
+#include <algorithm>
+#include <functional>
+
 namespace ortc { namespace test { ZS_DECLARE_SUBSYSTEM(ortc_test) } }
 
 using zsLib::String;
@@ -917,6 +922,7 @@ namespace ortc
 
                (mReceivedBinary == op2.mReceivedBinary) &&
                (mReceivedText == op2.mReceivedText) &&
+               (mReceivedPartial == op2.mReceivedPartial) &&
 
                (mError == op2.mError) &&
 
@@ -1118,6 +1124,38 @@ namespace ortc
         channel->send(*buffer);
       }
 
+      //-----------------------------------------------------------------------
+      void SCTPTester::sendDataAdopted(
+                                       const char *channelID,
+                                       SecureByteBlockPtr buffer
+                                       )
+      {
+        {
+          auto remote = mConnectedTester.lock();
+          TESTING_CHECK((bool)remote)
+
+          // the channel takes ownership of the sent buffer so expect a copy
+          AutoRecursiveLock lock(*remote);
+          remote->expectData(channelID, make_shared<SecureByteBlock>(buffer->BytePtr(), buffer->SizeInBytes()));
+        }
+
+        IDataChannelPtr channel;
+
+        {
+          AutoRecursiveLock lock(*this);
+          TESTING_CHECK((bool)mSCTP)
+
+          auto found = mDataChannels.find(String(channelID));
+          TESTING_CHECK(found != mDataChannels.end())
+
+          channel = (*found).second;
+
+          TESTING_CHECK((bool)channel)
+        }
+
+        channel->send(buffer);
+      }
+
       //-----------------------------------------------------------------------
       void SCTPTester::sendData(
                                 const char *channelID,
@@ -1149,6 +1187,107 @@ namespace ortc
         channel->send(message);
       }
 
+      //-----------------------------------------------------------------------
+      zsLib::Microseconds SCTPTester::maxTextLatency() const
+      {
+        AutoRecursiveLock lock(*this);
+        return mMaxTextLatency;
+      }
+
+      //-----------------------------------------------------------------------
+      zsLib::Microseconds SCTPTester::averageTextLatency() const
+      {
+        AutoRecursiveLock lock(*this);
+        if (0 == mTotalTextLatencySamples) return zsLib::Microseconds();
+        return zsLib::Microseconds(mTotalTextLatency.count() / mTotalTextLatencySamples);
+      }
+
+      //-----------------------------------------------------------------------
+      size_t SCTPTester::maxBufferedAmount() const
+      {
+        AutoRecursiveLock lock(*this);
+        return mMaxBufferedAmount;
+      }
+
+      //-----------------------------------------------------------------------
+      ULONG SCTPTester::rejectedDuringStream() const
+      {
+        AutoRecursiveLock lock(*this);
+        return mRejectedDuringStream;
+      }
+
+      //-----------------------------------------------------------------------
+      void SCTPTester::sendStream(
+                                  const char *channelID,
+                                  size_t totalSize,
+                                  size_t chunkSize,
+                                  size_t window
+                                  )
+      {
+        AutoRecursiveLock lock(*this);
+
+        TESTING_CHECK(chunkSize > 0)
+
+        OutgoingStream stream;
+        stream.mRemaining = totalSize;
+        stream.mChunkSize = chunkSize;
+        stream.mWindow = window;
+
+        mOutgoingStreams[String(channelID)] = stream;
+
+        auto found = mDataChannels.find(String(channelID));
+        TESTING_CHECK(found != mDataChannels.end())
+
+        (*found).second->bufferedAmountLowThreshold(window / 2);
+
+        pumpStream(String(channelID));
+      }
+
+      //-----------------------------------------------------------------------
+      void SCTPTester::expectBenchmark(const char *channelID)
+      {
+        AutoRecursiveLock lock(*this);
+        mBenchmarkResults[String(channelID)] = BenchmarkResults();
+      }
+
+      //-----------------------------------------------------------------------
+      void SCTPTester::sendBenchmark(
+                                     const char *channelID,
+                                     size_t messageSize,
+                                     size_t totalMessages,
+                                     size_t window
+                                     )
+      {
+        AutoRecursiveLock lock(*this);
+
+        // every message carries its send time in the first bytes
+        TESTING_CHECK(messageSize >= sizeof(QWORD))
+
+        OutgoingBenchmark benchmark;
+        benchmark.mRemaining = totalMessages;
+        benchmark.mMessageSize = messageSize;
+        benchmark.mWindow = window;
+
+        mOutgoingBenchmarks[String(channelID)] = benchmark;
+
+        auto found = mDataChannels.find(String(channelID));
+        TESTING_CHECK(found != mDataChannels.end())
+
+        (*found).second->bufferedAmountLowThreshold(window / 2);
+
+        pumpBenchmark(String(channelID));
+      }
+
+      //-----------------------------------------------------------------------
+      SCTPTester::BenchmarkResults SCTPTester::benchmarkResults(const char *channelID) const
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto found = mBenchmarkResults.find(String(channelID));
+        if (found == mBenchmarkResults.end()) return BenchmarkResults();
+        return (*found).second;
+      }
+
       //-----------------------------------------------------------------------
       void SCTPTester::closeChannel(const char *channelID)
       {
@@ -1291,6 +1430,14 @@ namespace ortc
         ZS_LOG_BASIC(log("data channel buffer low event") + ZS_PARAM("channel id", channel->getID()))
 #define TODO_TEST_TO_VERIFY_BUFFER_LOW_EVENT 1
 #define TODO_TEST_TO_VERIFY_BUFFER_LOW_EVENT 2
+
+        AutoRecursiveLock lock(*this);
+
+        auto params = channel->parameters();
+        if (!params) return;
+
+        if (mOutgoingStreams.end() != mOutgoingStreams.find(params->mLabel)) pumpStream(params->mLabel);
+        if (mOutgoingBenchmarks.end() != mOutgoingBenchmarks.find(params->mLabel)) pumpBenchmark(params->mLabel);
       }
 
       //-----------------------------------------------------------------------
@@ -1304,8 +1451,32 @@ namespace ortc
 
         auto params = channel->parameters();
 
+        if (data->mPartial) ++mExpectations.mReceivedPartial;
+
+        auto foundBenchmark = mBenchmarkResults.find(params->mLabel);
+        if ((foundBenchmark != mBenchmarkResults.end()) &&
+            (data->mBinary)) {
+          // benchmark payloads are not compared; only timing and volume matter
+          BenchmarkResults &results = (*foundBenchmark).second;
+
+          auto now = zsLib::now();
+          QWORD received = static_cast<QWORD>(zsLib::toMicroseconds(now.time_since_epoch()).count());
+          QWORD sent {};
+          if (data->mBinary->SizeInBytes() >= sizeof(sent)) {
+            memcpy(&sent, data->mBinary->BytePtr(), sizeof(sent));
+            results.mLatencies.push_back(zsLib::Microseconds(received > sent ? received - sent : 0));
+          }
+
+          ++results.mMessages;
+          results.mBytes += data->mBinary->SizeInBytes();
+          results.mLastReceived = now;
+
+          ++mExpectations.mReceivedBinary;
+          return;
+        }
+
         if (data->mBinary) {
-          ZS_LOG_DETAIL(log("data channel binary message") + ZS_PARAM("channel id", channel->getID()) + ZS_PARAM("data", data->mBinary->SizeInBytes()))
+          ZS_LOG_DETAIL(log("data channel binary message") + ZS_PARAM("channel id", channel->getID()) + ZS_PARAM("data", data->mBinary->SizeInBytes()) + ZS_PARAM("partial", data->mPartial))
 
           auto found = mBuffers.find(params->mLabel);
           TESTING_CHECK(found != mBuffers.end())
@@ -1334,6 +1505,17 @@ namespace ortc
           ++mExpectations.mReceivedText;
 
           stringList.pop_front();
+
+          auto foundTime = mStringSentTimes.find(params->mLabel);
+          if ((foundTime != mStringSentTimes.end()) &&
+              ((*foundTime).second.size() > 0)) {
+            auto latency = zsLib::toMicroseconds(zsLib::now() - (*foundTime).second.front());
+            (*foundTime).second.pop_front();
+
+            if (latency > mMaxTextLatency) mMaxTextLatency = latency;
+            mTotalTextLatency += latency;
+            ++mTotalTextLatencySamples;
+          }
         }
       }
 
@@ -1397,6 +1579,8 @@ namespace ortc
 
         ZS_LOG_TRACE(log("expecting buffer") + ZS_PARAM("channel id", channelID) + ZS_PARAM("message", message))
 
+        mStringSentTimes[channelID].push_back(zsLib::now());
+
         auto found = mStrings.find(channelID);
         if (found == mStrings.end()) {
           StringList stringList;
@@ -1410,6 +1594,97 @@ namespace ortc
         stringList.push_back(message);
       }
 
+      //-----------------------------------------------------------------------
+      void SCTPTester::pumpStream(const String &channelID)
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto foundStream = mOutgoingStreams.find(channelID);
+        if (foundStream == mOutgoingStreams.end()) return;
+
+        auto foundChannel = mDataChannels.find(channelID);
+        if (foundChannel == mDataChannels.end()) return;
+
+        OutgoingStream &stream = (*foundStream).second;
+        IDataChannelPtr channel = (*foundChannel).second;
+
+        auto remote = mConnectedTester.lock();
+        TESTING_CHECK((bool)remote)
+
+        // only keep a window's worth of the message in flight at any time
+        while ((stream.mRemaining > 0) &&
+               (channel->bufferedAmount() < stream.mWindow)) {
+          size_t size = (stream.mRemaining < stream.mChunkSize ? stream.mRemaining : stream.mChunkSize);
+          stream.mRemaining -= size;
+
+          auto chunk = UseServicesHelper::random(size);
+
+          {
+            AutoRecursiveLock remoteLock(*remote);
+            remote->expectData(channelID.c_str(), chunk);
+          }
+
+          channel->sendPartial(chunk, 0 == stream.mRemaining);
+
+          if ((!stream.mCheckedRejection) &&
+              (0 != stream.mRemaining)) {
+            stream.mCheckedRejection = true;
+
+            // no whole message (of either type) may cut into the stream
+            try {
+              channel->send(String("interrupt"));
+            } catch (const zsLib::Exceptions::InvalidUsage &) {
+              ++mRejectedDuringStream;
+            }
+            try {
+              channel->send(*UseServicesHelper::random(16));
+            } catch (const zsLib::Exceptions::InvalidUsage &) {
+              ++mRejectedDuringStream;
+            }
+          }
+
+          auto buffered = channel->bufferedAmount();
+          if (buffered > mMaxBufferedAmount) mMaxBufferedAmount = buffered;
+        }
+
+        if (0 == stream.mRemaining) {
+          ZS_LOG_DETAIL(log("stream fully queued") + ZS_PARAM("channel id", channelID))
+          mOutgoingStreams.erase(foundStream);
+        }
+      }
+
+      //-----------------------------------------------------------------------
+      void SCTPTester::pumpBenchmark(const String &channelID)
+      {
+        AutoRecursiveLock lock(*this);
+
+        auto foundBenchmark = mOutgoingBenchmarks.find(channelID);
+        if (foundBenchmark == mOutgoingBenchmarks.end()) return;
+
+        auto foundChannel = mDataChannels.find(channelID);
+        if (foundChannel == mDataChannels.end()) return;
+
+        OutgoingBenchmark &benchmark = (*foundBenchmark).second;
+        IDataChannelPtr channel = (*foundChannel).second;
+
+        while ((benchmark.mRemaining > 0) &&
+               (channel->bufferedAmount() < benchmark.mWindow)) {
+          --benchmark.mRemaining;
+
+          SecureByteBlockPtr message(make_shared<SecureByteBlock>(benchmark.mMessageSize));
+
+          QWORD sent = static_cast<QWORD>(zsLib::toMicroseconds(zsLib::now().time_since_epoch()).count());
+          memcpy(message->BytePtr(), &sent, sizeof(sent));
+
+          channel->send(message);
+        }
+
+        if (0 == benchmark.mRemaining) {
+          ZS_LOG_DETAIL(log("benchmark fully queued") + ZS_PARAM("channel id", channelID))
+          mOutgoingBenchmarks.erase(foundBenchmark);
+        }
+      }
+
     }
   }
 }
@@ -1433,6 +1708,17 @@ using ortc::SecureByteBlockPtr;
 #define TEST_BASIC_CONNECTIVITY 0
 #define TEST_INCOMING_SCTP 1
 #define TEST_INCOMING_DELAYED_SCTP 2
+#define TEST_INTERLEAVED_SCTP 3
+#define TEST_NON_INTERLEAVED_SCTP 4
+#define TEST_STREAMED_SCTP 5
+
+#define TEST_BULK_MESSAGE_SIZE (256*1024)
+#define TEST_BULK_TOTAL_SIZE (64*1024*1024)
+#define TEST_CONTROL_MESSAGES 5
+
+#define TEST_STREAM_TOTAL_SIZE (64*1024*1024)
+#define TEST_STREAM_CHUNK_SIZE (64*1024)
+#define TEST_STREAM_WINDOW (1024*1024)
 
 static void bogusSleep()
 {
@@ -1464,6 +1750,8 @@ void doTestSCTP()
     ULONG testNumber = 0;
     ULONG maxSteps = 80;
 
+    Optional<zsLib::Microseconds> interleavedLatency;
+
     do
     {
       TESTING_STDOUT() << "TESTING       ---------->>>>>>>>>> " << testNumber << " <<<<<<<<<<----------\n";
@@ -1511,7 +1799,7 @@ void doTestSCTP()
           testSCTPObject1->setClientRole(true);
           testSCTPObject2->setClientRole(false);
 
-          expectationsSCTP2.mReceivedBinary = 3;
+          expectationsSCTP2.mReceivedBinary = 4;
           expectationsSCTP2.mReceivedText = 0;
 
           expectationsSCTP2.mTransportIncoming = 1;
@@ -1537,6 +1825,54 @@ void doTestSCTP()
           expectationsSCTP1.mError = 1;
           break;
         }
+        case TEST_INTERLEAVED_SCTP:
+        case TEST_NON_INTERLEAVED_SCTP:
+        {
+          ortc::ISettings::setUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_MESSAGE_SIZE, TEST_BULK_MESSAGE_SIZE);
+          ortc::ISettings::setBool(ORTC_SETTING_SCTP_TRANSPORT_MESSAGE_INTERLEAVING, TEST_INTERLEAVED_SCTP == testNumber);
+
+          testSCTPObject1 = SCTPTester::create(thread);
+          testSCTPObject2 = SCTPTester::create(thread);
+
+          TESTING_CHECK(testSCTPObject1)
+          TESTING_CHECK(testSCTPObject2)
+
+          testSCTPObject1->setClientRole(true);
+          testSCTPObject2->setClientRole(false);
+
+          // "bulk" and "control" channels on both sides
+          expectationsSCTP1.mStateOpen = 2;
+          expectationsSCTP1.mStateClosing = 2;
+          expectationsSCTP1.mStateClosed = 2;
+
+          expectationsSCTP2 = expectationsSCTP1;
+
+          expectationsSCTP2.mReceivedBinary = TEST_BULK_TOTAL_SIZE / TEST_BULK_MESSAGE_SIZE;
+          expectationsSCTP2.mReceivedText = TEST_CONTROL_MESSAGES;
+          break;
+        }
+        case TEST_STREAMED_SCTP:
+        {
+          testSCTPObject1 = SCTPTester::create(thread);
+          testSCTPObject2 = SCTPTester::create(thread);
+
+          TESTING_CHECK(testSCTPObject1)
+          TESTING_CHECK(testSCTPObject2)
+
+          testSCTPObject1->setClientRole(true);
+          testSCTPObject2->setClientRole(false);
+
+          expectationsSCTP1.mStateOpen = 1;
+          expectationsSCTP1.mStateClosing = 1;
+          expectationsSCTP1.mStateClosed = 1;
+
+          expectationsSCTP2 = expectationsSCTP1;
+
+          // every chunk arrives on its own; all but the last are flagged partial
+          expectationsSCTP2.mReceivedBinary = TEST_STREAM_TOTAL_SIZE / TEST_STREAM_CHUNK_SIZE;
+          expectationsSCTP2.mReceivedPartial = (TEST_STREAM_TOTAL_SIZE / TEST_STREAM_CHUNK_SIZE) - 1;
+          break;
+        }
         default:  quit = true; break;
       }
       if (quit) break;
@@ -1717,6 +2053,7 @@ void doTestSCTP()
                 if (testSCTPObject1) testSCTPObject1->sendData("foo1", UseServicesHelper::random(20));
                 if (testSCTPObject1) testSCTPObject1->sendData("foo1", UseServicesHelper::random(20));
                 if (testSCTPObject1) testSCTPObject1->sendData("foo1", UseServicesHelper::random(20));
+                if (testSCTPObject1) testSCTPObject1->sendDataAdopted("foo1", UseServicesHelper::random(20));
                 //bogusSleep();
                 break;
               }
@@ -1873,6 +2210,186 @@ void doTestSCTP()
             }
             break;
           }
+          case TEST_INTERLEAVED_SCTP:
+          case TEST_NON_INTERLEAVED_SCTP: {
+            switch (step) {
+              case 2: {
+                if (testSCTPObject1) testSCTPObject1->start(testSCTPObject2);
+                break;
+              }
+              case 3: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Checking);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Checking);
+                break;
+              }
+              case 5: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Connected);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Connected);
+                break;
+              }
+              case 7: {
+                if (testSCTPObject1) testSCTPObject1->state(IDTLSTransportTypes::State_Connecting);
+                if (testSCTPObject2) testSCTPObject2->state(IDTLSTransportTypes::State_Connecting);
+                break;
+              }
+              case 11: {
+                if (testSCTPObject1) testSCTPObject1->state(IDTLSTransportTypes::State_Connected);
+                if (testSCTPObject2) testSCTPObject2->state(IDTLSTransportTypes::State_Connected);
+                break;
+              }
+              case 12: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Completed);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Completed);
+                break;
+              }
+              case 15: {
+                IDataChannel::Parameters bulkParams;
+                bulkParams.mLabel = "bulk";
+                bulkParams.mID = 0;
+                bulkParams.mNegotiated = true;
+
+                IDataChannel::Parameters controlParams;
+                controlParams.mLabel = "control";
+                controlParams.mID = 2;
+                controlParams.mNegotiated = true;
+
+                if (testSCTPObject1) testSCTPObject1->createChannel(bulkParams);
+                if (testSCTPObject2) testSCTPObject2->createChannel(bulkParams);
+                if (testSCTPObject1) testSCTPObject1->createChannel(controlParams);
+                if (testSCTPObject2) testSCTPObject2->createChannel(controlParams);
+                break;
+              }
+              case 20: {
+                // queue the whole bulk transfer up front so it saturates the association
+                for (size_t sent = 0; sent < TEST_BULK_TOTAL_SIZE; sent += TEST_BULK_MESSAGE_SIZE) {
+                  if (testSCTPObject1) testSCTPObject1->sendData("bulk", UseServicesHelper::random(TEST_BULK_MESSAGE_SIZE));
+                }
+                break;
+              }
+              case 21:
+              case 22:
+              case 23:
+              case 24:
+              case 25: {
+                if (testSCTPObject1) testSCTPObject1->sendData("control", UseServicesHelper::randomString(16));
+                break;
+              }
+              case 40: {
+                if (testSCTPObject1) testSCTPObject1->closeChannel("bulk");
+                if (testSCTPObject1) testSCTPObject1->closeChannel("control");
+                break;
+              }
+              case 44: {
+                if (testSCTPObject1) testSCTPObject1->close();
+                if (testSCTPObject2) testSCTPObject2->close();
+                break;
+              }
+              case 46: {
+                if (testSCTPObject1) testSCTPObject1->state(IDTLSTransportTypes::State_Closed);
+                if (testSCTPObject2) testSCTPObject2->state(IDTLSTransportTypes::State_Closed);
+                break;
+              }
+              case 47: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Disconnected);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Disconnected);
+                break;
+              }
+              case 49: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Closed);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Closed);
+                break;
+              }
+              case 50: {
+                lastStepReached = true;
+                break;
+              }
+              default: {
+                // nothing happening in this step
+                break;
+              }
+            }
+            break;
+          }
+          case TEST_STREAMED_SCTP: {
+            switch (step) {
+              case 2: {
+                if (testSCTPObject1) testSCTPObject1->start(testSCTPObject2);
+                break;
+              }
+              case 3: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Checking);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Checking);
+                break;
+              }
+              case 5: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Connected);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Connected);
+                break;
+              }
+              case 7: {
+                if (testSCTPObject1) testSCTPObject1->state(IDTLSTransportTypes::State_Connecting);
+                if (testSCTPObject2) testSCTPObject2->state(IDTLSTransportTypes::State_Connecting);
+                break;
+              }
+              case 11: {
+                if (testSCTPObject1) testSCTPObject1->state(IDTLSTransportTypes::State_Connected);
+                if (testSCTPObject2) testSCTPObject2->state(IDTLSTransportTypes::State_Connected);
+                break;
+              }
+              case 12: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Completed);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Completed);
+                break;
+              }
+              case 15: {
+                IDataChannel::Parameters params;
+                params.mLabel = "stream";
+                params.mID = 0;
+                params.mNegotiated = true;
+
+                if (testSCTPObject1) testSCTPObject1->createChannel(params);
+                if (testSCTPObject2) testSCTPObject2->createChannel(params);
+                break;
+              }
+              case 20: {
+                if (testSCTPObject1) testSCTPObject1->sendStream("stream", TEST_STREAM_TOTAL_SIZE, TEST_STREAM_CHUNK_SIZE, TEST_STREAM_WINDOW);
+                break;
+              }
+              case 40: {
+                if (testSCTPObject1) testSCTPObject1->closeChannel("stream");
+                break;
+              }
+              case 44: {
+                if (testSCTPObject1) testSCTPObject1->close();
+                if (testSCTPObject2) testSCTPObject2->close();
+                break;
+              }
+              case 46: {
+                if (testSCTPObject1) testSCTPObject1->state(IDTLSTransportTypes::State_Closed);
+                if (testSCTPObject2) testSCTPObject2->state(IDTLSTransportTypes::State_Closed);
+                break;
+              }
+              case 47: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Disconnected);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Disconnected);
+                break;
+              }
+              case 49: {
+                if (testSCTPObject1) testSCTPObject1->state(IICETransport::State_Closed);
+                if (testSCTPObject2) testSCTPObject2->state(IICETransport::State_Closed);
+                break;
+              }
+              case 50: {
+                lastStepReached = true;
+                break;
+              }
+              default: {
+                // nothing happening in this step
+                break;
+              }
+            }
+            break;
+          }
           default: {
             // none defined
             break;
@@ -1903,6 +2420,37 @@ void doTestSCTP()
         }
       //}
 
+      switch (testNumber) {
+        case TEST_INTERLEAVED_SCTP:
+        case TEST_NON_INTERLEAVED_SCTP: {
+          if (testSCTPObject2) {
+            auto averageLatency = testSCTPObject2->averageTextLatency();
+            TESTING_STDOUT() << "LATENCY:      " << (TEST_INTERLEAVED_SCTP == testNumber ? "I-DATA" : "DATA") << " control message latency during bulk transfer: average=" << averageLatency.count() << "us, max=" << testSCTPObject2->maxTextLatency().count() << "us\n";
+
+            if (TEST_INTERLEAVED_SCTP == testNumber) {
+              interleavedLatency = averageLatency;
+            } else if (interleavedLatency.hasValue()) {
+              // reported rather than asserted; wall clock averages over a
+              // loopback are too noisy for a functional pass/fail check
+              TESTING_STDOUT() << "LATENCY:      I-DATA average=" << interleavedLatency.value().count() << "us vs DATA average=" << averageLatency.count() << "us\n";
+            }
+          }
+          ortc::ISettings::applyDefaults();
+          break;
+        }
+        case TEST_STREAMED_SCTP: {
+          if (testSCTPObject1) {
+            // the sender never held more than one window plus one chunk
+            TESTING_CHECK(testSCTPObject1->maxBufferedAmount() <= TEST_STREAM_WINDOW + TEST_STREAM_CHUNK_SIZE)
+            // both whole messages sent mid-stream were refused
+            TESTING_CHECK(2 == testSCTPObject1->rejectedDuringStream())
+            TESTING_STDOUT() << "STREAM:       peak buffered amount while streaming " << (TEST_STREAM_TOTAL_SIZE / (1024*1024)) << "MB: " << testSCTPObject1->maxBufferedAmount() << " bytes\n";
+          }
+          break;
+        }
+        default: break;
+      }
+
       testSCTPObject1.reset();
       testSCTPObject2.reset();
 
@@ -1929,3 +2477,295 @@ void doTestSCTP()
   zsLib::proxyDump();
   TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
 }
+
+ZS_DECLARE_USING_PTR(ortc::test::sctp, FakeSecureTransport)
+
+#define TEST_LISTENER_BENCHMARK_ASSOCIATIONS 10000
+
+void doTestSCTPListenerBenchmark()
+{
+  if (!ORTC_TEST_DO_SCTP_TRANSPORT_LISTENER_BENCHMARK) return;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+
+  zsLib::MessageQueueThreadPtr thread(zsLib::MessageQueueThread::createBasic());
+
+  TESTING_STDOUT() << "BENCHMARK:    Creating and tearing down " << TEST_LISTENER_BENCHMARK_ASSOCIATIONS << " SCTP associations on a single listener.\n";
+
+  {
+    FakeICETransportPtr iceTransport = FakeICETransport::create(thread);
+    FakeSecureTransportPtr dtlsTransport = FakeSecureTransport::create(thread, iceTransport);
+
+    std::vector<ISCTPTransportPtr> transports;
+    transports.reserve(TEST_LISTENER_BENCHMARK_ASSOCIATIONS);
+
+    // every association holds on to its port so each allocation has to
+    // find a free port among a growing number of taken ones
+    auto start = zsLib::now();
+    for (size_t index = 0; index < TEST_LISTENER_BENCHMARK_ASSOCIATIONS; ++index) {
+      auto transport = ISCTPTransport::create(ortc::ISCTPTransportDelegatePtr(), dtlsTransport);
+      TESTING_CHECK(transport)
+      transports.push_back(transport);
+    }
+    auto created = zsLib::now();
+
+    for (auto iter = transports.begin(); iter != transports.end(); ++iter) {
+      (*iter)->stop();
+    }
+    auto stopped = zsLib::now();
+
+    transports.clear();
+
+    TESTING_STDOUT() << "BENCHMARK:    create=" << zsLib::toMilliseconds(created - start).count() << "ms, stop=" << zsLib::toMilliseconds(stopped - created).count() << "ms\n";
+
+    // let the listener process the shutdown notifications and free the ports
+    TESTING_SLEEP(5000)
+
+    // churn: ports are released and reused continuously
+    start = zsLib::now();
+    for (size_t index = 0; index < TEST_LISTENER_BENCHMARK_ASSOCIATIONS; ++index) {
+      auto transport = ISCTPTransport::create(ortc::ISCTPTransportDelegatePtr(), dtlsTransport);
+      TESTING_CHECK(transport)
+      transport->stop();
+    }
+    auto churned = zsLib::now();
+
+    TESTING_STDOUT() << "BENCHMARK:    churn create+stop=" << zsLib::toMilliseconds(churned - start).count() << "ms\n";
+
+    TESTING_SLEEP(5000)
+
+    dtlsTransport->state(ortc::IDTLSTransportTypes::State_Closed);
+    iceTransport->state(IICETransport::State_Closed);
+  }
+
+  TESTING_SLEEP(5000)
+
+  // wait for shutdown
+  {
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+
+    thread->waitForShutdown();
+  }
+  TESTING_UNINSTALL_LOGGER();
+  zsLib::proxyDump();
+  TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
+}
+
+#define TEST_DATACHANNEL_BENCHMARK_CHANNELS 4
+#define TEST_DATACHANNEL_BENCHMARK_BYTES_PER_RUN (32*1024*1024)
+#define TEST_DATACHANNEL_BENCHMARK_MAX_MESSAGES_PER_CHANNEL 20000
+#define TEST_DATACHANNEL_BENCHMARK_MAX_MESSAGE_SIZE (64*1024)
+#define TEST_DATACHANNEL_BENCHMARK_WINDOW (1024*1024)
+#define TEST_DATACHANNEL_BENCHMARK_TIMEOUT_IN_SECONDS 120
+#define TEST_DATACHANNEL_BENCHMARK_LATENCY_PROBES 200
+#define TEST_DATACHANNEL_BENCHMARK_LATENCY_PROBE_TIMEOUT_IN_SECONDS 1
+
+static bool waitForBenchmark(
+                             std::function<bool()> condition,
+                             zsLib::Seconds timeout = zsLib::Seconds(TEST_DATACHANNEL_BENCHMARK_TIMEOUT_IN_SECONDS)
+                             )
+{
+  auto expires = zsLib::now() + timeout;
+  while (!condition()) {
+    if (zsLib::now() > expires) return false;
+    TESTING_SLEEP(10)
+  }
+  return true;
+}
+
+void doTestSCTPDataChannelBenchmark()
+{
+  if (!ORTC_TEST_DO_SCTP_DATACHANNEL_BENCHMARK) return;
+
+  TESTING_INSTALL_LOGGER();
+
+  ortc::ISettings::applyDefaults();
+  ortc::ISettings::setUInt(ORTC_SETTING_SCTP_TRANSPORT_MAX_MESSAGE_SIZE, TEST_DATACHANNEL_BENCHMARK_MAX_MESSAGE_SIZE);
+
+  zsLib::MessageQueueThreadPtr thread(zsLib::MessageQueueThread::createBasic());
+
+  struct Scenario
+  {
+    const char *mName;
+    bool mOrdered;
+    bool mReliable;
+  };
+
+  static const Scenario scenarios[] = {
+    {"ordered-reliable", true, true},
+    {"unordered-reliable", false, true},
+    {"ordered-partial", true, false},
+    {"unordered-partial", false, false},
+  };
+
+  static const size_t messageSizes[] = {64, 1024, 16*1024, TEST_DATACHANNEL_BENCHMARK_MAX_MESSAGE_SIZE};
+
+  TESTING_STDOUT() << "BENCHMARK:    Loopback data channel throughput and latency over " << TEST_DATACHANNEL_BENCHMARK_CHANNELS << " channels per run.\n";
+
+  {
+    // two SCTP transports linked back to back through the fake ICE/DTLS
+    // transports; packets never touch a socket or get encrypted
+    SCTPTesterPtr sender = SCTPTester::create(thread);
+    SCTPTesterPtr receiver = SCTPTester::create(thread);
+
+    TESTING_CHECK(sender)
+    TESTING_CHECK(receiver)
+
+    sender->setClientRole(true);
+    receiver->setClientRole(false);
+
+    sender->start(receiver);
+
+    sender->state(IICETransport::State_Checking);
+    receiver->state(IICETransport::State_Checking);
+    sender->state(IICETransport::State_Connected);
+    receiver->state(IICETransport::State_Connected);
+    sender->state(IDTLSTransportTypes::State_Connecting);
+    receiver->state(IDTLSTransportTypes::State_Connecting);
+    sender->state(IDTLSTransportTypes::State_Connected);
+    receiver->state(IDTLSTransportTypes::State_Connected);
+    sender->state(IICETransport::State_Completed);
+    receiver->state(IICETransport::State_Completed);
+
+    TESTING_SLEEP(2000)
+
+    ULONG totalChannels = 0;
+
+    for (size_t scenarioIndex = 0; scenarioIndex < (sizeof(scenarios) / sizeof(scenarios[0])); ++scenarioIndex) {
+      const Scenario &scenario = scenarios[scenarioIndex];
+
+      for (size_t sizeIndex = 0; sizeIndex < (sizeof(messageSizes) / sizeof(messageSizes[0])); ++sizeIndex) {
+        size_t messageSize = messageSizes[sizeIndex];
+
+        size_t messagesPerChannel = TEST_DATACHANNEL_BENCHMARK_BYTES_PER_RUN / messageSize / TEST_DATACHANNEL_BENCHMARK_CHANNELS;
+        if (messagesPerChannel > TEST_DATACHANNEL_BENCHMARK_MAX_MESSAGES_PER_CHANNEL) messagesPerChannel = TEST_DATACHANNEL_BENCHMARK_MAX_MESSAGES_PER_CHANNEL;
+
+        std::vector<String> labels;
+        for (size_t index = 0; index < TEST_DATACHANNEL_BENCHMARK_CHANNELS; ++index) {
+          String label = String("bench-") + scenario.mName + "-" + zsLib::string(messageSize) + "-" + zsLib::string(index);
+          labels.push_back(label);
+
+          receiver->expectBenchmark(label.c_str());
+
+          IDataChannel::Parameters params;
+          params.mLabel = label;
+          params.mOrdered = scenario.mOrdered;
+          if (!scenario.mReliable) params.mMaxRetransmits = 0;
+
+          sender->createChannel(params);
+        }
+        totalChannels += TEST_DATACHANNEL_BENCHMARK_CHANNELS;
+
+        TESTING_CHECK(waitForBenchmark([&]() -> bool {return sender->getExpectations().mStateOpen >= totalChannels;}))
+
+        auto start = zsLib::now();
+        for (auto iter = labels.begin(); iter != labels.end(); ++iter) {
+          sender->sendBenchmark((*iter).c_str(), messageSize, messagesPerChannel, TEST_DATACHANNEL_BENCHMARK_WINDOW);
+        }
+
+        size_t expectedMessages = messagesPerChannel * TEST_DATACHANNEL_BENCHMARK_CHANNELS;
+
+        auto receivedMessages = [&]() -> size_t {
+          size_t total = 0;
+          for (auto iter = labels.begin(); iter != labels.end(); ++iter) {
+            total += receiver->benchmarkResults((*iter).c_str()).mMessages;
+          }
+          return total;
+        };
+
+        bool completed = waitForBenchmark([&]() -> bool {return receivedMessages() >= expectedMessages;});
+
+        // partially reliable channels may give up on messages; reliable ones may not
+        if (scenario.mReliable) {
+          TESTING_CHECK(completed)
+        }
+
+        size_t messages = 0;
+        size_t bytes = 0;
+        zsLib::Time finished = start;
+
+        for (auto iter = labels.begin(); iter != labels.end(); ++iter) {
+          auto results = receiver->benchmarkResults((*iter).c_str());
+          messages += results.mMessages;
+          bytes += results.mBytes;
+          if (results.mLastReceived > finished) finished = results.mLastReceived;
+        }
+
+        double seconds = static_cast<double>(zsLib::toMicroseconds(finished - start).count()) / 1000000.0;
+        if (seconds <= 0.0) seconds = 0.000001;
+
+        // latency under the bulk window is mostly queueing; measure it
+        // separately with probes of the row's message size sent one at a
+        // time (a window of one message) on an idle channel
+        const String &probeLabel = labels.front();
+        receiver->expectBenchmark(probeLabel.c_str());
+
+        size_t probesDelivered = 0;
+        for (size_t probe = 0; probe < TEST_DATACHANNEL_BENCHMARK_LATENCY_PROBES; ++probe) {
+          sender->sendBenchmark(probeLabel.c_str(), messageSize, 1, messageSize);
+
+          // a lost probe (partially reliable channels) must not stall the run
+          waitForBenchmark([&]() -> bool {return receiver->benchmarkResults(probeLabel.c_str()).mMessages > probesDelivered;}, zsLib::Seconds(TEST_DATACHANNEL_BENCHMARK_LATENCY_PROBE_TIMEOUT_IN_SECONDS));
+          probesDelivered = receiver->benchmarkResults(probeLabel.c_str()).mMessages;
+        }
+
+        SCTPTester::LatencyList latencies = receiver->benchmarkResults(probeLabel.c_str()).mLatencies;
+        std::sort(latencies.begin(), latencies.end());
+
+        zsLib::Microseconds p50 {};
+        zsLib::Microseconds p99 {};
+        if (latencies.size() > 0) {
+          p50 = latencies[((latencies.size() - 1) * 50) / 100];
+          p99 = latencies[((latencies.size() - 1) * 99) / 100];
+        }
+
+        TESTING_STDOUT() << "BENCHMARK:    " << scenario.mName << " size=" << messageSize << " delivered=" << messages << "/" << expectedMessages
+                         << " msgs/sec=" << static_cast<size_t>(static_cast<double>(messages) / seconds)
+                         << " MB/sec=" << (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds
+                         << " probe p50=" << p50.count() << "us p99=" << p99.count() << "us (" << latencies.size() << "/" << TEST_DATACHANNEL_BENCHMARK_LATENCY_PROBES << " probes)\n";
+
+        for (auto iter = labels.begin(); iter != labels.end(); ++iter) {
+          sender->closeChannel((*iter).c_str());
+        }
+
+        TESTING_CHECK(waitForBenchmark([&]() -> bool {return sender->getExpectations().mStateClosed >= totalChannels;}))
+      }
+    }
+
+    sender->close();
+    receiver->close();
+
+    TESTING_SLEEP(2000)
+
+    sender->state(IDTLSTransportTypes::State_Closed);
+    receiver->state(IDTLSTransportTypes::State_Closed);
+    sender->state(IICETransport::State_Closed);
+    receiver->state(IICETransport::State_Closed);
+  }
+
+  TESTING_SLEEP(5000)
+
+  // wait for shutdown
+  {
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+
+    thread->waitForShutdown();
+  }
+  TESTING_UNINSTALL_LOGGER();
+  zsLib::proxyDump();
+  TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
+}
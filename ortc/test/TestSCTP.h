@@ -465,6 +465,7 @@ namespace ortc
 
           ULONG mReceivedBinary {0};
           ULONG mReceivedText {0};
+          ULONG mReceivedPartial {0};
 
           ULONG mError {0};
 
@@ -487,6 +488,34 @@ namespace ortc
         typedef std::list<String> StringList;
         typedef std::map<String, StringList> StringMap;
 
+        typedef std::list<Time> TimeList;
+        typedef std::map<String, TimeList> TimeMap;
+
+        struct OutgoingStream {
+          size_t mRemaining {};
+          size_t mChunkSize {};
+          size_t mWindow {};
+          bool mCheckedRejection {false};
+        };
+        typedef std::map<String, OutgoingStream> OutgoingStreamMap;
+
+        struct OutgoingBenchmark {
+          size_t mRemaining {};
+          size_t mMessageSize {};
+          size_t mWindow {};
+        };
+        typedef std::map<String, OutgoingBenchmark> OutgoingBenchmarkMap;
+
+        typedef std::vector<zsLib::Microseconds> LatencyList;
+
+        struct BenchmarkResults {
+          size_t mMessages {};
+          size_t mBytes {};
+          Time mLastReceived;
+          LatencyList mLatencies;   // one-way, from the timestamp stamped into each message
+        };
+        typedef std::map<String, BenchmarkResults> BenchmarkResultsMap;
+
       public:
         static SCTPTesterPtr create(
                                     IMessageQueuePtr queue,
@@ -532,13 +561,41 @@ namespace ortc
                       SecureByteBlockPtr buffer
                       );
 
+        void sendDataAdopted(
+                             const char *channelID,
+                             SecureByteBlockPtr buffer
+                             );
+
         void sendData(
                       const char *channelID,
                       const String &message
                       );
 
+        void sendStream(
+                        const char *channelID,
+                        size_t totalSize,
+                        size_t chunkSize,
+                        size_t window
+                        );
+
+        void expectBenchmark(const char *channelID);
+
+        void sendBenchmark(
+                           const char *channelID,
+                           size_t messageSize,
+                           size_t totalMessages,
+                           size_t window
+                           );
+
+        BenchmarkResults benchmarkResults(const char *channelID) const;
+
         void closeChannel(const char *channelID);
 
+        zsLib::Microseconds maxTextLatency() const;
+        zsLib::Microseconds averageTextLatency() const;
+        size_t maxBufferedAmount() const;
+        ULONG rejectedDuringStream() const;
+
       protected:
 
         //---------------------------------------------------------------------
@@ -604,6 +661,9 @@ namespace ortc
                         const String &message
                         );
 
+        void pumpStream(const String &channelID);
+        void pumpBenchmark(const String &channelID);
+
       public:
         //---------------------------------------------------------------------
         #pragma mark
@@ -627,6 +687,18 @@ namespace ortc
 
         BufferMap mBuffers;
         StringMap mStrings;
+
+        TimeMap mStringSentTimes;
+        zsLib::Microseconds mMaxTextLatency {};
+        zsLib::Microseconds mTotalTextLatency {};
+        ULONG mTotalTextLatencySamples {};
+
+        OutgoingStreamMap mOutgoingStreams;
+        size_t mMaxBufferedAmount {};
+        ULONG mRejectedDuringStream {};
+
+        OutgoingBenchmarkMap mOutgoingBenchmarks;
+        BenchmarkResultsMap mBenchmarkResults;
       };
     }
   }
@@ -45,10 +45,18 @@
 #define ORTC_TEST_TELNET_SERVER_LOGGING_PORT  (51999)
 
 #define ORTC_TEST_DO_ICE_GATHERER_TEST                    (false)
+#define ORTC_TEST_DO_ICE_GATHERER_UDP_MUX_TEST            (false)
+#define ORTC_TEST_DO_ICE_GATHERER_UDP_SEND_BATCH_TEST     (false)
+#define ORTC_TEST_DO_ICE_GATHERER_WARM_POOL_TEST          (false)
 #define ORTC_TEST_DO_ICE_TRANSPORT_TEST                   (false)
+#define ORTC_TEST_DO_ICE_TRANSPORT_RENOMINATION_TEST      (false)
+#define ORTC_TEST_DO_TIMER_WHEEL_TEST                     (false)
+#define ORTC_TEST_DO_ICE_CHECK_PACER_TEST                 (false)
 #define ORTC_TEST_DO_DTLS_TRANSPORT_TEST                  (false)
 #define ORTC_TEST_DO_SRTP_TEST                            (false)
 #define ORTC_TEST_DO_SCTP_TRANSPORT_TEST                  (false)
+#define ORTC_TEST_DO_SCTP_TRANSPORT_LISTENER_BENCHMARK    (false)
+#define ORTC_TEST_DO_SCTP_DATACHANNEL_BENCHMARK           (false)
 #define ORTC_TEST_DO_RTP_PACKET_TEST                      (false)
 #define ORTC_TEST_DO_RTCP_PACKET_TEST                     (false)
 #define ORTC_TEST_DO_RTP_LISTENER_TEST                    (false)
@@ -61,10 +61,18 @@ void doTestRTPListener();
 void doTestRTPPacket();
 void doTestRTCPPacket();
 void doTestSCTP();
+void doTestSCTPListenerBenchmark();
+void doTestSCTPDataChannelBenchmark();
 void doTestDTLS();
 void doTestSRTP();
 void doTestICEGatherer();
+void doTestICEGathererUDPMux();
+void doTestICEGathererUDPSendBatch();
+void doTestICEGathererWarmPool();
 void doTestICETransport();
+void doTestICETransportRenomination();
+void doTestTimerWheel();
+void doTestICECheckPacer();
 void doTestMediaStreamTrack(void* videoSurface);
 void doTestRTPChannelAudio();
 void doTestRTPChannelVideo(void* localSurface, void* remoteSurface);
@@ -201,10 +209,18 @@ namespace Testing
     TESTING_RUN_TEST_FUNC_0(doTestRTPPacket)
     TESTING_RUN_TEST_FUNC_0(doTestRTCPPacket)
     TESTING_RUN_TEST_FUNC_0(doTestSCTP)
+    TESTING_RUN_TEST_FUNC_0(doTestSCTPListenerBenchmark)
+    TESTING_RUN_TEST_FUNC_0(doTestSCTPDataChannelBenchmark)
     TESTING_RUN_TEST_FUNC_0(doTestSRTP)
     TESTING_RUN_TEST_FUNC_0(doTestDTLS)
     TESTING_RUN_TEST_FUNC_0(doTestICEGatherer)
+    TESTING_RUN_TEST_FUNC_0(doTestICEGathererUDPMux)
+    TESTING_RUN_TEST_FUNC_0(doTestICEGathererUDPSendBatch)
+    TESTING_RUN_TEST_FUNC_0(doTestICEGathererWarmPool)
     TESTING_RUN_TEST_FUNC_0(doTestICETransport)
+    TESTING_RUN_TEST_FUNC_0(doTestICETransportRenomination)
+    TESTING_RUN_TEST_FUNC_0(doTestTimerWheel)
+    TESTING_RUN_TEST_FUNC_0(doTestICECheckPacer)
     TESTING_RUN_TEST_FUNC_1(doTestMediaStreamTrack, videoSurface1)
     TESTING_RUN_TEST_FUNC_0(doTestRTPChannelAudio)
     TESTING_RUN_TEST_FUNC_2(doTestRTPChannelVideo, videoSurface1, videoSurface2)